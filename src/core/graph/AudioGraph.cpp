@@ -3,6 +3,8 @@
 #include "ExecutionSorter.h"
 #include "FeedbackLoopDetector.h"
 #include "../../api/IAudioNode.h"
+#include "../../events/ClockCorrelator.h"
+#include "../../events/MidiEventBus.h"
 
 namespace nap {
 
@@ -12,6 +14,9 @@ public:
     std::unique_ptr<ConnectionManager> connectionManager;
     std::unique_ptr<ExecutionSorter> executionSorter;
     std::unique_ptr<FeedbackLoopDetector> feedbackDetector;
+    std::unique_ptr<events::MidiEventBus> midiBus;
+    std::unique_ptr<events::ClockCorrelator> clock;
+    std::uint64_t samplePosition = 0;
     std::vector<std::string> processingOrder;
     double sampleRate = 44100.0;
     std::uint32_t blockSize = 512;
@@ -24,6 +29,8 @@ AudioGraph::AudioGraph()
     m_impl->connectionManager = std::make_unique<ConnectionManager>();
     m_impl->executionSorter = std::make_unique<ExecutionSorter>();
     m_impl->feedbackDetector = std::make_unique<FeedbackLoopDetector>();
+    m_impl->midiBus = std::make_unique<events::MidiEventBus>();
+    m_impl->clock = std::make_unique<events::ClockCorrelator>(m_impl->sampleRate);
 }
 
 AudioGraph::~AudioGraph() = default;
@@ -101,18 +108,48 @@ bool AudioGraph::disconnect(const std::string& sourceNodeId, std::uint32_t sourc
 }
 
 void AudioGraph::processBlock(std::uint32_t numFrames)
+{
+    // Filter the callback jitter out of the call time, then place the block
+    // one block duration earlier so recent events keep their spacing
+    const std::uint64_t position = m_impl->samplePosition;
+    m_impl->clock->update(events::MidiEventBus::now(), position);
+    const double start = static_cast<double>(position) - static_cast<double>(numFrames);
+    processBlock(numFrames, m_impl->clock->systemTimeAt(start));
+}
+
+void AudioGraph::processBlock(std::uint32_t numFrames, std::uint64_t blockStartUs)
 {
     if (m_impl->needsRebuild) {
         rebuildProcessingOrder();
     }
 
+    m_impl->midiBus->processBlock(blockStartUs, numFrames, m_impl->sampleRate);
+    m_impl->samplePosition += numFrames;
+
     // TODO: Implement block processing with proper buffer management
 }
 
+void AudioGraph::setStreamPosition(std::uint64_t samplePosition)
+{
+    m_impl->samplePosition = samplePosition;
+}
+
+events::MidiEventBus& AudioGraph::getMidiBus()
+{
+    return *m_impl->midiBus;
+}
+
+events::ClockCorrelator& AudioGraph::getClockCorrelator()
+{
+    return *m_impl->clock;
+}
+
 void AudioGraph::prepare(double sampleRate, std::uint32_t blockSize)
 {
     m_impl->sampleRate = sampleRate;
     m_impl->blockSize = blockSize;
+    m_impl->samplePosition = 0;
+    m_impl->clock->reset(sampleRate);
 
     for (auto& [id, node] : m_impl->nodes) {
         node->prepare(sampleRate, blockSize);
@@ -141,6 +178,11 @@ std::vector<std::string> AudioGraph::getAllNodeIds() const
     return ids;
 }
 
+std::vector<Connection> AudioGraph::getConnections() const
+{
+    return m_impl->connectionManager->getAllConnections();
+}
+
 void AudioGraph::rebuildProcessingOrder()
 {
     // TODO: Use ExecutionSorter to compute topological order
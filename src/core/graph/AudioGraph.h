@@ -11,9 +11,15 @@ namespace nap {
 
 class IAudioNode;
 class ConnectionManager;
+struct Connection;
 class ExecutionSorter;
 class FeedbackLoopDetector;
 
+namespace events {
+class ClockCorrelator;
+class MidiEventBus;
+}
+
 /**
  * @brief Central audio processing graph that manages nodes and their connections.
  *
@@ -79,6 +85,44 @@ public:
      */
     void processBlock(std::uint32_t numFrames);
 
+    /**
+     * @brief Process one block whose first sample corresponds to a known time.
+     *
+     * MIDI events are placed at sample offsets relative to blockStartUs
+     * (steady-clock microseconds, see events::MidiEventBus::now()). The
+     * overload without a time feeds the call time and the graph's running
+     * sample count (see setStreamPosition()) to its ClockCorrelator. It then uses the filtered time
+     * one block before the call, so events received during the previous
+     * block keep their relative timing at a constant one-block latency.
+     * @param numFrames Number of frames to process
+     * @param blockStartUs Time of the block's first sample
+     */
+    void processBlock(std::uint32_t numFrames, std::uint64_t blockStartUs);
+
+    /**
+     * @brief Align the graph's sample count with the driver's stream position.
+     *
+     * Call from the audio callback before processBlock(numFrames) with the
+     * driver's position in samples at the start of the block, so the
+     * ClockCorrelator tracks the device clock rather than the number of
+     * frames the graph happened to process. The count then advances by
+     * numFrames per block until the next call.
+     * @param samplePosition Driver stream position in samples
+     */
+    void setStreamPosition(std::uint64_t samplePosition);
+
+    /**
+     * @brief MIDI inputs drained by the graph at the start of every block.
+     * @return The graph's event bus; nodes read the block's events from it
+     */
+    events::MidiEventBus& getMidiBus();
+
+    /**
+     * @brief Jitter-filtered mapping between system time and the graph's sample count.
+     * @return The correlator updated by processBlock(numFrames)
+     */
+    events::ClockCorrelator& getClockCorrelator();
+
     /**
      * @brief Prepare all nodes for processing.
      * @param sampleRate The sample rate
@@ -103,6 +147,12 @@ public:
      */
     std::vector<std::string> getAllNodeIds() const;
 
+    /**
+     * @brief Get all connections in the graph.
+     * @return Vector of connections
+     */
+    std::vector<Connection> getConnections() const;
+
     /**
      * @brief Rebuild the processing order after topology changes.
      */
@@ -15,6 +15,20 @@ public:
     {
     }
 
+    // Split [start, start + count) into the part before the end of storage
+    // and the part that wraps to the beginning.
+    Region makeRegion(std::size_t start, std::size_t count)
+    {
+        Region region;
+        const std::size_t untilEnd = capacity - start;
+
+        region.first.data = buffer.data() + start;
+        region.first.size = std::min(count, untilEnd);
+        region.second.data = buffer.data();
+        region.second.size = count - region.first.size;
+        return region;
+    }
+
     std::vector<float> buffer;
     std::size_t capacity;
     std::atomic<std::size_t> readIndex;
@@ -33,51 +47,63 @@ CircularBuffer& CircularBuffer::operator=(CircularBuffer&&) noexcept = default;
 
 std::size_t CircularBuffer::write(const float* data, std::size_t numSamples)
 {
-    const std::size_t available = getAvailableForWrite();
-    const std::size_t toWrite = std::min(numSamples, available);
+    const Region region = prepareWrite(numSamples);
 
-    std::size_t writeIdx = m_impl->writeIndex.load(std::memory_order_relaxed);
+    std::copy_n(data, region.first.size, region.first.data);
+    std::copy_n(data + region.first.size, region.second.size, region.second.data);
 
-    for (std::size_t i = 0; i < toWrite; ++i) {
-        m_impl->buffer[writeIdx] = data[i];
-        writeIdx = (writeIdx + 1) % m_impl->capacity;
-    }
-
-    m_impl->writeIndex.store(writeIdx, std::memory_order_release);
-    return toWrite;
+    return commitWrite(region.size());
 }
 
 std::size_t CircularBuffer::read(float* data, std::size_t numSamples)
 {
-    const std::size_t available = getAvailableForRead();
-    const std::size_t toRead = std::min(numSamples, available);
-
-    std::size_t readIdx = m_impl->readIndex.load(std::memory_order_relaxed);
+    const Region region = prepareRead(numSamples);
 
-    for (std::size_t i = 0; i < toRead; ++i) {
-        data[i] = m_impl->buffer[readIdx];
-        readIdx = (readIdx + 1) % m_impl->capacity;
-    }
+    std::copy_n(region.first.data, region.first.size, data);
+    std::copy_n(region.second.data, region.second.size, data + region.first.size);
 
-    m_impl->readIndex.store(readIdx, std::memory_order_release);
-    return toRead;
+    return commitRead(region.size());
 }
 
 std::size_t CircularBuffer::peek(float* data, std::size_t numSamples) const
 {
-    const std::size_t available = getAvailableForRead();
-    const std::size_t toPeek = std::min(numSamples, available);
+    const std::size_t toPeek = std::min(numSamples, getAvailableForRead());
+    const Region region = m_impl->makeRegion(
+        m_impl->readIndex.load(std::memory_order_acquire), toPeek);
 
-    std::size_t readIdx = m_impl->readIndex.load(std::memory_order_acquire);
-
-    for (std::size_t i = 0; i < toPeek; ++i) {
-        data[i] = m_impl->buffer[readIdx];
-        readIdx = (readIdx + 1) % m_impl->capacity;
-    }
+    std::copy_n(region.first.data, region.first.size, data);
+    std::copy_n(region.second.data, region.second.size, data + region.first.size);
 
     return toPeek;
 }
 
+CircularBuffer::Region CircularBuffer::prepareWrite(std::size_t numSamples)
+{
+    const std::size_t toWrite = std::min(numSamples, getAvailableForWrite());
+    return m_impl->makeRegion(m_impl->writeIndex.load(std::memory_order_relaxed), toWrite);
+}
+
+std::size_t CircularBuffer::commitWrite(std::size_t numSamples)
+{
+    const std::size_t toCommit = std::min(numSamples, getAvailableForWrite());
+
+    const std::size_t writeIdx = m_impl->writeIndex.load(std::memory_order_relaxed);
+    m_impl->writeIndex.store((writeIdx + toCommit) % m_impl->capacity, std::memory_order_release);
+
+    return toCommit;
+}
+
+CircularBuffer::Region CircularBuffer::prepareRead(std::size_t numSamples)
+{
+    const std::size_t toRead = std::min(numSamples, getAvailableForRead());
+    return m_impl->makeRegion(m_impl->readIndex.load(std::memory_order_relaxed), toRead);
+}
+
+std::size_t CircularBuffer::commitRead(std::size_t numSamples)
+{
+    return skip(numSamples);
+}
+
 std::size_t CircularBuffer::skip(std::size_t numSamples)
 {
     const std::size_t available = getAvailableForRead();
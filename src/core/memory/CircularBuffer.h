@@ -14,6 +14,28 @@ namespace nap {
  */
 class CircularBuffer {
 public:
+    /**
+     * @brief A contiguous run of samples inside the ring storage.
+     */
+    struct Span {
+        float* data = nullptr;
+        std::size_t size = 0;
+    };
+
+    /**
+     * @brief Up to two contiguous spans covering a reserved range.
+     *
+     * The second span is non-empty only when the range wraps around the
+     * end of the ring storage.
+     */
+    struct Region {
+        Span first;
+        Span second;
+
+        std::size_t size() const { return first.size + second.size; }
+        bool empty() const { return size() == 0; }
+    };
+
     /**
      * @brief Construct a circular buffer with the specified capacity.
      * @param capacity Maximum number of samples the buffer can hold
@@ -57,6 +79,39 @@ public:
      */
     std::size_t skip(std::size_t numSamples);
 
+    /**
+     * @brief Reserve space for writing directly into the ring (producer only).
+     *
+     * The returned region stays valid until commitWrite() is called. Nothing
+     * becomes visible to the consumer until the write is committed.
+     * @param numSamples Number of samples the producer wants to write
+     * @return Writable region, possibly smaller than requested
+     */
+    Region prepareWrite(std::size_t numSamples);
+
+    /**
+     * @brief Publish samples written into a region from prepareWrite().
+     * @param numSamples Number of samples actually written
+     * @return Number of samples committed
+     */
+    std::size_t commitWrite(std::size_t numSamples);
+
+    /**
+     * @brief Access readable samples in place without copying (consumer only).
+     *
+     * The returned region stays valid until commitRead() is called.
+     * @param numSamples Number of samples the consumer wants to read
+     * @return Readable region, possibly smaller than requested
+     */
+    Region prepareRead(std::size_t numSamples);
+
+    /**
+     * @brief Release samples obtained from prepareRead() back to the producer.
+     * @param numSamples Number of samples consumed
+     * @return Number of samples released
+     */
+    std::size_t commitRead(std::size_t numSamples);
+
     /**
      * @brief Get the number of samples available for reading.
      * @return Number of available samples
@@ -0,0 +1,158 @@
+#include "MappedFile.h"
+#include <cerrno>
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define NAP_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <vector>
+#endif
+
+namespace nap {
+
+class MappedFile::Impl {
+public:
+    const std::uint8_t* data = nullptr;
+    std::size_t size = 0;
+    bool open = false;
+    bool mapped = false;
+    std::string lastError;
+
+#if !defined(NAP_HAS_MMAP)
+    std::vector<std::uint64_t> buffer;  // 64-bit elements keep the copy aligned
+#endif
+
+    void release()
+    {
+#if defined(NAP_HAS_MMAP)
+        if (mapped && data) {
+            munmap(const_cast<std::uint8_t*>(data), size);
+        }
+#else
+        buffer.clear();
+        buffer.shrink_to_fit();
+#endif
+        data = nullptr;
+        size = 0;
+        open = false;
+        mapped = false;
+    }
+};
+
+MappedFile::MappedFile()
+    : m_impl(std::make_unique<Impl>())
+{
+}
+
+MappedFile::~MappedFile()
+{
+    if (m_impl) {
+        m_impl->release();
+    }
+}
+
+MappedFile::MappedFile(MappedFile&&) noexcept = default;
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other) {
+        if (m_impl) {
+            m_impl->release();
+        }
+        m_impl = std::move(other.m_impl);
+    }
+    return *this;
+}
+
+bool MappedFile::open(const std::string& filepath)
+{
+    m_impl->release();
+    m_impl->lastError.clear();
+
+#if defined(NAP_HAS_MMAP)
+    const int fd = ::open(filepath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        m_impl->lastError = "Failed to open " + filepath + ": " + std::strerror(errno);
+        return false;
+    }
+
+    struct stat info{};
+    if (fstat(fd, &info) != 0) {
+        m_impl->lastError = "Failed to stat " + filepath + ": " + std::strerror(errno);
+        ::close(fd);
+        return false;
+    }
+
+    const auto length = static_cast<std::size_t>(info.st_size);
+    if (length > 0) {
+        void* address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address == MAP_FAILED) {
+            m_impl->lastError = "Failed to map " + filepath + ": " + std::strerror(errno);
+            ::close(fd);
+            return false;
+        }
+        m_impl->data = static_cast<const std::uint8_t*>(address);
+        m_impl->mapped = true;
+    }
+    ::close(fd);  // The mapping keeps the file referenced
+    m_impl->size = length;
+#else
+    std::ifstream file(filepath, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        m_impl->lastError = "Failed to open " + filepath;
+        return false;
+    }
+
+    const auto length = static_cast<std::size_t>(file.tellg());
+    file.seekg(0, std::ios::beg);
+    m_impl->buffer.resize((length + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t));
+    if (length > 0 && !file.read(reinterpret_cast<char*>(m_impl->buffer.data()),
+                                 static_cast<std::streamsize>(length))) {
+        m_impl->lastError = "Failed to read " + filepath;
+        m_impl->buffer.clear();
+        return false;
+    }
+    m_impl->data = length > 0 ? reinterpret_cast<const std::uint8_t*>(m_impl->buffer.data()) : nullptr;
+    m_impl->size = length;
+#endif
+
+    m_impl->open = true;
+    return true;
+}
+
+void MappedFile::close()
+{
+    m_impl->release();
+}
+
+bool MappedFile::isOpen() const
+{
+    return m_impl->open;
+}
+
+bool MappedFile::isMapped() const
+{
+    return m_impl->mapped;
+}
+
+const std::uint8_t* MappedFile::data() const
+{
+    return m_impl->data;
+}
+
+std::size_t MappedFile::size() const
+{
+    return m_impl->size;
+}
+
+std::string MappedFile::getLastError() const
+{
+    return m_impl->lastError;
+}
+
+} // namespace nap
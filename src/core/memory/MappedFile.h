@@ -0,0 +1,78 @@
+#ifndef NAP_MAPPEDFILE_H
+#define NAP_MAPPEDFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace nap {
+
+/**
+ * @brief Read-only view of a whole file's contents.
+ *
+ * On POSIX systems the file is memory-mapped, so opening costs the same
+ * regardless of file size and pages are only read when touched. Elsewhere
+ * the file is read into an owned, 16-byte aligned buffer. Either way the
+ * data pointer stays valid until the MappedFile is closed or destroyed.
+ */
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&&) noexcept;
+    MappedFile& operator=(MappedFile&&) noexcept;
+
+    /**
+     * @brief Open and map a file, closing any previously open one.
+     * @param filepath Path of the file
+     * @return True on success; see getLastError() otherwise
+     */
+    bool open(const std::string& filepath);
+
+    /**
+     * @brief Unmap the file and release its resources.
+     */
+    void close();
+
+    /**
+     * @brief Check whether a file is open.
+     * @return True if open
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Check whether the contents are mapped rather than copied.
+     * @return True if backed by a memory mapping
+     */
+    bool isMapped() const;
+
+    /**
+     * @brief Get the file contents.
+     * @return Pointer to the first byte, or nullptr if closed or empty
+     */
+    const std::uint8_t* data() const;
+
+    /**
+     * @brief Get the file size.
+     * @return Size in bytes
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Get the reason the last open() failed.
+     * @return Error message, empty after a successful open
+     */
+    std::string getLastError() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace nap
+
+#endif // NAP_MAPPEDFILE_H
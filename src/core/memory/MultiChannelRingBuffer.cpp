@@ -0,0 +1,219 @@
+#include "MultiChannelRingBuffer.h"
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+namespace nap {
+
+class MultiChannelRingBuffer::Impl {
+public:
+    // One slot is kept free to tell "full" from "empty", so each lane holds
+    // capacityFrames + 1 samples.
+    Impl(std::uint32_t numChannels, std::size_t capacityFrames)
+        : numChannels(numChannels)
+        , capacity(capacityFrames)
+        , laneSize(capacityFrames + 1)
+        , storage(static_cast<std::size_t>(numChannels) * (capacityFrames + 1), 0.0f)
+        , readIndex(0)
+        , writeIndex(0)
+    {
+    }
+
+    FrameRegion makeRegion(std::size_t start, std::size_t count) const
+    {
+        FrameRegion region;
+        region.firstStart = start;
+        region.firstFrames = std::min(count, laneSize - start);
+        region.secondFrames = count - region.firstFrames;
+        return region;
+    }
+
+    float* lane(std::uint32_t channel)
+    {
+        return storage.data() + static_cast<std::size_t>(channel) * laneSize;
+    }
+
+    const float* lane(std::uint32_t channel) const
+    {
+        return storage.data() + static_cast<std::size_t>(channel) * laneSize;
+    }
+
+    std::size_t availableForRead() const
+    {
+        const std::size_t writeIdx = writeIndex.load(std::memory_order_acquire);
+        const std::size_t readIdx = readIndex.load(std::memory_order_acquire);
+
+        if (writeIdx >= readIdx) {
+            return writeIdx - readIdx;
+        }
+        return laneSize - readIdx + writeIdx;
+    }
+
+    std::uint32_t numChannels;
+    std::size_t capacity;
+    std::size_t laneSize;
+    std::vector<float> storage;
+    std::atomic<std::size_t> readIndex;
+    std::atomic<std::size_t> writeIndex;
+};
+
+MultiChannelRingBuffer::MultiChannelRingBuffer(std::uint32_t numChannels, std::size_t capacityFrames)
+    : m_impl(std::make_unique<Impl>(numChannels, capacityFrames))
+{
+}
+
+MultiChannelRingBuffer::~MultiChannelRingBuffer() = default;
+
+MultiChannelRingBuffer::MultiChannelRingBuffer(MultiChannelRingBuffer&&) noexcept = default;
+MultiChannelRingBuffer& MultiChannelRingBuffer::operator=(MultiChannelRingBuffer&&) noexcept = default;
+
+std::size_t MultiChannelRingBuffer::writeInterleaved(const float* data, std::size_t numFrames)
+{
+    const FrameRegion region = prepareWrite(numFrames);
+    const std::uint32_t numChannels = m_impl->numChannels;
+
+    for (std::uint32_t ch = 0; ch < numChannels; ++ch) {
+        float* lane = m_impl->lane(ch);
+        const float* src = data + ch;
+
+        float* dst = lane + region.firstStart;
+        for (std::size_t i = 0; i < region.firstFrames; ++i) {
+            dst[i] = src[i * numChannels];
+        }
+        src += region.firstFrames * numChannels;
+        for (std::size_t i = 0; i < region.secondFrames; ++i) {
+            lane[i] = src[i * numChannels];
+        }
+    }
+
+    return commitWrite(region.size());
+}
+
+std::size_t MultiChannelRingBuffer::readInterleaved(float* data, std::size_t numFrames)
+{
+    const FrameRegion region = prepareRead(numFrames);
+    const std::uint32_t numChannels = m_impl->numChannels;
+
+    for (std::uint32_t ch = 0; ch < numChannels; ++ch) {
+        const float* lane = m_impl->lane(ch);
+        float* dst = data + ch;
+
+        const float* src = lane + region.firstStart;
+        for (std::size_t i = 0; i < region.firstFrames; ++i) {
+            dst[i * numChannels] = src[i];
+        }
+        dst += region.firstFrames * numChannels;
+        for (std::size_t i = 0; i < region.secondFrames; ++i) {
+            dst[i * numChannels] = lane[i];
+        }
+    }
+
+    return commitRead(region.size());
+}
+
+std::size_t MultiChannelRingBuffer::writePlanar(const float* const* channels, std::size_t numFrames)
+{
+    const FrameRegion region = prepareWrite(numFrames);
+
+    for (std::uint32_t ch = 0; ch < m_impl->numChannels; ++ch) {
+        float* lane = m_impl->lane(ch);
+        std::copy_n(channels[ch], region.firstFrames, lane + region.firstStart);
+        std::copy_n(channels[ch] + region.firstFrames, region.secondFrames, lane);
+    }
+
+    return commitWrite(region.size());
+}
+
+std::size_t MultiChannelRingBuffer::readPlanar(float* const* channels, std::size_t numFrames)
+{
+    const FrameRegion region = prepareRead(numFrames);
+
+    for (std::uint32_t ch = 0; ch < m_impl->numChannels; ++ch) {
+        const float* lane = m_impl->lane(ch);
+        std::copy_n(lane + region.firstStart, region.firstFrames, channels[ch]);
+        std::copy_n(lane, region.secondFrames, channels[ch] + region.firstFrames);
+    }
+
+    return commitRead(region.size());
+}
+
+MultiChannelRingBuffer::FrameRegion MultiChannelRingBuffer::prepareWrite(std::size_t numFrames)
+{
+    const std::size_t toWrite = std::min(numFrames, getAvailableForWrite());
+    return m_impl->makeRegion(m_impl->writeIndex.load(std::memory_order_relaxed), toWrite);
+}
+
+std::size_t MultiChannelRingBuffer::commitWrite(std::size_t numFrames)
+{
+    const std::size_t toCommit = std::min(numFrames, getAvailableForWrite());
+
+    const std::size_t writeIdx = m_impl->writeIndex.load(std::memory_order_relaxed);
+    m_impl->writeIndex.store((writeIdx + toCommit) % m_impl->laneSize, std::memory_order_release);
+
+    return toCommit;
+}
+
+MultiChannelRingBuffer::FrameRegion MultiChannelRingBuffer::prepareRead(std::size_t numFrames)
+{
+    const std::size_t toRead = std::min(numFrames, getAvailableForRead());
+    return m_impl->makeRegion(m_impl->readIndex.load(std::memory_order_relaxed), toRead);
+}
+
+std::size_t MultiChannelRingBuffer::commitRead(std::size_t numFrames)
+{
+    const std::size_t toRelease = std::min(numFrames, getAvailableForRead());
+
+    const std::size_t readIdx = m_impl->readIndex.load(std::memory_order_relaxed);
+    m_impl->readIndex.store((readIdx + toRelease) % m_impl->laneSize, std::memory_order_release);
+
+    return toRelease;
+}
+
+float* MultiChannelRingBuffer::getChannelData(std::uint32_t channel)
+{
+    if (channel >= m_impl->numChannels) {
+        return nullptr;
+    }
+    return m_impl->lane(channel);
+}
+
+const float* MultiChannelRingBuffer::getChannelData(std::uint32_t channel) const
+{
+    if (channel >= m_impl->numChannels) {
+        return nullptr;
+    }
+    return m_impl->lane(channel);
+}
+
+std::size_t MultiChannelRingBuffer::getAvailableForRead() const
+{
+    return m_impl->availableForRead();
+}
+
+std::size_t MultiChannelRingBuffer::getAvailableForWrite() const
+{
+    return m_impl->capacity - m_impl->availableForRead();
+}
+
+std::size_t MultiChannelRingBuffer::getCapacity() const
+{
+    return m_impl->capacity;
+}
+
+std::uint32_t MultiChannelRingBuffer::getNumChannels() const
+{
+    return m_impl->numChannels;
+}
+
+bool MultiChannelRingBuffer::isEmpty() const
+{
+    return getAvailableForRead() == 0;
+}
+
+void MultiChannelRingBuffer::clear()
+{
+    m_impl->readIndex.store(0, std::memory_order_release);
+    m_impl->writeIndex.store(0, std::memory_order_release);
+}
+
+} // namespace nap
@@ -0,0 +1,164 @@
+#ifndef NAP_MULTICHANNELRINGBUFFER_H
+#define NAP_MULTICHANNELRINGBUFFER_H
+
+#include <cstdint>
+#include <memory>
+
+namespace nap {
+
+/**
+ * @brief Lock-free multi-channel ring buffer that moves whole frames.
+ *
+ * Samples are stored planar (one contiguous lane per channel) and all
+ * channels share a single read/write index pair, so a frame is always
+ * published or consumed atomically across every channel. Intended for
+ * single-producer, single-consumer streaming between a driver or decoder
+ * thread and the audio graph.
+ */
+class MultiChannelRingBuffer {
+public:
+    /**
+     * @brief A range of frames inside the ring, split at the wrap point.
+     *
+     * The first part starts at firstStart; the second part, if any,
+     * starts at frame 0 of every channel lane.
+     */
+    struct FrameRegion {
+        std::size_t firstStart = 0;
+        std::size_t firstFrames = 0;
+        std::size_t secondFrames = 0;
+
+        std::size_t size() const { return firstFrames + secondFrames; }
+        bool empty() const { return size() == 0; }
+    };
+
+    /**
+     * @brief Construct a ring buffer.
+     * @param numChannels Number of channels per frame
+     * @param capacityFrames Maximum number of frames the buffer can hold
+     */
+    MultiChannelRingBuffer(std::uint32_t numChannels, std::size_t capacityFrames);
+    ~MultiChannelRingBuffer();
+
+    MultiChannelRingBuffer(const MultiChannelRingBuffer&) = delete;
+    MultiChannelRingBuffer& operator=(const MultiChannelRingBuffer&) = delete;
+    MultiChannelRingBuffer(MultiChannelRingBuffer&&) noexcept;
+    MultiChannelRingBuffer& operator=(MultiChannelRingBuffer&&) noexcept;
+
+    /**
+     * @brief Write interleaved frames (driver callback / decoder layout).
+     * @param data Interleaved samples, numFrames * getNumChannels() long
+     * @param numFrames Number of frames to write
+     * @return Number of frames actually written
+     */
+    std::size_t writeInterleaved(const float* data, std::size_t numFrames);
+
+    /**
+     * @brief Read interleaved frames.
+     * @param data Destination, numFrames * getNumChannels() long
+     * @param numFrames Number of frames to read
+     * @return Number of frames actually read
+     */
+    std::size_t readInterleaved(float* data, std::size_t numFrames);
+
+    /**
+     * @brief Write planar frames.
+     * @param channels One pointer per channel, each numFrames long
+     * @param numFrames Number of frames to write
+     * @return Number of frames actually written
+     */
+    std::size_t writePlanar(const float* const* channels, std::size_t numFrames);
+
+    /**
+     * @brief Read planar frames.
+     * @param channels One destination pointer per channel, each numFrames long
+     * @param numFrames Number of frames to read
+     * @return Number of frames actually read
+     */
+    std::size_t readPlanar(float* const* channels, std::size_t numFrames);
+
+    /**
+     * @brief Reserve frames for writing in place (producer only).
+     *
+     * Write each channel through getChannelData(); nothing is visible to
+     * the consumer until commitWrite() is called.
+     * @param numFrames Number of frames the producer wants to write
+     * @return Writable region, possibly smaller than requested
+     */
+    FrameRegion prepareWrite(std::size_t numFrames);
+
+    /**
+     * @brief Publish frames written into a region from prepareWrite().
+     * @param numFrames Number of frames actually written
+     * @return Number of frames committed
+     */
+    std::size_t commitWrite(std::size_t numFrames);
+
+    /**
+     * @brief Access readable frames in place (consumer only).
+     * @param numFrames Number of frames the consumer wants to read
+     * @return Readable region, possibly smaller than requested
+     */
+    FrameRegion prepareRead(std::size_t numFrames);
+
+    /**
+     * @brief Release frames obtained from prepareRead().
+     * @param numFrames Number of frames consumed
+     * @return Number of frames released
+     */
+    std::size_t commitRead(std::size_t numFrames);
+
+    /**
+     * @brief Get the storage lane of one channel.
+     *
+     * Index the lane with the offsets of a FrameRegion returned by
+     * prepareWrite() or prepareRead().
+     * @param channel Channel index
+     * @return Pointer to the channel lane, or nullptr if out of range
+     */
+    float* getChannelData(std::uint32_t channel);
+    const float* getChannelData(std::uint32_t channel) const;
+
+    /**
+     * @brief Get the number of frames available for reading.
+     * @return Number of available frames
+     */
+    std::size_t getAvailableForRead() const;
+
+    /**
+     * @brief Get the space available for writing.
+     * @return Number of frames that can be written
+     */
+    std::size_t getAvailableForWrite() const;
+
+    /**
+     * @brief Get the total capacity of the buffer.
+     * @return Buffer capacity in frames
+     */
+    std::size_t getCapacity() const;
+
+    /**
+     * @brief Get the number of channels per frame.
+     * @return Number of channels
+     */
+    std::uint32_t getNumChannels() const;
+
+    /**
+     * @brief Check if the buffer is empty.
+     * @return True if empty
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief Clear all data from the buffer.
+     */
+    void clear();
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace nap
+
+#endif // NAP_MULTICHANNELRINGBUFFER_H
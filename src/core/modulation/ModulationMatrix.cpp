@@ -0,0 +1,336 @@
+#include "core/modulation/ModulationMatrix.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+namespace nap {
+
+namespace {
+
+// Parabolic sine approximation of sin(2*pi*x) for x in [0, 1); max error ~0.001
+inline float fastSine(float x)
+{
+    const float t = 2.0f * x - 1.0f;                // sin(2*pi*x) == -sin(pi*t)
+    const float y = 4.0f * t * (1.0f - std::fabs(t));
+    return -(0.225f * (y * std::fabs(y) - y) + y);
+}
+
+} // namespace
+
+class ModulationMatrix::Impl {
+public:
+    struct Source {
+        std::string name;
+        bool isLfo = false;
+        LfoShape shape = LfoShape::Sine;
+        std::atomic<float> rateHz{0.0f};
+        float phase = 0.0f;
+        std::vector<float> buffer;
+    };
+
+    struct Target {
+        std::string name;
+        INumericParameter* parameter = nullptr;
+        std::atomic<float> base{0.0f};
+        float minValue = 0.0f;
+        float maxValue = 1.0f;
+        std::vector<float> buffer;
+        std::vector<RouteId> routes;
+    };
+
+    struct Route {
+        SourceId source = kInvalidId;
+        TargetId target = kInvalidId;
+        std::atomic<float> depth{0.0f};
+        Curve curve = Curve::Linear;
+    };
+
+    double sampleRate = 44100.0;
+    std::uint32_t maxBlockSize = 512;
+    std::uint32_t lastBlockSize = 0;
+
+    std::vector<std::unique_ptr<Source>> sources;
+    std::vector<std::unique_ptr<Target>> targets;
+    std::vector<std::unique_ptr<Route>> routes;  // Removed routes leave a null entry
+
+    Source* source(SourceId id) const {
+        return id < sources.size() ? sources[id].get() : nullptr;
+    }
+
+    Target* target(TargetId id) const {
+        return id < targets.size() ? targets[id].get() : nullptr;
+    }
+
+    Route* route(RouteId id) const {
+        return id < routes.size() ? routes[id].get() : nullptr;
+    }
+
+    void renderLfo(Source& lfo, std::uint32_t numFrames) {
+        float* out = lfo.buffer.data();
+        const float increment =
+            lfo.rateHz.load(std::memory_order_relaxed) / static_cast<float>(sampleRate);
+        const float phase = lfo.phase;
+
+        // Phase is computed from the block start so each sample is independent
+        switch (lfo.shape) {
+            case LfoShape::Sine:
+                for (std::uint32_t i = 0; i < numFrames; ++i) {
+                    const float p = phase + increment * static_cast<float>(i);
+                    out[i] = fastSine(p - std::floor(p));
+                }
+                break;
+            case LfoShape::Triangle:
+                for (std::uint32_t i = 0; i < numFrames; ++i) {
+                    const float p = phase + increment * static_cast<float>(i);
+                    out[i] = 1.0f - 4.0f * std::fabs((p - std::floor(p)) - 0.5f);
+                }
+                break;
+            case LfoShape::Saw:
+                for (std::uint32_t i = 0; i < numFrames; ++i) {
+                    const float p = phase + increment * static_cast<float>(i);
+                    out[i] = 2.0f * (p - std::floor(p)) - 1.0f;
+                }
+                break;
+            case LfoShape::Square:
+                for (std::uint32_t i = 0; i < numFrames; ++i) {
+                    const float p = phase + increment * static_cast<float>(i);
+                    out[i] = (p - std::floor(p)) < 0.5f ? 1.0f : -1.0f;
+                }
+                break;
+        }
+
+        const float next = phase + increment * static_cast<float>(numFrames);
+        lfo.phase = next - std::floor(next);
+    }
+
+    static void accumulate(float* out, const float* in, float scale, Curve curve,
+                           std::uint32_t numFrames) {
+        switch (curve) {
+            case Curve::Linear:
+                for (std::uint32_t i = 0; i < numFrames; ++i) {
+                    out[i] += scale * in[i];
+                }
+                break;
+            case Curve::Unipolar:
+                for (std::uint32_t i = 0; i < numFrames; ++i) {
+                    out[i] += scale * (0.5f * in[i] + 0.5f);
+                }
+                break;
+            case Curve::Squared:
+                for (std::uint32_t i = 0; i < numFrames; ++i) {
+                    out[i] += scale * (in[i] * std::fabs(in[i]));
+                }
+                break;
+            case Curve::Cubic:
+                for (std::uint32_t i = 0; i < numFrames; ++i) {
+                    out[i] += scale * (in[i] * in[i] * in[i]);
+                }
+                break;
+        }
+    }
+
+    void evaluate(Target& t, std::uint32_t numFrames) {
+        float* out = t.buffer.data();
+        const float base = t.parameter ? t.parameter->getValue()
+                                       : t.base.load(std::memory_order_relaxed);
+        std::fill(out, out + numFrames, base);
+
+        const float range = t.maxValue - t.minValue;
+        for (RouteId id : t.routes) {
+            const Route& r = *routes[id];
+            const float depth = r.depth.load(std::memory_order_relaxed);
+            if (depth != 0.0f) {
+                accumulate(out, sources[r.source]->buffer.data(), depth * range, r.curve,
+                           numFrames);
+            }
+        }
+
+        const float lo = t.minValue;
+        const float hi = t.maxValue;
+        for (std::uint32_t i = 0; i < numFrames; ++i) {
+            out[i] = std::min(std::max(out[i], lo), hi);
+        }
+    }
+};
+
+ModulationMatrix::ModulationMatrix()
+    : pImpl(std::make_unique<Impl>()) {}
+
+ModulationMatrix::~ModulationMatrix() = default;
+
+ModulationMatrix::ModulationMatrix(ModulationMatrix&&) noexcept = default;
+ModulationMatrix& ModulationMatrix::operator=(ModulationMatrix&&) noexcept = default;
+
+void ModulationMatrix::prepare(double sampleRate, std::uint32_t maxBlockSize) {
+    if (sampleRate > 0.0) {
+        pImpl->sampleRate = sampleRate;
+    }
+    pImpl->maxBlockSize = std::max<std::uint32_t>(maxBlockSize, 1);
+    pImpl->lastBlockSize = 0;
+
+    for (auto& source : pImpl->sources) {
+        source->buffer.assign(pImpl->maxBlockSize, 0.0f);
+    }
+    for (auto& target : pImpl->targets) {
+        target->buffer.assign(pImpl->maxBlockSize, 0.0f);
+    }
+}
+
+ModulationMatrix::SourceId ModulationMatrix::addSource(const std::string& name) {
+    auto source = std::make_unique<Impl::Source>();
+    source->name = name;
+    source->buffer.assign(pImpl->maxBlockSize, 0.0f);
+    pImpl->sources.push_back(std::move(source));
+    return static_cast<SourceId>(pImpl->sources.size() - 1);
+}
+
+ModulationMatrix::SourceId ModulationMatrix::addLfo(const std::string& name, float rateHz,
+                                                    LfoShape shape) {
+    const SourceId id = addSource(name);
+    Impl::Source& lfo = *pImpl->sources[id];
+    lfo.isLfo = true;
+    lfo.shape = shape;
+    lfo.rateHz.store(rateHz, std::memory_order_relaxed);
+    return id;
+}
+
+void ModulationMatrix::setLfoRate(SourceId source, float rateHz) {
+    if (auto* s = pImpl->source(source)) {
+        s->rateHz.store(rateHz, std::memory_order_relaxed);
+    }
+}
+
+void ModulationMatrix::setLfoPhase(SourceId source, float phase) {
+    if (auto* s = pImpl->source(source)) {
+        s->phase = phase - std::floor(phase);
+    }
+}
+
+float* ModulationMatrix::getSourceBuffer(SourceId source) {
+    auto* s = pImpl->source(source);
+    return s ? s->buffer.data() : nullptr;
+}
+
+ModulationMatrix::SourceId ModulationMatrix::findSource(const std::string& name) const {
+    for (size_t i = 0; i < pImpl->sources.size(); ++i) {
+        if (pImpl->sources[i]->name == name) {
+            return static_cast<SourceId>(i);
+        }
+    }
+    return kInvalidId;
+}
+
+std::size_t ModulationMatrix::getSourceCount() const {
+    return pImpl->sources.size();
+}
+
+ModulationMatrix::TargetId ModulationMatrix::addTarget(INumericParameter* parameter) {
+    if (!parameter) return kInvalidId;
+
+    const TargetId id = addTarget(parameter->getName(), parameter->getMinValue(),
+                                  parameter->getMaxValue(), parameter->getValue());
+    pImpl->targets[id]->parameter = parameter;
+    return id;
+}
+
+ModulationMatrix::TargetId ModulationMatrix::addTarget(const std::string& name, float minValue,
+                                                       float maxValue, float baseValue) {
+    auto target = std::make_unique<Impl::Target>();
+    target->name = name;
+    target->minValue = std::min(minValue, maxValue);
+    target->maxValue = std::max(minValue, maxValue);
+    target->base.store(baseValue, std::memory_order_relaxed);
+    target->buffer.assign(pImpl->maxBlockSize, 0.0f);
+    pImpl->targets.push_back(std::move(target));
+    return static_cast<TargetId>(pImpl->targets.size() - 1);
+}
+
+void ModulationMatrix::setTargetBase(TargetId target, float baseValue) {
+    if (auto* t = pImpl->target(target)) {
+        t->base.store(baseValue, std::memory_order_relaxed);
+    }
+}
+
+ModulationMatrix::TargetId ModulationMatrix::findTarget(const std::string& name) const {
+    for (size_t i = 0; i < pImpl->targets.size(); ++i) {
+        if (pImpl->targets[i]->name == name) {
+            return static_cast<TargetId>(i);
+        }
+    }
+    return kInvalidId;
+}
+
+std::size_t ModulationMatrix::getTargetCount() const {
+    return pImpl->targets.size();
+}
+
+ModulationMatrix::RouteId ModulationMatrix::addRoute(SourceId source, TargetId target,
+                                                     float depth, Curve curve) {
+    Impl::Target* t = pImpl->target(target);
+    if (!pImpl->source(source) || !t) return kInvalidId;
+
+    auto route = std::make_unique<Impl::Route>();
+    route->source = source;
+    route->target = target;
+    route->depth.store(depth, std::memory_order_relaxed);
+    route->curve = curve;
+    pImpl->routes.push_back(std::move(route));
+
+    const auto id = static_cast<RouteId>(pImpl->routes.size() - 1);
+    t->routes.push_back(id);
+    return id;
+}
+
+void ModulationMatrix::removeRoute(RouteId route) {
+    Impl::Route* r = pImpl->route(route);
+    if (!r) return;
+
+    auto& targetRoutes = pImpl->targets[r->target]->routes;
+    targetRoutes.erase(std::remove(targetRoutes.begin(), targetRoutes.end(), route),
+                       targetRoutes.end());
+    pImpl->routes[route].reset();
+}
+
+void ModulationMatrix::setRouteDepth(RouteId route, float depth) {
+    if (auto* r = pImpl->route(route)) {
+        r->depth.store(depth, std::memory_order_relaxed);
+    }
+}
+
+float ModulationMatrix::getRouteDepth(RouteId route) const {
+    auto* r = pImpl->route(route);
+    return r ? r->depth.load(std::memory_order_relaxed) : 0.0f;
+}
+
+std::size_t ModulationMatrix::getRouteCount() const {
+    return static_cast<std::size_t>(
+        std::count_if(pImpl->routes.begin(), pImpl->routes.end(),
+                      [](const std::unique_ptr<Impl::Route>& r) { return r != nullptr; }));
+}
+
+void ModulationMatrix::process(std::uint32_t numFrames) {
+    numFrames = std::min(numFrames, pImpl->maxBlockSize);
+
+    for (auto& source : pImpl->sources) {
+        if (source->isLfo) {
+            pImpl->renderLfo(*source, numFrames);
+        }
+    }
+    for (auto& target : pImpl->targets) {
+        pImpl->evaluate(*target, numFrames);
+    }
+
+    pImpl->lastBlockSize = numFrames;
+}
+
+ModulationMatrix::Span ModulationMatrix::getTargetValues(TargetId target) const {
+    Span span;
+    if (auto* t = pImpl->target(target)) {
+        span.data = t->buffer.data();
+        span.size = pImpl->lastBlockSize;
+    }
+    return span;
+}
+
+} // namespace nap
@@ -0,0 +1,122 @@
+#ifndef NAP_MODULATION_MATRIX_H
+#define NAP_MODULATION_MATRIX_H
+
+#include "api/IParameter.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace nap {
+
+/**
+ * @brief Shared per-block modulation: sources, routes and modulated targets.
+ *
+ * Sources produce one value per sample into a block buffer owned by the
+ * matrix: built-in LFOs are rendered by process(), external sources
+ * (envelopes, followers, MIDI) write into getSourceBuffer() before it.
+ * Routes connect a source to a target with a depth and a response curve.
+ * Each block, every target's buffer starts at its base value (its
+ * parameter's current value, or a value set with setTargetBase()), every
+ * route adds depth * curve(source) scaled to the target's range, and the
+ * result is clamped to that range. Nodes read the result as a span, so an
+ * LFO shared by several nodes is computed once per block instead of once
+ * per node.
+ *
+ * All per-sample loops are branch-free over contiguous buffers so they
+ * vectorize when NAP_ENABLE_SIMD is on. Adding or removing sources,
+ * targets and routes, and prepare(), must not overlap process(); depths,
+ * LFO rates and target bases may be changed from any thread.
+ */
+class ModulationMatrix {
+public:
+    using SourceId = std::uint32_t;
+    using TargetId = std::uint32_t;
+    using RouteId = std::uint32_t;
+    static constexpr std::uint32_t kInvalidId = 0xFFFFFFFFu;
+
+    enum class LfoShape {
+        Sine,
+        Triangle,
+        Saw,
+        Square
+    };
+
+    // Response applied to the source value before depth
+    enum class Curve {
+        Linear,    // x
+        Unipolar,  // Maps -1..1 to 0..1
+        Squared,   // x * |x|, sign preserved
+        Cubic      // x^3
+    };
+
+    /**
+     * @brief Read-only view of a target's modulated values for the last block.
+     */
+    struct Span {
+        const float* data = nullptr;
+        std::size_t size = 0;
+
+        float operator[](std::size_t index) const { return data[index]; }
+        bool empty() const { return size == 0; }
+    };
+
+    ModulationMatrix();
+    ~ModulationMatrix();
+
+    ModulationMatrix(const ModulationMatrix&) = delete;
+    ModulationMatrix& operator=(const ModulationMatrix&) = delete;
+    ModulationMatrix(ModulationMatrix&&) noexcept;
+    ModulationMatrix& operator=(ModulationMatrix&&) noexcept;
+
+    /**
+     * @brief Allocate block buffers (not real-time safe).
+     * @param sampleRate Sample rate for LFO rates
+     * @param maxBlockSize Largest numFrames passed to process()
+     */
+    void prepare(double sampleRate, std::uint32_t maxBlockSize);
+
+    // Sources
+    SourceId addSource(const std::string& name);
+    SourceId addLfo(const std::string& name, float rateHz, LfoShape shape = LfoShape::Sine);
+    void setLfoRate(SourceId source, float rateHz);
+    void setLfoPhase(SourceId source, float phase);  // 0..1
+    float* getSourceBuffer(SourceId source);
+    SourceId findSource(const std::string& name) const;
+    std::size_t getSourceCount() const;
+
+    // Targets; a parameter target takes its base value and range from the parameter
+    TargetId addTarget(INumericParameter* parameter);
+    TargetId addTarget(const std::string& name, float minValue, float maxValue, float baseValue);
+    void setTargetBase(TargetId target, float baseValue);
+    TargetId findTarget(const std::string& name) const;
+    std::size_t getTargetCount() const;
+
+    // Routes
+    RouteId addRoute(SourceId source, TargetId target, float depth, Curve curve = Curve::Linear);
+    void removeRoute(RouteId route);
+    void setRouteDepth(RouteId route, float depth);  // Fraction of the target's range
+    float getRouteDepth(RouteId route) const;
+    std::size_t getRouteCount() const;
+
+    /**
+     * @brief Render sources and evaluate all routes for one block (audio thread).
+     * @param numFrames Block length, at most the prepared maxBlockSize
+     */
+    void process(std::uint32_t numFrames);
+
+    /**
+     * @brief Modulated values of a target for the last processed block.
+     * @param target Target id
+     * @return Span of numFrames values, empty for an unknown target
+     */
+    Span getTargetValues(TargetId target) const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace nap
+
+#endif // NAP_MODULATION_MATRIX_H
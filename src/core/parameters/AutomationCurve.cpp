@@ -0,0 +1,114 @@
+#include "core/parameters/AutomationCurve.h"
+#include <algorithm>
+#include <cmath>
+
+namespace nap {
+
+class AutomationCurve::Impl {
+public:
+    std::vector<Breakpoint> breakpoints;
+};
+
+AutomationCurve::AutomationCurve()
+    : pImpl(std::make_unique<Impl>()) {}
+
+AutomationCurve::~AutomationCurve() = default;
+
+AutomationCurve::AutomationCurve(const AutomationCurve& other)
+    : pImpl(std::make_unique<Impl>(*other.pImpl)) {}
+
+AutomationCurve& AutomationCurve::operator=(const AutomationCurve& other) {
+    if (this != &other) {
+        pImpl = std::make_unique<Impl>(*other.pImpl);
+    }
+    return *this;
+}
+
+AutomationCurve::AutomationCurve(AutomationCurve&&) noexcept = default;
+AutomationCurve& AutomationCurve::operator=(AutomationCurve&&) noexcept = default;
+
+size_t AutomationCurve::addBreakpoint(double time, float value, Shape shape) {
+    auto& points = pImpl->breakpoints;
+    auto it = std::upper_bound(points.begin(), points.end(), time,
+                               [](double t, const Breakpoint& point) {
+                                   return t < point.time;
+                               });
+
+    const auto index = static_cast<size_t>(it - points.begin());
+    Breakpoint point;
+    point.time = time;
+    point.value = value;
+    point.shape = shape;
+    points.insert(it, point);
+    return index;
+}
+
+void AutomationCurve::removeBreakpoint(size_t index) {
+    if (index < pImpl->breakpoints.size()) {
+        pImpl->breakpoints.erase(pImpl->breakpoints.begin() + index);
+    }
+}
+
+void AutomationCurve::setBreakpointValue(size_t index, float value) {
+    if (index < pImpl->breakpoints.size()) {
+        pImpl->breakpoints[index].value = value;
+    }
+}
+
+void AutomationCurve::clear() {
+    pImpl->breakpoints.clear();
+}
+
+size_t AutomationCurve::getBreakpointCount() const {
+    return pImpl->breakpoints.size();
+}
+
+bool AutomationCurve::isEmpty() const {
+    return pImpl->breakpoints.empty();
+}
+
+const AutomationCurve::Breakpoint& AutomationCurve::getBreakpoint(size_t index) const {
+    return pImpl->breakpoints.at(index);
+}
+
+const AutomationCurve::Breakpoint* AutomationCurve::getBreakpoints() const {
+    return pImpl->breakpoints.data();
+}
+
+double AutomationCurve::getDuration() const {
+    return pImpl->breakpoints.empty() ? 0.0 : pImpl->breakpoints.back().time;
+}
+
+size_t AutomationCurve::findSegment(double time) const {
+    const auto& points = pImpl->breakpoints;
+    auto it = std::upper_bound(points.begin(), points.end(), time,
+                               [](double t, const Breakpoint& point) {
+                                   return t < point.time;
+                               });
+    if (it == points.begin()) {
+        return points.size();
+    }
+    return static_cast<size_t>(it - points.begin()) - 1;
+}
+
+float AutomationCurve::getValueAt(double time) const {
+    const auto& points = pImpl->breakpoints;
+    if (points.empty()) return 0.0f;
+
+    const size_t segment = findSegment(time);
+    if (segment >= points.size()) return points.front().value;
+    if (segment + 1 == points.size()) return points.back().value;
+
+    const Breakpoint& from = points[segment];
+    const Breakpoint& to = points[segment + 1];
+    const double length = to.time - from.time;
+    if (from.shape == Shape::Hold || length <= 0.0) return from.value;
+
+    const float fraction = static_cast<float>((time - from.time) / length);
+    if (from.shape == Shape::Exponential && from.value * to.value > 0.0f) {
+        return from.value * std::pow(to.value / from.value, fraction);
+    }
+    return from.value + (to.value - from.value) * fraction;
+}
+
+} // namespace nap
@@ -0,0 +1,72 @@
+#ifndef NAP_AUTOMATION_CURVE_H
+#define NAP_AUTOMATION_CURVE_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace nap {
+
+/**
+ * @brief Breakpoint envelope describing a parameter's value over time.
+ *
+ * Breakpoints are kept sorted by time. Each breakpoint's shape describes
+ * the segment that leaves it: a straight line, an exponential (constant
+ * ratio) curve, or a step that holds the value until the next breakpoint.
+ * Before the first breakpoint the curve holds the first value; after the
+ * last it holds the last value.
+ *
+ * Editing is not real-time safe; evaluation on the audio thread goes
+ * through AutomationLane, which renders whole blocks at a time.
+ */
+class AutomationCurve {
+public:
+    enum class Shape {
+        Linear,       // Straight line to the next breakpoint
+        Exponential,  // Constant ratio per second; linear if the values differ in sign or touch zero
+        Hold          // Keep this value until the next breakpoint
+    };
+
+    struct Breakpoint {
+        double time = 0.0;  // Seconds
+        float value = 0.0f;
+        Shape shape = Shape::Linear;
+    };
+
+    AutomationCurve();
+    ~AutomationCurve();
+
+    AutomationCurve(const AutomationCurve& other);
+    AutomationCurve& operator=(const AutomationCurve& other);
+    AutomationCurve(AutomationCurve&&) noexcept;
+    AutomationCurve& operator=(AutomationCurve&&) noexcept;
+
+    // Editing; a breakpoint at the same time as an existing one goes after it,
+    // which produces a jump
+    size_t addBreakpoint(double time, float value, Shape shape = Shape::Linear);
+    void removeBreakpoint(size_t index);
+    void setBreakpointValue(size_t index, float value);
+    void clear();
+
+    // Access
+    size_t getBreakpointCount() const;
+    bool isEmpty() const;
+    const Breakpoint& getBreakpoint(size_t index) const;
+    const Breakpoint* getBreakpoints() const;
+    double getDuration() const;  // Time of the last breakpoint
+
+    // Index of the segment containing time: the last breakpoint at or before
+    // it, or getBreakpointCount() if time is before the first breakpoint
+    size_t findSegment(double time) const;
+
+    // Point evaluation (binary search); use AutomationLane for blocks
+    float getValueAt(double time) const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace nap
+
+#endif // NAP_AUTOMATION_CURVE_H
@@ -0,0 +1,183 @@
+#include "core/parameters/AutomationLane.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+namespace nap {
+
+class AutomationLane::Impl {
+public:
+    using Breakpoint = AutomationCurve::Breakpoint;
+    using Shape = AutomationCurve::Shape;
+
+    INumericParameter* target = nullptr;
+    std::shared_ptr<const AutomationCurve> curve;
+    bool enabled = true;
+    double sampleRate = 44100.0;
+
+    // Segment of the previous lookup; == breakpoint count means "before the first"
+    size_t cursor = 0;
+    std::atomic<float> lastValue{0.0f};
+    std::atomic<std::uint64_t> searches{0};
+
+    size_t locate(const Breakpoint* points, size_t count, double time) {
+        if (cursor < count && points[cursor].time <= time) {
+            if (cursor + 1 == count || time < points[cursor + 1].time) {
+                return cursor;
+            }
+            // Sequential playback usually just crossed into the next segment
+            if (cursor + 2 == count || time < points[cursor + 2].time) {
+                return ++cursor;
+            }
+        } else if (cursor == count && time < points[0].time) {
+            return cursor;
+        }
+
+        searches.fetch_add(1, std::memory_order_relaxed);
+        cursor = curve->findSegment(time);
+        return cursor;
+    }
+
+    // Samples from position up to (not including) the first sample at or after time
+    size_t samplesUntil(double time, std::uint64_t position, size_t remaining) const {
+        const auto end = static_cast<std::uint64_t>(std::ceil(time * sampleRate));
+        const std::uint64_t run = end > position ? end - position : 1;
+        return static_cast<size_t>(std::min<std::uint64_t>(run, remaining));
+    }
+
+    void renderSegment(const Breakpoint& from, const Breakpoint& to,
+                       std::uint64_t position, float* dst, size_t numSamples) const {
+        const double length = to.time - from.time;
+        const double offset = static_cast<double>(position) / sampleRate - from.time;
+        const double samplesInSegment = length * sampleRate;
+
+        if (from.shape == Shape::Hold) {
+            std::fill(dst, dst + numSamples, from.value);
+        } else if (from.shape == Shape::Exponential && from.value * to.value > 0.0f) {
+            const double totalRatio = static_cast<double>(to.value) / from.value;
+            const auto ratio = static_cast<float>(std::pow(totalRatio, 1.0 / samplesInSegment));
+            auto current = static_cast<float>(from.value * std::pow(totalRatio, offset / length));
+            for (size_t i = 0; i < numSamples; ++i) {
+                dst[i] = current;
+                current *= ratio;
+            }
+        } else {
+            const double delta = static_cast<double>(to.value) - from.value;
+            const auto slope = static_cast<float>(delta / samplesInSegment);
+            const auto base = static_cast<float>(from.value + delta * (offset / length));
+            for (size_t i = 0; i < numSamples; ++i) {
+                dst[i] = base + slope * static_cast<float>(i);
+            }
+        }
+    }
+
+    void renderCurve(std::uint64_t startSample, float* dst, size_t numSamples) {
+        const Breakpoint* points = curve->getBreakpoints();
+        const size_t count = curve->getBreakpointCount();
+
+        size_t i = 0;
+        while (i < numSamples) {
+            const std::uint64_t position = startSample + i;
+            const double time = static_cast<double>(position) / sampleRate;
+            const size_t segment = locate(points, count, time);
+            size_t run;
+
+            if (segment == count) {
+                run = samplesUntil(points[0].time, position, numSamples - i);
+                std::fill(dst + i, dst + i + run, points[0].value);
+            } else if (segment + 1 == count) {
+                run = numSamples - i;
+                std::fill(dst + i, dst + numSamples, points[segment].value);
+            } else {
+                run = samplesUntil(points[segment + 1].time, position, numSamples - i);
+                renderSegment(points[segment], points[segment + 1], position, dst + i, run);
+            }
+            i += run;
+        }
+    }
+};
+
+AutomationLane::AutomationLane(INumericParameter* target)
+    : pImpl(std::make_unique<Impl>()) {
+    setTarget(target);
+}
+
+AutomationLane::~AutomationLane() = default;
+
+AutomationLane::AutomationLane(AutomationLane&&) noexcept = default;
+AutomationLane& AutomationLane::operator=(AutomationLane&&) noexcept = default;
+
+void AutomationLane::setTarget(INumericParameter* target) {
+    pImpl->target = target;
+    if (target) {
+        pImpl->lastValue.store(target->getValue(), std::memory_order_relaxed);
+    }
+}
+
+INumericParameter* AutomationLane::getTarget() const {
+    return pImpl->target;
+}
+
+void AutomationLane::setCurve(std::shared_ptr<const AutomationCurve> curve) {
+    pImpl->curve = std::move(curve);
+    resetCursor();
+}
+
+std::shared_ptr<const AutomationCurve> AutomationLane::getCurve() const {
+    return pImpl->curve;
+}
+
+void AutomationLane::setEnabled(bool enabled) {
+    pImpl->enabled = enabled;
+}
+
+bool AutomationLane::isEnabled() const {
+    return pImpl->enabled;
+}
+
+void AutomationLane::prepare(double sampleRate) {
+    if (sampleRate > 0.0) {
+        pImpl->sampleRate = sampleRate;
+    }
+    resetCursor();
+}
+
+double AutomationLane::getSampleRate() const {
+    return pImpl->sampleRate;
+}
+
+void AutomationLane::renderBlock(std::uint64_t startSample, float* dst, std::size_t numSamples) {
+    if (!dst || numSamples == 0) return;
+
+    INumericParameter* target = pImpl->target;
+
+    if (!pImpl->enabled || !pImpl->curve || pImpl->curve->isEmpty()) {
+        std::fill(dst, dst + numSamples, target ? target->getValue() : 0.0f);
+    } else {
+        pImpl->renderCurve(startSample, dst, numSamples);
+
+        if (target) {
+            const float lo = target->getMinValue();
+            const float hi = target->getMaxValue();
+            for (std::size_t i = 0; i < numSamples; ++i) {
+                dst[i] = std::min(std::max(dst[i], lo), hi);
+            }
+        }
+    }
+
+    pImpl->lastValue.store(dst[numSamples - 1], std::memory_order_relaxed);
+}
+
+void AutomationLane::resetCursor() {
+    pImpl->cursor = 0;
+}
+
+float AutomationLane::getLastValue() const {
+    return pImpl->lastValue.load(std::memory_order_relaxed);
+}
+
+std::uint64_t AutomationLane::getSegmentSearchCount() const {
+    return pImpl->searches.load(std::memory_order_relaxed);
+}
+
+} // namespace nap
@@ -0,0 +1,77 @@
+#ifndef NAP_AUTOMATION_LANE_H
+#define NAP_AUTOMATION_LANE_H
+
+#include "api/IParameter.h"
+#include "core/parameters/AutomationCurve.h"
+#include <cstdint>
+#include <memory>
+
+namespace nap {
+
+/**
+ * @brief Plays an AutomationCurve into per-block value buffers for one parameter.
+ *
+ * The audio thread calls renderBlock() with the block's position on the
+ * timeline and receives one value per sample, clamped to the target
+ * parameter's range. Nodes consume that buffer directly instead of having
+ * another thread call setValue() on every automation step.
+ *
+ * The lane remembers the segment it last rendered, so sequential playback
+ * only compares against the neighbouring breakpoints; a seek falls back to
+ * a binary search. Within a segment values are produced with a constant
+ * per-sample step (linear) or ratio (exponential).
+ *
+ * setCurve(), setTarget() and prepare() must not run concurrently with
+ * renderBlock(), and the curve must not be edited while it is attached
+ * to a playing lane.
+ */
+class AutomationLane {
+public:
+    explicit AutomationLane(INumericParameter* target = nullptr);
+    ~AutomationLane();
+
+    AutomationLane(const AutomationLane&) = delete;
+    AutomationLane& operator=(const AutomationLane&) = delete;
+    AutomationLane(AutomationLane&&) noexcept;
+    AutomationLane& operator=(AutomationLane&&) noexcept;
+
+    // Configuration
+    void setTarget(INumericParameter* target);
+    INumericParameter* getTarget() const;
+    void setCurve(std::shared_ptr<const AutomationCurve> curve);
+    std::shared_ptr<const AutomationCurve> getCurve() const;
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+    void prepare(double sampleRate);
+    double getSampleRate() const;
+
+    /**
+     * @brief Render automation values for one block (audio thread).
+     *
+     * Without an enabled, non-empty curve the block is filled with the
+     * target's current value.
+     * @param startSample Timeline position of the block's first sample
+     * @param dst Receives numSamples values
+     * @param numSamples Block length
+     */
+    void renderBlock(std::uint64_t startSample, float* dst, std::size_t numSamples);
+
+    /**
+     * @brief Forget the cached segment, e.g. after the curve was edited.
+     */
+    void resetCursor();
+
+    // Last rendered value; safe to read from any thread
+    float getLastValue() const;
+
+    // Number of binary searches performed; stays flat during sequential playback
+    std::uint64_t getSegmentSearchCount() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace nap
+
+#endif // NAP_AUTOMATION_LANE_H
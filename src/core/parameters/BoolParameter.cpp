@@ -47,6 +47,10 @@ void BoolParameter::setValue(bool value) {
     }
 }
 
+void BoolParameter::setValueSilently(bool value) {
+    pImpl->value = value;
+}
+
 void BoolParameter::toggle() {
     setValue(!pImpl->value);
 }
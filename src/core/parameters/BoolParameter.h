@@ -27,6 +27,8 @@ public:
     // Value access
     bool getValue() const;
     void setValue(bool value);
+    // Sets the value without firing the change callback
+    void setValueSilently(bool value);
 
     // Convenience
     void toggle();
@@ -56,6 +56,11 @@ void EnumParameter::setSelectedIndex(size_t index) {
     }
 }
 
+void EnumParameter::setSelectedIndexSilently(size_t index) {
+    if (pImpl->options.empty()) return;
+    pImpl->selectedIndex = std::min(index, pImpl->options.size() - 1);
+}
+
 const std::string& EnumParameter::getSelectedValue() const {
     static const std::string empty;
     if (pImpl->options.empty()) return empty;
@@ -31,6 +31,8 @@ public:
     // Index-based access
     size_t getSelectedIndex() const;
     void setSelectedIndex(size_t index);
+    // Selects without firing the change callback
+    void setSelectedIndexSilently(size_t index);
 
     // String-based access
     const std::string& getSelectedValue() const;
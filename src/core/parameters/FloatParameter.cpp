@@ -1,5 +1,6 @@
 #include "core/parameters/FloatParameter.h"
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 
 namespace nap {
@@ -7,7 +8,10 @@ namespace nap {
 class FloatParameter::Impl {
 public:
     std::string name;
-    float value;
+    float localValue;
+    // Points into a group's value storage when attached. Only re-pointed when
+    // the parameter joins or leaves a group; the group's storage never moves.
+    std::atomic<float*> value{&localValue};
     float defaultValue;
     float minValue;
     float maxValue;
@@ -16,17 +20,110 @@ public:
     bool smoothingEnabled = false;
     float smoothingTime = 0.01f;
     float smoothedValue;
+    SmoothingMode smoothingMode = SmoothingMode::OnePole;
+
+    // Cached per sample rate by updateCoefficients()
+    float sampleRate = 44100.0f;
     float smoothingCoeff = 0.0f;
+    std::size_t rampLength = 1;
+
+    // Active Linear / Multiplicative ramp
+    float rampTarget;
+    float rampStep = 0.0f;
+    std::size_t rampRemaining = 0;
+    bool rampIsMultiplicative = false;
 
     ChangeCallback changeCallback;
 
     Impl(const std::string& n, float def, float min, float max)
         : name(n)
-        , value(std::clamp(def, min, max))
+        , localValue(std::clamp(def, min, max))
         , defaultValue(def)
         , minValue(min)
         , maxValue(max)
-        , smoothedValue(value) {}
+        , smoothedValue(stored())
+        , rampTarget(stored()) {
+        updateCoefficients();
+    }
+
+    float& stored() {
+        return *value.load(std::memory_order_acquire);
+    }
+
+    const float& stored() const {
+        return *value.load(std::memory_order_acquire);
+    }
+
+    void updateCoefficients() {
+        const float samples = smoothingTime * sampleRate;
+        smoothingCoeff = samples > 0.0f ? std::exp(-1.0f / samples) : 0.0f;
+        rampLength = std::max<std::size_t>(1, static_cast<std::size_t>(std::lround(samples)));
+    }
+
+    void settle() {
+        smoothedValue = stored();
+        rampTarget = stored();
+        rampRemaining = 0;
+    }
+
+    // Close enough to the target that the remaining step is inaudible
+    bool hasConverged(float current) const {
+        return std::abs(current - stored()) <= 1.0e-5f * std::max(std::abs(stored()), 1.0f);
+    }
+
+    void startRamp() {
+        rampTarget = stored();
+        rampRemaining = rampLength;
+        rampIsMultiplicative = smoothingMode == SmoothingMode::Multiplicative &&
+                               smoothedValue * stored() > 0.0f;
+        if (rampIsMultiplicative) {
+            rampStep = std::pow(stored() / smoothedValue, 1.0f / static_cast<float>(rampLength));
+        } else {
+            rampStep = (stored() - smoothedValue) / static_cast<float>(rampLength);
+        }
+    }
+
+    void renderOnePole(float* dst, std::size_t numSamples) {
+        const float target = stored();
+        const float coeff = smoothingCoeff;
+        float current = smoothedValue;
+        for (std::size_t i = 0; i < numSamples; ++i) {
+            current = target + coeff * (current - target);
+            dst[i] = current;
+        }
+        smoothedValue = hasConverged(current) ? target : current;
+    }
+
+    void renderRamp(float* dst, std::size_t numSamples) {
+        if (stored() != rampTarget) {
+            startRamp();
+        }
+
+        const std::size_t rampSamples = std::min(numSamples, rampRemaining);
+        const float start = smoothedValue;
+        const float step = rampStep;
+
+        if (rampIsMultiplicative) {
+            float current = start;
+            for (std::size_t i = 0; i < rampSamples; ++i) {
+                current *= step;
+                dst[i] = current;
+            }
+            smoothedValue = current;
+        } else {
+            // Computed from the start value, so the loop has no carried dependency
+            for (std::size_t i = 0; i < rampSamples; ++i) {
+                dst[i] = start + step * static_cast<float>(i + 1);
+            }
+            smoothedValue = start + step * static_cast<float>(rampSamples);
+        }
+
+        rampRemaining -= rampSamples;
+        if (rampRemaining == 0) {
+            smoothedValue = rampTarget;
+        }
+        std::fill(dst + rampSamples, dst + numSamples, smoothedValue);
+    }
 
     float clamp(float v) const {
         return std::clamp(v, minValue, maxValue);
@@ -58,27 +155,31 @@ ParameterType FloatParameter::getType() const {
 
 void FloatParameter::reset() {
     setValue(pImpl->defaultValue);
-    pImpl->smoothedValue = pImpl->value;
+    pImpl->settle();
 }
 
 float FloatParameter::getValue() const {
-    return pImpl->value;
+    return pImpl->stored();
 }
 
 void FloatParameter::setValue(float value) {
-    float oldValue = pImpl->value;
+    float oldValue = pImpl->stored();
     float newValue = pImpl->clamp(value);
 
     if (oldValue != newValue) {
-        pImpl->value = newValue;
+        pImpl->stored() = newValue;
         if (pImpl->changeCallback) {
             pImpl->changeCallback(oldValue, newValue);
         }
     }
 }
 
+void FloatParameter::setValueSilently(float value) {
+    pImpl->stored() = pImpl->clamp(value);
+}
+
 float FloatParameter::getNormalizedValue() const {
-    return pImpl->normalize(pImpl->value);
+    return pImpl->normalize(pImpl->stored());
 }
 
 void FloatParameter::setNormalizedValue(float normalized) {
@@ -100,14 +201,15 @@ float FloatParameter::getDefaultValue() const {
 void FloatParameter::setRange(float minValue, float maxValue) {
     pImpl->minValue = minValue;
     pImpl->maxValue = maxValue;
-    pImpl->value = pImpl->clamp(pImpl->value);
+    pImpl->stored() = pImpl->clamp(pImpl->stored());
 }
 
 void FloatParameter::enableSmoothing(bool enable, float smoothingTime) {
     pImpl->smoothingEnabled = enable;
     pImpl->smoothingTime = smoothingTime;
+    pImpl->updateCoefficients();
     if (!enable) {
-        pImpl->smoothedValue = pImpl->value;
+        pImpl->settle();
     }
 }
 
@@ -117,13 +219,72 @@ bool FloatParameter::isSmoothingEnabled() const {
 
 float FloatParameter::getSmoothedValue(float sampleRate) {
     if (!pImpl->smoothingEnabled) {
-        return pImpl->value;
+        return pImpl->stored();
+    }
+
+    if (sampleRate != pImpl->sampleRate) {
+        setSampleRate(sampleRate);
     }
 
-    // One-pole smoothing filter
-    float coeff = std::exp(-1.0f / (pImpl->smoothingTime * sampleRate));
-    pImpl->smoothedValue = pImpl->value + coeff * (pImpl->smoothedValue - pImpl->value);
-    return pImpl->smoothedValue;
+    float smoothed;
+    fillSmoothedBlock(&smoothed, 1);
+    return smoothed;
+}
+
+void FloatParameter::setSmoothingMode(SmoothingMode mode) {
+    pImpl->smoothingMode = mode;
+    pImpl->rampRemaining = 0;
+    pImpl->rampTarget = pImpl->smoothedValue;
+}
+
+FloatParameter::SmoothingMode FloatParameter::getSmoothingMode() const {
+    return pImpl->smoothingMode;
+}
+
+void FloatParameter::setSampleRate(float sampleRate) {
+    if (sampleRate <= 0.0f) return;
+    pImpl->sampleRate = sampleRate;
+    pImpl->updateCoefficients();
+}
+
+float FloatParameter::getSampleRate() const {
+    return pImpl->sampleRate;
+}
+
+void FloatParameter::fillSmoothedBlock(float* dst, std::size_t numSamples) {
+    if (!dst || numSamples == 0) return;
+
+    // Settled: no per-sample work at all
+    if (!pImpl->smoothingEnabled || !isSmoothing()) {
+        pImpl->settle();
+        std::fill(dst, dst + numSamples, pImpl->stored());
+        return;
+    }
+
+    if (pImpl->smoothingMode == SmoothingMode::OnePole) {
+        pImpl->renderOnePole(dst, numSamples);
+    } else {
+        pImpl->renderRamp(dst, numSamples);
+    }
+}
+
+bool FloatParameter::isSmoothing() const {
+    return pImpl->smoothingEnabled &&
+           (pImpl->smoothedValue != pImpl->stored() || pImpl->rampRemaining > 0);
+}
+
+void FloatParameter::resetSmoothing() {
+    pImpl->settle();
+}
+
+void FloatParameter::attachValueStorage(float* slot) {
+    float* target = slot ? slot : &pImpl->localValue;
+    *target = pImpl->stored();
+    pImpl->value.store(target, std::memory_order_release);
+}
+
+bool FloatParameter::hasExternalValueStorage() const {
+    return pImpl->value.load(std::memory_order_acquire) != &pImpl->localValue;
 }
 
 void FloatParameter::setChangeCallback(ChangeCallback callback) {
@@ -134,4 +295,8 @@ void FloatParameter::removeChangeCallback() {
     pImpl->changeCallback = nullptr;
 }
 
+void FloatParameter::setValueChangedCallback(ValueChangedCallback callback) {
+    setChangeCallback(std::move(callback));
+}
+
 } // namespace nap
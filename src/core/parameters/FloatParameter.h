@@ -2,6 +2,7 @@
 #define NAP_FLOAT_PARAMETER_H
 
 #include "api/IParameter.h"
+#include <cstddef>
 #include <string>
 #include <functional>
 
@@ -12,11 +13,21 @@ namespace nap {
  *
  * Handles floating-point parameter values with range validation,
  * smoothing support, and change notification callbacks.
+ *
+ * For audio-rate use, fillSmoothedBlock() renders a whole block of smoothed
+ * values with the coefficients cached for the current sample rate; once the
+ * value has settled it just fills the block with a constant.
  */
-class FloatParameter : public IParameter {
+class FloatParameter : public INumericParameter {
 public:
     using ChangeCallback = std::function<void(float oldValue, float newValue)>;
 
+    enum class SmoothingMode {
+        Linear,         // Straight ramp reaching the target in exactly smoothingTime
+        OnePole,        // Exponential approach with time constant smoothingTime
+        Multiplicative  // Constant-ratio ramp for gains and frequencies
+    };
+
     FloatParameter(const std::string& name, float defaultValue,
                    float minValue = 0.0f, float maxValue = 1.0f);
     ~FloatParameter() override;
@@ -27,27 +38,45 @@ public:
     void reset() override;
 
     // Value access
-    float getValue() const;
-    void setValue(float value);
+    float getValue() const override;
+    void setValue(float value) override;
+    // Same as setValue but without invoking the change callback; used when
+    // queued changes are applied on the audio thread
+    void setValueSilently(float value);
 
     // Normalized access (0.0 - 1.0)
-    float getNormalizedValue() const;
-    void setNormalizedValue(float normalized);
+    float getNormalizedValue() const override;
+    void setNormalizedValue(float normalized) override;
 
     // Range access
-    float getMinValue() const;
-    float getMaxValue() const;
-    float getDefaultValue() const;
+    float getMinValue() const override;
+    float getMaxValue() const override;
+    float getDefaultValue() const override;
     void setRange(float minValue, float maxValue);
 
     // Smoothing
-    void enableSmoothing(bool enable, float smoothingTime = 0.01f);
+    void enableSmoothing(bool enable, float smoothingTime = 0.01f) override;
     bool isSmoothingEnabled() const;
-    float getSmoothedValue(float sampleRate);
+    float getSmoothedValue(float sampleRate) override;
+
+    // Block smoothing; setSampleRate() caches the per-sample coefficients
+    void setSmoothingMode(SmoothingMode mode);
+    SmoothingMode getSmoothingMode() const;
+    void setSampleRate(float sampleRate);
+    float getSampleRate() const;
+    void fillSmoothedBlock(float* dst, std::size_t numSamples);
+    bool isSmoothing() const;
+    void resetSmoothing();  // Jump the smoothed value to the target
+
+    // External value storage, e.g. a slot in a ParameterGroup's value array.
+    // The current value is copied in; nullptr copies it back and detaches.
+    void attachValueStorage(float* slot);
+    bool hasExternalValueStorage() const;
 
     // Callbacks
     void setChangeCallback(ChangeCallback callback);
     void removeChangeCallback();
+    void setValueChangedCallback(ValueChangedCallback callback) override;
 
 private:
     class Impl;
@@ -68,6 +68,10 @@ void IntParameter::setValue(int value) {
     }
 }
 
+void IntParameter::setValueSilently(int value) {
+    pImpl->value = pImpl->clamp(pImpl->quantize(value));
+}
+
 float IntParameter::getNormalizedValue() const {
     if (pImpl->maxValue == pImpl->minValue) return 0.0f;
     return static_cast<float>(pImpl->value - pImpl->minValue) /
@@ -29,6 +29,8 @@ public:
     // Value access
     int getValue() const;
     void setValue(int value);
+    // No change callback; see FloatParameter::setValueSilently
+    void setValueSilently(int value);
 
     // Normalized access (0.0 - 1.0)
     float getNormalizedValue() const;
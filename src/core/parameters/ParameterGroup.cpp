@@ -1,22 +1,240 @@
 #include "core/parameters/ParameterGroup.h"
-#include <unordered_map>
+#include "core/parameters/BoolParameter.h"
+#include "core/parameters/EnumParameter.h"
+#include "core/parameters/FloatParameter.h"
+#include "core/parameters/IntParameter.h"
+#include "core/parameters/TriggerParameter.h"
+#include "core/threading/SpscQueue.h"
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <unordered_map>
 
 namespace nap {
 
 class ParameterGroup::Impl {
 public:
+    // Float values live in fixed blocks that are never reallocated, so a
+    // parameter attached to a slot keeps a valid pointer while it is live
+    static constexpr size_t kValueBlockSize = 64;
+
+    // Typed view of a parameter so hot paths never need a dynamic_cast
+    struct Slot {
+        IParameter* parameter = nullptr;
+        ParameterType type = ParameterType::Custom;
+        bool inArray = false;  // Float parameter whose value lives in values[handle]
+    };
+
     std::string name;
     std::vector<std::shared_ptr<IParameter>> parameters;
-    std::unordered_map<std::string, size_t> parameterIndex;
     std::vector<std::unique_ptr<ParameterGroup>> groups;
     std::unordered_map<std::string, size_t> groupIndex;
 
-    explicit Impl(const std::string& n) : name(n) {}
+    // Indexed by handle; slots of removed parameters are left empty and
+    // their handles are never reissued, so stale queued changes find no target
+    std::vector<Slot> slots;
+    std::vector<std::unique_ptr<float[]>> valueBlocks;
+    std::unordered_map<std::string, ParameterHandle> handleIndex;
+
+    SpscQueue<ParameterChange> changeQueue;
+    SpscQueue<ParameterNotification> notificationQueue;
+    std::atomic<uint64_t> droppedChanges{0};
+    std::atomic<uint64_t> droppedNotifications{0};
+
+    NotificationCallback notificationCallback;
+    std::vector<ParameterNotification> batch;
+    std::vector<uint32_t> batchIndex;  // By handle: position in batch, or kNotBatched
+    static constexpr uint32_t kNotBatched = 0xFFFFFFFFu;
+
+    Impl(const std::string& n, size_t queueCapacity)
+        : name(n)
+        , changeQueue(queueCapacity)
+        , notificationQueue(queueCapacity) {
+        batch.reserve(notificationQueue.getCapacity());
+    }
+
+    // Parameters can outlive the group, so hand their values back first
+    ~Impl() {
+        detachAll();
+    }
+
+    static Slot makeSlot(IParameter* parameter) {
+        Slot slot;
+        slot.parameter = parameter;
+        if (dynamic_cast<FloatParameter*>(parameter)) {
+            slot.type = ParameterType::Float;
+        } else if (dynamic_cast<IntParameter*>(parameter)) {
+            slot.type = ParameterType::Int;
+        } else if (dynamic_cast<BoolParameter*>(parameter)) {
+            slot.type = ParameterType::Bool;
+        } else if (dynamic_cast<EnumParameter*>(parameter)) {
+            slot.type = ParameterType::Enum;
+        } else if (dynamic_cast<TriggerParameter*>(parameter)) {
+            slot.type = ParameterType::Trigger;
+        }
+        return slot;
+    }
+
+    static FloatParameter* asFloat(const Slot& slot) {
+        return static_cast<FloatParameter*>(slot.parameter);
+    }
+
+    void detach(Slot& slot) {
+        if (slot.inArray) {
+            asFloat(slot)->attachValueStorage(nullptr);
+            slot.inArray = false;
+        }
+    }
+
+    void detachAll() {
+        for (auto& slot : slots) {
+            detach(slot);
+        }
+    }
+
+    float* valueSlot(size_t handle) const {
+        return &valueBlocks[handle / kValueBlockSize][handle % kValueBlockSize];
+    }
+
+    ParameterHandle add(IParameter* parameter) {
+        const ParameterHandle handle = static_cast<ParameterHandle>(slots.size());
+        if (slots.size() == valueBlocks.size() * kValueBlockSize) {
+            valueBlocks.push_back(std::make_unique<float[]>(kValueBlockSize));
+        }
+        slots.emplace_back();
+
+        Slot slot = makeSlot(parameter);
+        if (slot.type == ParameterType::Float && !asFloat(slot)->hasExternalValueStorage()) {
+            asFloat(slot)->attachValueStorage(valueSlot(handle));
+            slot.inArray = true;
+        }
+        slots[handle] = slot;
+        *valueSlot(handle) = read(handle);
+        return handle;
+    }
+
+    void release(ParameterHandle handle) {
+        detach(slots[handle]);
+        slots[handle] = Slot{};
+    }
+
+    const Slot* find(ParameterHandle handle) const {
+        if (handle >= slots.size() || !slots[handle].parameter) {
+            return nullptr;
+        }
+        return &slots[handle];
+    }
+
+    float read(ParameterHandle handle) const {
+        const Slot& slot = slots[handle];
+        switch (slot.type) {
+            case ParameterType::Float:
+                return slot.inArray ? *valueSlot(handle) : asFloat(slot)->getValue();
+            case ParameterType::Int:
+                return static_cast<float>(static_cast<IntParameter*>(slot.parameter)->getValue());
+            case ParameterType::Bool:
+                return static_cast<BoolParameter*>(slot.parameter)->getValue() ? 1.0f : 0.0f;
+            case ParameterType::Enum:
+                return static_cast<float>(
+                    static_cast<EnumParameter*>(slot.parameter)->getSelectedIndex());
+            case ParameterType::Trigger:
+                return static_cast<TriggerParameter*>(slot.parameter)->isPending() ? 1.0f : 0.0f;
+            default:
+                return 0.0f;
+        }
+    }
+
+    // Writes through the typed setter; silent writes skip the parameter's callback
+    bool write(const Slot& slot, float value, bool silent) {
+        switch (slot.type) {
+            case ParameterType::Float: {
+                auto* param = asFloat(slot);
+                silent ? param->setValueSilently(value) : param->setValue(value);
+                return true;
+            }
+            case ParameterType::Int: {
+                auto* param = static_cast<IntParameter*>(slot.parameter);
+                const int intValue = static_cast<int>(std::lround(value));
+                silent ? param->setValueSilently(intValue) : param->setValue(intValue);
+                return true;
+            }
+            case ParameterType::Bool: {
+                auto* param = static_cast<BoolParameter*>(slot.parameter);
+                silent ? param->setValueSilently(value >= 0.5f) : param->setValue(value >= 0.5f);
+                return true;
+            }
+            case ParameterType::Enum: {
+                auto* param = static_cast<EnumParameter*>(slot.parameter);
+                const size_t index = value > 0.0f ? static_cast<size_t>(std::lround(value)) : 0;
+                silent ? param->setSelectedIndexSilently(index) : param->setSelectedIndex(index);
+                return true;
+            }
+            case ParameterType::Trigger: {
+                if (value == 0.0f) {
+                    return false;
+                }
+                auto* param = static_cast<TriggerParameter*>(slot.parameter);
+                silent ? param->triggerSilently() : param->trigger();
+                return true;
+            }
+            default:
+                return false;
+        }
+    }
+
+    size_t writeRange(ParameterHandle first, const float* source, size_t count, bool silent) {
+        const size_t end = std::min(slots.size(), static_cast<size_t>(first) + count);
+        if (!source || first >= end) return 0;
+
+        size_t written = 0;
+        for (size_t h = first; h < end; ++h) {
+            const Slot& slot = slots[h];
+            if (slot.parameter && write(slot, source[h - first], silent)) {
+                ++written;
+            }
+        }
+        return written;
+    }
+
+    // Applies a change to its parameter; returns true if the value changed.
+    bool apply(const ParameterChange& change, ParameterNotification& notification) {
+        const Slot* slot = find(change.handle);
+        if (!slot) {
+            return false;
+        }
+
+        const float oldValue = slot->type == ParameterType::Trigger ? 0.0f : read(change.handle);
+        if (!write(*slot, change.value, true)) {
+            return false;
+        }
+
+        notification.handle = change.handle;
+        notification.oldValue = oldValue;
+        notification.newValue = read(change.handle);
+        return slot->type == ParameterType::Trigger || oldValue != notification.newValue;
+    }
+
+    size_t process(ParameterChange* changes, size_t maxChanges) {
+        size_t count = 0;
+        ParameterChange change;
+        ParameterNotification notification;
+
+        while (count < maxChanges && changeQueue.pop(change)) {
+            if (changes) {
+                changes[count] = change;
+            }
+            ++count;
+
+            if (apply(change, notification) && !notificationQueue.push(notification)) {
+                droppedNotifications.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        return count;
+    }
 };
 
-ParameterGroup::ParameterGroup(const std::string& name)
-    : pImpl(std::make_unique<Impl>(name)) {}
+ParameterGroup::ParameterGroup(const std::string& name, size_t queueCapacity)
+    : pImpl(std::make_unique<Impl>(name, queueCapacity)) {}
 
 ParameterGroup::~ParameterGroup() = default;
 
@@ -35,48 +253,89 @@ void ParameterGroup::addParameter(std::shared_ptr<IParameter> parameter) {
     if (!parameter) return;
 
     const std::string& name = parameter->getName();
-    if (pImpl->parameterIndex.find(name) != pImpl->parameterIndex.end()) {
+    if (pImpl->handleIndex.find(name) != pImpl->handleIndex.end()) {
         return; // Already exists
     }
 
-    pImpl->parameterIndex[name] = pImpl->parameters.size();
+    pImpl->handleIndex[name] = pImpl->add(parameter.get());
     pImpl->parameters.push_back(std::move(parameter));
 }
 
 void ParameterGroup::removeParameter(const std::string& name) {
-    auto it = pImpl->parameterIndex.find(name);
-    if (it == pImpl->parameterIndex.end()) return;
-
-    size_t index = it->second;
-    pImpl->parameters.erase(pImpl->parameters.begin() + index);
-    pImpl->parameterIndex.erase(it);
-
-    // Update indices
-    for (auto& pair : pImpl->parameterIndex) {
-        if (pair.second > index) {
-            pair.second--;
-        }
-    }
+    auto it = pImpl->handleIndex.find(name);
+    if (it == pImpl->handleIndex.end()) return;
+
+    IParameter* parameter = pImpl->slots[it->second].parameter;
+    pImpl->release(it->second);
+    pImpl->handleIndex.erase(it);
+
+    auto& parameters = pImpl->parameters;
+    parameters.erase(std::find_if(parameters.begin(), parameters.end(),
+                                  [parameter](const std::shared_ptr<IParameter>& p) {
+                                      return p.get() == parameter;
+                                  }));
 }
 
 IParameter* ParameterGroup::getParameter(const std::string& name) {
-    auto it = pImpl->parameterIndex.find(name);
-    if (it != pImpl->parameterIndex.end()) {
-        return pImpl->parameters[it->second].get();
-    }
-    return nullptr;
+    return getParameter(getHandle(name));
 }
 
 const IParameter* ParameterGroup::getParameter(const std::string& name) const {
-    auto it = pImpl->parameterIndex.find(name);
-    if (it != pImpl->parameterIndex.end()) {
-        return pImpl->parameters[it->second].get();
-    }
-    return nullptr;
+    return getParameter(getHandle(name));
 }
 
 bool ParameterGroup::hasParameter(const std::string& name) const {
-    return pImpl->parameterIndex.find(name) != pImpl->parameterIndex.end();
+    return pImpl->handleIndex.find(name) != pImpl->handleIndex.end();
+}
+
+ParameterHandle ParameterGroup::getHandle(const std::string& name) const {
+    auto it = pImpl->handleIndex.find(name);
+    return it != pImpl->handleIndex.end() ? it->second : kInvalidParameterHandle;
+}
+
+IParameter* ParameterGroup::getParameter(ParameterHandle handle) {
+    const Impl::Slot* slot = pImpl->find(handle);
+    return slot ? slot->parameter : nullptr;
+}
+
+const IParameter* ParameterGroup::getParameter(ParameterHandle handle) const {
+    const Impl::Slot* slot = pImpl->find(handle);
+    return slot ? slot->parameter : nullptr;
+}
+
+size_t ParameterGroup::getHandleCount() const {
+    return pImpl->slots.size();
+}
+
+float ParameterGroup::getValue(ParameterHandle handle) const {
+    return pImpl->find(handle) ? pImpl->read(handle) : 0.0f;
+}
+
+bool ParameterGroup::setValue(ParameterHandle handle, float value) {
+    const Impl::Slot* slot = pImpl->find(handle);
+    return slot && pImpl->write(*slot, value, false);
+}
+
+size_t ParameterGroup::getValues(ParameterHandle first, float* values, size_t count) const {
+    const size_t end = std::min(pImpl->slots.size(), static_cast<size_t>(first) + count);
+    if (!values || first >= end) return 0;
+
+    const Impl::Slot* slots = pImpl->slots.data();
+    for (size_t h = first; h < end; ++h) {
+        // Attached float parameters are read straight from the value blocks
+        values[h - first] = slots[h].inArray ? *pImpl->valueSlot(h)
+                          : slots[h].parameter ? pImpl->read(static_cast<ParameterHandle>(h))
+                          : 0.0f;
+    }
+    return end - first;
+}
+
+size_t ParameterGroup::setValues(ParameterHandle first, const float* values, size_t count) {
+    return pImpl->writeRange(first, values, count, false);
+}
+
+size_t ParameterGroup::setValuesSilently(ParameterHandle first, const float* values, size_t count) {
+    return pImpl->writeRange(first, values, count, true);
 }
 
 void ParameterGroup::addGroup(std::unique_ptr<ParameterGroup> group) {
@@ -159,6 +418,85 @@ void ParameterGroup::forEachGroup(const std::function<void(const ParameterGroup&
     }
 }
 
+bool ParameterGroup::pushChange(ParameterHandle handle, float value, uint32_t sampleOffset) {
+    ParameterChange change;
+    change.handle = handle;
+    change.value = value;
+    change.sampleOffset = sampleOffset;
+    return pushChange(change);
+}
+
+bool ParameterGroup::pushChange(const ParameterChange& change) {
+    if (pImpl->changeQueue.push(change)) {
+        return true;
+    }
+    pImpl->droppedChanges.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+size_t ParameterGroup::processChanges() {
+    return pImpl->process(nullptr, pImpl->changeQueue.getCapacity());
+}
+
+size_t ParameterGroup::processChanges(ParameterChange* changes, size_t maxChanges) {
+    return pImpl->process(changes, changes ? maxChanges : 0);
+}
+
+void ParameterGroup::setNotificationCallback(NotificationCallback callback) {
+    pImpl->notificationCallback = std::move(callback);
+}
+
+size_t ParameterGroup::dispatchNotifications() {
+    auto& batch = pImpl->batch;
+    batch.clear();
+
+    auto& index = pImpl->batchIndex;
+    if (index.size() < pImpl->slots.size()) {
+        index.resize(pImpl->slots.size(), Impl::kNotBatched);
+    }
+
+    // Coalesce: keep the first old value and the latest new value per handle.
+    // Every trigger is its own event and is never merged.
+    ParameterNotification notification;
+    while (pImpl->notificationQueue.pop(notification)) {
+        const Impl::Slot* slot = pImpl->find(notification.handle);
+        if (!slot) {
+            continue;  // Parameter removed since the change was applied
+        }
+        if (slot->type == ParameterType::Trigger) {
+            batch.push_back(notification);
+            continue;
+        }
+        uint32_t& position = index[notification.handle];
+        if (position != Impl::kNotBatched) {
+            batch[position].newValue = notification.newValue;
+        } else {
+            position = static_cast<uint32_t>(batch.size());
+            batch.push_back(notification);
+        }
+    }
+    for (const auto& pending : batch) {
+        index[pending.handle] = Impl::kNotBatched;
+    }
+
+    if (!batch.empty() && pImpl->notificationCallback) {
+        pImpl->notificationCallback(batch.data(), batch.size());
+    }
+    return batch.size();
+}
+
+size_t ParameterGroup::getPendingChangeCount() const {
+    return pImpl->changeQueue.size();
+}
+
+uint64_t ParameterGroup::getDroppedChangeCount() const {
+    return pImpl->droppedChanges.load(std::memory_order_relaxed);
+}
+
+uint64_t ParameterGroup::getDroppedNotificationCount() const {
+    return pImpl->droppedNotifications.load(std::memory_order_relaxed);
+}
+
 void ParameterGroup::resetAll() {
     for (auto& param : pImpl->parameters) {
         param->reset();
@@ -169,8 +507,11 @@ void ParameterGroup::resetAll() {
 }
 
 void ParameterGroup::clear() {
+    // Handles issued so far stay retired, like after a removal
+    pImpl->detachAll();
     pImpl->parameters.clear();
-    pImpl->parameterIndex.clear();
+    std::fill(pImpl->slots.begin(), pImpl->slots.end(), Impl::Slot{});
+    pImpl->handleIndex.clear();
     pImpl->groups.clear();
     pImpl->groupIndex.clear();
 }
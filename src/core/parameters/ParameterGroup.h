@@ -2,6 +2,7 @@
 #define NAP_PARAMETER_GROUP_H
 
 #include "api/IParameter.h"
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <vector>
@@ -9,15 +10,61 @@
 
 namespace nap {
 
+/// Stable integer identifier for a parameter within its group.
+using ParameterHandle = std::uint32_t;
+constexpr ParameterHandle kInvalidParameterHandle = 0xFFFFFFFFu;
+
+/**
+ * @brief A value change queued from a control thread for the audio thread.
+ */
+struct ParameterChange {
+    ParameterHandle handle = kInvalidParameterHandle;
+    float value = 0.0f;
+    std::uint32_t sampleOffset = 0;  ///< Position within the next block
+};
+
+/**
+ * @brief A change applied on the audio thread, reported back to the UI.
+ */
+struct ParameterNotification {
+    ParameterHandle handle = kInvalidParameterHandle;
+    float oldValue = 0.0f;
+    float newValue = 0.0f;
+};
+
 /**
  * @brief Container for organizing related parameters
  *
  * Groups parameters together for logical organization,
  * supports nested groups and iteration over parameters.
+ *
+ * Parameters are addressed by integer handles issued in insertion order
+ * and never reused, so a change queued for a removed parameter can never
+ * reach another one, and a node's parameters, added together, form a
+ * dense handle range for bulk access. The values of the group's
+ * FloatParameters are stored in fixed-size blocks owned by the group (each
+ * parameter is attached to its slot), so handle-based reads are a single
+ * indexed load. The blocks are never reallocated: adding parameters never
+ * moves a live parameter's value.
+ *
+ * Each group also owns a lock-free channel to the audio thread. A control
+ * thread (UI, OSC, ...) queues changes by handle with pushChange(); the
+ * audio thread applies them once per block with processChanges(), which
+ * never blocks or allocates. Applied changes do not fire the parameters'
+ * own callbacks on the audio thread; they are queued back and delivered
+ * in coalesced batches when the UI thread calls dispatchNotifications().
+ * Both queues are single-producer / single-consumer. Adding or removing
+ * parameters must not overlap with processChanges().
  */
 class ParameterGroup {
 public:
-    explicit ParameterGroup(const std::string& name);
+    using NotificationCallback =
+        std::function<void(const ParameterNotification* notifications, size_t count)>;
+
+    static constexpr size_t kDefaultQueueCapacity = 256;
+
+    explicit ParameterGroup(const std::string& name,
+                            size_t queueCapacity = kDefaultQueueCapacity);
     ~ParameterGroup();
 
     // Non-copyable, movable
@@ -37,6 +84,25 @@ public:
     const IParameter* getParameter(const std::string& name) const;
     bool hasParameter(const std::string& name) const;
 
+    // Handles stay valid until the parameter is removed and are never reused.
+    // Resolve names once with getHandle() and use handles on hot paths.
+    ParameterHandle getHandle(const std::string& name) const;
+    IParameter* getParameter(ParameterHandle handle);
+    const IParameter* getParameter(ParameterHandle handle) const;
+    size_t getHandleCount() const;  // One past the highest handle issued
+
+    // Value access by handle, as float (bool: 0/1, enum: index, trigger: pending).
+    // setValue goes through the parameter's setter, so clamping and change
+    // callbacks behave as for a direct call. The bulk versions cover the
+    // handles [first, first + count); removed handles read as 0 and are skipped.
+    float getValue(ParameterHandle handle) const;
+    bool setValue(ParameterHandle handle, float value);
+    size_t getValues(ParameterHandle first, float* values, size_t count) const;
+    size_t setValues(ParameterHandle first, const float* values, size_t count);
+
+    // Audio thread: bulk write without change callbacks or notifications
+    size_t setValuesSilently(ParameterHandle first, const float* values, size_t count);
+
     // Nested groups
     void addGroup(std::unique_ptr<ParameterGroup> group);
     void removeGroup(const std::string& name);
@@ -53,6 +119,25 @@ public:
     void forEachGroup(const std::function<void(ParameterGroup&)>& callback);
     void forEachGroup(const std::function<void(const ParameterGroup&)>& callback) const;
 
+    // Control thread: queue a change; false if the queue is full
+    bool pushChange(ParameterHandle handle, float value, uint32_t sampleOffset = 0);
+    bool pushChange(const ParameterChange& change);
+
+    // Audio thread: apply all queued changes, or up to maxChanges of them
+    // while copying each applied change into changes[] for sample-accurate use
+    size_t processChanges();
+    size_t processChanges(ParameterChange* changes, size_t maxChanges);
+
+    // UI thread: deliver pending notifications to the callback as one batch,
+    // with repeated changes to the same parameter coalesced (every trigger is
+    // reported); notifications for removed parameters are dropped
+    void setNotificationCallback(NotificationCallback callback);
+    size_t dispatchNotifications();
+
+    size_t getPendingChangeCount() const;
+    uint64_t getDroppedChangeCount() const;
+    uint64_t getDroppedNotificationCount() const;
+
     // Bulk operations
     void resetAll();
     void clear();
@@ -35,6 +35,10 @@ void TriggerParameter::trigger() {
     }
 }
 
+void TriggerParameter::triggerSilently() {
+    pImpl->triggered.store(true, std::memory_order_release);
+}
+
 bool TriggerParameter::consume() {
     return pImpl->triggered.exchange(false, std::memory_order_acq_rel);
 }
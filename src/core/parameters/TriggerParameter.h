@@ -28,6 +28,8 @@ public:
 
     // Trigger operations
     void trigger();
+    // Marks the trigger pending without firing the callback
+    void triggerSilently();
     bool consume();  // Returns true if triggered, then resets
     bool isPending() const;
 
@@ -1,56 +1,805 @@
 #include "core/serialization/BinarySerializer.h"
+#include "core/serialization/ChunkCodec.h"
+#include "core/serialization/ParameterStateLayout.h"
+#include "core/serialization/StateVector.h"
+#include "core/graph/AudioGraph.h"
+#include "core/graph/ConnectionManager.h"
+#include "core/memory/MappedFile.h"
+#include "core/parameters/BoolParameter.h"
+#include "core/parameters/EnumParameter.h"
+#include "core/parameters/FloatParameter.h"
+#include "core/parameters/IntParameter.h"
+#include "core/parameters/ParameterGroup.h"
+#include "api/IAudioNode.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <fstream>
 #include <cstring>
+#include <thread>
+#include <unordered_map>
 
 namespace nap {
 
+namespace {
+
+// On-disk layout (version 2). All integers are little-endian and all
+// offsets are from the start of the file.
+constexpr size_t kHeaderSize = 32;
+constexpr size_t kLegacyHeaderSize = 8;
+
+struct FileHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t flags;
+    uint32_t fileSize;
+    uint32_t sectionCount;
+    uint32_t sectionTableOffset;  // Chunk table when compressed
+    uint32_t rawSize;             // Uncompressed image size when compressed
+    uint32_t reserved[2];
+};
+
+struct SectionEntry {
+    uint32_t tag;
+    uint32_t offset;
+    uint32_t size;
+    uint32_t count;
+};
+
+// String references are byte offsets into the string table
+struct NodeRecord {
+    uint32_t id;
+    uint32_t type;
+    uint32_t flags;
+};
+
+struct ConnectionRecord {
+    uint32_t source;
+    uint32_t sourceChannel;
+    uint32_t dest;
+    uint32_t destChannel;
+};
+
+// Path is "Group/Subgroup/Name"; value holds float bits or an int32
+struct ParameterRecord {
+    uint32_t path;
+    uint32_t type;
+    uint32_t value;
+};
+
+struct SampleRecord {
+    uint32_t name;
+    uint32_t offset;
+    uint32_t frames;
+    uint32_t channels;
+};
+
+// One independently compressed piece of the uncompressed image
+struct ChunkEntry {
+    uint32_t rawOffset;
+    uint32_t rawSize;
+    uint32_t offset;
+    uint32_t size;
+    uint8_t method;
+    uint8_t filter;
+    uint8_t strideWords;
+    uint8_t reserved;
+    uint32_t checksum;
+};
+
+static_assert(sizeof(FileHeader) == kHeaderSize, "FileHeader layout");
+static_assert(sizeof(ChunkEntry) == 24, "ChunkEntry layout");
+static_assert(sizeof(SectionEntry) == 16, "SectionEntry layout");
+static_assert(sizeof(NodeRecord) == 12, "NodeRecord layout");
+static_assert(sizeof(ConnectionRecord) == 16, "ConnectionRecord layout");
+static_assert(sizeof(ParameterRecord) == 12, "ParameterRecord layout");
+static_assert(sizeof(SampleRecord) == 16, "SampleRecord layout");
+
+constexpr uint32_t makeTag(char a, char b, char c, char d) {
+    return static_cast<uint32_t>(a) | (static_cast<uint32_t>(b) << 8) |
+           (static_cast<uint32_t>(c) << 16) | (static_cast<uint32_t>(d) << 24);
+}
+
+constexpr uint32_t kStringsTag = makeTag('S', 'T', 'R', 'S');
+constexpr uint32_t kNodesTag = makeTag('N', 'O', 'D', 'E');
+constexpr uint32_t kConnectionsTag = makeTag('C', 'O', 'N', 'N');
+constexpr uint32_t kParametersTag = makeTag('P', 'A', 'R', 'M');
+constexpr uint32_t kSamplesTag = makeTag('S', 'M', 'P', 'L');
+constexpr uint32_t kSampleDataTag = makeTag('D', 'A', 'T', 'A');
+
+constexpr uint32_t kNodeBypassed = 0x1;
+constexpr uint16_t kCompressedFlag = 0x0001;
+
+constexpr uint8_t kMethodStored = 0;
+constexpr uint8_t kMethodLz = 1;
+
+struct FilterChoice {
+    ChunkCodec::Filter filter;
+    uint8_t strideWords;
+};
+
+// Filters worth trying for each section, by what its words usually hold
+std::vector<FilterChoice> filtersFor(uint32_t tag) {
+    using F = ChunkCodec::Filter;
+    switch (tag) {
+        case kNodesTag: return {{F::None, 1}, {F::Delta32, 3}};
+        case kConnectionsTag: return {{F::None, 1}, {F::Delta32, 4}};
+        case kParametersTag: return {{F::None, 1}, {F::Delta32, 3}, {F::Xor32, 3}};
+        case kSamplesTag: return {{F::None, 1}, {F::Delta32, 4}};
+        case kSampleDataTag: return {{F::None, 1}, {F::Xor32, 1}, {F::Xor32, 2}, {F::Delta32, 1}};
+        default: return {{F::None, 1}};
+    }
+}
+
+size_t alignUp(size_t value) {
+    const size_t a = BinarySerializer::SECTION_ALIGNMENT;
+    return (value + a - 1) / a * a;
+}
+
+template<typename T>
+T readPod(const uint8_t* data) {
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+class StringTable {
+public:
+    uint32_t add(const std::string& text) {
+        auto it = index.find(text);
+        if (it != index.end()) return it->second;
+        const auto offset = static_cast<uint32_t>(bytes.size());
+        bytes.insert(bytes.end(), text.begin(), text.end());
+        bytes.push_back('\0');
+        index.emplace(text, offset);
+        return offset;
+    }
+
+    const std::vector<char>& data() const { return bytes; }
+
+private:
+    std::vector<char> bytes;
+    std::unordered_map<std::string, uint32_t> index;
+};
+
+} // namespace
+
 class BinarySerializer::Impl {
 public:
+    struct OutgoingSample {
+        std::string name;
+        const float* data;
+        uint32_t frames;
+        uint32_t channels;
+    };
+
+    // Sections of a validated file, pointing into the loaded bytes
+    struct View {
+        const uint8_t* base = nullptr;
+        size_t size = 0;
+        SectionEntry strings{};
+        SectionEntry nodes{};
+        SectionEntry connections{};
+        SectionEntry parameters{};
+        SectionEntry samples{};
+    };
+
     AudioGraph* graph = nullptr;
     ParameterGroup* parameterGroup = nullptr;
     std::string lastError;
     bool compressionEnabled = false;
+    unsigned decodeThreads = 0;
     bool valid = false;
-    std::vector<uint8_t> cachedData;
+
+    std::vector<OutgoingSample> outgoingSamples;
+
+    // Backing storage of the last load: a mapping, an owned copy, or caller memory
+    MappedFile mappedFile;
+    std::vector<uint8_t> ownedData;
+    std::unordered_map<std::string, SampleData> loadedSamples;
 
     void clearError() { lastError.clear(); }
     void setError(const std::string& error) { lastError = error; }
 
-    void writeHeader(std::vector<uint8_t>& buffer) const {
-        // Magic number (4 bytes)
-        buffer.push_back((MAGIC_NUMBER >> 0) & 0xFF);
-        buffer.push_back((MAGIC_NUMBER >> 8) & 0xFF);
-        buffer.push_back((MAGIC_NUMBER >> 16) & 0xFF);
-        buffer.push_back((MAGIC_NUMBER >> 24) & 0xFF);
+    void releaseLoaded() {
+        loadedSamples.clear();
+        mappedFile.close();
+        ownedData.clear();
+        ownedData.shrink_to_fit();
+        valid = false;
+    }
+
+    // Serialization
+
+    void collectParameters(const ParameterGroup& group, const std::string& prefix,
+                           StringTable& strings, std::vector<ParameterRecord>& records) const {
+        group.forEachParameter([&](const IParameter& param) {
+            ParameterRecord record{};
+            record.type = static_cast<uint32_t>(param.getType());
+
+            if (auto* f = dynamic_cast<const FloatParameter*>(&param)) {
+                const float value = f->getValue();
+                std::memcpy(&record.value, &value, sizeof(value));
+            } else if (auto* i = dynamic_cast<const IntParameter*>(&param)) {
+                const int32_t value = i->getValue();
+                std::memcpy(&record.value, &value, sizeof(value));
+            } else if (auto* b = dynamic_cast<const BoolParameter*>(&param)) {
+                record.value = b->getValue() ? 1 : 0;
+            } else if (auto* e = dynamic_cast<const EnumParameter*>(&param)) {
+                record.value = static_cast<uint32_t>(e->getSelectedIndex());
+            } else {
+                return;
+            }
+
+            record.path = strings.add(prefix + param.getName());
+            records.push_back(record);
+        });
+
+        group.forEachGroup([&](const ParameterGroup& child) {
+            collectParameters(child, prefix + child.getName() + "/", strings, records);
+        });
+    }
+
+    std::vector<uint8_t> write() {
+        StringTable strings;
+        std::vector<NodeRecord> nodes;
+        std::vector<ConnectionRecord> connections;
+        std::vector<ParameterRecord> parameters;
+        std::vector<SampleRecord> samples;
+
+        if (graph) {
+            auto ids = graph->getAllNodeIds();
+            std::sort(ids.begin(), ids.end());
+            for (const auto& id : ids) {
+                auto node = graph->getNode(id);
+                NodeRecord record{};
+                record.id = strings.add(id);
+                record.type = strings.add(node->getTypeName());
+                record.flags = node->isBypassed() ? kNodeBypassed : 0;
+                nodes.push_back(record);
+            }
+            for (const auto& c : graph->getConnections()) {
+                ConnectionRecord record{};
+                record.source = strings.add(c.sourceNodeId);
+                record.sourceChannel = c.sourceChannel;
+                record.dest = strings.add(c.destNodeId);
+                record.destChannel = c.destChannel;
+                connections.push_back(record);
+            }
+        }
+        if (parameterGroup) {
+            collectParameters(*parameterGroup, "", strings, parameters);
+        }
+        for (const auto& sample : outgoingSamples) {
+            SampleRecord record{};
+            record.name = strings.add(sample.name);
+            record.frames = sample.frames;
+            record.channels = sample.channels;
+            samples.push_back(record);
+        }
+
+        // Lay out sections; sample blocks are placed last so their offsets are known
+        std::vector<SectionEntry> table = {
+            {kStringsTag, 0, static_cast<uint32_t>(strings.data().size()), 0},
+            {kNodesTag, 0, static_cast<uint32_t>(nodes.size() * sizeof(NodeRecord)),
+             static_cast<uint32_t>(nodes.size())},
+            {kConnectionsTag, 0, static_cast<uint32_t>(connections.size() * sizeof(ConnectionRecord)),
+             static_cast<uint32_t>(connections.size())},
+            {kParametersTag, 0, static_cast<uint32_t>(parameters.size() * sizeof(ParameterRecord)),
+             static_cast<uint32_t>(parameters.size())},
+            {kSamplesTag, 0, static_cast<uint32_t>(samples.size() * sizeof(SampleRecord)),
+             static_cast<uint32_t>(samples.size())},
+            {kSampleDataTag, 0, 0, 0},
+        };
+
+        size_t cursor = alignUp(kHeaderSize + table.size() * sizeof(SectionEntry));
+        for (size_t i = 0; i + 1 < table.size(); ++i) {
+            table[i].offset = static_cast<uint32_t>(cursor);
+            cursor = alignUp(cursor + table[i].size);
+        }
+        SectionEntry& dataSection = table.back();
+        dataSection.offset = static_cast<uint32_t>(cursor);
+        for (size_t i = 0; i < samples.size(); ++i) {
+            samples[i].offset = static_cast<uint32_t>(cursor);
+            cursor = alignUp(cursor + size_t(samples[i].frames) * samples[i].channels * sizeof(float));
+        }
+        // Every offset and size below is bounded by the final cursor
+        if (cursor > UINT32_MAX) {
+            setError("Session exceeds the 4 GiB limit of the binary format");
+            return {};
+        }
+        dataSection.size = static_cast<uint32_t>(cursor - dataSection.offset);
+        dataSection.count = static_cast<uint32_t>(samples.size());
+
+        std::vector<uint8_t> buffer(cursor, 0);
+
+        FileHeader header{};
+        header.magic = MAGIC_NUMBER;
+        header.version = FORMAT_VERSION;
+        header.flags = 0;
+        header.fileSize = static_cast<uint32_t>(buffer.size());
+        header.sectionCount = static_cast<uint32_t>(table.size());
+        header.sectionTableOffset = kHeaderSize;
+        std::memcpy(buffer.data(), &header, sizeof(header));
+        std::memcpy(buffer.data() + kHeaderSize, table.data(), table.size() * sizeof(SectionEntry));
+
+        auto place = [&](const SectionEntry& section, const void* src) {
+            if (section.size > 0) std::memcpy(buffer.data() + section.offset, src, section.size);
+        };
+        place(table[0], strings.data().data());
+        place(table[1], nodes.data());
+        place(table[2], connections.data());
+        place(table[3], parameters.data());
+        place(table[4], samples.data());
+        for (size_t i = 0; i < samples.size(); ++i) {
+            const auto& sample = outgoingSamples[i];
+            const size_t bytes = size_t(sample.frames) * sample.channels * sizeof(float);
+            if (bytes > 0 && sample.data) {
+                std::memcpy(buffer.data() + samples[i].offset, sample.data, bytes);
+            }
+        }
+
+        return buffer;
+    }
 
-        // Version (2 bytes)
-        buffer.push_back((FORMAT_VERSION >> 0) & 0xFF);
-        buffer.push_back((FORMAT_VERSION >> 8) & 0xFF);
+    // Compression
+
+    void compressRange(const std::vector<uint8_t>& raw, size_t begin, size_t end, uint32_t tag,
+                       std::vector<ChunkEntry>& chunks, std::vector<uint8_t>& payload) const {
+        const auto choices = filtersFor(tag);
+        for (size_t offset = begin; offset < end; offset += COMPRESSION_CHUNK_SIZE) {
+            const size_t size = std::min<size_t>(COMPRESSION_CHUNK_SIZE, end - offset);
+            const uint8_t* data = raw.data() + offset;
+
+            ChunkEntry entry{};
+            entry.rawOffset = static_cast<uint32_t>(offset);
+            entry.rawSize = static_cast<uint32_t>(size);
+            entry.checksum = ChunkCodec::checksum(data, size);
+
+            std::vector<uint8_t> best;
+            for (const auto& choice : choices) {
+                auto encoded = ChunkCodec::compress(data, size, choice.filter, choice.strideWords);
+                if (best.empty() || encoded.size() < best.size()) {
+                    best.swap(encoded);
+                    entry.filter = static_cast<uint8_t>(choice.filter);
+                    entry.strideWords = choice.strideWords;
+                }
+            }
+
+            entry.offset = static_cast<uint32_t>(payload.size());
+            if (best.size() < size) {
+                entry.method = kMethodLz;
+                payload.insert(payload.end(), best.begin(), best.end());
+            } else {
+                entry.method = kMethodStored;
+                entry.filter = 0;
+                payload.insert(payload.end(), data, data + size);
+            }
+            entry.size = static_cast<uint32_t>(payload.size()) - entry.offset;
+            chunks.push_back(entry);
+        }
+    }
+
+    std::vector<uint8_t> compressImage(const std::vector<uint8_t>& raw) {
+        const auto header = readPod<FileHeader>(raw.data());
+        const size_t tableEnd = header.sectionTableOffset + header.sectionCount * sizeof(SectionEntry);
+
+        std::vector<ChunkEntry> chunks;
+        std::vector<uint8_t> payload;
+        compressRange(raw, 0, tableEnd, 0, chunks, payload);
+        for (uint32_t i = 0; i < header.sectionCount; ++i) {
+            const auto section = readPod<SectionEntry>(
+                raw.data() + header.sectionTableOffset + i * sizeof(SectionEntry));
+            compressRange(raw, section.offset, section.offset + size_t(section.size), section.tag,
+                          chunks, payload);
+        }
 
-        // Flags (2 bytes)
-        uint16_t flags = compressionEnabled ? 0x0001 : 0x0000;
-        buffer.push_back((flags >> 0) & 0xFF);
-        buffer.push_back((flags >> 8) & 0xFF);
+        // Padding between sections is zero and is not stored
+        const size_t payloadOffset = kHeaderSize + chunks.size() * sizeof(ChunkEntry);
+        for (auto& chunk : chunks) {
+            chunk.offset += static_cast<uint32_t>(payloadOffset);
+        }
+
+        if (payloadOffset + payload.size() > UINT32_MAX) {
+            setError("Compressed session exceeds the 4 GiB limit of the binary format");
+            return {};
+        }
+        std::vector<uint8_t> out(payloadOffset + payload.size());
+        FileHeader container{};
+        container.magic = MAGIC_NUMBER;
+        container.version = FORMAT_VERSION;
+        container.flags = kCompressedFlag;
+        container.fileSize = static_cast<uint32_t>(out.size());
+        container.sectionCount = static_cast<uint32_t>(chunks.size());
+        container.sectionTableOffset = kHeaderSize;
+        container.rawSize = static_cast<uint32_t>(raw.size());
+        std::memcpy(out.data(), &container, sizeof(container));
+        std::memcpy(out.data() + kHeaderSize, chunks.data(), chunks.size() * sizeof(ChunkEntry));
+        if (!payload.empty()) {
+            std::memcpy(out.data() + payloadOffset, payload.data(), payload.size());
+        }
+        return out;
     }
 
-    bool readHeader(const std::vector<uint8_t>& buffer) {
-        if (buffer.size() < 8) {
+    static bool decodeChunk(const uint8_t* data, const ChunkEntry& chunk, uint8_t* raw) {
+        const uint8_t* src = data + chunk.offset;
+        uint8_t* dst = raw + chunk.rawOffset;
+        if (chunk.method == kMethodStored) {
+            std::memcpy(dst, src, chunk.rawSize);
+        } else if (!ChunkCodec::decompress(src, chunk.size, dst, chunk.rawSize,
+                                           static_cast<ChunkCodec::Filter>(chunk.filter),
+                                           chunk.strideWords)) {
+            return false;
+        }
+        return ChunkCodec::checksum(dst, chunk.rawSize) == chunk.checksum;
+    }
+
+    bool decompressImage(const uint8_t* data, size_t size, std::vector<uint8_t>& raw) {
+        const auto header = readPod<FileHeader>(data);
+        if (header.fileSize != size) {
+            setError("File size mismatch");
+            return false;
+        }
+        if (header.sectionTableOffset < kHeaderSize || header.sectionTableOffset > size ||
+            size_t(header.sectionCount) * sizeof(ChunkEntry) > size - header.sectionTableOffset) {
+            setError("Chunk table out of bounds");
+            return false;
+        }
+
+        std::vector<ChunkEntry> chunks(header.sectionCount);
+        if (!chunks.empty()) {
+            std::memcpy(chunks.data(), data + header.sectionTableOffset,
+                        chunks.size() * sizeof(ChunkEntry));
+        }
+
+        // Chunks must lie inside both images and must not overlap, so they can decode concurrently
+        std::vector<const ChunkEntry*> order;
+        order.reserve(chunks.size());
+        for (const auto& chunk : chunks) {
+            const bool methodOk = chunk.method == kMethodLz ||
+                                  (chunk.method == kMethodStored && chunk.size == chunk.rawSize);
+            if (!methodOk || chunk.rawSize > COMPRESSION_CHUNK_SIZE ||
+                chunk.offset > size || chunk.size > size - chunk.offset ||
+                size_t(chunk.rawOffset) + chunk.rawSize > header.rawSize) {
+                setError("Invalid chunk entry");
+                return false;
+            }
+            order.push_back(&chunk);
+        }
+        std::sort(order.begin(), order.end(), [](const ChunkEntry* a, const ChunkEntry* b) {
+            return a->rawOffset < b->rawOffset;
+        });
+        for (size_t i = 1; i < order.size(); ++i) {
+            if (order[i - 1]->rawOffset + order[i - 1]->rawSize > order[i]->rawOffset) {
+                setError("Overlapping chunks");
+                return false;
+            }
+        }
+        const size_t coveredEnd = order.empty() ? 0 : order.back()->rawOffset + order.back()->rawSize;
+        if (header.rawSize < kHeaderSize || header.rawSize > coveredEnd + SECTION_ALIGNMENT) {
+            setError("Invalid uncompressed size");
+            return false;
+        }
+
+        raw.assign(header.rawSize, 0);
+
+        unsigned threads = decodeThreads ? decodeThreads : std::thread::hardware_concurrency();
+        threads = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>(chunks.size())));
+
+        std::atomic<size_t> next{0};
+        std::atomic<bool> ok{true};
+        auto worker = [&]() {
+            for (size_t i; ok.load(std::memory_order_relaxed) &&
+                           (i = next.fetch_add(1, std::memory_order_relaxed)) < chunks.size();) {
+                if (!decodeChunk(data, chunks[i], raw.data())) {
+                    ok.store(false, std::memory_order_relaxed);
+                }
+            }
+        };
+
+        std::vector<std::thread> pool;
+        for (unsigned t = 1; t < threads; ++t) {
+            pool.emplace_back(worker);
+        }
+        worker();
+        for (auto& thread : pool) {
+            thread.join();
+        }
+
+        if (!ok.load()) {
+            setError("Corrupt compressed chunk");
+            return false;
+        }
+        return true;
+    }
+
+    // Validation
+
+    bool readHeader(const uint8_t* data, size_t size, uint16_t& version, uint16_t& flags) {
+        if (size < kLegacyHeaderSize) {
             setError("Buffer too small for header");
             return false;
         }
 
-        uint32_t magic = buffer[0] | (buffer[1] << 8) | (buffer[2] << 16) | (buffer[3] << 24);
+        uint32_t magic = readPod<uint32_t>(data);
         if (magic != MAGIC_NUMBER) {
             setError("Invalid magic number");
             return false;
         }
 
-        uint16_t version = buffer[4] | (buffer[5] << 8);
+        version = readPod<uint16_t>(data + 4);
         if (version > FORMAT_VERSION) {
             setError("Unsupported format version");
             return false;
         }
+        flags = readPod<uint16_t>(data + 6);
+
+        return true;
+    }
 
+    bool sectionInBounds(const SectionEntry& section, size_t recordSize, size_t size) {
+        if (section.offset % SECTION_ALIGNMENT != 0 ||
+            section.offset > size || section.size > size - section.offset) {
+            setError("Section out of bounds");
+            return false;
+        }
+        if (recordSize > 0 && size_t(section.count) * recordSize != section.size) {
+            setError("Section size does not match record count");
+            return false;
+        }
+        return true;
+    }
+
+    bool validString(const View& view, uint32_t offset) const {
+        if (offset >= view.strings.size) return false;
+        const auto* begin = view.base + view.strings.offset + offset;
+        return std::memchr(begin, '\0', view.strings.size - offset) != nullptr;
+    }
+
+    const char* string(const View& view, uint32_t offset) const {
+        return reinterpret_cast<const char*>(view.base + view.strings.offset + offset);
+    }
+
+    template<typename Record>
+    Record record(const View& view, const SectionEntry& section, size_t index) const {
+        return readPod<Record>(view.base + section.offset + index * sizeof(Record));
+    }
+
+    bool validate(const uint8_t* data, size_t size, View& view) {
+        if (size < kHeaderSize) {
+            setError("Buffer too small for header");
+            return false;
+        }
+
+        const auto header = readPod<FileHeader>(data);
+        if (header.fileSize != size) {
+            setError("File size mismatch");
+            return false;
+        }
+        if (header.sectionTableOffset < kHeaderSize || header.sectionTableOffset > size ||
+            size_t(header.sectionCount) * sizeof(SectionEntry) > size - header.sectionTableOffset) {
+            setError("Section table out of bounds");
+            return false;
+        }
+
+        view.base = data;
+        view.size = size;
+
+        // Unknown sections are ignored so newer writers stay readable
+        for (uint32_t i = 0; i < header.sectionCount; ++i) {
+            const auto entry = readPod<SectionEntry>(
+                data + header.sectionTableOffset + i * sizeof(SectionEntry));
+            size_t recordSize = 0;
+            SectionEntry* target = nullptr;
+            switch (entry.tag) {
+                case kStringsTag: target = &view.strings; break;
+                case kNodesTag: target = &view.nodes; recordSize = sizeof(NodeRecord); break;
+                case kConnectionsTag: target = &view.connections; recordSize = sizeof(ConnectionRecord); break;
+                case kParametersTag: target = &view.parameters; recordSize = sizeof(ParameterRecord); break;
+                case kSamplesTag: target = &view.samples; recordSize = sizeof(SampleRecord); break;
+                default: break;
+            }
+            if (!sectionInBounds(entry, recordSize, size)) return false;
+            if (target) *target = entry;
+        }
+
+        for (uint32_t i = 0; i < view.nodes.count; ++i) {
+            const auto node = record<NodeRecord>(view, view.nodes, i);
+            if (!validString(view, node.id) || !validString(view, node.type)) {
+                setError("Invalid string reference in node record");
+                return false;
+            }
+        }
+        for (uint32_t i = 0; i < view.connections.count; ++i) {
+            const auto c = record<ConnectionRecord>(view, view.connections, i);
+            if (!validString(view, c.source) || !validString(view, c.dest)) {
+                setError("Invalid string reference in connection record");
+                return false;
+            }
+        }
+        for (uint32_t i = 0; i < view.parameters.count; ++i) {
+            if (!validString(view, record<ParameterRecord>(view, view.parameters, i).path)) {
+                setError("Invalid string reference in parameter record");
+                return false;
+            }
+        }
+        for (uint32_t i = 0; i < view.samples.count; ++i) {
+            const auto sample = record<SampleRecord>(view, view.samples, i);
+            const uint64_t bytes = uint64_t(sample.frames) * sample.channels * sizeof(float);
+            if (!validString(view, sample.name) || sample.offset % SECTION_ALIGNMENT != 0 ||
+                sample.offset > size || bytes > size - sample.offset) {
+                setError("Invalid sample record");
+                return false;
+            }
+            if (reinterpret_cast<uintptr_t>(data + sample.offset) % alignof(float) != 0) {
+                setError("Sample data is misaligned in memory");
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Applying
+
+    IParameter* findParameter(const char* path) const {
+        ParameterGroup* group = parameterGroup;
+        const char* segment = path;
+        for (const char* slash; group && (slash = std::strchr(segment, '/')); segment = slash + 1) {
+            group = group->getGroup(std::string(segment, slash));
+        }
+        return group ? group->getParameter(segment) : nullptr;
+    }
+
+    void apply(const View& view) {
+        if (graph) {
+            for (uint32_t i = 0; i < view.nodes.count; ++i) {
+                const auto node = record<NodeRecord>(view, view.nodes, i);
+                if (auto target = graph->getNode(string(view, node.id))) {
+                    target->setBypassed((node.flags & kNodeBypassed) != 0);
+                }
+            }
+            for (uint32_t i = 0; i < view.connections.count; ++i) {
+                const auto c = record<ConnectionRecord>(view, view.connections, i);
+                graph->connect(string(view, c.source), c.sourceChannel,
+                               string(view, c.dest), c.destChannel);
+            }
+        }
+
+        if (parameterGroup) {
+            for (uint32_t i = 0; i < view.parameters.count; ++i) {
+                const auto p = record<ParameterRecord>(view, view.parameters, i);
+                IParameter* param = findParameter(string(view, p.path));
+                if (!param) continue;
+
+                if (auto* f = dynamic_cast<FloatParameter*>(param)) {
+                    float value;
+                    std::memcpy(&value, &p.value, sizeof(value));
+                    f->setValue(value);
+                } else if (auto* n = dynamic_cast<IntParameter*>(param)) {
+                    int32_t value;
+                    std::memcpy(&value, &p.value, sizeof(value));
+                    n->setValue(value);
+                } else if (auto* b = dynamic_cast<BoolParameter*>(param)) {
+                    b->setValue(p.value != 0);
+                } else if (auto* e = dynamic_cast<EnumParameter*>(param)) {
+                    e->setSelectedIndex(p.value);
+                }
+            }
+        }
+
+        for (uint32_t i = 0; i < view.samples.count; ++i) {
+            const auto s = record<SampleRecord>(view, view.samples, i);
+            SampleData sample;
+            sample.data = reinterpret_cast<const float*>(view.base + s.offset);
+            sample.frames = s.frames;
+            sample.channels = s.channels;
+            loadedSamples[string(view, s.name)] = sample;
+        }
+    }
+
+    // Validates and applies bytes that must stay alive while samples are in use
+    bool load(const uint8_t* data, size_t size) {
+        uint16_t version = 0;
+        uint16_t flags = 0;
+        if (!readHeader(data, size, version, flags)) {
+            return false;
+        }
+
+        if (version >= 2 && (flags & kCompressedFlag)) {
+            if (size < kHeaderSize) {
+                setError("Buffer too small for header");
+                return false;
+            }
+            std::vector<uint8_t> decoded;
+            if (!decompressImage(data, size, decoded)) {
+                return false;
+            }
+            // The source may be ownedData or the mapping; neither is needed any more
+            ownedData.swap(decoded);
+            mappedFile.close();
+            data = ownedData.data();
+            size = ownedData.size();
+
+            if (!readHeader(data, size, version, flags) || (flags & kCompressedFlag)) {
+                setError(lastError.empty() ? "Nested compression" : lastError);
+                return false;
+            }
+        }
+
+        // Version 1 files carried no state beyond the header
+        if (version >= 2) {
+            View view;
+            if (!validate(data, size, view)) {
+                return false;
+            }
+            apply(view);
+        }
+
+        valid = true;
+        return true;
+    }
+
+    // Like load(), but only stores parameter values into state
+    bool readState(const uint8_t* data, size_t size,
+                   const ParameterStateLayout& layout, StateVector& state) {
+        uint16_t version = 0;
+        uint16_t flags = 0;
+        if (!readHeader(data, size, version, flags)) {
+            return false;
+        }
+
+        std::vector<uint8_t> decoded;
+        if (version >= 2 && (flags & kCompressedFlag)) {
+            if (size < kHeaderSize || !decompressImage(data, size, decoded)) {
+                if (lastError.empty()) setError("Buffer too small for header");
+                return false;
+            }
+            data = decoded.data();
+            size = decoded.size();
+            if (!readHeader(data, size, version, flags) || (flags & kCompressedFlag)) {
+                setError(lastError.empty() ? "Nested compression" : lastError);
+                return false;
+            }
+        }
+
+        if (version < 2) {
+            return true;
+        }
+
+        View view;
+        if (!validate(data, size, view)) {
+            return false;
+        }
+
+        for (uint32_t i = 0; i < view.parameters.count; ++i) {
+            const auto p = record<ParameterRecord>(view, view.parameters, i);
+            const size_t index = layout.indexOf(string(view, p.path));
+            if (index == ParameterStateLayout::npos) continue;
+
+            switch (static_cast<ParameterType>(p.type)) {
+                case ParameterType::Float: {
+                    float value;
+                    std::memcpy(&value, &p.value, sizeof(value));
+                    state[index] = value;
+                    break;
+                }
+                case ParameterType::Int: {
+                    int32_t value;
+                    std::memcpy(&value, &p.value, sizeof(value));
+                    state[index] = static_cast<float>(value);
+                    break;
+                }
+                case ParameterType::Bool:
+                    state[index] = p.value != 0 ? 1.0f : 0.0f;
+                    break;
+                case ParameterType::Enum:
+                    state[index] = static_cast<float>(p.value);
+                    break;
+                default:
+                    break;
+            }
+        }
         return true;
     }
 };
@@ -69,26 +818,12 @@ std::string BinarySerializer::serialize() const {
 }
 
 std::vector<uint8_t> BinarySerializer::serializeBinary() const {
-    std::vector<uint8_t> buffer;
-    buffer.reserve(1024);
-
-    pImpl->writeHeader(buffer);
-
-    // Placeholder: node count (4 bytes)
-    uint32_t nodeCount = 0;
-    buffer.push_back((nodeCount >> 0) & 0xFF);
-    buffer.push_back((nodeCount >> 8) & 0xFF);
-    buffer.push_back((nodeCount >> 16) & 0xFF);
-    buffer.push_back((nodeCount >> 24) & 0xFF);
-
-    // Placeholder: connection count (4 bytes)
-    uint32_t connectionCount = 0;
-    buffer.push_back((connectionCount >> 0) & 0xFF);
-    buffer.push_back((connectionCount >> 8) & 0xFF);
-    buffer.push_back((connectionCount >> 16) & 0xFF);
-    buffer.push_back((connectionCount >> 24) & 0xFF);
-
-    return buffer;
+    pImpl->clearError();
+    auto image = pImpl->write();
+    if (image.empty() || !pImpl->compressionEnabled) {
+        return image;
+    }
+    return pImpl->compressImage(image);
 }
 
 bool BinarySerializer::deserialize(const std::string& data) {
@@ -97,18 +832,40 @@ bool BinarySerializer::deserialize(const std::string& data) {
 
 bool BinarySerializer::deserializeBinary(const std::vector<uint8_t>& data) {
     pImpl->clearError();
-
-    if (!pImpl->readHeader(data)) {
+    pImpl->releaseLoaded();
+
+    // The caller's vector may not outlive us, so sample data needs an owned
+    // copy; compressed input is decoded into one instead
+    const bool compressed = data.size() >= kLegacyHeaderSize &&
+                            (readPod<uint16_t>(data.data() + 6) & kCompressedFlag);
+    const uint8_t* source = data.data();
+    if (!compressed) {
+        pImpl->ownedData = data;
+        source = pImpl->ownedData.data();
+    }
+    if (!pImpl->load(source, data.size())) {
+        pImpl->releaseLoaded();
         return false;
     }
+    return true;
+}
 
-    pImpl->cachedData = data;
-    pImpl->valid = true;
+bool BinarySerializer::deserializeInPlace(const uint8_t* data, size_t size) {
+    pImpl->clearError();
+    pImpl->releaseLoaded();
+
+    if (!pImpl->load(data, size)) {
+        pImpl->releaseLoaded();
+        return false;
+    }
     return true;
 }
 
 bool BinarySerializer::saveToFile(const std::string& filepath) const {
-    pImpl->clearError();
+    auto data = serializeBinary();
+    if (data.empty()) {
+        return false;
+    }
 
     std::ofstream file(filepath, std::ios::binary);
     if (!file.is_open()) {
@@ -116,7 +873,6 @@ bool BinarySerializer::saveToFile(const std::string& filepath) const {
         return false;
     }
 
-    auto data = serializeBinary();
     file.write(reinterpret_cast<const char*>(data.data()), data.size());
     file.close();
 
@@ -130,23 +886,37 @@ bool BinarySerializer::saveToFile(const std::string& filepath) const {
 
 bool BinarySerializer::loadFromFile(const std::string& filepath) {
     pImpl->clearError();
+    pImpl->releaseLoaded();
 
-    std::ifstream file(filepath, std::ios::binary | std::ios::ate);
-    if (!file.is_open()) {
+    if (!pImpl->mappedFile.open(filepath)) {
         pImpl->setError("Failed to open file for reading: " + filepath);
         return false;
     }
 
-    std::streamsize size = file.tellg();
-    file.seekg(0, std::ios::beg);
+    if (!pImpl->load(pImpl->mappedFile.data(), pImpl->mappedFile.size())) {
+        pImpl->releaseLoaded();
+        return false;
+    }
+    return true;
+}
+
+bool BinarySerializer::readParameterState(const std::string& filepath,
+                                          const ParameterStateLayout& layout,
+                                          StateVector& state) const {
+    pImpl->clearError();
 
-    std::vector<uint8_t> buffer(size);
-    if (!file.read(reinterpret_cast<char*>(buffer.data()), size)) {
-        pImpl->setError("Failed to read file: " + filepath);
+    if (!layout.getRoot() || state.size() != layout.size()) {
+        pImpl->setError("State does not match the parameter layout");
         return false;
     }
 
-    return deserializeBinary(buffer);
+    // A mapping of its own leaves the loaded session and its samples alone
+    MappedFile file;
+    if (!file.open(filepath)) {
+        pImpl->setError("Failed to open file for reading: " + filepath);
+        return false;
+    }
+    return pImpl->readState(file.data(), file.size(), layout, state);
 }
 
 bool BinarySerializer::isValid() const {
@@ -173,6 +943,36 @@ bool BinarySerializer::isCompressionEnabled() const {
     return pImpl->compressionEnabled;
 }
 
+void BinarySerializer::setDecodeThreads(unsigned threads) {
+    pImpl->decodeThreads = threads;
+}
+
+unsigned BinarySerializer::getDecodeThreads() const {
+    return pImpl->decodeThreads;
+}
+
+void BinarySerializer::addSampleData(const std::string& name, const float* data,
+                                     uint32_t frames, uint32_t channels) {
+    pImpl->outgoingSamples.push_back({name, data, frames, channels});
+}
+
+void BinarySerializer::clearSampleData() {
+    pImpl->outgoingSamples.clear();
+}
+
+BinarySerializer::SampleData BinarySerializer::getSampleData(const std::string& name) const {
+    auto it = pImpl->loadedSamples.find(name);
+    return it != pImpl->loadedSamples.end() ? it->second : SampleData{};
+}
+
+size_t BinarySerializer::getSampleDataCount() const {
+    return pImpl->loadedSamples.size();
+}
+
+bool BinarySerializer::isMemoryMapped() const {
+    return pImpl->valid && pImpl->mappedFile.isMapped();
+}
+
 void BinarySerializer::setGraph(AudioGraph* graph) {
     pImpl->graph = graph;
 }
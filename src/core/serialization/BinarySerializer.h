@@ -15,12 +15,49 @@ class ParameterGroup;
  *
  * Serializes audio graph state to compact binary format.
  * Optimized for fast loading and small file sizes.
+ *
+ * Version 2 files are a header, a section table and 16-byte aligned
+ * sections of fixed-size little-endian records that refer to each other
+ * by offset (nodes, connections, parameters, a shared string table and
+ * sample data). Nothing needs to be decoded into an intermediate form:
+ * loadFromFile() memory-maps the file, validates every offset once and
+ * applies the records straight from the mapping. Sample data such as
+ * impulse responses and wavetables stays in the mapping and is handed
+ * out by pointer, so it is never copied.
+ *
+ * With compression enabled the same image is split into chunks, each
+ * filtered and compressed with ChunkCodec (the filter that compresses
+ * best is picked per chunk). Chunks decode independently and are spread
+ * over several threads on load. Compressed files trade the zero-copy
+ * mapping for size, so they suit presets and autosaves rather than large
+ * sessions.
+ *
+ * Offsets are 32-bit, so a file is limited to 4 GiB. Serializing a larger
+ * session fails: serializeBinary() returns an empty buffer and
+ * getLastError() says why.
  */
 class BinarySerializer : public ISerializer {
 public:
     // Magic number for file format identification
     static constexpr uint32_t MAGIC_NUMBER = 0x4E415042; // "NAPB"
-    static constexpr uint16_t FORMAT_VERSION = 1;
+    static constexpr uint16_t FORMAT_VERSION = 2;
+
+    // Alignment of every section and sample block in the file
+    static constexpr uint32_t SECTION_ALIGNMENT = 16;
+
+    // Largest uncompressed chunk; a multiple of every record size
+    static constexpr uint32_t COMPRESSION_CHUNK_SIZE = 48 * 1024;
+
+    /**
+     * @brief Interleaved float sample data stored alongside the session
+     */
+    struct SampleData {
+        const float* data = nullptr;
+        uint32_t frames = 0;
+        uint32_t channels = 0;
+
+        bool empty() const { return data == nullptr; }
+    };
 
     BinarySerializer();
     ~BinarySerializer() override;
@@ -38,14 +75,38 @@ public:
     bool deserializeBinary(const std::vector<uint8_t>& data) override;
     bool saveToFile(const std::string& filepath) const override;
     bool loadFromFile(const std::string& filepath) override;
+    bool readParameterState(const std::string& filepath, const ParameterStateLayout& layout,
+                            StateVector& state) const override;
     bool isValid() const override;
     std::string getLastError() const override;
     std::string getFormatName() const override;
     std::string getFileExtension() const override;
 
+    /**
+     * @brief Load from memory the caller keeps alive, without copying it.
+     *
+     * Sample data returned by getSampleData() points into this memory.
+     * @param data Serialized session, at least 4-byte aligned
+     * @param size Size in bytes
+     * @return True on success
+     */
+    bool deserializeInPlace(const uint8_t* data, size_t size);
+
     // Binary-specific options
     void setCompression(bool enabled);
     bool isCompressionEnabled() const;
+    void setDecodeThreads(unsigned threads);  // 0 uses the hardware concurrency
+    unsigned getDecodeThreads() const;
+
+    // Sample data to write; referenced, not copied, so it must outlive serialization
+    void addSampleData(const std::string& name, const float* data,
+                       uint32_t frames, uint32_t channels);
+    void clearSampleData();
+
+    // Sample data of the last loaded session; valid until the next load
+    SampleData getSampleData(const std::string& name) const;
+    size_t getSampleDataCount() const;
+    bool isMemoryMapped() const;
 
     // Graph binding
     void setGraph(AudioGraph* graph);
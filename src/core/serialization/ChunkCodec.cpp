@@ -0,0 +1,237 @@
+#include "core/serialization/ChunkCodec.h"
+#include <cstring>
+
+namespace nap {
+
+namespace {
+
+constexpr size_t kMinMatch = 4;
+constexpr size_t kMaxOffset = 65535;
+constexpr int kHashBits = 14;
+constexpr uint32_t kNoPosition = 0xFFFFFFFFu;
+
+uint32_t read32(const uint8_t* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+void write32(uint8_t* p, uint32_t value) {
+    std::memcpy(p, &value, sizeof(value));
+}
+
+uint32_t hashOf(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - kHashBits);
+}
+
+void writeLength(std::vector<uint8_t>& out, size_t length) {
+    while (length >= 255) {
+        out.push_back(255);
+        length -= 255;
+    }
+    out.push_back(static_cast<uint8_t>(length));
+}
+
+bool readLength(const uint8_t*& src, const uint8_t* end, size_t& length) {
+    for (;;) {
+        if (src == end) return false;
+        const uint8_t byte = *src++;
+        length += byte;
+        if (byte != 255) return true;
+    }
+}
+
+// A run of literals followed by a back-reference; matchLength 0 ends the stream
+void writeSequence(std::vector<uint8_t>& out, const uint8_t* literals, size_t literalLength,
+                   size_t offset, size_t matchLength) {
+    const size_t matchCode = matchLength ? matchLength - kMinMatch : 0;
+    const auto token = static_cast<uint8_t>(((literalLength < 15 ? literalLength : 15) << 4) |
+                                            (matchCode < 15 ? matchCode : 15));
+    out.push_back(token);
+    if (literalLength >= 15) writeLength(out, literalLength - 15);
+    out.insert(out.end(), literals, literals + literalLength);
+
+    if (matchLength) {
+        out.push_back(static_cast<uint8_t>(offset & 0xFF));
+        out.push_back(static_cast<uint8_t>(offset >> 8));
+        if (matchCode >= 15) writeLength(out, matchCode - 15);
+    }
+}
+
+void lzCompress(const uint8_t* src, size_t size, std::vector<uint8_t>& out) {
+    std::vector<uint32_t> table(size_t(1) << kHashBits, kNoPosition);
+    size_t anchor = 0;
+    size_t i = 0;
+
+    while (i + kMinMatch <= size) {
+        const uint32_t sequence = read32(src + i);
+        const uint32_t h = hashOf(sequence);
+        const uint32_t candidate = table[h];
+        table[h] = static_cast<uint32_t>(i);
+
+        if (candidate == kNoPosition || i - candidate > kMaxOffset ||
+            read32(src + candidate) != sequence) {
+            ++i;
+            continue;
+        }
+
+        size_t length = kMinMatch;
+        while (i + length < size && src[candidate + length] == src[i + length]) {
+            ++length;
+        }
+
+        writeSequence(out, src + anchor, i - anchor, i - candidate, length);
+
+        // Index the matched positions so later data can refer into them
+        const size_t matchEnd = i + length;
+        for (size_t j = i + 1; j + kMinMatch <= size && j < matchEnd; ++j) {
+            table[hashOf(read32(src + j))] = static_cast<uint32_t>(j);
+        }
+        i = matchEnd;
+        anchor = i;
+    }
+
+    writeSequence(out, src + anchor, size - anchor, 0, 0);
+}
+
+bool lzDecompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize) {
+    const uint8_t* end = src + srcSize;
+    uint8_t* d = dst;
+    uint8_t* const dEnd = dst + dstSize;
+
+    while (src < end) {
+        const uint8_t token = *src++;
+
+        size_t literalLength = token >> 4;
+        if (literalLength == 15 && !readLength(src, end, literalLength)) return false;
+        if (literalLength > static_cast<size_t>(end - src) ||
+            literalLength > static_cast<size_t>(dEnd - d)) {
+            return false;
+        }
+        std::memcpy(d, src, literalLength);
+        src += literalLength;
+        d += literalLength;
+
+        if (src == end) break;  // Final sequence carries no match
+
+        if (end - src < 2) return false;
+        const size_t offset = src[0] | (size_t(src[1]) << 8);
+        src += 2;
+        if (offset == 0 || offset > static_cast<size_t>(d - dst)) return false;
+
+        size_t matchLength = token & 0x0F;
+        if (matchLength == 15 && !readLength(src, end, matchLength)) return false;
+        matchLength += kMinMatch;
+        if (matchLength > static_cast<size_t>(dEnd - d)) return false;
+
+        const uint8_t* from = d - offset;
+        if (offset >= matchLength) {
+            std::memcpy(d, from, matchLength);
+            d += matchLength;
+        } else {
+            // Overlapping copy repeats the last `offset` bytes
+            for (size_t k = 0; k < matchLength; ++k) {
+                *d++ = from[k];
+            }
+        }
+    }
+
+    return d == dEnd;
+}
+
+template<typename Op>
+void filterForward(uint8_t* data, size_t words, uint32_t stride, Op op) {
+    for (size_t i = words; i-- > stride;) {
+        write32(data + i * 4, op(read32(data + i * 4), read32(data + (i - stride) * 4)));
+    }
+}
+
+template<typename Op>
+void filterInverse(uint8_t* data, size_t words, uint32_t stride, Op op) {
+    for (size_t i = stride; i < words; ++i) {
+        write32(data + i * 4, op(read32(data + i * 4), read32(data + (i - stride) * 4)));
+    }
+}
+
+// Groups byte k of every word together; bytes past the last whole word stay in place
+void shuffle(const uint8_t* src, uint8_t* dst, size_t size) {
+    const size_t words = size / 4;
+    for (size_t i = 0; i < words; ++i) {
+        for (size_t k = 0; k < 4; ++k) {
+            dst[k * words + i] = src[i * 4 + k];
+        }
+    }
+    std::memcpy(dst + words * 4, src + words * 4, size - words * 4);
+}
+
+void unshuffle(const uint8_t* src, uint8_t* dst, size_t size) {
+    const size_t words = size / 4;
+    for (size_t i = 0; i < words; ++i) {
+        for (size_t k = 0; k < 4; ++k) {
+            dst[i * 4 + k] = src[k * words + i];
+        }
+    }
+    std::memcpy(dst + words * 4, src + words * 4, size - words * 4);
+}
+
+} // namespace
+
+std::vector<uint8_t> ChunkCodec::compress(const uint8_t* data, size_t size,
+                                          Filter filter, uint32_t strideWords) {
+    std::vector<uint8_t> out;
+    out.reserve(size / 2 + 16);
+
+    if (filter == Filter::None || size < 4) {
+        lzCompress(data, size, out);
+        return out;
+    }
+
+    const size_t words = size / 4;
+    const uint32_t stride = strideWords ? strideWords : 1;
+    std::vector<uint8_t> filtered(data, data + size);
+    if (filter == Filter::Delta32) {
+        filterForward(filtered.data(), words, stride, [](uint32_t a, uint32_t b) { return a - b; });
+    } else {
+        filterForward(filtered.data(), words, stride, [](uint32_t a, uint32_t b) { return a ^ b; });
+    }
+
+    std::vector<uint8_t> planes(size);
+    shuffle(filtered.data(), planes.data(), size);
+    lzCompress(planes.data(), size, out);
+    return out;
+}
+
+bool ChunkCodec::decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize,
+                            Filter filter, uint32_t strideWords) {
+    if (filter == Filter::None || dstSize < 4) {
+        return lzDecompress(src, srcSize, dst, dstSize);
+    }
+    if (filter != Filter::Delta32 && filter != Filter::Xor32) {
+        return false;
+    }
+
+    std::vector<uint8_t> planes(dstSize);
+    if (!lzDecompress(src, srcSize, planes.data(), dstSize)) {
+        return false;
+    }
+    unshuffle(planes.data(), dst, dstSize);
+
+    const size_t words = dstSize / 4;
+    const uint32_t stride = strideWords ? strideWords : 1;
+    if (filter == Filter::Delta32) {
+        filterInverse(dst, words, stride, [](uint32_t a, uint32_t b) { return a + b; });
+    } else {
+        filterInverse(dst, words, stride, [](uint32_t a, uint32_t b) { return a ^ b; });
+    }
+    return true;
+}
+
+uint32_t ChunkCodec::checksum(const uint8_t* data, size_t size) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+} // namespace nap
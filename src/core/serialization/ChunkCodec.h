@@ -0,0 +1,61 @@
+#ifndef NAP_CHUNK_CODEC_H
+#define NAP_CHUNK_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace nap {
+
+/**
+ * @brief Dependency-free compressor for serialized session chunks
+ *
+ * A chunk is first run through an optional word filter, then its bytes
+ * are regrouped into planes (all first bytes of each 32-bit word, then all
+ * second bytes, ...), and the result is compressed with a byte-oriented
+ * LZ77 coder (literal runs and back-references within a 64 KB window).
+ *
+ * The filters turn slowly changing data into long runs of equal bytes:
+ * Delta32 subtracts the word one record earlier, which suits integer
+ * fields such as counters and string offsets; Xor32 XORs float bit
+ * patterns with their predecessor, which zeroes the sign, exponent and
+ * high mantissa bits of smooth sample data and parameter snapshots.
+ *
+ * Every chunk decodes on its own, so callers can decode chunks in
+ * parallel. Decoding validates all lengths and offsets and fails rather
+ * than reading or writing out of bounds on corrupt input.
+ */
+class ChunkCodec {
+public:
+    enum class Filter : uint8_t {
+        None = 0,
+        Delta32 = 1,
+        Xor32 = 2
+    };
+
+    /**
+     * @brief Compress one chunk.
+     * @param data Input bytes
+     * @param size Input size
+     * @param filter Word filter applied before compression
+     * @param strideWords Distance in 32-bit words to the value the filter
+     *                    compares against (the record size for record arrays)
+     * @return Compressed bytes
+     */
+    static std::vector<uint8_t> compress(const uint8_t* data, size_t size,
+                                         Filter filter = Filter::None, uint32_t strideWords = 1);
+
+    /**
+     * @brief Decompress one chunk into a buffer of the exact original size.
+     * @return False if the input is corrupt or does not fill dst exactly
+     */
+    static bool decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize,
+                           Filter filter = Filter::None, uint32_t strideWords = 1);
+
+    // 32-bit FNV-1a, used to verify decoded chunks
+    static uint32_t checksum(const uint8_t* data, size_t size);
+};
+
+} // namespace nap
+
+#endif // NAP_CHUNK_CODEC_H
@@ -7,6 +7,9 @@
 
 namespace nap {
 
+class ParameterStateLayout;
+class StateVector;
+
 /**
  * @brief Interface for serialization/deserialization of audio graphs
  *
@@ -29,6 +32,13 @@ public:
     virtual bool saveToFile(const std::string& filepath) const = 0;
     virtual bool loadFromFile(const std::string& filepath) = 0;
 
+    // Reads the stored parameter values into state (laid out by layout)
+    // without applying anything, so it can run on a loader thread. Slots
+    // the file does not mention keep their value.
+    virtual bool readParameterState(const std::string& filepath,
+                                    const ParameterStateLayout& layout,
+                                    StateVector& state) const = 0;
+
     // Validation
     virtual bool isValid() const = 0;
     virtual std::string getLastError() const = 0;
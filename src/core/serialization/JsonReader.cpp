@@ -0,0 +1,374 @@
+#include "core/serialization/JsonReader.h"
+#include <charconv>
+#include <istream>
+#include <vector>
+
+namespace nap {
+
+namespace {
+
+bool isDigit(int c) { return c >= '0' && c <= '9'; }
+
+// Validates the JSON number grammar, which is stricter than from_chars
+bool isValidNumber(const char* s, size_t length) {
+    size_t i = 0;
+    if (i < length && s[i] == '-') ++i;
+    if (i == length) return false;
+    if (s[i] == '0') {
+        ++i;
+    } else if (isDigit(s[i])) {
+        while (i < length && isDigit(s[i])) ++i;
+    } else {
+        return false;
+    }
+    if (i < length && s[i] == '.') {
+        ++i;
+        if (i == length || !isDigit(s[i])) return false;
+        while (i < length && isDigit(s[i])) ++i;
+    }
+    if (i < length && (s[i] == 'e' || s[i] == 'E')) {
+        ++i;
+        if (i < length && (s[i] == '+' || s[i] == '-')) ++i;
+        if (i == length || !isDigit(s[i])) return false;
+        while (i < length && isDigit(s[i])) ++i;
+    }
+    return i == length;
+}
+
+void appendUtf8(std::string& out, uint32_t cp) {
+    if (cp < 0x80) {
+        out.push_back(static_cast<char>(cp));
+    } else if (cp < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else if (cp < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    }
+}
+
+} // namespace
+
+class JsonReader::Impl {
+public:
+    enum class State {
+        Value,        // Any value
+        ArrayFirst,   // Value or ']' right after '['
+        ObjectFirst,  // Key or '}' right after '{'
+        ObjectKey,    // Key after ','
+        AfterValue    // ',' or closing bracket, or end of input at top level
+    };
+
+    size_t maxDepth = kDefaultMaxDepth;
+    std::string lastError;
+    bool aborted = false;
+
+    // Input window; stream input refills it chunk by chunk
+    const char* pos = nullptr;
+    const char* end = nullptr;
+    const char* windowStart = nullptr;
+    uint64_t consumedBefore = 0;
+    std::istream* stream = nullptr;
+    std::vector<char> chunk;
+
+    // Reused across parses so steady-state parsing does not allocate
+    std::string scratch;
+    std::vector<char> stack;
+
+    void begin(const char* data, size_t size, std::istream* input) {
+        lastError.clear();
+        aborted = false;
+        stream = input;
+        pos = windowStart = data;
+        end = data + size;
+        consumedBefore = 0;
+        stack.clear();
+    }
+
+    uint64_t offset() const {
+        return consumedBefore + static_cast<uint64_t>(pos - windowStart);
+    }
+
+    bool refill() {
+        if (!stream) return false;
+        consumedBefore += static_cast<uint64_t>(end - windowStart);
+        stream->read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        const auto count = static_cast<size_t>(stream->gcount());
+        pos = windowStart = chunk.data();
+        end = pos + count;
+        return count > 0;
+    }
+
+    int peek() {
+        if (pos == end && !refill()) return -1;
+        return static_cast<unsigned char>(*pos);
+    }
+
+    int get() {
+        const int c = peek();
+        if (c >= 0) ++pos;
+        return c;
+    }
+
+    int nextNonWhitespace() {
+        for (;;) {
+            while (pos < end) {
+                const char c = *pos++;
+                if (c != ' ' && c != '\n' && c != '\r' && c != '\t') {
+                    return static_cast<unsigned char>(c);
+                }
+            }
+            if (!refill()) return -1;
+        }
+    }
+
+    bool fail(const std::string& message) {
+        lastError = message + " at offset " + std::to_string(offset());
+        return false;
+    }
+
+    bool check(bool handlerResult) {
+        if (handlerResult) return true;
+        aborted = true;
+        return fail("Aborted by handler");
+    }
+
+    bool readHex4(uint32_t& value) {
+        value = 0;
+        for (int i = 0; i < 4; ++i) {
+            const int c = get();
+            value <<= 4;
+            if (isDigit(c)) value |= static_cast<uint32_t>(c - '0');
+            else if (c >= 'a' && c <= 'f') value |= static_cast<uint32_t>(c - 'a' + 10);
+            else if (c >= 'A' && c <= 'F') value |= static_cast<uint32_t>(c - 'A' + 10);
+            else return fail("Invalid \\u escape");
+        }
+        return true;
+    }
+
+    bool readEscape() {
+        const int c = get();
+        switch (c) {
+            case '"': scratch.push_back('"'); return true;
+            case '\\': scratch.push_back('\\'); return true;
+            case '/': scratch.push_back('/'); return true;
+            case 'b': scratch.push_back('\b'); return true;
+            case 'f': scratch.push_back('\f'); return true;
+            case 'n': scratch.push_back('\n'); return true;
+            case 'r': scratch.push_back('\r'); return true;
+            case 't': scratch.push_back('\t'); return true;
+            case 'u': break;
+            case -1: return fail("Unterminated string");
+            default: return fail("Invalid escape sequence");
+        }
+
+        uint32_t cp;
+        if (!readHex4(cp)) return false;
+        if (cp >= 0xD800 && cp <= 0xDBFF) {
+            uint32_t low;
+            if (get() != '\\' || get() != 'u' || !readHex4(low) || low < 0xDC00 || low > 0xDFFF) {
+                return fail("Invalid surrogate pair");
+            }
+            cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+        } else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+            return fail("Invalid surrogate pair");
+        }
+        appendUtf8(scratch, cp);
+        return true;
+    }
+
+    // Reads a string body into scratch; the opening quote is already consumed
+    bool readString() {
+        scratch.clear();
+        for (;;) {
+            const char* start = pos;
+            while (pos < end) {
+                const auto c = static_cast<unsigned char>(*pos);
+                if (c == '"' || c == '\\' || c < 0x20) break;
+                ++pos;
+            }
+            scratch.append(start, static_cast<size_t>(pos - start));
+
+            if (pos == end) {
+                if (!refill()) return fail("Unterminated string");
+                continue;
+            }
+
+            const auto c = static_cast<unsigned char>(*pos++);
+            if (c == '"') return true;
+            if (c < 0x20) return fail("Control character in string");
+            if (!readEscape()) return false;
+        }
+    }
+
+    bool readNumber(int first, double& value) {
+        char text[64];
+        size_t length = 0;
+        text[length++] = static_cast<char>(first);
+        for (;;) {
+            const int c = peek();
+            if (!isDigit(c) && c != '.' && c != 'e' && c != 'E' && c != '+' && c != '-') break;
+            if (length == sizeof(text)) return fail("Number too long");
+            text[length++] = static_cast<char>(c);
+            ++pos;
+        }
+
+        if (!isValidNumber(text, length)) return fail("Invalid number");
+        const auto result = std::from_chars(text, text + length, value);
+        if (result.ec != std::errc()) return fail("Number out of range");
+        return true;
+    }
+
+    bool expectLiteral(const char* rest) {
+        for (; *rest; ++rest) {
+            if (get() != *rest) return fail("Invalid literal");
+        }
+        return true;
+    }
+
+    bool readScalar(int c, Handler& handler) {
+        switch (c) {
+            case '"':
+                return readString() && check(handler.onString(scratch));
+            case 't':
+                return expectLiteral("rue") && check(handler.onBool(true));
+            case 'f':
+                return expectLiteral("alse") && check(handler.onBool(false));
+            case 'n':
+                return expectLiteral("ull") && check(handler.onNull());
+            case -1:
+                return fail("Unexpected end of input");
+            default:
+                if (c == '-' || isDigit(c)) {
+                    double value;
+                    return readNumber(c, value) && check(handler.onNumber(value));
+                }
+                return fail(std::string("Unexpected character '") + static_cast<char>(c) + "'");
+        }
+    }
+
+    bool push(char bracket) {
+        if (stack.size() >= maxDepth) return fail("Maximum nesting depth exceeded");
+        stack.push_back(bracket);
+        return true;
+    }
+
+    bool run(Handler& handler) {
+        State state = State::Value;
+
+        for (;;) {
+            const int c = nextNonWhitespace();
+
+            switch (state) {
+                case State::ArrayFirst:
+                    if (c == ']') {
+                        stack.pop_back();
+                        if (!check(handler.onEndArray())) return false;
+                        state = State::AfterValue;
+                        break;
+                    }
+                    [[fallthrough]];
+
+                case State::Value:
+                    if (c == '{') {
+                        if (!push('{') || !check(handler.onStartObject())) return false;
+                        state = State::ObjectFirst;
+                    } else if (c == '[') {
+                        if (!push('[') || !check(handler.onStartArray())) return false;
+                        state = State::ArrayFirst;
+                    } else {
+                        if (!readScalar(c, handler)) return false;
+                        state = State::AfterValue;
+                    }
+                    break;
+
+                case State::ObjectFirst:
+                    if (c == '}') {
+                        stack.pop_back();
+                        if (!check(handler.onEndObject())) return false;
+                        state = State::AfterValue;
+                        break;
+                    }
+                    [[fallthrough]];
+
+                case State::ObjectKey:
+                    if (c != '"') return fail(c < 0 ? "Unexpected end of input" : "Expected string key");
+                    if (!readString() || !check(handler.onKey(scratch))) return false;
+                    if (nextNonWhitespace() != ':') return fail("Expected ':'");
+                    state = State::Value;
+                    break;
+
+                case State::AfterValue:
+                    if (stack.empty()) {
+                        if (c < 0) return true;
+                        return fail("Trailing characters after document");
+                    }
+                    if (c == ',') {
+                        state = stack.back() == '{' ? State::ObjectKey : State::Value;
+                    } else if (c == '}' && stack.back() == '{') {
+                        stack.pop_back();
+                        if (!check(handler.onEndObject())) return false;
+                    } else if (c == ']' && stack.back() == '[') {
+                        stack.pop_back();
+                        if (!check(handler.onEndArray())) return false;
+                    } else {
+                        return fail(c < 0 ? "Unexpected end of input" : "Expected ',' or closing bracket");
+                    }
+                    break;
+            }
+        }
+    }
+};
+
+JsonReader::JsonReader()
+    : pImpl(std::make_unique<Impl>()) {}
+
+JsonReader::~JsonReader() = default;
+
+JsonReader::JsonReader(JsonReader&&) noexcept = default;
+JsonReader& JsonReader::operator=(JsonReader&&) noexcept = default;
+
+bool JsonReader::parse(const char* data, size_t size, Handler& handler) {
+    pImpl->begin(data, size, nullptr);
+    return pImpl->run(handler);
+}
+
+bool JsonReader::parse(std::string_view json, Handler& handler) {
+    return parse(json.data(), json.size(), handler);
+}
+
+bool JsonReader::parse(std::istream& stream, Handler& handler) {
+    if (pImpl->chunk.size() != kChunkSize) {
+        pImpl->chunk.resize(kChunkSize);
+    }
+    pImpl->begin(pImpl->chunk.data(), 0, &stream);
+    return pImpl->run(handler);
+}
+
+void JsonReader::setMaxDepth(size_t depth) {
+    pImpl->maxDepth = depth;
+}
+
+size_t JsonReader::getMaxDepth() const {
+    return pImpl->maxDepth;
+}
+
+std::string JsonReader::getLastError() const {
+    return pImpl->lastError;
+}
+
+bool JsonReader::wasAbortedByHandler() const {
+    return pImpl->aborted;
+}
+
+uint64_t JsonReader::getBytesConsumed() const {
+    return pImpl->offset();
+}
+
+} // namespace nap
@@ -0,0 +1,78 @@
+#ifndef NAP_JSON_READER_H
+#define NAP_JSON_READER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace nap {
+
+/**
+ * @brief Single-pass, event-driven (SAX-style) JSON parser
+ *
+ * Reports each token to a Handler as it is read instead of building a
+ * document tree. Stream input is consumed in fixed-size chunks, so a file
+ * never has to be held in memory as a whole. Keys and strings are decoded
+ * into one reusable buffer and handed out as string views that stay valid
+ * only for the duration of the callback.
+ *
+ * Nesting is tracked with an explicit stack rather than recursion, bounded
+ * by setMaxDepth().
+ */
+class JsonReader {
+public:
+    /**
+     * @brief Receives parse events; returning false from any callback stops parsing
+     */
+    class Handler {
+    public:
+        virtual ~Handler() = default;
+
+        virtual bool onStartObject() { return true; }
+        virtual bool onEndObject() { return true; }
+        virtual bool onStartArray() { return true; }
+        virtual bool onEndArray() { return true; }
+        virtual bool onKey(std::string_view key) { (void)key; return true; }
+        virtual bool onString(std::string_view value) { (void)value; return true; }
+        virtual bool onNumber(double value) { (void)value; return true; }
+        virtual bool onBool(bool value) { (void)value; return true; }
+        virtual bool onNull() { return true; }
+    };
+
+    static constexpr size_t kDefaultMaxDepth = 256;
+    static constexpr size_t kChunkSize = 64 * 1024;
+
+    JsonReader();
+    ~JsonReader();
+
+    // Non-copyable, movable
+    JsonReader(const JsonReader&) = delete;
+    JsonReader& operator=(const JsonReader&) = delete;
+    JsonReader(JsonReader&&) noexcept;
+    JsonReader& operator=(JsonReader&&) noexcept;
+
+    // Parsing; each call parses exactly one top-level value
+    bool parse(const char* data, size_t size, Handler& handler);
+    bool parse(std::string_view json, Handler& handler);
+    bool parse(std::istream& stream, Handler& handler);
+
+    // Options
+    void setMaxDepth(size_t depth);
+    size_t getMaxDepth() const;
+
+    // Diagnostics
+    std::string getLastError() const;
+    bool wasAbortedByHandler() const;
+    uint64_t getBytesConsumed() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace nap
+
+#endif // NAP_JSON_READER_H
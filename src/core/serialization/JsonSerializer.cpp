@@ -1,9 +1,278 @@
 #include "core/serialization/JsonSerializer.h"
+#include "core/serialization/JsonReader.h"
+#include "core/serialization/ParameterStateLayout.h"
+#include "core/serialization/StateVector.h"
+#include "core/graph/AudioGraph.h"
+#include "core/graph/ConnectionManager.h"
+#include "core/parameters/BoolParameter.h"
+#include "core/parameters/EnumParameter.h"
+#include "core/parameters/FloatParameter.h"
+#include "core/parameters/IntParameter.h"
+#include "core/parameters/ParameterGroup.h"
+#include "api/IAudioNode.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
 #include <fstream>
+#include <limits>
 #include <sstream>
 
 namespace nap {
 
+namespace {
+
+void writeString(std::ostream& out, const std::string& value) {
+    out << '"';
+    for (char c : value) {
+        switch (c) {
+            case '"': out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\r': out << "\\r"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    static const char* hex = "0123456789abcdef";
+                    out << "\\u00" << hex[(c >> 4) & 0xF] << hex[c & 0xF];
+                } else {
+                    out << c;
+                }
+        }
+    }
+    out << '"';
+}
+
+void writeFloat(std::ostream& out, float value) {
+    if (!std::isfinite(value)) {
+        out << "null";
+        return;
+    }
+    char text[32];
+    const auto result = std::to_chars(text, text + sizeof(text), value);
+    out.write(text, result.ptr - text);
+}
+
+// True when value is a whole number in [0, limit]; checked before any
+// integer cast, since converting an out-of-range double is undefined
+bool isIndex(double value, double limit) {
+    return std::isfinite(value) && value >= 0.0 && value <= limit && std::floor(value) == value;
+}
+
+/**
+ * Applies parse events directly to the bound graph and parameter group,
+ * or, given a layout and a state vector, stores parameter values in the
+ * state instead of applying them.
+ *
+ * Only the parts of the document the handler understands are applied;
+ * unknown keys, nodes and parameters are skipped so that newer files still
+ * load. Strings that must outlive a callback are copied into members that
+ * are reused for every node, connection and key. A number that cannot
+ * be a channel, enum index or int value rejects the whole document.
+ */
+class StateHandler : public JsonReader::Handler {
+public:
+    StateHandler(AudioGraph* graph, ParameterGroup* parameters)
+        : graph(graph), parameters(parameters) {}
+
+    StateHandler(const ParameterStateLayout& layout, StateVector& state)
+        : graph(nullptr), parameters(layout.getRoot()), layout(&layout), state(&state) {}
+
+    bool onStartObject() override {
+        ++depth;
+        if (section == Section::Parameters && depth > 2 && depth == groups.size() + 2) {
+            // Object directly inside a group is a subgroup
+            ParameterGroup* parent = groups.back();
+            groups.push_back(parent ? parent->getGroup(key) : nullptr);
+        } else if (depth == 3 && (section == Section::Nodes || section == Section::Connections)) {
+            beginRecord();
+        }
+        return true;
+    }
+
+    bool onEndObject() override {
+        if (section == Section::Parameters && depth > 2 && inGroup()) {
+            groups.pop_back();
+        } else if (depth == 3 && section == Section::Nodes) {
+            applyNode();
+        } else if (depth == 3 && section == Section::Connections) {
+            applyConnection();
+        }
+        return leave();
+    }
+
+    bool onStartArray() override {
+        ++depth;
+        return true;
+    }
+
+    bool onEndArray() override {
+        return leave();
+    }
+
+    bool onKey(std::string_view name) override {
+        key.assign(name.data(), name.size());
+        if (depth == 1) {
+            section = sectionFor(name);
+            if (section == Section::Parameters) {
+                groups.assign(1, parameters);
+            }
+        }
+        return true;
+    }
+
+    bool onString(std::string_view value) override {
+        if (section == Section::Nodes && depth == 3) {
+            if (key == "id") recordId.assign(value.data(), value.size());
+        } else if (section == Section::Connections && depth == 3) {
+            if (key == "source") recordId.assign(value.data(), value.size());
+            else if (key == "dest") recordDest.assign(value.data(), value.size());
+        } else if (inGroup()) {
+            if (auto* param = lookup()) {
+                if (auto* e = dynamic_cast<EnumParameter*>(param)) {
+                    if (state) {
+                        const auto& options = e->getOptions();
+                        auto it = std::find(options.begin(), options.end(), value);
+                        if (it != options.end()) store(static_cast<float>(it - options.begin()));
+                    } else {
+                        e->setSelectedValue(std::string(value));
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    bool onNumber(double value) override {
+        if (section == Section::Connections && depth == 3) {
+            if (key != "sourceChannel" && key != "destChannel") return true;
+            if (!isIndex(value, static_cast<double>(std::numeric_limits<uint32_t>::max()))) {
+                return false;
+            }
+            if (key == "sourceChannel") recordSourceChannel = static_cast<uint32_t>(value);
+            else recordDestChannel = static_cast<uint32_t>(value);
+        } else if (inGroup()) {
+            return applyNumber(value);
+        }
+        return true;
+    }
+
+    bool onBool(bool value) override {
+        if (section == Section::Nodes && depth == 3) {
+            if (key == "bypassed") recordBypassed = value ? 1 : 0;
+        } else if (inGroup()) {
+            if (auto* param = lookup()) {
+                if (auto* b = dynamic_cast<BoolParameter*>(param)) {
+                    if (state) store(value ? 1.0f : 0.0f);
+                    else b->setValue(value);
+                }
+            }
+        }
+        return true;
+    }
+
+private:
+    enum class Section { None, Nodes, Connections, Parameters };
+
+    static Section sectionFor(std::string_view name) {
+        if (name == "nodes") return Section::Nodes;
+        if (name == "connections") return Section::Connections;
+        if (name == "parameters") return Section::Parameters;
+        return Section::None;
+    }
+
+    // True while reading values that belong directly to the current group
+    bool inGroup() const {
+        return section == Section::Parameters && depth == groups.size() + 1;
+    }
+
+    bool leave() {
+        if (--depth == 1) {
+            section = Section::None;
+        }
+        return true;
+    }
+
+    IParameter* lookup() {
+        ParameterGroup* group = groups.empty() ? nullptr : groups.back();
+        return group ? group->getParameter(key) : nullptr;
+    }
+
+    bool applyNumber(double value) {
+        IParameter* param = lookup();
+        if (!param) return true;
+
+        if (auto* f = dynamic_cast<FloatParameter*>(param)) {
+            if (state) store(static_cast<float>(value));
+            else f->setValue(static_cast<float>(value));
+        } else if (auto* i = dynamic_cast<IntParameter*>(param)) {
+            if (!std::isfinite(value) || value < std::numeric_limits<int>::min() ||
+                value > std::numeric_limits<int>::max()) {
+                return false;
+            }
+            if (state) store(static_cast<float>(std::lround(value)));
+            else i->setValue(static_cast<int>(std::lround(value)));
+        } else if (auto* e = dynamic_cast<EnumParameter*>(param)) {
+            const size_t count = e->getOptions().size();
+            if (count == 0 || !isIndex(value, static_cast<double>(count - 1))) return false;
+            if (state) store(static_cast<float>(static_cast<size_t>(value)));
+            else e->setSelectedIndex(static_cast<size_t>(value));
+        } else if (auto* b = dynamic_cast<BoolParameter*>(param)) {
+            if (state) store(value != 0.0 ? 1.0f : 0.0f);
+            else b->setValue(value != 0.0);
+        }
+        return true;
+    }
+
+    // Writes the value of the current key's parameter into its state slot
+    void store(float value) {
+        ParameterGroup* group = groups.back();
+        const size_t index = layout->indexOf(*group, group->getHandle(key));
+        if (index != ParameterStateLayout::npos) {
+            (*state)[index] = value;
+        }
+    }
+
+    void beginRecord() {
+        recordId.clear();
+        recordDest.clear();
+        recordSourceChannel = 0;
+        recordDestChannel = 0;
+        recordBypassed = -1;
+    }
+
+    void applyNode() {
+        if (!graph || recordBypassed < 0) return;
+        if (auto node = graph->getNode(recordId)) {
+            node->setBypassed(recordBypassed != 0);
+        }
+    }
+
+    void applyConnection() {
+        if (graph) {
+            graph->connect(recordId, recordSourceChannel, recordDest, recordDestChannel);
+        }
+    }
+
+    AudioGraph* graph;
+    ParameterGroup* parameters;
+    const ParameterStateLayout* layout = nullptr;
+    StateVector* state = nullptr;
+
+    size_t depth = 0;
+    Section section = Section::None;
+    std::string key;
+    std::vector<ParameterGroup*> groups;  // Null entries for unknown subgroups
+
+    // Fields of the node or connection being read
+    std::string recordId;
+    std::string recordDest;
+    uint32_t recordSourceChannel = 0;
+    uint32_t recordDestChannel = 0;
+    int recordBypassed = -1;
+};
+
+} // namespace
+
 class JsonSerializer::Impl {
 public:
     AudioGraph* graph = nullptr;
@@ -12,10 +281,121 @@ public:
     bool prettyPrint = true;
     int indentSize = 2;
     bool valid = false;
-    std::string cachedJson;
+    JsonReader reader;
 
     void clearError() { lastError.clear(); }
     void setError(const std::string& error) { lastError = error; }
+
+    struct Writer {
+        std::ostream& out;
+        bool pretty;
+        int indentSize;
+
+        void newline(int level) const {
+            if (!pretty) return;
+            out << '\n' << std::string(static_cast<size_t>(level * indentSize), ' ');
+        }
+
+        const char* colon() const { return pretty ? ": " : ":"; }
+    };
+
+    void writeParameter(const Writer& w, const IParameter& param) const {
+        if (auto* f = dynamic_cast<const FloatParameter*>(&param)) {
+            writeFloat(w.out, f->getValue());
+        } else if (auto* i = dynamic_cast<const IntParameter*>(&param)) {
+            w.out << i->getValue();
+        } else if (auto* b = dynamic_cast<const BoolParameter*>(&param)) {
+            w.out << (b->getValue() ? "true" : "false");
+        } else if (auto* e = dynamic_cast<const EnumParameter*>(&param)) {
+            writeString(w.out, e->getSelectedValue());
+        } else {
+            w.out << "null";
+        }
+    }
+
+    void writeGroup(const Writer& w, const ParameterGroup& group, int level) const {
+        w.out << '{';
+        bool first = true;
+        auto separator = [&]() {
+            if (!first) w.out << ',';
+            first = false;
+            w.newline(level + 1);
+        };
+
+        group.forEachParameter([&](const IParameter& param) {
+            if (param.getType() == ParameterType::Trigger) return;
+            separator();
+            writeString(w.out, param.getName());
+            w.out << w.colon();
+            writeParameter(w, param);
+        });
+        group.forEachGroup([&](const ParameterGroup& child) {
+            separator();
+            writeString(w.out, child.getName());
+            w.out << w.colon();
+            writeGroup(w, child, level + 1);
+        });
+
+        if (!first) w.newline(level);
+        w.out << '}';
+    }
+
+    void writeNodes(const Writer& w) const {
+        w.out << '[';
+        auto ids = graph ? graph->getAllNodeIds() : std::vector<std::string>();
+        std::sort(ids.begin(), ids.end());
+        for (size_t i = 0; i < ids.size(); ++i) {
+            auto node = graph->getNode(ids[i]);
+            if (i > 0) w.out << ',';
+            w.newline(2);
+            w.out << '{';
+            writeString(w.out, "id");
+            w.out << w.colon();
+            writeString(w.out, ids[i]);
+            w.out << ',';
+            writeString(w.out, "type");
+            w.out << w.colon();
+            writeString(w.out, node->getTypeName());
+            w.out << ',';
+            writeString(w.out, "bypassed");
+            w.out << w.colon() << (node->isBypassed() ? "true" : "false") << '}';
+        }
+        if (!ids.empty()) w.newline(1);
+        w.out << ']';
+    }
+
+    void writeConnections(const Writer& w) const {
+        w.out << '[';
+        auto connections = graph ? graph->getConnections() : std::vector<Connection>();
+        for (size_t i = 0; i < connections.size(); ++i) {
+            const Connection& c = connections[i];
+            if (i > 0) w.out << ',';
+            w.newline(2);
+            w.out << '{';
+            writeString(w.out, "source");
+            w.out << w.colon();
+            writeString(w.out, c.sourceNodeId);
+            w.out << ',';
+            writeString(w.out, "sourceChannel");
+            w.out << w.colon() << c.sourceChannel << ',';
+            writeString(w.out, "dest");
+            w.out << w.colon();
+            writeString(w.out, c.destNodeId);
+            w.out << ',';
+            writeString(w.out, "destChannel");
+            w.out << w.colon() << c.destChannel << '}';
+        }
+        if (!connections.empty()) w.newline(1);
+        w.out << ']';
+    }
+
+    bool finishParse(bool parsed) {
+        if (!parsed) {
+            setError("Invalid JSON: " + reader.getLastError());
+        }
+        valid = parsed;
+        return parsed;
+    }
 };
 
 JsonSerializer::JsonSerializer()
@@ -32,18 +412,31 @@ std::string JsonSerializer::serialize() const {
         return "{}";
     }
 
-    // Placeholder JSON structure
     std::ostringstream oss;
-    std::string indent = pImpl->prettyPrint ? std::string(pImpl->indentSize, ' ') : "";
-    std::string newline = pImpl->prettyPrint ? "\n" : "";
-
-    oss << "{" << newline;
-    oss << indent << "\"format\": \"nap-audio-graph\"," << newline;
-    oss << indent << "\"version\": \"1.0.0\"," << newline;
-    oss << indent << "\"nodes\": []," << newline;
-    oss << indent << "\"connections\": []," << newline;
-    oss << indent << "\"parameters\": {}" << newline;
-    oss << "}";
+    Impl::Writer w{oss, pImpl->prettyPrint, pImpl->indentSize};
+
+    oss << '{';
+    w.newline(1);
+    oss << "\"format\"" << w.colon() << "\"nap-audio-graph\",";
+    w.newline(1);
+    oss << "\"version\"" << w.colon() << "\"1.0.0\",";
+    w.newline(1);
+    oss << "\"nodes\"" << w.colon();
+    pImpl->writeNodes(w);
+    oss << ',';
+    w.newline(1);
+    oss << "\"connections\"" << w.colon();
+    pImpl->writeConnections(w);
+    oss << ',';
+    w.newline(1);
+    oss << "\"parameters\"" << w.colon();
+    if (pImpl->parameterGroup) {
+        pImpl->writeGroup(w, *pImpl->parameterGroup, 1);
+    } else {
+        oss << "{}";
+    }
+    w.newline(0);
+    oss << '}';
 
     return oss.str();
 }
@@ -58,23 +451,26 @@ bool JsonSerializer::deserialize(const std::string& data) {
 
     if (data.empty()) {
         pImpl->setError("Empty JSON data");
+        pImpl->valid = false;
         return false;
     }
 
-    // Basic validation - check for JSON structure
-    if (data.front() != '{' || data.back() != '}') {
-        pImpl->setError("Invalid JSON format");
-        return false;
-    }
-
-    pImpl->cachedJson = data;
-    pImpl->valid = true;
-    return true;
+    StateHandler handler(pImpl->graph, pImpl->parameterGroup);
+    return pImpl->finishParse(pImpl->reader.parse(data, handler));
 }
 
 bool JsonSerializer::deserializeBinary(const std::vector<uint8_t>& data) {
-    std::string json(data.begin(), data.end());
-    return deserialize(json);
+    pImpl->clearError();
+
+    if (data.empty()) {
+        pImpl->setError("Empty JSON data");
+        pImpl->valid = false;
+        return false;
+    }
+
+    StateHandler handler(pImpl->graph, pImpl->parameterGroup);
+    const auto* text = reinterpret_cast<const char*>(data.data());
+    return pImpl->finishParse(pImpl->reader.parse(text, data.size(), handler));
 }
 
 bool JsonSerializer::saveToFile(const std::string& filepath) const {
@@ -100,21 +496,49 @@ bool JsonSerializer::saveToFile(const std::string& filepath) const {
 bool JsonSerializer::loadFromFile(const std::string& filepath) {
     pImpl->clearError();
 
-    std::ifstream file(filepath);
+    std::ifstream file(filepath, std::ios::binary);
     if (!file.is_open()) {
         pImpl->setError("Failed to open file for reading: " + filepath);
         return false;
     }
 
-    std::stringstream buffer;
-    buffer << file.rdbuf();
+    // Parsed chunk by chunk; the file is never held in memory as a whole
+    StateHandler handler(pImpl->graph, pImpl->parameterGroup);
+    const bool parsed = pImpl->reader.parse(file, handler);
 
-    if (file.fail()) {
+    if (file.bad()) {
         pImpl->setError("Failed to read file: " + filepath);
+        pImpl->valid = false;
         return false;
     }
 
-    return deserialize(buffer.str());
+    return pImpl->finishParse(parsed);
+}
+
+bool JsonSerializer::readParameterState(const std::string& filepath,
+                                        const ParameterStateLayout& layout,
+                                        StateVector& state) const {
+    pImpl->clearError();
+
+    if (!layout.getRoot() || state.size() != layout.size()) {
+        pImpl->setError("State does not match the parameter layout");
+        return false;
+    }
+
+    std::ifstream file(filepath, std::ios::binary);
+    if (!file.is_open()) {
+        pImpl->setError("Failed to open file for reading: " + filepath);
+        return false;
+    }
+
+    // A reader of its own keeps this usable from a loader thread
+    JsonReader reader;
+    StateHandler handler(layout, state);
+    if (!reader.parse(file, handler)) {
+        pImpl->setError("Invalid JSON: " + reader.getLastError());
+        return false;
+    }
+    return true;
 }
 
 bool JsonSerializer::isValid() const {
@@ -34,6 +34,8 @@ public:
     bool deserializeBinary(const std::vector<uint8_t>& data) override;
     bool saveToFile(const std::string& filepath) const override;
     bool loadFromFile(const std::string& filepath) override;
+    bool readParameterState(const std::string& filepath, const ParameterStateLayout& layout,
+                            StateVector& state) const override;
     bool isValid() const override;
     std::string getLastError() const override;
     std::string getFormatName() const override;
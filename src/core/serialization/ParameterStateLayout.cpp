@@ -0,0 +1,134 @@
+#include "core/serialization/ParameterStateLayout.h"
+#include "core/serialization/StateVector.h"
+#include <unordered_map>
+
+namespace nap {
+
+class ParameterStateLayout::Impl {
+public:
+    // A run of consecutive handles of one group stored in consecutive slots
+    struct Run {
+        ParameterGroup* group;
+        ParameterHandle first;
+        size_t count;
+        size_t offset;
+    };
+
+    ParameterGroup* root = nullptr;
+    size_t size = 0;
+    std::vector<Run> runs;
+    std::vector<size_t> stepped;
+    std::vector<bool> steppedMask;
+    std::unordered_map<std::string, size_t> paths;
+
+    static bool isStored(ParameterType type) {
+        return type == ParameterType::Float || type == ParameterType::Int ||
+               type == ParameterType::Bool || type == ParameterType::Enum;
+    }
+
+    void add(ParameterGroup& group, const std::string& prefix) {
+        const size_t handles = group.getHandleCount();
+        for (size_t h = 0; h < handles; ++h) {
+            const auto handle = static_cast<ParameterHandle>(h);
+            const IParameter* param = group.getParameter(handle);
+            if (!param || !isStored(param->getType())) continue;
+
+            // Extend the current run when this handle directly follows it
+            if (runs.empty() || runs.back().group != &group ||
+                runs.back().first + runs.back().count != handle) {
+                runs.push_back({&group, handle, 0, size});
+            }
+            ++runs.back().count;
+
+            if (param->getType() != ParameterType::Float) {
+                stepped.push_back(size);
+            }
+            paths[prefix + param->getName()] = size;
+            ++size;
+        }
+
+        group.forEachGroup([&](ParameterGroup& child) {
+            add(child, prefix + child.getName() + "/");
+        });
+    }
+
+    const Run* findRun(const ParameterGroup& group, ParameterHandle handle) const {
+        for (const Run& run : runs) {
+            if (run.group == &group && handle >= run.first && handle - run.first < run.count) {
+                return &run;
+            }
+        }
+        return nullptr;
+    }
+};
+
+ParameterStateLayout::ParameterStateLayout()
+    : pImpl(std::make_unique<Impl>()) {}
+
+ParameterStateLayout::ParameterStateLayout(ParameterGroup& root)
+    : pImpl(std::make_unique<Impl>()) {
+    build(root);
+}
+
+ParameterStateLayout::~ParameterStateLayout() = default;
+
+ParameterStateLayout::ParameterStateLayout(ParameterStateLayout&&) noexcept = default;
+ParameterStateLayout& ParameterStateLayout::operator=(ParameterStateLayout&&) noexcept = default;
+
+void ParameterStateLayout::build(ParameterGroup& root) {
+    pImpl = std::make_unique<Impl>();
+    pImpl->root = &root;
+    pImpl->add(root, "");
+
+    pImpl->steppedMask.assign(pImpl->size, false);
+    for (size_t index : pImpl->stepped) {
+        pImpl->steppedMask[index] = true;
+    }
+}
+
+ParameterGroup* ParameterStateLayout::getRoot() const {
+    return pImpl->root;
+}
+
+size_t ParameterStateLayout::size() const {
+    return pImpl->size;
+}
+
+size_t ParameterStateLayout::indexOf(const ParameterGroup& group, ParameterHandle handle) const {
+    const Impl::Run* run = pImpl->findRun(group, handle);
+    return run ? run->offset + (handle - run->first) : npos;
+}
+
+size_t ParameterStateLayout::indexOf(const std::string& path) const {
+    auto it = pImpl->paths.find(path);
+    return it != pImpl->paths.end() ? it->second : npos;
+}
+
+bool ParameterStateLayout::isStepped(size_t index) const {
+    return index < pImpl->steppedMask.size() && pImpl->steppedMask[index];
+}
+
+const std::vector<size_t>& ParameterStateLayout::getSteppedIndices() const {
+    return pImpl->stepped;
+}
+
+void ParameterStateLayout::capture(StateVector& state) const {
+    state.resize(pImpl->size);
+    float* values = state.data();
+    for (const Impl::Run& run : pImpl->runs) {
+        run.group->getValues(run.first, values + run.offset, run.count);
+    }
+}
+
+size_t ParameterStateLayout::apply(const StateVector& state) const {
+    if (state.size() != pImpl->size) return 0;
+
+    const float* values = state.data();
+    size_t written = 0;
+    for (const Impl::Run& run : pImpl->runs) {
+        written += run.group->setValuesSilently(run.first, values + run.offset, run.count);
+    }
+    return written;
+}
+
+} // namespace nap
@@ -0,0 +1,66 @@
+#ifndef NAP_PARAMETER_STATE_LAYOUT_H
+#define NAP_PARAMETER_STATE_LAYOUT_H
+
+#include "core/parameters/ParameterGroup.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace nap {
+
+class StateVector;
+
+/**
+ * @brief Maps the values of a parameter tree onto StateVector slots
+ *
+ * Every float, int, bool and enum parameter of the root group and its
+ * nested groups gets one slot, in handle order, root group first. Values
+ * are stored as ParameterGroup::getValue() reports them (bool: 0/1, enum:
+ * index). Triggers and other value-less parameters are left out.
+ *
+ * The layout records handle ranges, so capture() and apply() are a few
+ * bulk copies per group and never allocate once the state vector has been
+ * sized. Rebuild the layout after adding or removing parameters or groups.
+ */
+class ParameterStateLayout {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    ParameterStateLayout();
+    explicit ParameterStateLayout(ParameterGroup& root);
+    ~ParameterStateLayout();
+
+    // Non-copyable, movable
+    ParameterStateLayout(const ParameterStateLayout&) = delete;
+    ParameterStateLayout& operator=(const ParameterStateLayout&) = delete;
+    ParameterStateLayout(ParameterStateLayout&&) noexcept;
+    ParameterStateLayout& operator=(ParameterStateLayout&&) noexcept;
+
+    void build(ParameterGroup& root);
+    ParameterGroup* getRoot() const;
+    size_t size() const;
+
+    // Slot lookup; npos for unknown or excluded parameters. Paths are
+    // "Group/Subgroup/Name" below the root, as written by the serializers.
+    size_t indexOf(const ParameterGroup& group, ParameterHandle handle) const;
+    size_t indexOf(const std::string& path) const;
+
+    // Int, bool and enum slots, which must not be interpolated
+    bool isStepped(size_t index) const;
+    const std::vector<size_t>& getSteppedIndices() const;
+
+    // Reads the live values; resizes state to size()
+    void capture(StateVector& state) const;
+
+    // Writes state back without change callbacks; returns parameters written
+    size_t apply(const StateVector& state) const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace nap
+
+#endif // NAP_PARAMETER_STATE_LAYOUT_H
@@ -1,25 +1,280 @@
 #include "core/serialization/PresetManager.h"
 #include "core/serialization/ISerializer.h"
-#include <unordered_map>
+#include "core/serialization/PresetMorpher.h"
 #include <algorithm>
+#include <atomic>
+#include <charconv>
 #include <filesystem>
+#include <fstream>
 #include <chrono>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <thread>
 
 namespace nap {
 
+namespace {
+
+namespace fs = std::filesystem;
+
+constexpr const char* kIndexHeader = "NAPPRESETINDEX 1";
+constexpr size_t kIndexFieldCount = 9;
+
+// Index entry: the public info plus the raw file time used for change detection
+struct IndexEntry {
+    PresetInfo info;
+    int64_t fileTime = 0;
+};
+
+using PresetMap = std::map<std::string, IndexEntry>;
+
+uint64_t toEpochSeconds(fs::file_time_type time) {
+    const auto system = std::chrono::system_clock::now() +
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            time - fs::file_time_type::clock::now());
+    const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(
+        system.time_since_epoch()).count();
+    return seconds > 0 ? static_cast<uint64_t>(seconds) : 0;
+}
+
+bool hashFile(const std::string& path, uint64_t& hash) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+
+    hash = 14695981039346656037ull;
+    std::vector<char> buffer(64 * 1024);
+    while (file) {
+        file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        const auto count = static_cast<size_t>(file.gcount());
+        for (size_t i = 0; i < count; ++i) {
+            hash = (hash ^ static_cast<unsigned char>(buffer[i])) * 1099511628211ull;
+        }
+    }
+    return !file.bad();
+}
+
+// Fills size, times and hash from the file at entry.info.filepath
+bool refreshEntry(IndexEntry& entry) {
+    std::error_code ec;
+    const auto time = fs::last_write_time(entry.info.filepath, ec);
+    if (ec) return false;
+    const auto size = fs::file_size(entry.info.filepath, ec);
+    if (ec) return false;
+
+    uint64_t hash = 0;
+    if (!hashFile(entry.info.filepath, hash)) return false;
+
+    entry.fileTime = static_cast<int64_t>(time.time_since_epoch().count());
+    entry.info.fileSize = size;
+    entry.info.modifiedTime = toEpochSeconds(time);
+    entry.info.contentHash = hash;
+    if (entry.info.createdTime == 0) {
+        entry.info.createdTime = entry.info.modifiedTime;
+    }
+    return true;
+}
+
+std::string escapeField(const std::string& value) {
+    std::string out;
+    out.reserve(value.size());
+    for (char c : value) {
+        switch (c) {
+            case '\\': out += "\\\\"; break;
+            case '\t': out += "\\t"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            default: out += c;
+        }
+    }
+    return out;
+}
+
+std::string unescapeField(const std::string& value) {
+    std::string out;
+    out.reserve(value.size());
+    for (size_t i = 0; i < value.size(); ++i) {
+        if (value[i] == '\\' && i + 1 < value.size()) {
+            const char next = value[++i];
+            out += next == 't' ? '\t' : next == 'n' ? '\n' : next == 'r' ? '\r' : next;
+        } else {
+            out += value[i];
+        }
+    }
+    return out;
+}
+
+template<typename T>
+bool parseNumber(const std::string& text, T& value, int base = 10) {
+    const auto result = std::from_chars(text.data(), text.data() + text.size(), value, base);
+    return result.ec == std::errc() && result.ptr == text.data() + text.size();
+}
+
+std::string indexPathFor(const std::string& directory) {
+    return directory + "/" + PresetManager::INDEX_FILENAME;
+}
+
+// Unreadable or foreign index files yield an empty map, which forces a full rescan
+PresetMap readIndex(const std::string& directory) {
+    PresetMap entries;
+    std::ifstream file(indexPathFor(directory));
+    std::string line;
+    if (!file.is_open() || !std::getline(file, line) || line != kIndexHeader) {
+        return entries;
+    }
+
+    std::vector<std::string> fields;
+    while (std::getline(file, line)) {
+        fields.clear();
+        size_t begin = 0;
+        for (size_t tab; (tab = line.find('\t', begin)) != std::string::npos; begin = tab + 1) {
+            fields.push_back(line.substr(begin, tab - begin));
+        }
+        fields.push_back(line.substr(begin));
+        if (fields.size() != kIndexFieldCount) continue;
+
+        IndexEntry entry;
+        entry.info.name = unescapeField(fields[0]);
+        entry.info.filepath = directory + "/" + unescapeField(fields[1]);
+        entry.info.category = unescapeField(fields[2]);
+        entry.info.author = unescapeField(fields[3]);
+        if (!parseNumber(fields[4], entry.info.createdTime) ||
+            !parseNumber(fields[5], entry.info.modifiedTime) ||
+            !parseNumber(fields[6], entry.info.fileSize) ||
+            !parseNumber(fields[7], entry.info.contentHash, 16) ||
+            !parseNumber(fields[8], entry.fileTime)) {
+            continue;
+        }
+        entries[entry.info.name] = std::move(entry);
+    }
+    return entries;
+}
+
+// Written to a temporary file and renamed so a crash never leaves a torn index
+bool writeIndex(const std::string& directory, const PresetMap& entries) {
+    const std::string path = indexPathFor(directory);
+    const std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::trunc);
+        if (!file.is_open()) return false;
+
+        file << kIndexHeader << '\n';
+        char hash[17];
+        for (const auto& pair : entries) {
+            const PresetInfo& info = pair.second.info;
+            const auto end = std::to_chars(hash, hash + 16, info.contentHash, 16).ptr;
+            file << escapeField(info.name) << '\t'
+                 << escapeField(fs::path(info.filepath).filename().string()) << '\t'
+                 << escapeField(info.category) << '\t'
+                 << escapeField(info.author) << '\t'
+                 << info.createdTime << '\t'
+                 << info.modifiedTime << '\t'
+                 << info.fileSize << '\t'
+                 << std::string(hash, end) << '\t'
+                 << pair.second.fileTime << '\n';
+        }
+        if (!file) return false;
+    }
+
+    std::error_code ec;
+    fs::rename(tempPath, path, ec);
+    return !ec;
+}
+
+// Stats every file and re-reads only those that differ from the previous index
+PresetMap scanDirectory(const std::string& directory, const PresetMap& previous,
+                        PresetScanStatistics& stats) {
+    PresetMap result;
+    const fs::path dirPath(directory);
+    if (!fs::exists(dirPath)) return result;
+
+    for (const auto& entry : fs::directory_iterator(dirPath)) {
+        const std::string filename = entry.path().filename().string();
+        if (filename.empty() || filename[0] == '.' || !entry.is_regular_file()) continue;
+        ++stats.filesSeen;
+
+        std::error_code ec;
+        const auto time = entry.last_write_time(ec);
+        if (ec) continue;
+        const auto size = entry.file_size(ec);
+        if (ec) continue;
+
+        const std::string name = entry.path().stem().string();
+        const std::string filepath = entry.path().string();
+        const auto known = previous.find(name);
+
+        if (known != previous.end() && known->second.info.filepath == filepath &&
+            known->second.fileTime == static_cast<int64_t>(time.time_since_epoch().count()) &&
+            known->second.info.fileSize == size) {
+            result[name] = known->second;
+            continue;
+        }
+
+        IndexEntry fresh;
+        if (known != previous.end()) {
+            fresh.info = known->second.info;  // Keep category, author and creation time
+        }
+        fresh.info.name = name;
+        fresh.info.filepath = filepath;
+        if (refreshEntry(fresh)) {
+            ++stats.filesRead;
+            result[name] = std::move(fresh);
+        }
+    }
+
+    for (const auto& pair : previous) {
+        if (result.find(pair.first) == result.end()) {
+            ++stats.filesRemoved;
+        }
+    }
+    return result;
+}
+
+} // namespace
+
 class PresetManager::Impl {
 public:
+    mutable std::mutex mutex;
+
     std::string presetDirectory;
-    std::unordered_map<std::string, PresetInfo> presets;
+    PresetMap presets;
+    std::map<std::string, std::set<std::string>> categories;  // Category -> preset names
+    bool indexLoaded = false;
+    bool indexDirty = false;
+
     std::string currentPresetName;
-    bool modified = false;
+    std::atomic<bool> modified{false};  // Also written by the loader thread
     std::string lastError;
 
-    std::shared_ptr<ISerializer> serializer;
+    std::shared_ptr<ISerializer> serializer;  // Guarded by mutex; copied before use
     ParameterGroup* parameterGroup = nullptr;
 
     PresetLoadedCallback loadedCallback;
     PresetSavedCallback savedCallback;
+    ScanCompletedCallback scanCallback;
+
+    std::thread scanThread;
+    std::atomic<bool> scanning{false};
+    PresetScanStatistics lastScan;
+
+    std::thread loadThread;
+    std::atomic<bool> loading{false};
+
+    // Edits made while a background scan runs; reapplied over its result
+    std::map<std::string, std::optional<IndexEntry>> pendingEdits;
+
+    ~Impl() {
+        if (loadThread.joinable()) {
+            loadThread.join();
+        }
+        if (scanThread.joinable()) {
+            scanThread.join();
+        }
+        if (indexDirty && !presetDirectory.empty()) {
+            writeIndex(presetDirectory, presets);
+        }
+    }
 
     void clearError() { lastError.clear(); }
     void setError(const std::string& error) { lastError = error; }
@@ -33,6 +288,184 @@ public:
         return std::chrono::duration_cast<std::chrono::seconds>(
             std::chrono::system_clock::now().time_since_epoch()).count();
     }
+
+    // Everything below expects the mutex to be held
+
+    void rebuildCategories() {
+        categories.clear();
+        for (const auto& pair : presets) {
+            if (!pair.second.info.category.empty()) {
+                categories[pair.second.info.category].insert(pair.first);
+            }
+        }
+    }
+
+    void unlinkCategory(const std::string& name) {
+        auto it = presets.find(name);
+        if (it == presets.end() || it->second.info.category.empty()) return;
+        auto category = categories.find(it->second.info.category);
+        if (category != categories.end()) {
+            category->second.erase(name);
+            if (category->second.empty()) categories.erase(category);
+        }
+    }
+
+    void apply(const std::string& name, const std::optional<IndexEntry>& entry) {
+        unlinkCategory(name);
+        if (entry) {
+            presets[name] = *entry;
+            if (!entry->info.category.empty()) {
+                categories[entry->info.category].insert(name);
+            }
+        } else {
+            presets.erase(name);
+        }
+    }
+
+    void record(const std::string& name, std::optional<IndexEntry> entry) {
+        apply(name, entry);
+        if (scanning.load()) {
+            pendingEdits[name] = std::move(entry);
+        }
+        indexDirty = true;
+    }
+
+    const IndexEntry* find(const std::string& name) const {
+        auto it = presets.find(name);
+        return it != presets.end() ? &it->second : nullptr;
+    }
+
+    // Looks up what a load needs; call with the mutex held
+    bool resolve(const std::string& name, std::string& filepath,
+                 std::shared_ptr<ISerializer>& boundSerializer) {
+        clearError();
+
+        if (!serializer) {
+            setError("No serializer bound");
+            return false;
+        }
+
+        const IndexEntry* entry = find(name);
+        if (!entry) {
+            setError("Preset not found: " + name);
+            return false;
+        }
+        filepath = entry->info.filepath;
+        boundSerializer = serializer;
+        return true;
+    }
+
+    void finishLoad(const std::string& name) {
+        PresetLoadedCallback callback;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            currentPresetName = name;
+            modified = false;
+            callback = loadedCallback;
+        }
+
+        if (callback) {
+            callback(name);
+        }
+    }
+
+    // Loader thread: resolve the file into target and queue the morph
+    void loadState(const std::string& name, PresetMorpher& morpher,
+                   std::unique_ptr<StateVector> target, uint32_t morphBlocks) {
+        std::string filepath;
+        std::shared_ptr<ISerializer> boundSerializer;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!resolve(name, filepath, boundSerializer)) return;
+        }
+
+        if (!boundSerializer->readParameterState(filepath, morpher.getLayout(), *target)) {
+            std::lock_guard<std::mutex> lock(mutex);
+            setError(boundSerializer->getLastError());
+            return;
+        }
+
+        if (!morpher.morphTo(std::move(target), morphBlocks)) {
+            std::lock_guard<std::mutex> lock(mutex);
+            setError("Preset morpher is not accepting states: " + name);
+            return;
+        }
+
+        finishLoad(name);
+    }
+
+    // Runs without the mutex except while reading and publishing state
+    void runScan() {
+        std::string directory;
+        PresetMap previous;
+        bool needIndex = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            directory = presetDirectory;
+            needIndex = !indexLoaded;
+            previous = presets;
+            pendingEdits.clear();
+        }
+        if (directory.empty()) return;
+
+        const auto start = std::chrono::steady_clock::now();
+        PresetScanStatistics stats;
+        PresetMap result;
+        bool failed = false;
+        try {
+            if (needIndex) {
+                PresetMap stored = readIndex(directory);
+                for (auto& pair : previous) {
+                    stored[pair.first] = std::move(pair.second);
+                }
+                previous.swap(stored);
+            }
+            result = scanDirectory(directory, previous, stats);
+        } catch (...) {
+            failed = true;
+        }
+        stats.durationUs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count());
+
+        PresetMap snapshot;
+        bool writeNeeded = false;
+        ScanCompletedCallback callback;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (directory != presetDirectory) {
+                pendingEdits.clear();
+                return;
+            }
+            if (failed) {
+                setError("Failed to scan preset directory");
+                pendingEdits.clear();
+                return;
+            }
+
+            presets.swap(result);
+            for (const auto& edit : pendingEdits) {
+                if (edit.second) presets[edit.first] = *edit.second;
+                else presets.erase(edit.first);
+            }
+            pendingEdits.clear();
+            rebuildCategories();
+
+            indexDirty = indexDirty || needIndex || stats.filesRead > 0 || stats.filesRemoved > 0;
+            indexLoaded = true;
+            lastScan = stats;
+            writeNeeded = indexDirty;
+            if (writeNeeded) snapshot = presets;
+            callback = scanCallback;
+        }
+
+        if (writeNeeded && writeIndex(directory, snapshot)) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (directory == presetDirectory) indexDirty = false;
+        }
+        if (callback) {
+            callback(stats);
+        }
+    }
 };
 
 PresetManager::PresetManager()
@@ -44,127 +477,230 @@ PresetManager::PresetManager(PresetManager&&) noexcept = default;
 PresetManager& PresetManager::operator=(PresetManager&&) noexcept = default;
 
 void PresetManager::setPresetDirectory(const std::string& path) {
+    waitForScan();
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    if (path == pImpl->presetDirectory) return;
+
+    if (pImpl->indexDirty && !pImpl->presetDirectory.empty()) {
+        writeIndex(pImpl->presetDirectory, pImpl->presets);
+    }
     pImpl->presetDirectory = path;
+    pImpl->presets.clear();
+    pImpl->categories.clear();
+    pImpl->indexLoaded = false;
+    pImpl->indexDirty = false;
 }
 
 std::string PresetManager::getPresetDirectory() const {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
     return pImpl->presetDirectory;
 }
 
 void PresetManager::scanPresets() {
-    pImpl->presets.clear();
-
-    if (pImpl->presetDirectory.empty()) return;
+    waitForScan();
+    // Flagged like a background scan so edits made meanwhile survive it
+    while (pImpl->scanning.exchange(true)) {
+        std::this_thread::yield();
+    }
+    pImpl->runScan();
+    pImpl->scanning.store(false);
+}
 
-    try {
-        std::filesystem::path dirPath(pImpl->presetDirectory);
-        if (!std::filesystem::exists(dirPath)) return;
-
-        for (const auto& entry : std::filesystem::directory_iterator(dirPath)) {
-            if (entry.is_regular_file()) {
-                PresetInfo info;
-                info.filepath = entry.path().string();
-                info.name = entry.path().stem().string();
-                info.createdTime = 0;
-                info.modifiedTime = 0;
-                pImpl->presets[info.name] = info;
-            }
-        }
-    } catch (...) {
-        pImpl->setError("Failed to scan preset directory");
+bool PresetManager::scanPresetsAsync() {
+    if (pImpl->scanning.exchange(true)) {
+        return false;
     }
+    if (pImpl->scanThread.joinable()) {
+        pImpl->scanThread.join();
+    }
+
+    Impl* impl = pImpl.get();
+    pImpl->scanThread = std::thread([impl]() {
+        impl->runScan();
+        impl->scanning.store(false);
+    });
+    return true;
 }
 
-bool PresetManager::savePreset(const std::string& name, const std::string& category) {
-    pImpl->clearError();
+bool PresetManager::isScanning() const {
+    return pImpl->scanning.load();
+}
 
-    if (!pImpl->serializer) {
-        pImpl->setError("No serializer bound");
-        return false;
+void PresetManager::waitForScan() {
+    if (pImpl->scanThread.joinable()) {
+        pImpl->scanThread.join();
     }
+}
 
+PresetScanStatistics PresetManager::getLastScanStatistics() const {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    return pImpl->lastScan;
+}
+
+bool PresetManager::saveIndex() {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
     if (pImpl->presetDirectory.empty()) {
         pImpl->setError("Preset directory not set");
         return false;
     }
+    if (!writeIndex(pImpl->presetDirectory, pImpl->presets)) {
+        pImpl->setError("Failed to write preset index");
+        return false;
+    }
+    pImpl->indexDirty = false;
+    return true;
+}
 
-    try {
-        std::filesystem::create_directories(pImpl->presetDirectory);
-    } catch (...) {
+std::string PresetManager::getIndexPath() const {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    return pImpl->presetDirectory.empty() ? std::string() : indexPathFor(pImpl->presetDirectory);
+}
+
+bool PresetManager::savePreset(const std::string& name, const std::string& category) {
+    std::string directory;
+    std::string filepath;
+    std::shared_ptr<ISerializer> serializer;
+    {
+        std::lock_guard<std::mutex> lock(pImpl->mutex);
+        pImpl->clearError();
+
+        if (!pImpl->serializer) {
+            pImpl->setError("No serializer bound");
+            return false;
+        }
+
+        if (pImpl->presetDirectory.empty()) {
+            pImpl->setError("Preset directory not set");
+            return false;
+        }
+
+        directory = pImpl->presetDirectory;
+        filepath = pImpl->buildPresetPath(name);
+        serializer = pImpl->serializer;
+    }
+
+    // Writing and hashing the file run without the mutex; only the index
+    // entry is published under it
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec) {
+        std::lock_guard<std::mutex> lock(pImpl->mutex);
         pImpl->setError("Failed to create preset directory");
         return false;
     }
 
-    std::string filepath = pImpl->buildPresetPath(name);
-    if (!pImpl->serializer->saveToFile(filepath)) {
-        pImpl->setError(pImpl->serializer->getLastError());
+    if (!serializer->saveToFile(filepath)) {
+        std::lock_guard<std::mutex> lock(pImpl->mutex);
+        pImpl->setError(serializer->getLastError());
         return false;
     }
 
-    PresetInfo info;
-    info.name = name;
-    info.filepath = filepath;
-    info.category = category;
-    info.createdTime = pImpl->currentTimestamp();
-    info.modifiedTime = info.createdTime;
-    pImpl->presets[name] = info;
-
-    pImpl->currentPresetName = name;
-    pImpl->modified = false;
+    IndexEntry entry;
+    entry.info.name = name;
+    entry.info.filepath = filepath;
+    entry.info.category = category;
+    entry.info.createdTime = pImpl->currentTimestamp();
+    refreshEntry(entry);
+
+    PresetSavedCallback callback;
+    {
+        std::lock_guard<std::mutex> lock(pImpl->mutex);
+        if (directory != pImpl->presetDirectory) {
+            // The directory changed while saving; the file is not indexed here
+            pImpl->setError("Preset directory changed while saving: " + name);
+            return false;
+        }
 
-    if (pImpl->savedCallback) {
-        pImpl->savedCallback(name);
+        // Keep authorship and creation time of the preset being replaced
+        if (const IndexEntry* existing = pImpl->find(name)) {
+            entry.info.author = existing->info.author;
+            if (existing->info.createdTime != 0) {
+                entry.info.createdTime = existing->info.createdTime;
+            }
+        }
+        pImpl->record(name, entry);
+
+        pImpl->currentPresetName = name;
+        pImpl->modified = false;
+        callback = pImpl->savedCallback;
+    }
+
+    if (callback) {
+        callback(name);
     }
 
     return true;
 }
 
 bool PresetManager::loadPreset(const std::string& name) {
-    pImpl->clearError();
-
-    if (!pImpl->serializer) {
-        pImpl->setError("No serializer bound");
-        return false;
+    std::string filepath;
+    std::shared_ptr<ISerializer> serializer;
+    {
+        std::lock_guard<std::mutex> lock(pImpl->mutex);
+        if (!pImpl->resolve(name, filepath, serializer)) {
+            return false;
+        }
     }
 
-    auto it = pImpl->presets.find(name);
-    if (it == pImpl->presets.end()) {
-        pImpl->setError("Preset not found: " + name);
+    if (!serializer->loadFromFile(filepath)) {
+        std::lock_guard<std::mutex> lock(pImpl->mutex);
+        pImpl->setError(serializer->getLastError());
         return false;
     }
 
-    if (!pImpl->serializer->loadFromFile(it->second.filepath)) {
-        pImpl->setError(pImpl->serializer->getLastError());
+    pImpl->finishLoad(name);
+    return true;
+}
+
+bool PresetManager::loadPresetAsync(const std::string& name, PresetMorpher& morpher,
+                                    uint32_t morphBlocks) {
+    if (pImpl->loading.exchange(true)) {
         return false;
     }
-
-    pImpl->currentPresetName = name;
-    pImpl->modified = false;
-
-    if (pImpl->loadedCallback) {
-        pImpl->loadedCallback(name);
+    if (pImpl->loadThread.joinable()) {
+        pImpl->loadThread.join();
     }
 
+    // Parameters the preset does not mention keep their current value
+    auto target = morpher.createState();
+
+    Impl* impl = pImpl.get();
+    pImpl->loadThread = std::thread(
+        [impl, name, &morpher, morphBlocks, target = std::move(target)]() mutable {
+            impl->loadState(name, morpher, std::move(target), morphBlocks);
+            impl->loading.store(false);
+        });
     return true;
 }
 
+bool PresetManager::isLoading() const {
+    return pImpl->loading.load();
+}
+
+void PresetManager::waitForLoad() {
+    if (pImpl->loadThread.joinable()) {
+        pImpl->loadThread.join();
+    }
+}
+
 bool PresetManager::deletePreset(const std::string& name) {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
     pImpl->clearError();
 
-    auto it = pImpl->presets.find(name);
-    if (it == pImpl->presets.end()) {
+    const IndexEntry* entry = pImpl->find(name);
+    if (!entry) {
         pImpl->setError("Preset not found: " + name);
         return false;
     }
 
     try {
-        std::filesystem::remove(it->second.filepath);
+        std::filesystem::remove(entry->info.filepath);
     } catch (...) {
         pImpl->setError("Failed to delete preset file");
         return false;
     }
 
-    pImpl->presets.erase(it);
+    pImpl->record(name, std::nullopt);
 
     if (pImpl->currentPresetName == name) {
         pImpl->currentPresetName.clear();
@@ -174,34 +710,50 @@ bool PresetManager::deletePreset(const std::string& name) {
 }
 
 bool PresetManager::renamePreset(const std::string& oldName, const std::string& newName) {
-    pImpl->clearError();
+    std::string directory;
+    std::string newPath;
+    IndexEntry renamed;
+    {
+        std::lock_guard<std::mutex> lock(pImpl->mutex);
+        pImpl->clearError();
+
+        const IndexEntry* entry = pImpl->find(oldName);
+        if (!entry) {
+            pImpl->setError("Preset not found: " + oldName);
+            return false;
+        }
 
-    auto it = pImpl->presets.find(oldName);
-    if (it == pImpl->presets.end()) {
-        pImpl->setError("Preset not found: " + oldName);
-        return false;
-    }
+        if (pImpl->find(newName)) {
+            pImpl->setError("Preset already exists: " + newName);
+            return false;
+        }
 
-    if (pImpl->presets.find(newName) != pImpl->presets.end()) {
-        pImpl->setError("Preset already exists: " + newName);
-        return false;
+        directory = pImpl->presetDirectory;
+        newPath = pImpl->buildPresetPath(newName);
+        renamed = *entry;
     }
 
-    std::string newPath = pImpl->buildPresetPath(newName);
-    try {
-        std::filesystem::rename(it->second.filepath, newPath);
-    } catch (...) {
+    // Moving and re-hashing the file run without the mutex, as in savePreset()
+    std::error_code ec;
+    std::filesystem::rename(renamed.info.filepath, newPath, ec);
+    if (ec) {
+        std::lock_guard<std::mutex> lock(pImpl->mutex);
         pImpl->setError("Failed to rename preset file");
         return false;
     }
 
-    PresetInfo info = it->second;
-    info.name = newName;
-    info.filepath = newPath;
-    info.modifiedTime = pImpl->currentTimestamp();
+    renamed.info.name = newName;
+    renamed.info.filepath = newPath;
+    refreshEntry(renamed);
+
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    if (directory != pImpl->presetDirectory) {
+        pImpl->setError("Preset directory changed while renaming: " + oldName);
+        return false;
+    }
 
-    pImpl->presets.erase(it);
-    pImpl->presets[newName] = info;
+    pImpl->record(oldName, std::nullopt);
+    pImpl->record(newName, renamed);
 
     if (pImpl->currentPresetName == oldName) {
         pImpl->currentPresetName = newName;
@@ -211,84 +763,121 @@ bool PresetManager::renamePreset(const std::string& oldName, const std::string&
 }
 
 bool PresetManager::duplicatePreset(const std::string& name, const std::string& newName) {
-    pImpl->clearError();
+    std::string directory;
+    std::string newPath;
+    IndexEntry copy;
+    {
+        std::lock_guard<std::mutex> lock(pImpl->mutex);
+        pImpl->clearError();
+
+        const IndexEntry* entry = pImpl->find(name);
+        if (!entry) {
+            pImpl->setError("Preset not found: " + name);
+            return false;
+        }
 
-    auto it = pImpl->presets.find(name);
-    if (it == pImpl->presets.end()) {
-        pImpl->setError("Preset not found: " + name);
-        return false;
-    }
+        if (pImpl->find(newName)) {
+            pImpl->setError("Preset already exists: " + newName);
+            return false;
+        }
 
-    if (pImpl->presets.find(newName) != pImpl->presets.end()) {
-        pImpl->setError("Preset already exists: " + newName);
-        return false;
+        directory = pImpl->presetDirectory;
+        newPath = pImpl->buildPresetPath(newName);
+        copy = *entry;
     }
 
-    std::string newPath = pImpl->buildPresetPath(newName);
-    try {
-        std::filesystem::copy_file(it->second.filepath, newPath);
-    } catch (...) {
+    std::error_code ec;
+    std::filesystem::copy_file(copy.info.filepath, newPath, ec);
+    if (ec) {
+        std::lock_guard<std::mutex> lock(pImpl->mutex);
         pImpl->setError("Failed to duplicate preset file");
         return false;
     }
 
-    PresetInfo info = it->second;
-    info.name = newName;
-    info.filepath = newPath;
-    info.createdTime = pImpl->currentTimestamp();
-    info.modifiedTime = info.createdTime;
-    pImpl->presets[newName] = info;
+    copy.info.name = newName;
+    copy.info.filepath = newPath;
+    copy.info.createdTime = pImpl->currentTimestamp();
+    refreshEntry(copy);
+
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    if (directory != pImpl->presetDirectory) {
+        pImpl->setError("Preset directory changed while duplicating: " + name);
+        return false;
+    }
+    pImpl->record(newName, copy);
 
     return true;
 }
 
 std::vector<std::string> PresetManager::getPresetNames() const {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
     std::vector<std::string> names;
     names.reserve(pImpl->presets.size());
     for (const auto& pair : pImpl->presets) {
         names.push_back(pair.first);
     }
-    std::sort(names.begin(), names.end());
     return names;
 }
 
 std::vector<std::string> PresetManager::getCategories() const {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
     std::vector<std::string> categories;
-    for (const auto& pair : pImpl->presets) {
-        if (!pair.second.category.empty()) {
-            if (std::find(categories.begin(), categories.end(), pair.second.category) == categories.end()) {
-                categories.push_back(pair.second.category);
-            }
-        }
+    categories.reserve(pImpl->categories.size());
+    for (const auto& pair : pImpl->categories) {
+        categories.push_back(pair.first);
     }
-    std::sort(categories.begin(), categories.end());
     return categories;
 }
 
 std::vector<std::string> PresetManager::getPresetsInCategory(const std::string& category) const {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
     std::vector<std::string> names;
-    for (const auto& pair : pImpl->presets) {
-        if (pair.second.category == category) {
-            names.push_back(pair.first);
+    if (category.empty()) {
+        for (const auto& pair : pImpl->presets) {
+            if (pair.second.info.category.empty()) {
+                names.push_back(pair.first);
+            }
         }
+        return names;
+    }
+
+    auto it = pImpl->categories.find(category);
+    if (it != pImpl->categories.end()) {
+        names.assign(it->second.begin(), it->second.end());
     }
-    std::sort(names.begin(), names.end());
     return names;
 }
 
+std::vector<std::string> PresetManager::findPresetsByPrefix(const std::string& prefix) const {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    std::vector<std::string> names;
+    for (auto it = pImpl->presets.lower_bound(prefix);
+         it != pImpl->presets.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it) {
+        names.push_back(it->first);
+    }
+    return names;
+}
+
+size_t PresetManager::getPresetCount() const {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    return pImpl->presets.size();
+}
+
 bool PresetManager::presetExists(const std::string& name) const {
-    return pImpl->presets.find(name) != pImpl->presets.end();
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    return pImpl->find(name) != nullptr;
 }
 
 PresetInfo PresetManager::getPresetInfo(const std::string& name) const {
-    auto it = pImpl->presets.find(name);
-    if (it != pImpl->presets.end()) {
-        return it->second;
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    if (const IndexEntry* entry = pImpl->find(name)) {
+        return entry->info;
     }
     return PresetInfo{};
 }
 
 std::string PresetManager::getCurrentPresetName() const {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
     return pImpl->currentPresetName;
 }
 
@@ -305,10 +894,12 @@ void PresetManager::clearModifiedFlag() {
 }
 
 void PresetManager::setSerializer(std::shared_ptr<ISerializer> serializer) {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
     pImpl->serializer = std::move(serializer);
 }
 
 std::shared_ptr<ISerializer> PresetManager::getSerializer() const {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
     return pImpl->serializer;
 }
 
@@ -321,14 +912,22 @@ ParameterGroup* PresetManager::getParameterGroup() const {
 }
 
 void PresetManager::setPresetLoadedCallback(PresetLoadedCallback callback) {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
     pImpl->loadedCallback = std::move(callback);
 }
 
 void PresetManager::setPresetSavedCallback(PresetSavedCallback callback) {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
     pImpl->savedCallback = std::move(callback);
 }
 
+void PresetManager::setScanCompletedCallback(ScanCompletedCallback callback) {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    pImpl->scanCallback = std::move(callback);
+}
+
 std::string PresetManager::getLastError() const {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
     return pImpl->lastError;
 }
 
@@ -1,6 +1,7 @@
 #ifndef NAP_PRESET_MANAGER_H
 #define NAP_PRESET_MANAGER_H
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <memory>
@@ -11,6 +12,7 @@ namespace nap {
 // Forward declarations
 class ISerializer;
 class ParameterGroup;
+class PresetMorpher;
 
 /**
  * @brief Preset information structure
@@ -20,19 +22,47 @@ struct PresetInfo {
     std::string filepath;
     std::string category;
     std::string author;
-    uint64_t createdTime;
-    uint64_t modifiedTime;
+    uint64_t createdTime = 0;   // Seconds since the epoch
+    uint64_t modifiedTime = 0;  // File modification time, seconds since the epoch
+    uint64_t fileSize = 0;
+    uint64_t contentHash = 0;   // 64-bit FNV-1a of the file contents
+};
+
+/**
+ * @brief What the last preset scan had to do
+ */
+struct PresetScanStatistics {
+    size_t filesSeen = 0;
+    size_t filesRead = 0;       // New or changed files that were hashed
+    size_t filesRemoved = 0;
+    uint64_t durationUs = 0;
 };
 
 /**
  * @brief Manager for storing and recalling named parameter states
  *
  * Handles preset organization, saving, loading, and categorization.
+ *
+ * Preset metadata (names, categories, authors, times, sizes and content
+ * hashes) is kept in an index file inside the preset directory. A scan
+ * loads the index once, then only stats each file and re-reads those
+ * whose modification time or size differ from the index, so rescanning a
+ * large library that has not changed reads no preset contents at all.
+ * scanPresetsAsync() runs the same scan on a background thread; queries
+ * keep answering from the previous state until it completes. Name,
+ * prefix and category queries are served from in-memory indexes.
+ *
+ * loadPreset() applies a preset on the calling thread. loadPresetAsync()
+ * instead reads and resolves the file into a target state on a loader
+ * thread and hands it to a PresetMorpher, which glides the parameters to
+ * it on the audio thread, so switching presets mid-performance neither
+ * steps nor stalls the audio callback.
  */
 class PresetManager {
 public:
     using PresetLoadedCallback = std::function<void(const std::string& presetName)>;
     using PresetSavedCallback = std::function<void(const std::string& presetName)>;
+    using ScanCompletedCallback = std::function<void(const PresetScanStatistics& stats)>;
 
     PresetManager();
     ~PresetManager();
@@ -48,6 +78,17 @@ public:
     std::string getPresetDirectory() const;
     void scanPresets();
 
+    // Background scanning; returns false if a scan is already running
+    bool scanPresetsAsync();
+    bool isScanning() const;
+    void waitForScan();
+    PresetScanStatistics getLastScanStatistics() const;
+
+    // Persistent index; written after each scan and on destruction when changed
+    static constexpr const char* INDEX_FILENAME = ".nap-preset-index";
+    bool saveIndex();
+    std::string getIndexPath() const;
+
     // Preset operations
     bool savePreset(const std::string& name, const std::string& category = "");
     bool loadPreset(const std::string& name);
@@ -55,10 +96,20 @@ public:
     bool renamePreset(const std::string& oldName, const std::string& newName);
     bool duplicatePreset(const std::string& name, const std::string& newName);
 
+    // Asynchronous loading through a morpher bound to the same parameters;
+    // false if a load is already running. The morpher must not be fed from
+    // another thread meanwhile. Completion fires the loaded callback on the
+    // loader thread; failures are reported through getLastError().
+    bool loadPresetAsync(const std::string& name, PresetMorpher& morpher, uint32_t morphBlocks = 0);
+    bool isLoading() const;
+    void waitForLoad();
+
     // Preset queries
     std::vector<std::string> getPresetNames() const;
     std::vector<std::string> getCategories() const;
     std::vector<std::string> getPresetsInCategory(const std::string& category) const;
+    std::vector<std::string> findPresetsByPrefix(const std::string& prefix) const;
+    size_t getPresetCount() const;
     bool presetExists(const std::string& name) const;
     PresetInfo getPresetInfo(const std::string& name) const;
 
@@ -79,6 +130,7 @@ public:
     // Callbacks
     void setPresetLoadedCallback(PresetLoadedCallback callback);
     void setPresetSavedCallback(PresetSavedCallback callback);
+    void setScanCompletedCallback(ScanCompletedCallback callback);  // Called on the scanning thread
 
     // Error handling
     std::string getLastError() const;
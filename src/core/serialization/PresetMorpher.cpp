@@ -0,0 +1,161 @@
+#include "core/serialization/PresetMorpher.h"
+#include "core/threading/SpscQueue.h"
+#include <atomic>
+#include <vector>
+
+namespace nap {
+
+class PresetMorpher::Impl {
+public:
+    struct Request {
+        StateVector* target = nullptr;
+        uint32_t blocks = 0;
+    };
+
+    Impl(ParameterGroup& root, size_t queueCapacity)
+        : layout(root)
+        , pending(queueCapacity)
+        , retired(queueCapacity + 1)
+        , maxOutstanding(retired.getCapacity()) {
+        layout.capture(current);
+        steppedTargets.resize(layout.getSteppedIndices().size());
+    }
+
+    ~Impl() {
+        delete active;
+        Request request;
+        while (pending.pop(request)) delete request.target;
+        reclaim();
+    }
+
+    // Control thread: free targets the audio thread is done with
+    void reclaim() {
+        StateVector* done;
+        while (retired.pop(done)) {
+            delete done;
+            --outstanding;
+        }
+    }
+
+    // Audio thread; cannot fail because outstanding targets never exceed the capacity
+    void retire(StateVector* target) {
+        retired.push(target);
+    }
+
+    void begin(const Request& request) {
+        if (active) retire(active);
+        active = request.target;
+        remaining = request.blocks;
+
+        // Morph from the live values so edits made since the last morph are kept
+        layout.capture(current);
+
+        // Stepped slots hold still until the last block
+        const auto& stepped = layout.getSteppedIndices();
+        float* target = active->data();
+        for (size_t k = 0; k < stepped.size(); ++k) {
+            steppedTargets[k] = target[stepped[k]];
+            target[stepped[k]] = current[stepped[k]];
+        }
+        morphing.store(true, std::memory_order_release);
+    }
+
+    void finish() {
+        const auto& stepped = layout.getSteppedIndices();
+        float* target = active->data();
+        for (size_t k = 0; k < stepped.size(); ++k) {
+            target[stepped[k]] = steppedTargets[k];
+        }
+
+        current = *active;  // Same size, so this copies without allocating
+        layout.apply(current);
+
+        retire(active);
+        active = nullptr;
+        completed.fetch_add(1, std::memory_order_relaxed);
+        morphing.store(false, std::memory_order_release);
+    }
+
+    bool process() {
+        // Only the newest target matters; older ones are dropped unapplied
+        Request request;
+        bool received = false;
+        Request latest;
+        while (pending.pop(request)) {
+            if (received) retire(latest.target);
+            latest = request;
+            received = true;
+        }
+        if (received) begin(latest);
+
+        if (!active) return false;
+
+        if (remaining <= 1) {
+            finish();
+            return false;
+        }
+
+        // An equal share of the remaining distance keeps the glide linear
+        current.lerpTowards(*active, 1.0f / static_cast<float>(remaining));
+        --remaining;
+        layout.apply(current);
+        return true;
+    }
+
+    ParameterStateLayout layout;
+
+    SpscQueue<Request> pending;
+    SpscQueue<StateVector*> retired;
+    const size_t maxOutstanding;
+    size_t outstanding = 0;  // Control thread: handed over and not yet reclaimed
+
+    // Audio thread
+    StateVector* active = nullptr;
+    StateVector current;
+    std::vector<float> steppedTargets;
+    uint32_t remaining = 0;
+
+    std::atomic<bool> morphing{false};
+    std::atomic<uint64_t> completed{0};
+};
+
+PresetMorpher::PresetMorpher(ParameterGroup& root, size_t queueCapacity)
+    : pImpl(std::make_unique<Impl>(root, queueCapacity)) {}
+
+PresetMorpher::~PresetMorpher() = default;
+
+const ParameterStateLayout& PresetMorpher::getLayout() const {
+    return pImpl->layout;
+}
+
+std::unique_ptr<StateVector> PresetMorpher::createState() const {
+    auto state = std::make_unique<StateVector>(pImpl->layout.size());
+    pImpl->layout.capture(*state);
+    return state;
+}
+
+bool PresetMorpher::morphTo(std::unique_ptr<StateVector> target, uint32_t blocks) {
+    pImpl->reclaim();
+
+    if (!target || target->size() != pImpl->layout.size()) return false;
+    if (pImpl->outstanding >= pImpl->maxOutstanding) return false;
+    if (!pImpl->pending.push({target.get(), blocks})) return false;
+
+    target.release();
+    ++pImpl->outstanding;
+    return true;
+}
+
+bool PresetMorpher::process() {
+    return pImpl->process();
+}
+
+bool PresetMorpher::isMorphing() const {
+    return pImpl->morphing.load(std::memory_order_acquire) || !pImpl->pending.isEmpty();
+}
+
+uint64_t PresetMorpher::getCompletedMorphCount() const {
+    return pImpl->completed.load(std::memory_order_relaxed);
+}
+
+} // namespace nap
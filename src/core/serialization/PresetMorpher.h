@@ -0,0 +1,61 @@
+#ifndef NAP_PRESET_MORPHER_H
+#define NAP_PRESET_MORPHER_H
+
+#include "core/serialization/ParameterStateLayout.h"
+#include "core/serialization/StateVector.h"
+#include <cstdint>
+#include <memory>
+
+namespace nap {
+
+/**
+ * @brief Glides a parameter tree to prepared target states on the audio thread
+ *
+ * A control or loader thread builds a complete target StateVector (for
+ * example with ISerializer::readParameterState()) and hands it over with
+ * morphTo(). The audio thread calls process() once per block: it picks up
+ * the newest target, then moves every continuous parameter an equal step
+ * towards it on each block, so a morph over N blocks is linear and ends
+ * exactly on the target. Int, bool and enum parameters switch on the last
+ * block. A target arriving mid-morph starts a new morph from wherever the
+ * parameters are at that moment.
+ *
+ * The hand-over goes through wait-free queues and process() works on
+ * buffers sized at construction, so the audio thread never blocks,
+ * allocates or frees; replaced targets travel back and are deleted on the
+ * next morphTo() call. Values are written without change callbacks.
+ */
+class PresetMorpher {
+public:
+    static constexpr size_t kDefaultQueueCapacity = 4;
+
+    explicit PresetMorpher(ParameterGroup& root, size_t queueCapacity = kDefaultQueueCapacity);
+    ~PresetMorpher();
+
+    // Non-copyable, non-movable (the audio thread holds on to it)
+    PresetMorpher(const PresetMorpher&) = delete;
+    PresetMorpher& operator=(const PresetMorpher&) = delete;
+
+    const ParameterStateLayout& getLayout() const;
+
+    // Control thread: a state sized for the layout, holding the live values
+    std::unique_ptr<StateVector> createState() const;
+
+    // Control thread: queue a target; blocks == 0 switches on the next block.
+    // False if the state does not match the layout or too many are in flight.
+    bool morphTo(std::unique_ptr<StateVector> target, uint32_t blocks);
+
+    // Audio thread: advance by one block; true while a morph is running
+    bool process();
+
+    bool isMorphing() const;
+    uint64_t getCompletedMorphCount() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace nap
+
+#endif // NAP_PRESET_MORPHER_H
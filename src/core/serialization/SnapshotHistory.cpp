@@ -0,0 +1,475 @@
+#include "core/serialization/SnapshotHistory.h"
+#include "core/serialization/StateVector.h"
+#include "core/threading/WorkerThread.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+namespace nap {
+
+namespace {
+
+constexpr uint32_t kFileMagic = 0x4E415048;  // "NAPH"
+constexpr uint16_t kFileVersion = 1;
+constexpr size_t kDefaultArenaKeyframes = 16;
+
+enum RecordType : uint8_t {
+    kKeyframeRecord = 0,
+    kDeltaRecord = 1
+};
+
+struct FileHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t stateSize;
+};
+
+// Followed by wordCount 32-bit words: the state for keyframes, index/XOR pairs for deltas
+struct FileRecord {
+    uint64_t sequence;
+    uint32_t wordCount;
+    uint8_t type;
+    uint8_t reserved[3];
+};
+
+uint32_t bitsOf(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+float floatOf(uint32_t bits) {
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+} // namespace
+
+class SnapshotHistory::Impl {
+public:
+    // Where a record lives in the arena; sequence is stored last and marks it valid
+    struct Descriptor {
+        std::atomic<uint64_t> sequence{0};
+        std::atomic<uint64_t> keyframe{0};  // Sequence of the keyframe the record builds on
+        std::atomic<uint32_t> offset{0};
+        std::atomic<uint32_t> length{0};
+    };
+
+    Impl(size_t stateSize, size_t maxSnapshots, uint32_t keyframeInterval, size_t arenaWords)
+        : stateSize(stateSize)
+        , keyframeInterval(std::max<uint32_t>(keyframeInterval, 1))
+        , descriptorCount(std::max<size_t>(maxSnapshots, 2))
+        , descriptors(new Descriptor[descriptorCount])
+        , arenaWords(std::max({arenaWords, stateSize * 2, size_t(64)}))
+        , arena(new std::atomic<uint32_t>[this->arenaWords])
+        , last(stateSize, 0)
+        , diff(stateSize * 2)
+        , worker("SnapshotHistory", WorkerThread::Priority::Low) {
+        for (size_t i = 0; i < this->arenaWords; ++i) {
+            arena[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    const size_t stateSize;
+    const uint32_t keyframeInterval;
+    const size_t descriptorCount;
+    std::unique_ptr<Descriptor[]> descriptors;
+    const size_t arenaWords;
+    std::unique_ptr<std::atomic<uint32_t>[]> arena;
+
+    // Published by the writer; readers validate against oldest after reading
+    std::atomic<uint64_t> latest{0};
+    std::atomic<uint64_t> oldest{1};
+    std::atomic<size_t> storedWords{0};
+
+    // Writer only
+    std::vector<uint32_t> last;
+    std::vector<uint32_t> diff;
+    size_t writeOffset = 0;
+    uint64_t lastKeyframe = 0;
+    uint32_t sinceKeyframe = 0;
+
+    // Persistence
+    WorkerThread worker;
+    std::mutex stopMutex;
+    std::condition_variable stopCv;
+    bool stopRequested = false;
+    uint32_t intervalMs = 100;
+    std::ofstream file;
+    bool fileNeedsKeyframe = true;
+    std::atomic<uint64_t> persisted{0};
+    std::vector<uint32_t> persistWords;
+    StateVector persistState;
+
+    Descriptor& descriptor(uint64_t sequence) const {
+        return descriptors[sequence % descriptorCount];
+    }
+
+    // Writer: drop the oldest record
+    void evict() {
+        const uint64_t sequence = oldest.load(std::memory_order_relaxed);
+        storedWords.fetch_sub(descriptor(sequence).length.load(std::memory_order_relaxed),
+                              std::memory_order_relaxed);
+        oldest.store(sequence + 1, std::memory_order_relaxed);
+    }
+
+    // Writer: find room for length words, evicting whatever is in the way
+    size_t reserve(size_t length) {
+        const uint64_t newest = latest.load(std::memory_order_relaxed);
+        auto live = [&]() { return oldest.load(std::memory_order_relaxed) <= newest; };
+        auto oldestDescriptor = [&]() -> Descriptor& {
+            return descriptor(oldest.load(std::memory_order_relaxed));
+        };
+
+        size_t start = writeOffset;
+        if (start + length > arenaWords) {
+            // Records between here and the end are the oldest; wrap past them
+            while (live() && oldestDescriptor().offset.load(std::memory_order_relaxed) >= start) {
+                evict();
+            }
+            start = 0;
+        }
+
+        while (live()) {
+            const Descriptor& d = oldestDescriptor();
+            const size_t offset = d.offset.load(std::memory_order_relaxed);
+            const size_t end = offset + d.length.load(std::memory_order_relaxed);
+            const bool ringFull = newest - oldest.load(std::memory_order_relaxed) + 1 >= descriptorCount;
+            if (!ringFull && (offset >= start + length || end <= start)) break;
+            evict();
+        }
+
+        // Readers that see any word written below also see the records it replaced as evicted
+        std::atomic_thread_fence(std::memory_order_release);
+
+        writeOffset = start + length;
+        return start;
+    }
+
+    uint64_t capture(const StateVector& state) {
+        if (state.size() != stateSize || stateSize == 0) return 0;
+
+        const float* values = state.data();
+        size_t pairs = 0;
+        for (size_t i = 0; i < stateSize; ++i) {
+            const uint32_t delta = bitsOf(values[i]) ^ last[i];
+            if (delta != 0) {
+                diff[pairs * 2] = static_cast<uint32_t>(i);
+                diff[pairs * 2 + 1] = delta;
+                ++pairs;
+            }
+        }
+
+        const uint64_t previous = latest.load(std::memory_order_relaxed);
+        if (previous != 0 && pairs == 0) {
+            return previous;
+        }
+
+        bool keyframe = previous == 0 || sinceKeyframe + 1 >= keyframeInterval ||
+                        pairs * 2 >= stateSize;
+        size_t length = keyframe ? stateSize : pairs * 2;
+        const uint64_t sequence = previous + 1;
+        size_t offset = reserve(length);
+        if (!keyframe && lastKeyframe < oldest.load(std::memory_order_relaxed)) {
+            // Making room evicted the keyframe this delta would build on, so
+            // nothing after it could be restored; store a keyframe instead
+            writeOffset = offset;
+            keyframe = true;
+            length = stateSize;
+            offset = reserve(length);
+        }
+
+        for (size_t i = 0; i < stateSize; ++i) {
+            last[i] = bitsOf(values[i]);
+        }
+        const uint32_t* source = keyframe ? last.data() : diff.data();
+        for (size_t i = 0; i < length; ++i) {
+            arena[offset + i].store(source[i], std::memory_order_relaxed);
+        }
+
+        if (keyframe) {
+            lastKeyframe = sequence;
+            sinceKeyframe = 0;
+        } else {
+            ++sinceKeyframe;
+        }
+
+        Descriptor& d = descriptor(sequence);
+        d.offset.store(static_cast<uint32_t>(offset), std::memory_order_relaxed);
+        d.length.store(static_cast<uint32_t>(length), std::memory_order_relaxed);
+        d.keyframe.store(lastKeyframe, std::memory_order_relaxed);
+        d.sequence.store(sequence, std::memory_order_release);
+
+        storedWords.fetch_add(length, std::memory_order_relaxed);
+        latest.store(sequence, std::memory_order_release);
+        return sequence;
+    }
+
+    // Reader: bounds of one record, or false if it is gone or malformed
+    bool locate(uint64_t sequence, size_t& offset, size_t& length, uint64_t& keyframe) const {
+        const Descriptor& d = descriptor(sequence);
+        if (d.sequence.load(std::memory_order_acquire) != sequence) return false;
+        offset = d.offset.load(std::memory_order_relaxed);
+        length = d.length.load(std::memory_order_relaxed);
+        keyframe = d.keyframe.load(std::memory_order_relaxed);
+        return offset + length <= arenaWords && keyframe <= sequence;
+    }
+
+    // Reader: true if nothing from sequence on was evicted while it was read
+    bool stillValid(uint64_t sequence) const {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return oldest.load(std::memory_order_relaxed) <= sequence;
+    }
+
+    bool restore(uint64_t sequence, StateVector& state) const {
+        if (sequence == 0 || sequence > latest.load(std::memory_order_acquire)) return false;
+        if (sequence < oldest.load(std::memory_order_acquire)) return false;
+
+        size_t offset, length;
+        uint64_t keyframe;
+        if (!locate(sequence, offset, length, keyframe)) return false;
+        if (keyframe < oldest.load(std::memory_order_acquire)) return false;
+
+        state.resize(stateSize);
+        float* values = state.data();
+        for (uint64_t s = keyframe; s <= sequence; ++s) {
+            uint64_t base;
+            if (!locate(s, offset, length, base)) return false;
+
+            if (s == keyframe) {
+                if (length != stateSize) return false;
+                for (size_t i = 0; i < stateSize; ++i) {
+                    values[i] = floatOf(arena[offset + i].load(std::memory_order_relaxed));
+                }
+                continue;
+            }
+            for (size_t p = 0; p + 1 < length; p += 2) {
+                const uint32_t index = arena[offset + p].load(std::memory_order_relaxed);
+                const uint32_t delta = arena[offset + p + 1].load(std::memory_order_relaxed);
+                if (index >= stateSize) return false;
+                values[index] = floatOf(bitsOf(values[index]) ^ delta);
+            }
+        }
+        return stillValid(keyframe);
+    }
+
+    // Reader: copy one record as stored
+    bool copyRecord(uint64_t sequence, std::vector<uint32_t>& words, bool& keyframe) const {
+        size_t offset, length;
+        uint64_t base;
+        if (!locate(sequence, offset, length, base)) return false;
+
+        words.resize(length);
+        for (size_t i = 0; i < length; ++i) {
+            words[i] = arena[offset + i].load(std::memory_order_relaxed);
+        }
+        keyframe = base == sequence;
+        return stillValid(sequence);
+    }
+
+    void writeRecord(uint64_t sequence, RecordType type, const uint32_t* words, size_t count) {
+        FileRecord record{};
+        record.sequence = sequence;
+        record.wordCount = static_cast<uint32_t>(count);
+        record.type = type;
+        file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+        file.write(reinterpret_cast<const char*>(words), static_cast<std::streamsize>(count * sizeof(uint32_t)));
+    }
+
+    // Persisting thread: append every record captured since the last pass
+    void persist() {
+        const uint64_t newest = latest.load(std::memory_order_acquire);
+        uint64_t done = persisted.load(std::memory_order_relaxed);
+
+        while (done < newest) {
+            const uint64_t sequence = done + 1;
+            bool keyframe = false;
+            if (copyRecord(sequence, persistWords, keyframe) && (keyframe || !fileNeedsKeyframe)) {
+                writeRecord(sequence, keyframe ? kKeyframeRecord : kDeltaRecord,
+                            persistWords.data(), persistWords.size());
+                fileNeedsKeyframe = false;
+                done = sequence;
+                continue;
+            }
+
+            // Fell behind the ring (or the file has no keyframe yet): write the newest state whole
+            if (!restore(newest, persistState)) break;
+            persistWords.resize(stateSize);
+            for (size_t i = 0; i < stateSize; ++i) {
+                persistWords[i] = bitsOf(persistState[i]);
+            }
+            writeRecord(newest, kKeyframeRecord, persistWords.data(), stateSize);
+            fileNeedsKeyframe = false;
+            done = newest;
+        }
+
+        file.flush();
+        persisted.store(done, std::memory_order_release);
+    }
+
+    void workerLoop() {
+        std::unique_lock<std::mutex> lock(stopMutex);
+        while (!stopRequested) {
+            lock.unlock();
+            persist();
+            lock.lock();
+            stopCv.wait_for(lock, std::chrono::milliseconds(intervalMs),
+                            [this]() { return stopRequested; });
+        }
+    }
+};
+
+SnapshotHistory::SnapshotHistory(size_t stateSize, size_t maxSnapshots,
+                                 uint32_t keyframeInterval, size_t arenaWords)
+    : pImpl(std::make_unique<Impl>(stateSize, maxSnapshots, keyframeInterval,
+                                   arenaWords ? arenaWords : stateSize * kDefaultArenaKeyframes)) {}
+
+SnapshotHistory::~SnapshotHistory() {
+    stopPersisting();
+}
+
+size_t SnapshotHistory::getStateSize() const {
+    return pImpl->stateSize;
+}
+
+uint64_t SnapshotHistory::capture(const StateVector& state) {
+    return pImpl->capture(state);
+}
+
+uint64_t SnapshotHistory::getLatestSequence() const {
+    return pImpl->latest.load(std::memory_order_acquire);
+}
+
+uint64_t SnapshotHistory::getOldestSequence() const {
+    const uint64_t newest = pImpl->latest.load(std::memory_order_acquire);
+    const uint64_t first = pImpl->oldest.load(std::memory_order_acquire);
+
+    // Deltas whose keyframe was evicted cannot be restored
+    for (uint64_t s = first; s <= newest; ++s) {
+        size_t offset, length;
+        uint64_t keyframe;
+        if (pImpl->locate(s, offset, length, keyframe) && keyframe >= first) {
+            return s;
+        }
+    }
+    return 0;
+}
+
+bool SnapshotHistory::restore(uint64_t sequence, StateVector& state) const {
+    return pImpl->restore(sequence, state);
+}
+
+size_t SnapshotHistory::getStoredWords() const {
+    return pImpl->storedWords.load(std::memory_order_relaxed);
+}
+
+bool SnapshotHistory::startPersisting(const std::string& filepath, uint32_t intervalMs) {
+    if (pImpl->worker.isRunning()) {
+        return false;
+    }
+
+    pImpl->file.open(filepath, std::ios::binary | std::ios::trunc);
+    if (!pImpl->file.is_open()) {
+        return false;
+    }
+    const FileHeader header{kFileMagic, kFileVersion, 0, static_cast<uint32_t>(pImpl->stateSize)};
+    pImpl->file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    pImpl->fileNeedsKeyframe = true;
+    pImpl->persisted.store(0, std::memory_order_relaxed);
+
+    {
+        std::lock_guard<std::mutex> lock(pImpl->stopMutex);
+        pImpl->stopRequested = false;
+        pImpl->intervalMs = intervalMs;
+    }
+
+    Impl* impl = pImpl.get();
+    pImpl->worker.setTask([impl]() { impl->workerLoop(); });
+    if (!pImpl->worker.start()) {
+        pImpl->file.close();
+        return false;
+    }
+    pImpl->worker.wake();
+    return true;
+}
+
+void SnapshotHistory::stopPersisting() {
+    if (!pImpl->file.is_open()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(pImpl->stopMutex);
+        pImpl->stopRequested = true;
+    }
+    pImpl->stopCv.notify_all();
+    pImpl->worker.stop(true);
+
+    pImpl->persist();
+    pImpl->file.close();
+}
+
+bool SnapshotHistory::isPersisting() const {
+    return pImpl->worker.isRunning();
+}
+
+uint64_t SnapshotHistory::getPersistedSequence() const {
+    return pImpl->persisted.load(std::memory_order_acquire);
+}
+
+bool SnapshotHistory::recover(const std::string& filepath, StateVector& state, uint64_t* sequence) {
+    std::ifstream file(filepath, std::ios::binary);
+    FileHeader header{};
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        header.magic != kFileMagic || header.version != kFileVersion) {
+        return false;
+    }
+
+    std::vector<uint32_t> words;
+    StateVector restored;
+    restored.resize(header.stateSize);
+    uint64_t restoredSequence = 0;
+    bool haveKeyframe = false;
+
+    FileRecord record{};
+    while (file.read(reinterpret_cast<char*>(&record), sizeof(record))) {
+        words.resize(record.wordCount);
+        // A record cut short by a crash ends the file
+        if (!file.read(reinterpret_cast<char*>(words.data()),
+                       static_cast<std::streamsize>(words.size() * sizeof(uint32_t)))) {
+            break;
+        }
+
+        if (record.type == kKeyframeRecord) {
+            if (words.size() != header.stateSize) return false;
+            for (size_t i = 0; i < words.size(); ++i) {
+                restored[i] = floatOf(words[i]);
+            }
+            haveKeyframe = true;
+        } else if (record.type == kDeltaRecord && haveKeyframe) {
+            for (size_t p = 0; p + 1 < words.size(); p += 2) {
+                if (words[p] >= header.stateSize) return false;
+                restored[words[p]] = floatOf(bitsOf(restored[words[p]]) ^ words[p + 1]);
+            }
+        } else {
+            return false;
+        }
+        restoredSequence = record.sequence;
+    }
+
+    if (!haveKeyframe) {
+        return false;
+    }
+    state = restored;
+    if (sequence) *sequence = restoredSequence;
+    return true;
+}
+
+} // namespace nap
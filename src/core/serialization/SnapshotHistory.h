@@ -0,0 +1,80 @@
+#ifndef NAP_SNAPSHOT_HISTORY_H
+#define NAP_SNAPSHOT_HISTORY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace nap {
+
+class StateVector;
+
+/**
+ * @brief Preallocated ring of StateVector snapshots for undo and crash recovery
+ *
+ * Each capture() is stored as the XOR of the state against the previous
+ * capture, as sparse (index, bits) pairs, with a full keyframe every
+ * keyframeInterval captures, whenever the diff would be larger than the
+ * keyframe, or when making room overwrote the keyframe the diff would
+ * build on. Records live in a fixed word arena; the oldest are overwritten
+ * as it fills. A capture of an unchanged state stores nothing.
+ *
+ * capture() is wait-free and allocation-free, so it can run on the audio
+ * thread; it must only ever be called from one thread. restore() may run
+ * concurrently on any thread: it rebuilds a snapshot from its keyframe and
+ * the diffs after it and fails, rather than returning torn data, if the
+ * writer overwrote them meanwhile.
+ *
+ * startPersisting() appends every record to a file from a background
+ * WorkerThread; recover() replays such a file into the last state it
+ * reached, ignoring a record cut short by a crash.
+ */
+class SnapshotHistory {
+public:
+    static constexpr size_t kDefaultMaxSnapshots = 1024;
+    static constexpr uint32_t kDefaultKeyframeInterval = 32;
+
+    // Sizes the arena for 16 keyframes unless arenaWords is given
+    explicit SnapshotHistory(size_t stateSize,
+                             size_t maxSnapshots = kDefaultMaxSnapshots,
+                             uint32_t keyframeInterval = kDefaultKeyframeInterval,
+                             size_t arenaWords = 0);
+    ~SnapshotHistory();
+
+    // Non-copyable, non-movable (writer and readers share it by reference)
+    SnapshotHistory(const SnapshotHistory&) = delete;
+    SnapshotHistory& operator=(const SnapshotHistory&) = delete;
+
+    size_t getStateSize() const;
+
+    // Writer thread: returns the sequence number now holding state (the
+    // previous one if nothing changed), or 0 if the size does not match
+    uint64_t capture(const StateVector& state);
+
+    // Any thread. Sequence numbers start at 1; 0 means empty.
+    uint64_t getLatestSequence() const;
+    uint64_t getOldestSequence() const;  // Oldest snapshot that can still be restored
+    bool restore(uint64_t sequence, StateVector& state) const;
+
+    // Footprint of the stored records, for monitoring compression
+    size_t getStoredWords() const;
+
+    // Background persistence; the file is truncated on start
+    bool startPersisting(const std::string& filepath, uint32_t intervalMs = 100);
+    void stopPersisting();  // Writes out everything captured so far
+    bool isPersisting() const;
+    uint64_t getPersistedSequence() const;
+
+    // Rebuilds the last state stored in a persisted file
+    static bool recover(const std::string& filepath, StateVector& state,
+                        uint64_t* sequence = nullptr);
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace nap
+
+#endif // NAP_SNAPSHOT_HISTORY_H
@@ -2,6 +2,15 @@
 #include <cmath>
 #include <cstring>
 #include <algorithm>
+#include <limits>
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define NAP_STATE_VECTOR_SSE 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define NAP_STATE_VECTOR_NEON 1
+#endif
 
 namespace nap {
 
@@ -131,14 +140,39 @@ StateVector StateVector::lerp(const StateVector& a, const StateVector& b, float
     StateVector result(size);
     result.resize(size);
 
-    t = std::clamp(t, 0.0f, 1.0f);
-    for (size_t i = 0; i < size; ++i) {
-        result.pImpl->data[i] = a.pImpl->data[i] + t * (b.pImpl->data[i] - a.pImpl->data[i]);
-    }
-
+    lerp(a.data(), b.data(), result.data(), size, std::clamp(t, 0.0f, 1.0f));
     return result;
 }
 
+bool StateVector::lerpTowards(const StateVector& target, float t) {
+    if (size() != target.size()) return false;
+
+    lerp(data(), target.data(), data(), size(), std::clamp(t, 0.0f, 1.0f));
+    return true;
+}
+
+void StateVector::lerp(const float* a, const float* b, float* out, size_t count, float t) {
+    size_t i = 0;
+#if defined(NAP_STATE_VECTOR_SSE)
+    const __m128 vt = _mm_set1_ps(t);
+    for (; i + 4 <= count; i += 4) {
+        const __m128 va = _mm_loadu_ps(a + i);
+        const __m128 vb = _mm_loadu_ps(b + i);
+        _mm_storeu_ps(out + i, _mm_add_ps(va, _mm_mul_ps(vt, _mm_sub_ps(vb, va))));
+    }
+#elif defined(NAP_STATE_VECTOR_NEON)
+    const float32x4_t vt = vdupq_n_f32(t);
+    for (; i + 4 <= count; i += 4) {
+        const float32x4_t va = vld1q_f32(a + i);
+        const float32x4_t vb = vld1q_f32(b + i);
+        vst1q_f32(out + i, vmlaq_f32(va, vt, vsubq_f32(vb, va)));
+    }
+#endif
+    for (; i < count; ++i) {
+        out[i] = a[i] + t * (b[i] - a[i]);
+    }
+}
+
 std::vector<uint8_t> StateVector::toBytes() const {
     std::vector<uint8_t> bytes;
     bytes.resize(sizeof(uint32_t) + pImpl->data.size() * sizeof(float));
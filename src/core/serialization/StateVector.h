@@ -13,6 +13,10 @@ namespace nap {
  *
  * Provides efficient storage and comparison of parameter states
  * for undo/redo, automation, and interpolation.
+ *
+ * lerpTowards() is safe on the audio thread: it works in place on the
+ * existing storage, so morphing between two prepared states never
+ * allocates.
  */
 class StateVector {
 public:
@@ -55,6 +59,13 @@ public:
     // Interpolation
     static StateVector lerp(const StateVector& a, const StateVector& b, float t);
 
+    // Moves every value the fraction t of the way towards target, in place and
+    // without allocating; false if the sizes differ. Vectorized where available.
+    bool lerpTowards(const StateVector& target, float t);
+
+    // out[i] = a[i] + t * (b[i] - a[i]); out may alias a or b
+    static void lerp(const float* a, const float* b, float* out, size_t count, float t);
+
     // Serialization helpers
     std::vector<uint8_t> toBytes() const;
     bool fromBytes(const std::vector<uint8_t>& bytes);
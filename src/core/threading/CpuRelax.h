@@ -0,0 +1,24 @@
+#ifndef NAP_CPURELAX_H
+#define NAP_CPURELAX_H
+
+namespace nap {
+
+/**
+ * @brief Issue a CPU spin-wait hint (PAUSE on x86, YIELD on ARM).
+ *
+ * Tells the core it is in a spin loop, which frees pipeline resources for
+ * the sibling hyperthread and avoids a memory-order mis-speculation flush
+ * when the awaited cache line finally changes.
+ */
+inline void cpuRelax()
+{
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+} // namespace nap
+
+#endif // NAP_CPURELAX_H
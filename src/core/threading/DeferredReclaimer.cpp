@@ -0,0 +1,335 @@
+#include "DeferredReclaimer.h"
+#include "WorkerThread.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+namespace nap {
+
+class DeferredReclaimer::Impl {
+public:
+    struct Retired {
+        std::shared_ptr<void> shared;
+        void* raw = nullptr;
+        Deleter deleter = nullptr;
+        std::uint64_t epoch = 0;
+
+        void destroy()
+        {
+            shared.reset();
+            if (raw && deleter) {
+                deleter(raw);
+            }
+            raw = nullptr;
+            deleter = nullptr;
+        }
+    };
+
+    explicit Impl(std::size_t capacity)
+        : ring(capacity + 1)
+        , worker("DeferredReclaimer", WorkerThread::Priority::Low)
+    {
+        limbo.reserve(capacity);
+        for (auto& epoch : readerEpochs) {
+            epoch.store(0, std::memory_order_relaxed);
+        }
+        for (auto& used : readerUsed) {
+            used.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    // Producer side of the SPSC ring; never blocks, never allocates.
+    bool push(Retired& entry)
+    {
+        const std::size_t tail = ringTail.load(std::memory_order_relaxed);
+        const std::size_t next = (tail + 1) % ring.size();
+        if (next == ringHead.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        ring[tail] = std::move(entry);
+        ringTail.store(next, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(Retired& entry)
+    {
+        const std::size_t head = ringHead.load(std::memory_order_relaxed);
+        if (head == ringTail.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        entry = std::move(ring[head]);
+        ring[head] = Retired{};
+        ringHead.store((head + 1) % ring.size(), std::memory_order_release);
+        return true;
+    }
+
+    // On a full ring the entry is handed back untouched: destroying it here
+    // would free on the audio thread, and readers may still hold it
+    bool enqueue(Retired& entry)
+    {
+        entry.epoch = globalEpoch.load(std::memory_order_seq_cst);
+        pendingCount.fetch_add(1, std::memory_order_relaxed);
+
+        if (push(entry)) {
+            return true;
+        }
+
+        pendingCount.fetch_sub(1, std::memory_order_relaxed);
+        overflowCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Objects retired before this epoch cannot be referenced by any reader.
+    std::uint64_t safeEpoch() const
+    {
+        std::uint64_t oldest = globalEpoch.load(std::memory_order_seq_cst);
+        for (const auto& epoch : readerEpochs) {
+            const std::uint64_t active = epoch.load(std::memory_order_seq_cst);
+            if (active != 0 && active < oldest) {
+                oldest = active;
+            }
+        }
+        return oldest;
+    }
+
+    void workerLoop()
+    {
+        std::unique_lock<std::mutex> lock(stopMutex);
+        while (!stopRequested) {
+            lock.unlock();
+            collect();
+            lock.lock();
+            stopCv.wait_for(lock, std::chrono::milliseconds(intervalMs),
+                            [this]() { return stopRequested; });
+        }
+    }
+
+    std::size_t collect()
+    {
+        std::lock_guard<std::mutex> lock(collectMutex);
+
+        globalEpoch.fetch_add(1, std::memory_order_seq_cst);
+
+        Retired entry;
+        while (pop(entry)) {
+            limbo.push_back(std::move(entry));
+        }
+
+        // Partition the reclaimable entries to the back and erase them in one go
+        const std::uint64_t safe = safeEpoch();
+        const auto reclaimable = std::partition(limbo.begin(), limbo.end(),
+                                                [safe](const Retired& retired) {
+                                                    return retired.epoch >= safe;
+                                                });
+        for (auto it = reclaimable; it != limbo.end(); ++it) {
+            it->destroy();
+        }
+        const std::size_t destroyed = static_cast<std::size_t>(limbo.end() - reclaimable);
+        limbo.erase(reclaimable, limbo.end());
+
+        pendingCount.fetch_sub(destroyed, std::memory_order_relaxed);
+        reclaimedCount.fetch_add(destroyed, std::memory_order_relaxed);
+        return destroyed;
+    }
+
+    void destroyAll()
+    {
+        std::lock_guard<std::mutex> lock(collectMutex);
+
+        Retired entry;
+        while (pop(entry)) {
+            entry.destroy();
+        }
+        for (auto& retired : limbo) {
+            retired.destroy();
+        }
+        limbo.clear();
+        pendingCount.store(0, std::memory_order_relaxed);
+    }
+
+    std::vector<Retired> ring;
+    std::atomic<std::size_t> ringHead{0};
+    std::atomic<std::size_t> ringTail{0};
+
+    // Epoch 0 marks an idle reader, so the global epoch starts at 1.
+    std::atomic<std::uint64_t> globalEpoch{1};
+    std::array<std::atomic<std::uint64_t>, kMaxReaders> readerEpochs;
+    std::array<std::atomic<bool>, kMaxReaders> readerUsed;
+
+    std::vector<Retired> limbo;
+    std::mutex collectMutex;
+
+    std::atomic<std::size_t> pendingCount{0};
+    std::atomic<std::uint64_t> reclaimedCount{0};
+    std::atomic<std::uint64_t> overflowCount{0};
+
+    WorkerThread worker;
+    std::uint32_t intervalMs = 10;
+    bool stopRequested = false;
+    std::mutex stopMutex;
+    std::condition_variable stopCv;
+};
+
+DeferredReclaimer::DeferredReclaimer(std::size_t capacity)
+    : m_impl(std::make_unique<Impl>(capacity))
+{
+}
+
+DeferredReclaimer::~DeferredReclaimer()
+{
+    if (m_impl) {
+        stop();
+        m_impl->destroyAll();
+    }
+}
+
+DeferredReclaimer::DeferredReclaimer(DeferredReclaimer&&) noexcept = default;
+DeferredReclaimer& DeferredReclaimer::operator=(DeferredReclaimer&&) noexcept = default;
+
+bool DeferredReclaimer::start(std::uint32_t intervalMs)
+{
+    if (m_impl->worker.isRunning()) {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_impl->stopMutex);
+        m_impl->stopRequested = false;
+        m_impl->intervalMs = intervalMs;
+    }
+
+    Impl* impl = m_impl.get();
+    m_impl->worker.setTask([impl]() { impl->workerLoop(); });
+    if (!m_impl->worker.start()) {
+        return false;
+    }
+    m_impl->worker.wake();
+    return true;
+}
+
+void DeferredReclaimer::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_impl->stopMutex);
+        m_impl->stopRequested = true;
+    }
+    m_impl->stopCv.notify_all();
+    m_impl->worker.stop(true);
+}
+
+bool DeferredReclaimer::isRunning() const
+{
+    return m_impl->worker.isRunning();
+}
+
+int DeferredReclaimer::registerReader()
+{
+    for (int i = 0; i < kMaxReaders; ++i) {
+        bool expected = false;
+        if (m_impl->readerUsed[i].compare_exchange_strong(expected, true)) {
+            m_impl->readerEpochs[i].store(0, std::memory_order_seq_cst);
+            return i;
+        }
+    }
+    return -1;
+}
+
+void DeferredReclaimer::unregisterReader(int reader)
+{
+    if (reader < 0 || reader >= kMaxReaders) {
+        return;
+    }
+    m_impl->readerEpochs[reader].store(0, std::memory_order_seq_cst);
+    m_impl->readerUsed[reader].store(false, std::memory_order_release);
+}
+
+void DeferredReclaimer::enterBlock(int reader)
+{
+    if (reader < 0 || reader >= kMaxReaders) {
+        return;
+    }
+    m_impl->readerEpochs[reader].store(
+        m_impl->globalEpoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+}
+
+void DeferredReclaimer::exitBlock(int reader)
+{
+    if (reader < 0 || reader >= kMaxReaders) {
+        return;
+    }
+    m_impl->readerEpochs[reader].store(0, std::memory_order_seq_cst);
+}
+
+bool DeferredReclaimer::retireShared(std::shared_ptr<void>& object)
+{
+    if (!object) {
+        return false;
+    }
+
+    Impl::Retired entry;
+    entry.shared = std::move(object);
+    if (m_impl->enqueue(entry)) {
+        return true;
+    }
+    object = std::move(entry.shared);
+    return false;
+}
+
+bool DeferredReclaimer::retire(void* object, Deleter deleter)
+{
+    if (!object || !deleter) {
+        return false;
+    }
+
+    Impl::Retired entry;
+    entry.raw = object;
+    entry.deleter = deleter;
+    return m_impl->enqueue(entry);
+}
+
+std::size_t DeferredReclaimer::collect()
+{
+    return m_impl->collect();
+}
+
+std::size_t DeferredReclaimer::getPendingCount() const
+{
+    return m_impl->pendingCount.load(std::memory_order_relaxed);
+}
+
+std::uint64_t DeferredReclaimer::getReclaimedCount() const
+{
+    return m_impl->reclaimedCount.load(std::memory_order_relaxed);
+}
+
+std::uint64_t DeferredReclaimer::getOverflowCount() const
+{
+    return m_impl->overflowCount.load(std::memory_order_relaxed);
+}
+
+std::uint64_t DeferredReclaimer::getCurrentEpoch() const
+{
+    return m_impl->globalEpoch.load(std::memory_order_relaxed);
+}
+
+// ReclaimerBlockGuard implementation
+
+ReclaimerBlockGuard::ReclaimerBlockGuard(DeferredReclaimer& reclaimer, int reader)
+    : m_reclaimer(reclaimer)
+    , m_reader(reader)
+{
+    m_reclaimer.enterBlock(m_reader);
+}
+
+ReclaimerBlockGuard::~ReclaimerBlockGuard()
+{
+    m_reclaimer.exitBlock(m_reader);
+}
+
+} // namespace nap
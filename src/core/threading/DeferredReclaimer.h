@@ -0,0 +1,209 @@
+#ifndef NAP_DEFERREDRECLAIMER_H
+#define NAP_DEFERREDRECLAIMER_H
+
+#include <cstdint>
+#include <memory>
+
+namespace nap {
+
+/**
+ * @brief Moves destruction of objects released by the audio thread onto a
+ *        background WorkerThread.
+ *
+ * The audio thread hands retired objects (the last shared_ptr to a removed
+ * node, a replaced IR buffer, ...) to retire(), which only writes into a
+ * preallocated wait-free single-producer ring. A background WorkerThread
+ * drains the ring and runs destructors and frees.
+ *
+ * Epoch tracking keeps an object alive while any block that might still
+ * reference it is in flight: every thread that reads shared structures
+ * registers as a reader and brackets each block with enterBlock() /
+ * exitBlock(). An object retired in epoch E is destroyed only once every
+ * reader is either idle or has entered a block in a later epoch.
+ */
+class DeferredReclaimer {
+public:
+    using Deleter = void (*)(void*);
+
+    /// Maximum number of concurrently registered reader threads.
+    static constexpr int kMaxReaders = 16;
+
+    /**
+     * @brief Construct a reclaimer.
+     * @param capacity Maximum number of retired objects waiting to be drained
+     */
+    explicit DeferredReclaimer(std::size_t capacity = 1024);
+
+    /**
+     * @brief Destroy the reclaimer, stopping the worker and freeing everything
+     *        still pending. No reader may be inside a block at this point.
+     */
+    ~DeferredReclaimer();
+
+    DeferredReclaimer(const DeferredReclaimer&) = delete;
+    DeferredReclaimer& operator=(const DeferredReclaimer&) = delete;
+    DeferredReclaimer(DeferredReclaimer&&) noexcept;
+    DeferredReclaimer& operator=(DeferredReclaimer&&) noexcept;
+
+    /**
+     * @brief Start the background worker.
+     * @param intervalMs Time between collection passes in milliseconds
+     * @return True if started successfully
+     */
+    bool start(std::uint32_t intervalMs = 10);
+
+    /**
+     * @brief Stop the background worker. Pending objects stay queued.
+     */
+    void stop();
+
+    /**
+     * @brief Check if the background worker is running.
+     * @return True if running
+     */
+    bool isRunning() const;
+
+    /**
+     * @brief Register a thread that reads objects which may be retired.
+     * @return Reader id, or -1 if all reader slots are taken
+     */
+    int registerReader();
+
+    /**
+     * @brief Release a reader slot. The reader must be outside any block.
+     * @param reader Reader id from registerReader()
+     */
+    void unregisterReader(int reader);
+
+    /**
+     * @brief Mark the start of a processing block on a reader thread.
+     * @param reader Reader id from registerReader()
+     */
+    void enterBlock(int reader);
+
+    /**
+     * @brief Mark the end of a processing block on a reader thread.
+     * @param reader Reader id from registerReader()
+     */
+    void exitBlock(int reader);
+
+    /**
+     * @brief Retire a shared object (audio thread only, wait-free).
+     *
+     * Only this reference is dropped on the worker; other copies keep the
+     * object alive as usual. If the ring is full nothing is destroyed:
+     * object is left untouched with the caller, who must retry later, and
+     * getOverflowCount() is incremented.
+     * @tparam T Object type
+     * @param object Reference to release, reset only on success
+     * @return True if the release was deferred
+     */
+    template<typename T>
+    bool retire(std::shared_ptr<T>&& object)
+    {
+        // Copying only bumps the count; the caller's reference is dropped
+        // once the ring holds one, so a full ring never frees anything here
+        std::shared_ptr<void> erased = object;
+        if (!retireShared(erased)) {
+            return false;
+        }
+        object.reset();
+        return true;
+    }
+
+    /**
+     * @brief Retire a raw allocation with its deleter (audio thread only, wait-free).
+     *
+     * If the ring is full the object is not deleted; it stays owned by the
+     * caller and getOverflowCount() is incremented.
+     * @param object Object to delete
+     * @param deleter Function that destroys and frees the object
+     * @return True if the deletion was deferred
+     */
+    bool retire(void* object, Deleter deleter);
+
+    /**
+     * @brief Retire a uniquely owned object (audio thread only, wait-free).
+     * @tparam T Object type
+     * @param object Object to delete, released only on success
+     * @return True if the deletion was deferred
+     */
+    template<typename T>
+    bool retire(std::unique_ptr<T>&& object)
+    {
+        if (!retire(object.get(), [](void* ptr) { delete static_cast<T*>(ptr); })) {
+            return false;
+        }
+        object.release();
+        return true;
+    }
+
+    /**
+     * @brief Run one collection pass on the calling thread.
+     *
+     * Advances the epoch, drains the retire ring and destroys every object
+     * no reader can still reference. Called periodically by the worker;
+     * never call it from the audio thread.
+     * @return Number of objects destroyed
+     */
+    std::size_t collect();
+
+    /**
+     * @brief Get the number of retired objects not yet destroyed.
+     * @return Pending object count
+     */
+    std::size_t getPendingCount() const;
+
+    /**
+     * @brief Get the total number of objects destroyed by collect().
+     * @return Reclaimed object count
+     */
+    std::uint64_t getReclaimedCount() const;
+
+    /**
+     * @brief Get the number of retire calls refused because the ring was full.
+     * @return Overflow count
+     */
+    std::uint64_t getOverflowCount() const;
+
+    /**
+     * @brief Get the current global epoch.
+     * @return Epoch counter
+     */
+    std::uint64_t getCurrentEpoch() const;
+
+private:
+    bool retireShared(std::shared_ptr<void>& object);
+
+    class Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+/**
+ * @brief RAII guard that brackets one processing block for a reader.
+ */
+class ReclaimerBlockGuard {
+public:
+    /**
+     * @brief Enter a block.
+     * @param reclaimer The reclaimer to report to
+     * @param reader Reader id from registerReader()
+     */
+    ReclaimerBlockGuard(DeferredReclaimer& reclaimer, int reader);
+
+    /**
+     * @brief Exit the block.
+     */
+    ~ReclaimerBlockGuard();
+
+    ReclaimerBlockGuard(const ReclaimerBlockGuard&) = delete;
+    ReclaimerBlockGuard& operator=(const ReclaimerBlockGuard&) = delete;
+
+private:
+    DeferredReclaimer& m_reclaimer;
+    int m_reader;
+};
+
+} // namespace nap
+
+#endif // NAP_DEFERREDRECLAIMER_H
@@ -0,0 +1,133 @@
+#ifndef NAP_INPLACETASK_H
+#define NAP_INPLACETASK_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace nap {
+
+/**
+ * @brief Move-only void() callable stored entirely inline.
+ *
+ * Unlike std::function, InplaceTask never allocates: the callable is
+ * placement-constructed into a fixed buffer, and a callable that does not
+ * fit is rejected at compile time. This makes it safe to create and move
+ * tasks on the audio thread.
+ *
+ * @tparam StorageSize Bytes available for the callable's captures
+ */
+template<std::size_t StorageSize>
+class InplaceTask {
+public:
+    static constexpr std::size_t kStorageSize = StorageSize;
+    static constexpr std::size_t kStorageAlign = alignof(void*);
+
+    InplaceTask() noexcept = default;
+
+    /**
+     * @brief Construct from any callable that fits the inline storage.
+     * @param callable Callable invocable as void()
+     */
+    template<typename F,
+             typename Fn = std::decay_t<F>,
+             typename = std::enable_if_t<!std::is_same<Fn, InplaceTask>::value>>
+    InplaceTask(F&& callable) noexcept(std::is_nothrow_constructible<Fn, F&&>::value)
+    {
+        static_assert(sizeof(Fn) <= StorageSize,
+                      "Callable captures too much state for InplaceTask storage");
+        static_assert(alignof(Fn) <= kStorageAlign,
+                      "Callable is over-aligned for InplaceTask storage");
+        static_assert(std::is_nothrow_move_constructible<Fn>::value,
+                      "InplaceTask callables must be nothrow move constructible");
+
+        new (&m_storage) Fn(std::forward<F>(callable));
+        m_ops = &kOpsFor<Fn>;
+    }
+
+    ~InplaceTask() { reset(); }
+
+    InplaceTask(InplaceTask&& other) noexcept
+    {
+        moveFrom(other);
+    }
+
+    InplaceTask& operator=(InplaceTask&& other) noexcept
+    {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    InplaceTask(const InplaceTask&) = delete;
+    InplaceTask& operator=(const InplaceTask&) = delete;
+
+    /**
+     * @brief Invoke the stored callable.
+     */
+    void operator()()
+    {
+        m_ops->invoke(&m_storage);
+    }
+
+    /**
+     * @brief Destroy the stored callable, leaving the task empty.
+     */
+    void reset() noexcept
+    {
+        if (m_ops) {
+            m_ops->destroy(&m_storage);
+            m_ops = nullptr;
+        }
+    }
+
+    explicit operator bool() const noexcept { return m_ops != nullptr; }
+
+private:
+    struct Ops {
+        void (*invoke)(void*);
+        void (*move)(void* dst, void* src) noexcept;
+        void (*destroy)(void*) noexcept;
+    };
+
+    template<typename Fn>
+    static void invokeImpl(void* storage)
+    {
+        (*static_cast<Fn*>(storage))();
+    }
+
+    template<typename Fn>
+    static void moveImpl(void* dst, void* src) noexcept
+    {
+        new (dst) Fn(std::move(*static_cast<Fn*>(src)));
+        static_cast<Fn*>(src)->~Fn();
+    }
+
+    template<typename Fn>
+    static void destroyImpl(void* storage) noexcept
+    {
+        static_cast<Fn*>(storage)->~Fn();
+    }
+
+    template<typename Fn>
+    static constexpr Ops kOpsFor = {&invokeImpl<Fn>, &moveImpl<Fn>, &destroyImpl<Fn>};
+
+    void moveFrom(InplaceTask& other) noexcept
+    {
+        if (other.m_ops) {
+            other.m_ops->move(&m_storage, &other.m_storage);
+            m_ops = other.m_ops;
+            other.m_ops = nullptr;
+        }
+    }
+
+    const Ops* m_ops = nullptr;
+    std::aligned_storage_t<StorageSize, kStorageAlign> m_storage;
+};
+
+} // namespace nap
+
+#endif // NAP_INPLACETASK_H
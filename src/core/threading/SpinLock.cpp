@@ -1,9 +1,53 @@
 #include "SpinLock.h"
+#include "CpuRelax.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
 
 namespace nap {
 
-SpinLock::SpinLock()
-    : m_flag(ATOMIC_FLAG_INIT)
+namespace {
+
+// Upper bound for TTAS exponential backoff; ~a few microseconds on x86
+constexpr std::uint32_t kMaxBackoffPauses = 1024;
+
+// Ticket-mode pause rounds per waiter ahead of us in line
+constexpr std::uint32_t kTicketPausesPerWaiter = 32;
+
+// Backoff rounds before yielding, in case the holder has been preempted
+constexpr std::uint64_t kSpinRoundsBeforeYield = 64;
+
+void backoffRound(std::uint32_t pauses, std::uint64_t round)
+{
+    if (round >= kSpinRoundsBeforeYield) {
+        std::this_thread::yield();
+        return;
+    }
+    for (std::uint32_t i = 0; i < pauses; ++i) {
+        cpuRelax();
+    }
+}
+
+std::int64_t nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+SpinLock::SpinLock(Mode mode)
+    : m_mode(mode)
+    , m_flag(false)
+    , m_nextTicket(0)
+    , m_nowServing(0)
+    , m_acquiredAtNs(0)
+    , m_acquireCount(0)
+    , m_contendedCount(0)
+    , m_spinCount(0)
+    , m_tryLockFailures(0)
+    , m_maxHoldTimeNs(0)
+    , m_trackHoldTime(false)
 {
 }
 
@@ -11,29 +55,131 @@ SpinLock::~SpinLock() = default;
 
 void SpinLock::lock()
 {
-    while (m_flag.test_and_set(std::memory_order_acquire)) {
-        // Spin
-        // On x86, we could add a pause instruction here for efficiency
-#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
-        __builtin_ia32_pause();
-#endif
+    std::uint64_t spins = 0;
+
+    if (m_mode == Mode::Ticket) {
+        const std::uint32_t ticket = m_nextTicket.fetch_add(1, std::memory_order_relaxed);
+
+        for (;;) {
+            const std::uint32_t serving = m_nowServing.load(std::memory_order_acquire);
+            if (serving == ticket) {
+                break;
+            }
+            // Proportional backoff: wait longer the further back in line we are
+            backoffRound((ticket - serving) * kTicketPausesPerWaiter, spins);
+            ++spins;
+        }
+    } else {
+        std::uint32_t backoff = 1;
+
+        while (m_flag.exchange(true, std::memory_order_acquire)) {
+            // Wait on a plain load so the line stays shared until it is released
+            do {
+                backoffRound(backoff, spins);
+                backoff = std::min(backoff * 2, kMaxBackoffPauses);
+                ++spins;
+            } while (m_flag.load(std::memory_order_relaxed));
+        }
     }
+
+    onAcquired(spins);
 }
 
 bool SpinLock::tryLock()
 {
-    return !m_flag.test_and_set(std::memory_order_acquire);
+    bool acquired;
+
+    if (m_mode == Mode::Ticket) {
+        std::uint32_t serving = m_nowServing.load(std::memory_order_acquire);
+        acquired = m_nextTicket.compare_exchange_strong(serving, serving + 1,
+                                                        std::memory_order_acquire,
+                                                        std::memory_order_relaxed);
+    } else {
+        acquired = !m_flag.load(std::memory_order_relaxed) &&
+                   !m_flag.exchange(true, std::memory_order_acquire);
+    }
+
+    if (!acquired) {
+        m_tryLockFailures.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    onAcquired(0);
+    return true;
 }
 
 void SpinLock::unlock()
 {
-    m_flag.clear(std::memory_order_release);
+    if (m_trackHoldTime.load(std::memory_order_relaxed) && m_acquiredAtNs != 0) {
+        const auto held = static_cast<std::uint64_t>(nowNs() - m_acquiredAtNs);
+        if (held > m_maxHoldTimeNs.load(std::memory_order_relaxed)) {
+            m_maxHoldTimeNs.store(held, std::memory_order_relaxed);  // Only the holder writes
+        }
+        m_acquiredAtNs = 0;
+    }
+
+    if (m_mode == Mode::Ticket) {
+        const std::uint32_t serving = m_nowServing.load(std::memory_order_relaxed);
+        m_nowServing.store(serving + 1, std::memory_order_release);
+    } else {
+        m_flag.store(false, std::memory_order_release);
+    }
 }
 
 bool SpinLock::isLocked() const
 {
     // Note: This is a snapshot and may be stale
-    return m_flag.test(std::memory_order_relaxed);
+    if (m_mode == Mode::Ticket) {
+        return m_nextTicket.load(std::memory_order_relaxed) !=
+               m_nowServing.load(std::memory_order_relaxed);
+    }
+    return m_flag.load(std::memory_order_relaxed);
+}
+
+SpinLock::Mode SpinLock::getMode() const
+{
+    return m_mode;
+}
+
+void SpinLock::setHoldTimeTracking(bool enable)
+{
+    m_trackHoldTime.store(enable, std::memory_order_relaxed);
+}
+
+SpinLock::Statistics SpinLock::getStatistics() const
+{
+    Statistics stats;
+    stats.acquireCount = m_acquireCount.load(std::memory_order_relaxed);
+    stats.contendedCount = m_contendedCount.load(std::memory_order_relaxed);
+    stats.spinCount = m_spinCount.load(std::memory_order_relaxed);
+    stats.tryLockFailures = m_tryLockFailures.load(std::memory_order_relaxed);
+    stats.maxHoldTimeNs = m_maxHoldTimeNs.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void SpinLock::resetStatistics()
+{
+    m_acquireCount.store(0, std::memory_order_relaxed);
+    m_contendedCount.store(0, std::memory_order_relaxed);
+    m_spinCount.store(0, std::memory_order_relaxed);
+    m_tryLockFailures.store(0, std::memory_order_relaxed);
+    m_maxHoldTimeNs.store(0, std::memory_order_relaxed);
+}
+
+void SpinLock::onAcquired(std::uint64_t spins)
+{
+    // Only the holder writes these, so no read-modify-write is needed
+    m_acquireCount.store(m_acquireCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    if (spins > 0) {
+        m_contendedCount.store(m_contendedCount.load(std::memory_order_relaxed) + 1,
+                               std::memory_order_relaxed);
+        m_spinCount.store(m_spinCount.load(std::memory_order_relaxed) + spins,
+                          std::memory_order_relaxed);
+    }
+
+    if (m_trackHoldTime.load(std::memory_order_relaxed)) {
+        m_acquiredAtNs = nowNs();
+    }
 }
 
 // SpinLockGuard implementation
@@ -2,6 +2,7 @@
 #define NAP_SPINLOCK_H
 
 #include <atomic>
+#include <cstddef>
 #include <cstdint>
 
 namespace nap {
@@ -11,10 +12,38 @@ namespace nap {
  *
  * SpinLock provides a minimal-overhead synchronization primitive suitable
  * for protecting very short critical sections in real-time audio code.
+ *
+ * The default mode is test-and-test-and-set: waiters spin on a plain load
+ * (the cache line stays shared) with a pause hint and exponential backoff,
+ * and only attempt the exchange once the lock looks free. Ticket mode
+ * hands the lock out in arrival order for fairness under heavy contention.
+ *
+ * Contention counters are updated with relaxed atomics and can be read
+ * from a diagnostics thread at any time.
  */
 class SpinLock {
 public:
-    SpinLock();
+    enum class Mode {
+        TestAndTestAndSet,
+        Ticket
+    };
+
+    /**
+     * @brief Contention counters for one lock.
+     */
+    struct Statistics {
+        std::uint64_t acquireCount = 0;       ///< Successful lock()/tryLock() calls
+        std::uint64_t contendedCount = 0;     ///< Acquires that had to wait
+        std::uint64_t spinCount = 0;          ///< Total backoff rounds spent waiting
+        std::uint64_t tryLockFailures = 0;
+        std::uint64_t maxHoldTimeNs = 0;      ///< Only tracked when enabled
+    };
+
+    /**
+     * @brief Construct a spin lock.
+     * @param mode Acquisition strategy
+     */
+    explicit SpinLock(Mode mode = Mode::TestAndTestAndSet);
     ~SpinLock();
 
     SpinLock(const SpinLock&) = delete;
@@ -42,8 +71,50 @@ public:
      */
     bool isLocked() const;
 
+    /**
+     * @brief Get the acquisition strategy.
+     * @return Lock mode
+     */
+    Mode getMode() const;
+
+    /**
+     * @brief Measure how long the lock is held (two clock reads per acquire).
+     * @param enable True to track maximum hold time
+     */
+    void setHoldTimeTracking(bool enable);
+
+    /**
+     * @brief Read the contention counters.
+     * @return Snapshot of the counters
+     */
+    Statistics getStatistics() const;
+
+    /**
+     * @brief Reset the contention counters.
+     */
+    void resetStatistics();
+
 private:
-    std::atomic_flag m_flag;
+    static constexpr std::size_t kCacheLineSize = 64;
+
+    void onAcquired(std::uint64_t spins);
+
+    const Mode m_mode;
+
+    // Lock word(s): the flag for TTAS, the ticket pair for Ticket mode
+    alignas(kCacheLineSize) std::atomic<bool> m_flag;
+    std::atomic<std::uint32_t> m_nextTicket;
+    std::atomic<std::uint32_t> m_nowServing;
+    std::int64_t m_acquiredAtNs;  // Written only by the holder
+
+    // Counters live on their own line so diagnostics reads do not steal
+    // the lock word from spinning waiters.
+    alignas(kCacheLineSize) std::atomic<std::uint64_t> m_acquireCount;
+    std::atomic<std::uint64_t> m_contendedCount;
+    std::atomic<std::uint64_t> m_spinCount;
+    std::atomic<std::uint64_t> m_tryLockFailures;
+    std::atomic<std::uint64_t> m_maxHoldTimeNs;
+    std::atomic<bool> m_trackHoldTime;
 };
 
 /**
@@ -0,0 +1,224 @@
+#include "SpinParkEvent.h"
+#include <algorithm>
+#include <chrono>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <condition_variable>
+#include <mutex>
+#endif
+
+namespace nap {
+
+namespace {
+
+std::int64_t nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+#if defined(__linux__)
+// Park while *word == expected; returns false only on timeout.
+bool futexWait(std::atomic<std::uint32_t>& word, std::uint32_t expected, std::int64_t timeoutNs)
+{
+    timespec timeout{};
+    timespec* timeoutPtr = nullptr;
+    if (timeoutNs >= 0) {
+        timeout.tv_sec = static_cast<time_t>(timeoutNs / 1000000000);
+        timeout.tv_nsec = static_cast<long>(timeoutNs % 1000000000);
+        timeoutPtr = &timeout;
+    }
+
+    const long result = syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word),
+                                FUTEX_WAIT_PRIVATE, expected, timeoutPtr, nullptr, 0);
+    return !(result == -1 && errno == ETIMEDOUT);
+}
+
+void futexWake(std::atomic<std::uint32_t>& word, int count)
+{
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word),
+            FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+}
+#endif
+
+} // namespace
+
+struct SpinParkEvent::FallbackWait {
+#if !defined(__linux__)
+    std::mutex mutex;
+    std::condition_variable cv;
+#endif
+};
+
+SpinParkEvent::SpinParkEvent(std::uint32_t spinIterations)
+    : m_epoch(0)
+    , m_parkedWaiters(0)
+    , m_spinIterations(spinIterations)
+    , m_lastNotifyNs(0)
+    , m_spinWakes(0)
+    , m_parkedWakes(0)
+    , m_timeouts(0)
+    , m_totalLatencyNs(0)
+    , m_maxLatencyNs(0)
+    , m_fallback(std::make_unique<FallbackWait>())
+{
+}
+
+SpinParkEvent::~SpinParkEvent() = default;
+
+std::uint32_t SpinParkEvent::prepareWait() const
+{
+    return m_epoch.load(std::memory_order_acquire);
+}
+
+bool SpinParkEvent::wait(std::uint32_t epoch, std::uint32_t timeoutMs)
+{
+    // Already notified before we got here; not a wake-up worth measuring
+    if (m_epoch.load(std::memory_order_acquire) != epoch) {
+        return true;
+    }
+
+    const std::uint32_t spins = m_spinIterations.load(std::memory_order_relaxed);
+    for (std::uint32_t i = 0; i < spins; ++i) {
+        if (m_epoch.load(std::memory_order_acquire) != epoch) {
+            recordWake(false);
+            return true;
+        }
+        cpuRelax();
+    }
+
+    const std::int64_t deadline = timeoutMs > 0
+        ? nowNs() + static_cast<std::int64_t>(timeoutMs) * 1000000
+        : -1;
+
+    // seq_cst pairs with notify(): either we see the new epoch, or the
+    // notifier sees us parked and issues a wake.
+    m_parkedWaiters.fetch_add(1, std::memory_order_seq_cst);
+    bool notified = true;
+
+#if defined(__linux__)
+    while (m_epoch.load(std::memory_order_seq_cst) == epoch) {
+        std::int64_t remaining = -1;
+        if (deadline >= 0) {
+            remaining = deadline - nowNs();
+            if (remaining <= 0) {
+                notified = false;
+                break;
+            }
+        }
+        futexWait(m_epoch, epoch, remaining);
+    }
+#else
+    {
+        std::unique_lock<std::mutex> lock(m_fallback->mutex);
+        auto changed = [this, epoch]() { return m_epoch.load(std::memory_order_seq_cst) != epoch; };
+        if (deadline >= 0) {
+            notified = m_fallback->cv.wait_for(lock, std::chrono::milliseconds(timeoutMs), changed);
+        } else {
+            m_fallback->cv.wait(lock, changed);
+        }
+    }
+#endif
+
+    m_parkedWaiters.fetch_sub(1, std::memory_order_relaxed);
+
+    if (!notified) {
+        m_timeouts.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    recordWake(true);
+    return true;
+}
+
+void SpinParkEvent::notifyOne()
+{
+    notify(false);
+}
+
+void SpinParkEvent::notifyAll()
+{
+    notify(true);
+}
+
+void SpinParkEvent::notify(bool all)
+{
+    m_lastNotifyNs.store(nowNs(), std::memory_order_relaxed);
+    m_epoch.fetch_add(1, std::memory_order_seq_cst);
+
+    if (m_parkedWaiters.load(std::memory_order_seq_cst) == 0) {
+        return;  // Nobody parked: no syscall
+    }
+
+#if defined(__linux__)
+    futexWake(m_epoch, all ? INT32_MAX : 1);
+#else
+    {
+        std::lock_guard<std::mutex> lock(m_fallback->mutex);
+    }
+    if (all) {
+        m_fallback->cv.notify_all();
+    } else {
+        m_fallback->cv.notify_one();
+    }
+#endif
+}
+
+void SpinParkEvent::recordWake(bool parked)
+{
+    const std::int64_t latency = nowNs() - m_lastNotifyNs.load(std::memory_order_relaxed);
+
+    (parked ? m_parkedWakes : m_spinWakes).fetch_add(1, std::memory_order_relaxed);
+    if (latency <= 0) {
+        return;
+    }
+
+    const auto latencyNs = static_cast<std::uint64_t>(latency);
+    m_totalLatencyNs.fetch_add(latencyNs, std::memory_order_relaxed);
+
+    std::uint64_t currentMax = m_maxLatencyNs.load(std::memory_order_relaxed);
+    while (latencyNs > currentMax &&
+           !m_maxLatencyNs.compare_exchange_weak(currentMax, latencyNs, std::memory_order_relaxed)) {
+    }
+}
+
+void SpinParkEvent::setSpinIterations(std::uint32_t iterations)
+{
+    m_spinIterations.store(iterations, std::memory_order_relaxed);
+}
+
+std::uint32_t SpinParkEvent::getSpinIterations() const
+{
+    return m_spinIterations.load(std::memory_order_relaxed);
+}
+
+SpinParkEvent::Statistics SpinParkEvent::getStatistics() const
+{
+    Statistics stats;
+    stats.spinWakeCount = m_spinWakes.load(std::memory_order_relaxed);
+    stats.parkedWakeCount = m_parkedWakes.load(std::memory_order_relaxed);
+    stats.wakeCount = stats.spinWakeCount + stats.parkedWakeCount;
+    stats.timeoutCount = m_timeouts.load(std::memory_order_relaxed);
+    stats.maxLatencyNs = static_cast<double>(m_maxLatencyNs.load(std::memory_order_relaxed));
+    if (stats.wakeCount > 0) {
+        stats.averageLatencyNs =
+            static_cast<double>(m_totalLatencyNs.load(std::memory_order_relaxed)) / stats.wakeCount;
+    }
+    return stats;
+}
+
+void SpinParkEvent::resetStatistics()
+{
+    m_spinWakes.store(0, std::memory_order_relaxed);
+    m_parkedWakes.store(0, std::memory_order_relaxed);
+    m_timeouts.store(0, std::memory_order_relaxed);
+    m_totalLatencyNs.store(0, std::memory_order_relaxed);
+    m_maxLatencyNs.store(0, std::memory_order_relaxed);
+}
+
+} // namespace nap
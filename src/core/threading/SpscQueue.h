@@ -0,0 +1,130 @@
+#ifndef NAP_SPSCQUEUE_H
+#define NAP_SPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace nap {
+
+/**
+ * @brief Bounded wait-free single-producer / single-consumer queue.
+ *
+ * All storage is allocated up front, so push() and pop() never allocate
+ * or block and are safe on the audio thread. Each side keeps a private
+ * copy of the other side's index and only reloads the shared one when the
+ * queue looks full (producer) or empty (consumer), which keeps the two
+ * cursors' cache lines from bouncing on every operation.
+ *
+ * @tparam T Element type; must be default constructible and nothrow movable
+ */
+template<typename T>
+class SpscQueue {
+public:
+    static_assert(std::is_nothrow_move_assignable<T>::value,
+                  "SpscQueue elements must be nothrow move assignable");
+
+    /**
+     * @brief Construct a queue.
+     * @param capacity Minimum number of elements; rounded up to a power of two
+     */
+    explicit SpscQueue(std::size_t capacity)
+        : m_capacity(roundUpToPowerOfTwo(capacity < 2 ? 2 : capacity))
+        , m_mask(m_capacity - 1)
+        , m_slots(new T[m_capacity])
+    {
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /**
+     * @brief Enqueue an element (producer thread only).
+     * @param value Element to enqueue
+     * @return False if the queue is full
+     */
+    bool push(T value)
+    {
+        const std::size_t tail = m_producer.tail.load(std::memory_order_relaxed);
+        if (tail - m_producer.cachedHead >= m_capacity) {
+            m_producer.cachedHead = m_consumer.head.load(std::memory_order_acquire);
+            if (tail - m_producer.cachedHead >= m_capacity) {
+                return false;
+            }
+        }
+
+        m_slots[tail & m_mask] = std::move(value);
+        m_producer.tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Dequeue an element (consumer thread only).
+     * @param value Receives the dequeued element
+     * @return False if the queue is empty
+     */
+    bool pop(T& value)
+    {
+        const std::size_t head = m_consumer.head.load(std::memory_order_relaxed);
+        if (head == m_consumer.cachedTail) {
+            m_consumer.cachedTail = m_producer.tail.load(std::memory_order_acquire);
+            if (head == m_consumer.cachedTail) {
+                return false;
+            }
+        }
+
+        value = std::move(m_slots[head & m_mask]);
+        m_consumer.head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Get the number of queued elements (a snapshot from either side).
+     * @return Element count
+     */
+    std::size_t size() const
+    {
+        const std::size_t head = m_consumer.head.load(std::memory_order_acquire);
+        const std::size_t tail = m_producer.tail.load(std::memory_order_acquire);
+        return tail - head;
+    }
+
+    bool isEmpty() const { return size() == 0; }
+
+    std::size_t getCapacity() const { return m_capacity; }
+
+private:
+    static constexpr std::size_t kCacheLineSize = 64;
+
+    static std::size_t roundUpToPowerOfTwo(std::size_t value)
+    {
+        std::size_t result = 1;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    const std::size_t m_capacity;
+    const std::size_t m_mask;
+    std::unique_ptr<T[]> m_slots;
+
+    struct alignas(kCacheLineSize) ProducerSide {
+        std::atomic<std::size_t> tail{0};
+        std::size_t cachedHead = 0;
+    };
+
+    struct alignas(kCacheLineSize) ConsumerSide {
+        std::atomic<std::size_t> head{0};
+        std::size_t cachedTail = 0;
+    };
+
+    ProducerSide m_producer;
+    ConsumerSide m_consumer;
+};
+
+} // namespace nap
+
+#endif // NAP_SPSCQUEUE_H
@@ -1,21 +1,112 @@
 #include "TaskQueue.h"
-#include <condition_variable>
-#include <mutex>
-#include <queue>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
 
 namespace nap {
 
+namespace {
+
+constexpr std::size_t kCacheLineSize = 64;
+
+std::size_t roundUpToPowerOfTwo(std::size_t value)
+{
+    std::size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+} // namespace
+
 class TaskQueue::Impl {
 public:
-    explicit Impl(std::size_t capacity)
-        : capacity(capacity)
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        Task task;
+    };
+
+    explicit Impl(std::size_t requestedCapacity)
+        : capacity(roundUpToPowerOfTwo(std::max<std::size_t>(requestedCapacity, 2)))
+        , mask(capacity - 1)
+        , cells(new Cell[capacity])
+    {
+        for (std::size_t i = 0; i < capacity; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        enqueuePos.store(0, std::memory_order_relaxed);
+        dequeuePos.store(0, std::memory_order_relaxed);
+    }
+
+    bool tryPush(Task& task)
+    {
+        std::size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+
+        for (;;) {
+            cell = &cells[pos & mask];
+            const std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;  // Full
+            } else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->task = std::move(task);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(Task& task)
+    {
+        std::size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+
+        for (;;) {
+            cell = &cells[pos & mask];
+            const std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+
+            if (diff == 0) {
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;  // Empty
+            } else {
+                pos = dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        task = std::move(cell->task);
+        cell->sequence.store(pos + mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::size_t size() const
     {
+        const std::size_t head = dequeuePos.load(std::memory_order_acquire);
+        const std::size_t tail = enqueuePos.load(std::memory_order_acquire);
+        return tail > head ? std::min(tail - head, capacity) : 0;
     }
 
-    std::queue<Task> tasks;
-    std::mutex mutex;
-    std::condition_variable cv;
-    std::size_t capacity;
+    const std::size_t capacity;
+    const std::size_t mask;
+    std::unique_ptr<Cell[]> cells;
+
+    // Producers and consumers each own a cursor; keep them on separate lines.
+    alignas(kCacheLineSize) std::atomic<std::size_t> enqueuePos;
+    alignas(kCacheLineSize) std::atomic<std::size_t> dequeuePos;
 };
 
 TaskQueue::TaskQueue(std::size_t capacity)
@@ -30,45 +121,42 @@ TaskQueue& TaskQueue::operator=(TaskQueue&&) noexcept = default;
 
 bool TaskQueue::push(Task task)
 {
-    std::lock_guard<std::mutex> lock(m_impl->mutex);
-
-    if (m_impl->tasks.size() >= m_impl->capacity) {
+    if (!task) {
         return false;
     }
-
-    m_impl->tasks.push(std::move(task));
-    m_impl->cv.notify_one();
-    return true;
+    return m_impl->tryPush(task);
 }
 
 bool TaskQueue::tryPop(Task& task)
 {
-    std::lock_guard<std::mutex> lock(m_impl->mutex);
-
-    if (m_impl->tasks.empty()) {
-        return false;
-    }
-
-    task = std::move(m_impl->tasks.front());
-    m_impl->tasks.pop();
-    return true;
+    return m_impl->tryPop(task);
 }
 
 bool TaskQueue::pop(Task& task, std::uint32_t timeoutMs)
 {
-    std::unique_lock<std::mutex> lock(m_impl->mutex);
+    using Clock = std::chrono::steady_clock;
+    const auto deadline = Clock::now() + std::chrono::milliseconds(timeoutMs);
 
-    if (timeoutMs > 0) {
-        if (!m_impl->cv.wait_for(lock, std::chrono::milliseconds(timeoutMs),
-                                  [this]() { return !m_impl->tasks.empty(); })) {
+    // Spin briefly, then yield, then sleep with growing intervals
+    std::uint32_t attempt = 0;
+    std::chrono::microseconds sleepTime(50);
+
+    while (!m_impl->tryPop(task)) {
+        if (timeoutMs > 0 && Clock::now() >= deadline) {
             return false;
         }
-    } else {
-        m_impl->cv.wait(lock, [this]() { return !m_impl->tasks.empty(); });
+
+        if (attempt < 64) {
+            ++attempt;
+        } else if (attempt < 128) {
+            ++attempt;
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(sleepTime);
+            sleepTime = std::min(sleepTime * 2, std::chrono::microseconds(1000));
+        }
     }
 
-    task = std::move(m_impl->tasks.front());
-    m_impl->tasks.pop();
     return true;
 }
 
@@ -79,6 +167,7 @@ std::size_t TaskQueue::executeAll()
 
     while (tryPop(task)) {
         task();
+        task.reset();
         ++count;
     }
 
@@ -92,6 +181,7 @@ std::size_t TaskQueue::executeN(std::size_t maxTasks)
 
     while (count < maxTasks && tryPop(task)) {
         task();
+        task.reset();
         ++count;
     }
 
@@ -100,20 +190,17 @@ std::size_t TaskQueue::executeN(std::size_t maxTasks)
 
 std::size_t TaskQueue::size() const
 {
-    std::lock_guard<std::mutex> lock(m_impl->mutex);
-    return m_impl->tasks.size();
+    return m_impl->size();
 }
 
 bool TaskQueue::isEmpty() const
 {
-    std::lock_guard<std::mutex> lock(m_impl->mutex);
-    return m_impl->tasks.empty();
+    return m_impl->size() == 0;
 }
 
 bool TaskQueue::isFull() const
 {
-    std::lock_guard<std::mutex> lock(m_impl->mutex);
-    return m_impl->tasks.size() >= m_impl->capacity;
+    return m_impl->size() >= m_impl->capacity;
 }
 
 std::size_t TaskQueue::getCapacity() const
@@ -123,9 +210,9 @@ std::size_t TaskQueue::getCapacity() const
 
 void TaskQueue::clear()
 {
-    std::lock_guard<std::mutex> lock(m_impl->mutex);
-    while (!m_impl->tasks.empty()) {
-        m_impl->tasks.pop();
+    Task task;
+    while (m_impl->tryPop(task)) {
+        task.reset();
     }
 }
 
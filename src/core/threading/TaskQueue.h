@@ -1,24 +1,32 @@
 #ifndef NAP_TASKQUEUE_H
 #define NAP_TASKQUEUE_H
 
+#include "InplaceTask.h"
 #include <cstdint>
-#include <functional>
 #include <memory>
 
 namespace nap {
 
 /**
- * @brief Thread-safe task queue for asynchronous audio processing.
+ * @brief Lock-free task queue for asynchronous audio processing.
  *
- * TaskQueue provides a lock-free or low-contention queue for passing
- * tasks between threads in a real-time audio context.
+ * TaskQueue is a bounded multi-producer, multi-consumer ring (Vyukov
+ * style): every slot carries a sequence number, and producers and
+ * consumers claim slots with a single CAS on their own cursor. Tasks are
+ * stored inline in the slots, so push() and tryPop() never lock and never
+ * allocate and can be called from the audio thread.
  */
 class TaskQueue {
 public:
-    using Task = std::function<void()>;
+    /// Bytes of capture state a task may carry; sized so a slot fills one cache line.
+    static constexpr std::size_t kTaskStorageSize = 48;
+
+    using Task = InplaceTask<kTaskStorageSize>;
 
     /**
      * @brief Construct a task queue with the specified capacity.
+     *
+     * The capacity is rounded up to the next power of two.
      * @param capacity Maximum number of pending tasks
      */
     explicit TaskQueue(std::size_t capacity = 1024);
@@ -30,9 +38,9 @@ public:
     TaskQueue& operator=(TaskQueue&&) noexcept;
 
     /**
-     * @brief Push a task onto the queue.
+     * @brief Push a task onto the queue without blocking.
      * @param task The task to push
-     * @return True if the task was pushed successfully
+     * @return True if the task was pushed, false if the queue is full
      */
     bool push(Task task);
 
@@ -44,9 +52,11 @@ public:
     bool tryPop(Task& task);
 
     /**
-     * @brief Pop a task, blocking until one is available.
+     * @brief Pop a task, waiting until one is available (consumer threads only).
+     *
+     * Waits by polling with backoff so producers never have to signal.
      * @param task Reference to store the popped task
-     * @param timeoutMs Maximum time to wait in milliseconds
+     * @param timeoutMs Maximum time to wait in milliseconds, 0 waits forever
      * @return True if a task was popped within the timeout
      */
     bool pop(Task& task, std::uint32_t timeoutMs = 0);
@@ -66,6 +76,8 @@ public:
 
     /**
      * @brief Get the number of pending tasks.
+     *
+     * A snapshot that may be stale while other threads push or pop.
      * @return Task count
      */
     std::size_t size() const;
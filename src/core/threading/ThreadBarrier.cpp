@@ -1,7 +1,7 @@
 #include "ThreadBarrier.h"
+#include <algorithm>
 #include <atomic>
-#include <condition_variable>
-#include <mutex>
+#include <chrono>
 
 namespace nap {
 
@@ -9,18 +9,91 @@ class ThreadBarrier::Impl {
 public:
     explicit Impl(std::uint32_t numThreads, CompletionFunction completionFunc)
         : numThreads(numThreads)
-        , waitingCount(0)
-        , generation(0)
+        , state(0)
         , completionFunc(std::move(completionFunc))
     {
     }
 
-    std::uint32_t numThreads;
-    std::atomic<std::uint32_t> waitingCount;
-    std::atomic<std::uint64_t> generation;
-    CompletionFunction completionFunc;
-    std::mutex mutex;
-    std::condition_variable cv;
+    // Generation in the high word, arrivals in the low word, so a round
+    // is closed and the count reset in one store: an arrival lands either
+    // in the old round (and is released with it) or in the new one.
+    static std::uint32_t countOf(std::uint64_t s) { return static_cast<std::uint32_t>(s); }
+    static std::uint64_t generationOf(std::uint64_t s) { return s >> 32; }
+
+    // Called by the last thread to arrive: run the completion function,
+    // then open the barrier for everyone parked on the event.
+    void release(std::uint64_t currentGen)
+    {
+        if (completionFunc) {
+            completionFunc();
+        }
+
+        state.store((currentGen + 1) << 32, std::memory_order_release);
+        event.notifyAll();
+    }
+
+    bool arriveAndWait(std::int64_t timeoutMs)
+    {
+        const std::uint64_t arrived = state.fetch_add(1, std::memory_order_acq_rel) + 1;
+        const std::uint64_t currentGen = generationOf(arrived);
+
+        if (countOf(arrived) == numThreads.load(std::memory_order_acquire)) {
+            release(currentGen);
+            return true;
+        }
+
+        using Clock = std::chrono::steady_clock;
+        const auto deadline = Clock::now() + std::chrono::milliseconds(std::max<std::int64_t>(timeoutMs, 0));
+
+        for (;;) {
+            const std::uint32_t epoch = event.prepareWait();
+            if (generationOf(state.load(std::memory_order_acquire)) != currentGen) {
+                return true;
+            }
+
+            if (timeoutMs < 0) {
+                event.wait(epoch);
+                continue;
+            }
+
+            const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - Clock::now());
+            if (remaining.count() <= 0 || !event.wait(epoch, static_cast<std::uint32_t>(remaining.count()))) {
+                return withdraw(currentGen);
+            }
+        }
+    }
+
+    // Timed out: take our arrival back unless the barrier opened meanwhile.
+    bool withdraw(std::uint64_t currentGen)
+    {
+        std::uint64_t s = state.load(std::memory_order_acquire);
+        for (;;) {
+            if (generationOf(s) != currentGen || countOf(s) >= numThreads.load(std::memory_order_acquire)) {
+                // Released (or being released by the last arriver)
+                while (generationOf(state.load(std::memory_order_acquire)) == currentGen) {
+                    cpuRelax();
+                }
+                return true;
+            }
+            if (state.compare_exchange_weak(s, s - 1, std::memory_order_acq_rel)) {
+                return false;
+            }
+        }
+    }
+
+    // Starts a new round without running the completion function
+    void advance()
+    {
+        std::uint64_t s = state.load(std::memory_order_acquire);
+        while (!state.compare_exchange_weak(s, (generationOf(s) + 1) << 32, std::memory_order_acq_rel)) {
+        }
+        event.notifyAll();
+    }
+
+    std::atomic<std::uint32_t> numThreads;
+    std::atomic<std::uint64_t> state;
+    CompletionFunction completionFunc;  // Run by the last arriver only
+    SpinParkEvent event;
 };
 
 ThreadBarrier::ThreadBarrier(std::uint32_t numThreads, CompletionFunction completionFunc)
@@ -35,102 +108,58 @@ ThreadBarrier& ThreadBarrier::operator=(ThreadBarrier&&) noexcept = default;
 
 void ThreadBarrier::wait()
 {
-    std::unique_lock<std::mutex> lock(m_impl->mutex);
-
-    std::uint64_t currentGen = m_impl->generation.load();
-    std::uint32_t count = ++m_impl->waitingCount;
-
-    if (count == m_impl->numThreads) {
-        // Last thread to arrive
-        m_impl->waitingCount = 0;
-        ++m_impl->generation;
-
-        if (m_impl->completionFunc) {
-            m_impl->completionFunc();
-        }
-
-        m_impl->cv.notify_all();
-    } else {
-        // Wait for other threads
-        m_impl->cv.wait(lock, [this, currentGen]() {
-            return m_impl->generation.load() != currentGen;
-        });
-    }
+    m_impl->arriveAndWait(-1);
 }
 
 bool ThreadBarrier::tryWait()
 {
-    std::lock_guard<std::mutex> lock(m_impl->mutex);
-    return m_impl->waitingCount.load() >= m_impl->numThreads - 1;
+    return Impl::countOf(m_impl->state.load()) >= m_impl->numThreads.load() - 1;
 }
 
 bool ThreadBarrier::waitFor(std::uint32_t timeoutMs)
 {
-    std::unique_lock<std::mutex> lock(m_impl->mutex);
-
-    std::uint64_t currentGen = m_impl->generation.load();
-    std::uint32_t count = ++m_impl->waitingCount;
-
-    if (count == m_impl->numThreads) {
-        m_impl->waitingCount = 0;
-        ++m_impl->generation;
-
-        if (m_impl->completionFunc) {
-            m_impl->completionFunc();
-        }
-
-        m_impl->cv.notify_all();
-        return true;
-    }
-
-    bool result = m_impl->cv.wait_for(lock, std::chrono::milliseconds(timeoutMs),
-        [this, currentGen]() {
-            return m_impl->generation.load() != currentGen;
-        });
-
-    if (!result) {
-        --m_impl->waitingCount;
-    }
-
-    return result;
+    return m_impl->arriveAndWait(timeoutMs);
 }
 
 std::uint32_t ThreadBarrier::getNumThreads() const
 {
-    return m_impl->numThreads;
+    return m_impl->numThreads.load();
 }
 
 std::uint32_t ThreadBarrier::getWaitingCount() const
 {
-    return m_impl->waitingCount.load();
+    return Impl::countOf(m_impl->state.load());
 }
 
 void ThreadBarrier::reset()
 {
-    std::lock_guard<std::mutex> lock(m_impl->mutex);
-    m_impl->waitingCount = 0;
-    ++m_impl->generation;
-    m_impl->cv.notify_all();
+    m_impl->advance();
 }
 
 void ThreadBarrier::reset(std::uint32_t numThreads)
 {
-    std::lock_guard<std::mutex> lock(m_impl->mutex);
-    m_impl->numThreads = numThreads;
-    m_impl->waitingCount = 0;
-    ++m_impl->generation;
-    m_impl->cv.notify_all();
+    m_impl->numThreads.store(numThreads);
+    reset();
 }
 
 void ThreadBarrier::setCompletionFunction(CompletionFunction func)
 {
-    std::lock_guard<std::mutex> lock(m_impl->mutex);
     m_impl->completionFunc = std::move(func);
 }
 
 std::uint64_t ThreadBarrier::getGeneration() const
 {
-    return m_impl->generation.load();
+    return Impl::generationOf(m_impl->state.load());
+}
+
+void ThreadBarrier::setSpinIterations(std::uint32_t iterations)
+{
+    m_impl->event.setSpinIterations(iterations);
+}
+
+SpinParkEvent::Statistics ThreadBarrier::getWakeStatistics() const
+{
+    return m_impl->event.getStatistics();
 }
 
 } // namespace nap
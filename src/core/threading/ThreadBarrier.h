@@ -1,6 +1,7 @@
 #ifndef NAP_THREADBARRIER_H
 #define NAP_THREADBARRIER_H
 
+#include "SpinParkEvent.h"
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -11,7 +12,9 @@ namespace nap {
  * @brief Thread synchronization barrier for parallel audio processing.
  *
  * ThreadBarrier allows multiple threads to synchronize at a common point,
- * useful for parallel audio processing phases.
+ * useful for parallel audio processing phases. Arrival is a single atomic
+ * increment; waiters spin briefly and then park (see SpinParkEvent), so a
+ * barrier crossed every audio block rarely enters the kernel.
  */
 class ThreadBarrier {
 public:
@@ -74,6 +77,10 @@ public:
 
     /**
      * @brief Set the completion function.
+     *
+     * The function runs on the last thread to arrive, before the others
+     * are released, without any lock held. Set it only while no thread is
+     * waiting at the barrier.
      * @param func The function to call when all threads arrive
      */
     void setCompletionFunction(CompletionFunction func);
@@ -84,6 +91,18 @@ public:
      */
     std::uint64_t getGeneration() const;
 
+    /**
+     * @brief Set how long waiters spin before parking.
+     * @param iterations Spin iterations, 0 parks immediately
+     */
+    void setSpinIterations(std::uint32_t iterations);
+
+    /**
+     * @brief Get wake-up latency measured from the last arrival to waiters running.
+     * @return Wake-up statistics
+     */
+    SpinParkEvent::Statistics getWakeStatistics() const;
+
 private:
     class Impl;
     std::unique_ptr<Impl> m_impl;
@@ -1,11 +1,45 @@
 #include "WorkerThread.h"
+#include <algorithm>
 #include <atomic>
-#include <condition_variable>
+#include <cerrno>
+#include <chrono>
 #include <mutex>
 #include <thread>
 
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#endif
+
 namespace nap {
 
+namespace {
+
+constexpr std::size_t kPrefaultChunkSize = 16 * 1024;
+constexpr std::size_t kPageSize = 4096;
+
+// Recurse in fixed-size frames, writing one byte per page, so the stack
+// pages are faulted in now rather than inside the first real-time cycle.
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((noinline))
+#endif
+std::size_t prefaultStack(std::size_t remaining)
+{
+    unsigned char chunk[kPrefaultChunkSize];
+    volatile unsigned char* page = chunk;
+    for (std::size_t i = 0; i < kPrefaultChunkSize; i += kPageSize) {
+        page[i] = 0;
+    }
+    if (remaining <= kPrefaultChunkSize) {
+        return kPrefaultChunkSize;
+    }
+    return kPrefaultChunkSize + prefaultStack(remaining - kPrefaultChunkSize);
+}
+
+} // namespace
+
 class WorkerThread::Impl {
 public:
     explicit Impl(const std::string& name, Priority priority)
@@ -13,7 +47,6 @@ public:
         , priority(priority)
         , running(false)
         , shouldStop(false)
-        , taskPending(false)
     {
     }
 
@@ -21,12 +54,156 @@ public:
     Priority priority;
     std::atomic<bool> running;
     std::atomic<bool> shouldStop;
-    std::atomic<bool> taskPending;
+    // wake() bumps requested; the worker publishes the requested count it
+    // had read before each run, so a wake during a run triggers another run
+    std::atomic<std::uint64_t> requested{0};
+    std::atomic<std::uint64_t> completed{0};
+    // Applied from the worker itself at startup, or through its handle while
+    // it runs; records what was actually granted.
+    bool applyPriority(bool onWorker)
+    {
+        std::lock_guard<std::mutex> lock(reportMutex);
+        report.requestedPriority = priority;
+
+#if defined(__linux__)
+        const pthread_t handle = onWorker ? pthread_self() : thread.native_handle();
+
+        const bool wantsRealtime = priority == Priority::High || priority == Priority::Realtime;
+        if (wantsRealtime) {
+            const int policy = realtimePolicy == RealtimePolicy::Fifo ? SCHED_FIFO : SCHED_RR;
+            const int minPrio = sched_get_priority_min(policy);
+            const int maxPrio = sched_get_priority_max(policy);
+
+            // Stay below the kernel's own watchdog/migration threads at the top
+            int requested = priority == Priority::Realtime ? maxPrio - 10 : (minPrio + maxPrio) / 2;
+
+            sched_param param{};
+            param.sched_priority = requested;
+            int result = pthread_setschedparam(handle, policy, &param);
+
+            if (result == EPERM) {
+                // Unprivileged: retry within the RLIMIT_RTPRIO allowance
+                rlimit limit{};
+                if (getrlimit(RLIMIT_RTPRIO, &limit) == 0 && limit.rlim_cur > 0) {
+                    requested = std::min<int>(requested, static_cast<int>(limit.rlim_cur));
+                    param.sched_priority = std::max(requested, minPrio);
+                    result = pthread_setschedparam(handle, policy, &param);
+                }
+            }
+
+            if (result == 0) {
+                report.realtimeGranted = true;
+                report.osPolicy = policy;
+                report.osPriority = param.sched_priority;
+                return true;
+            }
+        }
+
+        // Normal scheduling; Low uses SCHED_BATCH so it yields to interactive work
+        const int policy = priority == Priority::Low ? SCHED_BATCH : SCHED_OTHER;
+        sched_param param{};
+        param.sched_priority = 0;
+        pthread_setschedparam(handle, policy, &param);
+
+        report.realtimeGranted = false;
+        int currentPolicy = SCHED_OTHER;
+        if (pthread_getschedparam(handle, &currentPolicy, &param) == 0) {
+            report.osPolicy = currentPolicy;
+            report.osPriority = param.sched_priority;
+        }
+        return !wantsRealtime;
+#else
+        (void)onWorker;
+        report.realtimeGranted = false;
+        return priority != Priority::High && priority != Priority::Realtime;
+#endif
+    }
+
+    bool applyAffinity(bool onWorker)
+    {
+        std::lock_guard<std::mutex> lock(reportMutex);
+
+#if defined(__linux__)
+        const pthread_t handle = onWorker ? pthread_self() : thread.native_handle();
+
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        if (affinityMask == 0) {
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                CPU_SET(cpu, &cpus);
+            }
+        } else {
+            for (int cpu = 0; cpu < 64; ++cpu) {
+                if (affinityMask & (std::uint64_t{1} << cpu)) {
+                    CPU_SET(cpu, &cpus);
+                }
+            }
+        }
+
+        report.affinityApplied = pthread_setaffinity_np(handle, sizeof(cpus), &cpus) == 0;
+
+        report.affinityMask = 0;
+        if (pthread_getaffinity_np(handle, sizeof(cpus), &cpus) == 0) {
+            for (int cpu = 0; cpu < 64; ++cpu) {
+                if (CPU_ISSET(cpu, &cpus)) {
+                    report.affinityMask |= std::uint64_t{1} << cpu;
+                }
+            }
+        }
+        return report.affinityApplied;
+#else
+        (void)onWorker;
+        report.affinityApplied = false;
+        return affinityMask == 0;
+#endif
+    }
+
+    // Called first thing on the new thread.
+    void configureCurrentThread()
+    {
+#if defined(__linux__)
+        // Linux limits thread names to 15 characters plus the terminator
+        pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+#endif
+        bool wantsLock = false;
+        std::size_t prefaultBytes = 0;
+        {
+            std::lock_guard<std::mutex> lock(reportMutex);
+            wantsLock = lockMemory;
+            prefaultBytes = stackPrefaultBytes;
+        }
+
+        if (wantsLock) {
+            const bool locked = WorkerThread::lockProcessMemory();
+            std::lock_guard<std::mutex> lock(reportMutex);
+            report.memoryLocked = locked;
+        }
+
+        if (prefaultBytes > 0) {
+            const std::size_t touched = prefaultStack(prefaultBytes);
+            std::lock_guard<std::mutex> lock(reportMutex);
+            report.prefaultedStackBytes = touched;
+        }
+
+        applyPriority(true);
+        applyAffinity(true);
+    }
+
+    // Settings below and priority are guarded by reportMutex, since the
+    // setters may run while the worker reads them during startup
+    RealtimePolicy realtimePolicy = RealtimePolicy::Fifo;
+    std::uint64_t affinityMask = 0;
+    bool lockMemory = false;
+    std::size_t stackPrefaultBytes = 0;
+
+    mutable std::mutex reportMutex;
+    SchedulingReport report;
+
     TaskFunction task;
+    std::mutex taskMutex;  // Only contended while setTask() swaps the task
     std::thread thread;
-    std::mutex mutex;
-    std::condition_variable cv;
-    std::condition_variable completionCv;
+    SpinParkEvent wakeEvent;
+    SpinParkEvent completionEvent;
 };
 
 WorkerThread::WorkerThread(const std::string& name, Priority priority)
@@ -52,22 +229,29 @@ bool WorkerThread::start()
     m_impl->running = true;
 
     m_impl->thread = std::thread([this]() {
+        m_impl->configureCurrentThread();
+
         while (!m_impl->shouldStop) {
-            std::unique_lock<std::mutex> lock(m_impl->mutex);
-            m_impl->cv.wait(lock, [this]() {
-                return m_impl->taskPending || m_impl->shouldStop;
-            });
+            const std::uint32_t epoch = m_impl->wakeEvent.prepareWait();
+            const std::uint64_t target = m_impl->requested.load(std::memory_order_acquire);
+            if (target == m_impl->completed.load(std::memory_order_relaxed) && !m_impl->shouldStop) {
+                m_impl->wakeEvent.wait(epoch);
+                continue;
+            }
 
             if (m_impl->shouldStop) {
                 break;
             }
 
-            if (m_impl->task) {
-                m_impl->task();
+            {
+                std::lock_guard<std::mutex> lock(m_impl->taskMutex);
+                if (m_impl->task) {
+                    m_impl->task();
+                }
             }
 
-            m_impl->taskPending = false;
-            m_impl->completionCv.notify_all();
+            m_impl->completed.store(target, std::memory_order_release);
+            m_impl->completionEvent.notifyAll();
         }
 
         m_impl->running = false;
@@ -79,11 +263,7 @@ bool WorkerThread::start()
 void WorkerThread::stop(bool waitForCompletion)
 {
     m_impl->shouldStop = true;
-
-    {
-        std::lock_guard<std::mutex> lock(m_impl->mutex);
-        m_impl->cv.notify_all();
-    }
+    m_impl->wakeEvent.notifyAll();
 
     if (waitForCompletion && m_impl->thread.joinable()) {
         m_impl->thread.join();
@@ -97,36 +277,63 @@ bool WorkerThread::isRunning() const
 
 void WorkerThread::setTask(TaskFunction task)
 {
-    std::lock_guard<std::mutex> lock(m_impl->mutex);
+    std::lock_guard<std::mutex> lock(m_impl->taskMutex);
     m_impl->task = std::move(task);
 }
 
 void WorkerThread::wake()
 {
-    {
-        std::lock_guard<std::mutex> lock(m_impl->mutex);
-        m_impl->taskPending = true;
-    }
-    m_impl->cv.notify_one();
+    m_impl->requested.fetch_add(1, std::memory_order_acq_rel);
+    m_impl->wakeEvent.notifyOne();
 }
 
 bool WorkerThread::waitForCompletion(std::uint32_t timeoutMs)
 {
-    std::unique_lock<std::mutex> lock(m_impl->mutex);
-    return m_impl->completionCv.wait_for(lock,
-        std::chrono::milliseconds(timeoutMs),
-        [this]() { return !m_impl->taskPending; });
+    using Clock = std::chrono::steady_clock;
+    const auto deadline = Clock::now() + std::chrono::milliseconds(timeoutMs);
+
+    // Every wake() made before this call must have been served by a run
+    const std::uint64_t target = m_impl->requested.load(std::memory_order_acquire);
+    for (;;) {
+        const std::uint32_t epoch = m_impl->completionEvent.prepareWait();
+        if (m_impl->completed.load(std::memory_order_acquire) >= target) {
+            return true;
+        }
+
+        const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - Clock::now());
+        if (remaining.count() <= 0) {
+            return false;
+        }
+        m_impl->completionEvent.wait(epoch, static_cast<std::uint32_t>(remaining.count()));
+    }
+}
+
+void WorkerThread::setSpinIterations(std::uint32_t iterations)
+{
+    m_impl->wakeEvent.setSpinIterations(iterations);
+    m_impl->completionEvent.setSpinIterations(iterations);
+}
+
+SpinParkEvent::Statistics WorkerThread::getWakeStatistics() const
+{
+    return m_impl->wakeEvent.getStatistics();
 }
 
 bool WorkerThread::setPriority(Priority priority)
 {
-    m_impl->priority = priority;
-    // TODO: Implement platform-specific priority setting
-    return true;
+    {
+        std::lock_guard<std::mutex> lock(m_impl->reportMutex);
+        m_impl->priority = priority;
+    }
+    if (!m_impl->running) {
+        return true;
+    }
+    return m_impl->applyPriority(false);
 }
 
 WorkerThread::Priority WorkerThread::getPriority() const
 {
+    std::lock_guard<std::mutex> lock(m_impl->reportMutex);
     return m_impl->priority;
 }
 
@@ -137,9 +344,58 @@ std::string WorkerThread::getName() const
 
 bool WorkerThread::setAffinity(std::uint64_t mask)
 {
-    // TODO: Implement platform-specific CPU affinity setting
-    (void)mask;
-    return true;
+    {
+        std::lock_guard<std::mutex> lock(m_impl->reportMutex);
+        m_impl->affinityMask = mask;
+    }
+    if (!m_impl->running) {
+        return true;
+    }
+    return m_impl->applyAffinity(false);
+}
+
+void WorkerThread::setRealtimePolicy(RealtimePolicy policy)
+{
+    std::lock_guard<std::mutex> lock(m_impl->reportMutex);
+    m_impl->realtimePolicy = policy;
+}
+
+WorkerThread::RealtimePolicy WorkerThread::getRealtimePolicy() const
+{
+    std::lock_guard<std::mutex> lock(m_impl->reportMutex);
+    return m_impl->realtimePolicy;
+}
+
+void WorkerThread::setMemoryLocking(bool enable)
+{
+    std::lock_guard<std::mutex> lock(m_impl->reportMutex);
+    m_impl->lockMemory = enable;
+}
+
+void WorkerThread::setStackPrefaultSize(std::size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(m_impl->reportMutex);
+    m_impl->stackPrefaultBytes = bytes;
+}
+
+WorkerThread::SchedulingReport WorkerThread::getSchedulingReport() const
+{
+    std::lock_guard<std::mutex> lock(m_impl->reportMutex);
+    return m_impl->report;
+}
+
+bool WorkerThread::lockProcessMemory()
+{
+#if defined(__linux__)
+    // mlockall() applies to the whole process, so only the first caller
+    // issues it; every worker asking for locked memory shares the result
+    static std::once_flag once;
+    static bool locked = false;
+    std::call_once(once, []() { locked = mlockall(MCL_CURRENT | MCL_FUTURE) == 0; });
+    return locked;
+#else
+    return false;
+#endif
 }
 
 } // namespace nap
@@ -1,6 +1,8 @@
 #ifndef NAP_WORKERTHREAD_H
 #define NAP_WORKERTHREAD_H
 
+#include "SpinParkEvent.h"
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -23,6 +25,28 @@ public:
         Realtime
     };
 
+    /**
+     * @brief OS scheduling policy used for the High and Realtime priorities.
+     */
+    enum class RealtimePolicy {
+        Fifo,
+        RoundRobin
+    };
+
+    /**
+     * @brief What the OS actually granted when the thread was configured.
+     */
+    struct SchedulingReport {
+        Priority requestedPriority = Priority::Normal;
+        bool realtimeGranted = false;     ///< Running under SCHED_FIFO/SCHED_RR
+        int osPolicy = 0;                 ///< Policy in effect (SCHED_* value)
+        int osPriority = 0;               ///< Static priority in effect
+        bool affinityApplied = false;
+        std::uint64_t affinityMask = 0;   ///< CPUs the thread may run on
+        bool memoryLocked = false;        ///< Process memory is locked (mlockall)
+        std::size_t prefaultedStackBytes = 0;
+    };
+
     using TaskFunction = std::function<void()>;
 
     /**
@@ -65,6 +89,8 @@ public:
 
     /**
      * @brief Wake the thread to execute its task.
+     *
+     * Never locks; only enters the kernel if the worker has parked.
      */
     void wake();
 
@@ -75,10 +101,28 @@ public:
      */
     bool waitForCompletion(std::uint32_t timeoutMs = 1000);
 
+    /**
+     * @brief Set how long the worker (and waitForCompletion()) spins before parking.
+     * @param iterations Spin iterations, 0 parks immediately
+     */
+    void setSpinIterations(std::uint32_t iterations);
+
+    /**
+     * @brief Get wake-up latency measured from wake() to the worker running.
+     * @return Wake-up statistics
+     */
+    SpinParkEvent::Statistics getWakeStatistics() const;
+
     /**
      * @brief Set the thread priority.
+     *
+     * High and Realtime map to the configured RealtimePolicy. If the process
+     * lacks permission, the priority is clamped to RLIMIT_RTPRIO and, failing
+     * that, the thread falls back to normal scheduling. Applied immediately
+     * when running, otherwise when the thread starts.
      * @param priority The priority level
-     * @return True if priority was set successfully
+     * @return True if the OS granted the requested scheduling class (or
+     *         the thread is not running yet)
      */
     bool setPriority(Priority priority);
 
@@ -96,11 +140,58 @@ public:
 
     /**
      * @brief Set the CPU affinity mask.
-     * @param mask CPU affinity mask
-     * @return True if affinity was set successfully
+     *
+     * Pinning worker threads to isolated cores keeps them away from
+     * housekeeping work. Applied immediately when running, otherwise when
+     * the thread starts.
+     * @param mask CPU affinity mask, bit N for CPU N; 0 clears the restriction
+     * @return True if affinity was set successfully (or stored for start)
      */
     bool setAffinity(std::uint64_t mask);
 
+    /**
+     * @brief Choose the policy used for High and Realtime priorities.
+     * @param policy SCHED_FIFO or SCHED_RR
+     */
+    void setRealtimePolicy(RealtimePolicy policy);
+
+    /**
+     * @brief Get the policy used for High and Realtime priorities.
+     * @return Realtime policy
+     */
+    RealtimePolicy getRealtimePolicy() const;
+
+    /**
+     * @brief Lock all process memory (mlockall) when the thread starts.
+     *
+     * The lock is process-wide: it is taken once, by the first worker
+     * that starts with this enabled, and covers every thread.
+     * @param enable True to lock memory
+     */
+    void setMemoryLocking(bool enable);
+
+    /**
+     * @brief Touch this many bytes of stack when the thread starts so the
+     *        pages are resident before the first real-time iteration.
+     * @param bytes Stack bytes to pre-fault, 0 to disable
+     */
+    void setStackPrefaultSize(std::size_t bytes);
+
+    /**
+     * @brief Get what the OS granted for priority, affinity and memory.
+     * @return Scheduling report, updated whenever settings are applied
+     */
+    SchedulingReport getSchedulingReport() const;
+
+    /**
+     * @brief Lock all current and future process memory into RAM.
+     *
+     * Process-wide; mlockall() is only called on the first invocation and
+     * later calls return its result.
+     * @return True if mlockall succeeded
+     */
+    static bool lockProcessMemory();
+
 private:
     class Impl;
     std::unique_ptr<Impl> m_impl;
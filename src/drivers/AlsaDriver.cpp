@@ -1,4 +1,7 @@
 #include "drivers/AlsaDriver.h"
+#include <algorithm>
+#include <cerrno>
+#include <vector>
 
 namespace nap {
 
@@ -12,6 +15,120 @@ public:
     // ALSA-specific settings
     int periods = 2;
     int periodSize = 512;
+    PcmAccess accessMode = PcmAccess::MMapInterleaved;
+    PcmFormat sampleFormat = PcmFormat::S32_LE;
+
+    std::unique_ptr<IPcmDevice> pcm;
+    bool pcmStarted = false;
+    uint64_t xruns = 0;
+
+    std::vector<float> inputBuffer;
+    std::vector<float> outputBuffer;
+
+    // Device-format staging for the RW access modes
+    std::vector<uint8_t> scratch;
+    std::vector<PcmChannelArea> scratchAreas;
+    std::vector<void*> scratchPlanes;
+
+    bool isMmap() const {
+        return accessMode == PcmAccess::MMapInterleaved ||
+               accessMode == PcmAccess::MMapNonInterleaved;
+    }
+
+    bool openPcm() {
+        const size_t channels = static_cast<size_t>(std::max(config.outputChannels, 0));
+        const size_t frames = static_cast<size_t>(std::max(periodSize, 0));
+
+        PcmParams params;
+        params.format = sampleFormat;
+        params.access = accessMode;
+        params.channels = static_cast<unsigned int>(channels);
+        params.rate = static_cast<unsigned int>(config.sampleRate);
+        params.periodFrames = frames;
+        params.periods = static_cast<size_t>(std::max(periods, 0));
+        if (pcm->setParams(params) < 0) {
+            lastError = "PCM rejected the hardware parameters";
+            return false;
+        }
+
+        inputBuffer.assign(frames * static_cast<size_t>(std::max(config.inputChannels, 0)), 0.0f);
+        outputBuffer.assign(frames * channels, 0.0f);
+        pcmStarted = false;
+
+        scratch.clear();
+        scratchAreas.clear();
+        scratchPlanes.clear();
+        if (!isMmap()) {
+            const size_t bytes = getPcmSampleBytes(sampleFormat);
+            const unsigned int bits = static_cast<unsigned int>(bytes * 8);
+            scratch.assign(frames * channels * bytes, 0);
+            for (size_t ch = 0; ch < channels; ++ch) {
+                if (accessMode == PcmAccess::RWInterleaved) {
+                    scratchAreas.push_back({scratch.data(), static_cast<unsigned int>(ch) * bits,
+                                            static_cast<unsigned int>(channels) * bits});
+                } else {
+                    scratchAreas.push_back({scratch.data() + ch * frames * bytes, 0, bits});
+                    scratchPlanes.push_back(scratchAreas.back().addr);
+                }
+            }
+        }
+        return true;
+    }
+
+    // Converts the rendered period directly into the device ring
+    long writeMmap(size_t frames) {
+        const size_t channels = static_cast<size_t>(config.outputChannels);
+        size_t done = 0;
+        while (done < frames) {
+            const PcmChannelArea* areas = nullptr;
+            size_t offset = 0;
+            size_t granted = frames - done;
+            if (int err = pcm->mmapBegin(areas, offset, granted)) return err;
+            if (granted == 0) return -EAGAIN;
+
+            convertToPcm(outputBuffer.data() + done * channels, channels, granted,
+                         areas, offset, sampleFormat);
+            // A short commit leaves the rest for the next mmapBegin()
+            const long committed = pcm->mmapCommit(offset, granted);
+            if (committed < 0) return committed;
+            if (committed == 0) break;
+            done += static_cast<size_t>(committed);
+        }
+        return static_cast<long>(done);
+    }
+
+    // Converts into the scratch buffer, which the write call copies
+    long writeCopy(size_t frames) {
+        const size_t channels = static_cast<size_t>(config.outputChannels);
+        convertToPcm(outputBuffer.data(), channels, frames, scratchAreas.data(), 0, sampleFormat);
+
+        // Short writes are resumed from the first frame not taken
+        const size_t bytes = getPcmSampleBytes(sampleFormat);
+        size_t done = 0;
+        while (done < frames) {
+            long written;
+            if (accessMode == PcmAccess::RWInterleaved) {
+                written = pcm->writeInterleaved(scratch.data() + done * channels * bytes, frames - done);
+            } else {
+                for (size_t ch = 0; ch < channels; ++ch) {
+                    scratchPlanes[ch] = static_cast<uint8_t*>(scratchAreas[ch].addr) + done * bytes;
+                }
+                written = pcm->writeNonInterleaved(scratchPlanes.data(), frames - done);
+            }
+            if (written < 0) return written;
+            if (written == 0) break;
+            done += static_cast<size_t>(written);
+        }
+        return static_cast<long>(done);
+    }
+
+    void recoverXrun(long error) {
+        if (error == -EPIPE) {
+            ++xruns;
+        }
+        pcm->recover(static_cast<int>(error));
+        pcmStarted = false;
+    }
 };
 
 AlsaDriver::AlsaDriver()
@@ -55,6 +172,9 @@ bool AlsaDriver::start() {
     // TODO: Start ALSA stream
     // snd_pcm_prepare()
     // snd_pcm_start()
+    if (pImpl->pcm && !pImpl->openPcm()) {
+        return false;
+    }
     pImpl->state = DriverState::Running;
     return true;
 }
@@ -63,6 +183,10 @@ void AlsaDriver::stop() {
     if (pImpl->state == DriverState::Running) {
         // TODO: Stop ALSA stream
         // snd_pcm_drop()
+        if (pImpl->pcm) {
+            pImpl->pcm->drop();
+            pImpl->pcmStarted = false;
+        }
         pImpl->state = DriverState::Stopped;
     }
 }
@@ -148,4 +272,83 @@ void AlsaDriver::setHardwareParams(int periods, int periodSize) {
     pImpl->periodSize = periodSize;
 }
 
+bool AlsaDriver::setAccessMode(AccessMode mode) {
+    if (pImpl->state == DriverState::Running) {
+        pImpl->lastError = "Cannot change access mode while running";
+        return false;
+    }
+    pImpl->accessMode = mode;
+    return true;
+}
+
+AlsaDriver::AccessMode AlsaDriver::getAccessMode() const {
+    return pImpl->accessMode;
+}
+
+bool AlsaDriver::setSampleFormat(SampleFormat format) {
+    if (pImpl->state == DriverState::Running) {
+        pImpl->lastError = "Cannot change sample format while running";
+        return false;
+    }
+    pImpl->sampleFormat = format;
+    return true;
+}
+
+AlsaDriver::SampleFormat AlsaDriver::getSampleFormat() const {
+    return pImpl->sampleFormat;
+}
+
+void AlsaDriver::setPcmDevice(std::unique_ptr<IPcmDevice> device) {
+    if (pImpl->state == DriverState::Running) {
+        stop();
+    }
+    pImpl->pcm = std::move(device);
+}
+
+IPcmDevice* AlsaDriver::getPcmDevice() const {
+    return pImpl->pcm.get();
+}
+
+bool AlsaDriver::processPeriod() {
+    auto& impl = *pImpl;
+    if (impl.state != DriverState::Running || !impl.pcm) {
+        return false;
+    }
+
+    const size_t frames = static_cast<size_t>(impl.periodSize);
+    const long avail = impl.pcm->avail();
+    if (avail < 0) {
+        impl.recoverXrun(avail);
+        return false;
+    }
+    if (static_cast<size_t>(avail) < frames) {
+        return false;
+    }
+
+    std::fill(impl.outputBuffer.begin(), impl.outputBuffer.end(), 0.0f);
+    if (impl.callback) {
+        impl.callback(impl.inputBuffer.data(), impl.outputBuffer.data(), impl.periodSize,
+                      impl.config.inputChannels, impl.config.outputChannels);
+    }
+
+    const long written = impl.isMmap() ? impl.writeMmap(frames) : impl.writeCopy(frames);
+    if (written < 0) {
+        impl.recoverXrun(written);
+        return false;
+    }
+
+    // Start threshold is the whole ring, as ALSA's default
+    if (!impl.pcmStarted) {
+        const long room = impl.pcm->avail();
+        if (room >= 0 && static_cast<size_t>(room) < frames) {
+            impl.pcmStarted = impl.pcm->start() == 0;
+        }
+    }
+    return true;
+}
+
+uint64_t AlsaDriver::getXrunCount() const {
+    return pImpl->xruns;
+}
+
 } // namespace nap
@@ -2,6 +2,7 @@
 #define NAP_ALSA_DRIVER_H
 
 #include "drivers/IAudioDriver.h"
+#include "drivers/AlsaPcm.h"
 #include <memory>
 
 namespace nap {
@@ -11,6 +12,12 @@ namespace nap {
  *
  * Provides low-level audio I/O through ALSA (Advanced Linux Sound Architecture).
  * This is a stub implementation for cross-platform structure.
+ *
+ * Once an IPcmDevice is attached, processPeriod() renders one period and
+ * queues it on the device. In the MMap access modes the float output is
+ * converted straight into the device ring between mmapBegin() and
+ * mmapCommit(); the RW modes convert into a scratch buffer that the write
+ * call copies again. The stream starts once the ring is full.
  */
 class AlsaDriver : public IAudioDriver {
 public:
@@ -45,7 +52,22 @@ public:
     bool isAvailable() const override;
 
     // ALSA-specific
+    using AccessMode = PcmAccess;
+    using SampleFormat = PcmFormat;
+
     void setHardwareParams(int periods, int periodSize);
+    bool setAccessMode(AccessMode mode);
+    AccessMode getAccessMode() const;
+    bool setSampleFormat(SampleFormat format);
+    SampleFormat getSampleFormat() const;
+
+    // Device the stream runs on, e.g. a FakePcmDevice; set before start()
+    void setPcmDevice(std::unique_ptr<IPcmDevice> device);
+    IPcmDevice* getPcmDevice() const;
+
+    // Renders and queues one period; false if the device has no room for it
+    bool processPeriod();
+    uint64_t getXrunCount() const;
 
 private:
     class Impl;
@@ -0,0 +1,196 @@
+#include "drivers/AlsaPcm.h"
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define NAP_ALSA_PCM_SSE 1
+#endif
+
+namespace nap {
+
+namespace {
+
+constexpr float kS16Scale = 32767.0f;
+constexpr float kS24Scale = 8388607.0f;
+constexpr float kS32Scale = 2147483647.0f;
+// 2147483647 rounds up to 2^31 as a float; this is the largest float below it
+constexpr float kIntMax = 2147483520.0f;
+
+// Channels that are gathered before conversion go through a block this size
+constexpr size_t kGatherFrames = 64;
+
+float scaleOf(PcmFormat format) {
+    switch (format) {
+        case PcmFormat::S16_LE: return kS16Scale;
+        case PcmFormat::S24_LE:
+        case PcmFormat::S24_3LE: return kS24Scale;
+        default: return kS32Scale;
+    }
+}
+
+// NaN becomes silence rather than a full-scale sample, matching toInt4()
+int32_t toInt(float x, float scale) {
+    x = x == x ? x : 0.0f;
+    x = x > -1.0f ? x : -1.0f;
+    x = x < 1.0f ? x : 1.0f;
+    return static_cast<int32_t>(std::lrint(std::min(x * scale, kIntMax)));
+}
+
+void store24(uint8_t* dst, int32_t value) {
+    dst[0] = static_cast<uint8_t>(value);
+    dst[1] = static_cast<uint8_t>(value >> 8);
+    dst[2] = static_cast<uint8_t>(value >> 16);
+}
+
+void writeSample(uint8_t* dst, float x, PcmFormat format) {
+    if (format == PcmFormat::Float32_LE) {
+        std::memcpy(dst, &x, sizeof(float));
+        return;
+    }
+    const int32_t value = toInt(x, scaleOf(format));
+    if (format == PcmFormat::S16_LE) {
+        const int16_t s = static_cast<int16_t>(value);
+        std::memcpy(dst, &s, sizeof(s));
+    } else if (format == PcmFormat::S24_3LE) {
+        store24(dst, value);
+    } else {
+        std::memcpy(dst, &value, sizeof(value));
+    }
+}
+
+#if defined(NAP_ALSA_PCM_SSE)
+__m128i toInt4(const float* src, __m128 scale) {
+    __m128 x = _mm_loadu_ps(src);
+    x = _mm_and_ps(x, _mm_cmpord_ps(x, x));  // NaN -> 0
+    x = _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(-1.0f)), _mm_set1_ps(1.0f));
+    return _mm_cvtps_epi32(_mm_min_ps(_mm_mul_ps(x, scale), _mm_set1_ps(kIntMax)));
+}
+#endif
+
+// Contiguous samples into contiguous device memory
+void convertBlock(const float* src, uint8_t* dst, size_t count, PcmFormat format) {
+    if (format == PcmFormat::Float32_LE) {
+        std::memcpy(dst, src, count * sizeof(float));
+        return;
+    }
+
+    const size_t bytes = getPcmSampleBytes(format);
+    size_t i = 0;
+#if defined(NAP_ALSA_PCM_SSE)
+    const __m128 scale = _mm_set1_ps(scaleOf(format));
+    if (format == PcmFormat::S16_LE) {
+        for (; i + 8 <= count; i += 8) {
+            const __m128i lo = toInt4(src + i, scale);
+            const __m128i hi = toInt4(src + i + 4, scale);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 2), _mm_packs_epi32(lo, hi));
+        }
+    } else if (format == PcmFormat::S24_3LE) {
+        alignas(16) int32_t values[4];
+        for (; i + 4 <= count; i += 4) {
+            _mm_store_si128(reinterpret_cast<__m128i*>(values), toInt4(src + i, scale));
+            for (size_t k = 0; k < 4; ++k) {
+                store24(dst + (i + k) * 3, values[k]);
+            }
+        }
+    } else {
+        for (; i + 4 <= count; i += 4) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), toInt4(src + i, scale));
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        writeSample(dst + i * bytes, src[i], format);
+    }
+}
+
+} // namespace
+
+size_t getPcmSampleBytes(PcmFormat format) {
+    switch (format) {
+        case PcmFormat::S16_LE: return 2;
+        case PcmFormat::S24_3LE: return 3;
+        default: return 4;
+    }
+}
+
+void convertToPcm(const float* src, size_t channels, size_t frames,
+                  const PcmChannelArea* areas, size_t offset, PcmFormat format) {
+    if (channels == 0 || frames == 0) return;
+
+    const size_t bytes = getPcmSampleBytes(format);
+    const unsigned int bits = static_cast<unsigned int>(bytes * 8);
+
+    // Interleaved ring: one conversion over every sample of the span
+    bool interleaved = true;
+    for (size_t ch = 0; ch < channels && interleaved; ++ch) {
+        interleaved = areas[ch].addr == areas[0].addr &&
+                      areas[ch].first == ch * bits &&
+                      areas[ch].step == channels * bits;
+    }
+    if (interleaved) {
+        uint8_t* dst = static_cast<uint8_t*>(areas[0].addr) + offset * channels * bytes;
+        convertBlock(src, dst, frames * channels, format);
+        return;
+    }
+
+    for (size_t ch = 0; ch < channels; ++ch) {
+        const PcmChannelArea& area = areas[ch];
+        uint8_t* base = static_cast<uint8_t*>(area.addr);
+
+        if (area.step == bits && area.first % 8 == 0) {
+            // Contiguous channel: gather a block of its samples, then convert
+            uint8_t* dst = base + area.first / 8 + offset * bytes;
+            float block[kGatherFrames];
+            for (size_t done = 0; done < frames; done += kGatherFrames) {
+                const size_t n = std::min(kGatherFrames, frames - done);
+                for (size_t f = 0; f < n; ++f) {
+                    block[f] = src[(done + f) * channels + ch];
+                }
+                convertBlock(block, dst + done * bytes, n, format);
+            }
+            continue;
+        }
+
+        for (size_t f = 0; f < frames; ++f) {
+            const size_t bit = area.first + (offset + f) * area.step;
+            writeSample(base + bit / 8, src[f * channels + ch], format);
+        }
+    }
+}
+
+float decodePcmSample(const void* sample, PcmFormat format) {
+    const uint8_t* p = static_cast<const uint8_t*>(sample);
+    switch (format) {
+        case PcmFormat::S16_LE: {
+            int16_t s;
+            std::memcpy(&s, p, sizeof(s));
+            return s / kS16Scale;
+        }
+        case PcmFormat::S24_LE: {
+            uint32_t raw;
+            std::memcpy(&raw, p, sizeof(raw));
+            const int32_t s = static_cast<int32_t>(raw << 8) >> 8;
+            return s / kS24Scale;
+        }
+        case PcmFormat::S24_3LE: {
+            const uint32_t raw = p[0] | (p[1] << 8) | (static_cast<uint32_t>(p[2]) << 16);
+            const int32_t s = static_cast<int32_t>(raw << 8) >> 8;
+            return s / kS24Scale;
+        }
+        case PcmFormat::S32_LE: {
+            int32_t s;
+            std::memcpy(&s, p, sizeof(s));
+            return static_cast<float>(s / static_cast<double>(kS32Scale));
+        }
+        case PcmFormat::Float32_LE: {
+            float s;
+            std::memcpy(&s, p, sizeof(s));
+            return s;
+        }
+    }
+    return 0.0f;
+}
+
+} // namespace nap
@@ -0,0 +1,101 @@
+#ifndef NAP_ALSA_PCM_H
+#define NAP_ALSA_PCM_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace nap {
+
+/**
+ * @brief Sample formats an ALSA PCM can be opened with (all little-endian)
+ *
+ * S24_LE is 24 bits in the low bytes of a 32-bit word; S24_3LE is packed
+ * into 3 bytes.
+ */
+enum class PcmFormat {
+    S16_LE,
+    S24_LE,
+    S24_3LE,
+    S32_LE,
+    Float32_LE
+};
+
+/**
+ * @brief How frames reach the PCM ring buffer
+ *
+ * The RW modes copy through snd_pcm_writei()/writen(). The MMap modes write
+ * straight into the ring between snd_pcm_mmap_begin() and mmap_commit().
+ */
+enum class PcmAccess {
+    RWInterleaved,
+    RWNonInterleaved,
+    MMapInterleaved,
+    MMapNonInterleaved
+};
+
+/**
+ * @brief Location of one channel in a buffer, as snd_pcm_channel_area_t
+ *
+ * Sample n of the channel starts at bit (first + n * step) of addr.
+ */
+struct PcmChannelArea {
+    void* addr = nullptr;
+    unsigned int first = 0;
+    unsigned int step = 0;
+};
+
+/**
+ * @brief Hardware parameters requested from a PCM
+ */
+struct PcmParams {
+    PcmFormat format = PcmFormat::S32_LE;
+    PcmAccess access = PcmAccess::MMapInterleaved;
+    unsigned int channels = 2;
+    unsigned int rate = 48000;
+    size_t periodFrames = 512;
+    size_t periods = 2;
+};
+
+/**
+ * @brief The subset of the ALSA PCM API the playback path uses
+ *
+ * Methods mirror their snd_pcm_* namesakes, including negative errno
+ * results: -EPIPE reports an underrun until recover() is called. This lets
+ * the driver run against the real library or a FakePcmDevice unchanged.
+ */
+class IPcmDevice {
+public:
+    virtual ~IPcmDevice() = default;
+
+    virtual int setParams(const PcmParams& params) = 0;
+    virtual int prepare() = 0;
+    virtual int start() = 0;
+    virtual int drop() = 0;
+    virtual int recover(int error) = 0;
+
+    // Frames that can be written without blocking, or a negative error
+    virtual long avail() = 0;
+
+    // frames is in/out: requested, then the contiguous frames granted at offset
+    virtual int mmapBegin(const PcmChannelArea*& areas, size_t& offset, size_t& frames) = 0;
+    virtual long mmapCommit(size_t offset, size_t frames) = 0;
+
+    virtual long writeInterleaved(const void* buffer, size_t frames) = 0;
+    virtual long writeNonInterleaved(void* const* buffers, size_t frames) = 0;
+};
+
+// Bytes one sample of the format occupies
+size_t getPcmSampleBytes(PcmFormat format);
+
+// Converts interleaved float frames, clamped to [-1, 1] for the integer
+// formats, into the channel areas starting at frame offset. Interleaved and
+// per-channel contiguous areas take a vectorized path.
+void convertToPcm(const float* src, size_t channels, size_t frames,
+                  const PcmChannelArea* areas, size_t offset, PcmFormat format);
+
+// Reads one sample back as float; the inverse of convertToPcm's scaling
+float decodePcmSample(const void* sample, PcmFormat format);
+
+} // namespace nap
+
+#endif // NAP_ALSA_PCM_H
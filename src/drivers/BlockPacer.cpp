@@ -0,0 +1,243 @@
+#include "drivers/BlockPacer.h"
+#include "core/threading/CpuRelax.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <time.h>
+#else
+#include <thread>
+#endif
+
+namespace nap {
+
+namespace {
+
+constexpr int64_t kNsPerSecond = 1000000000;
+
+void raiseMax(std::atomic<int64_t>& target, int64_t value) {
+    // Single writer, so a plain load/store is enough
+    if (value > target.load(std::memory_order_relaxed)) {
+        target.store(value, std::memory_order_relaxed);
+    }
+}
+
+} // namespace
+
+size_t PacingHistogram::bucketFor(int64_t lateNs) {
+    if (lateNs < 1000) return 0;
+    uint64_t us = static_cast<uint64_t>(lateNs / 1000);
+    size_t bucket = 0;
+    while (us) {
+        ++bucket;
+        us >>= 1;
+    }
+    return bucket < kBuckets ? bucket : kBuckets - 1;
+}
+
+int64_t PacingHistogram::bucketFloorNs(size_t bucket) {
+    return bucket == 0 ? 0 : (int64_t{1} << (bucket - 1)) * 1000;
+}
+
+uint64_t PacingHistogram::total() const {
+    uint64_t sum = 0;
+    for (uint64_t count : counts) sum += count;
+    return sum;
+}
+
+class BlockPacer::Impl {
+public:
+    using Buckets = std::array<std::atomic<uint64_t>, PacingHistogram::kBuckets>;
+
+    // Schedule, touched only by the pacing thread
+    bool started = false;
+    int64_t rate = 0;
+    int64_t anchorNs = 0;
+    uint64_t anchorFrames = 0;
+    uint64_t scheduledFrames = 0;
+
+    std::atomic<int64_t> spinTailNs{0};
+    std::atomic<int64_t> maxLatenessNs{kDefaultMaxLatenessNs};
+
+    // Statistics, readable from any thread
+    std::atomic<uint64_t> blocks{0};
+    std::atomic<uint64_t> misses{0};
+    std::atomic<uint64_t> resyncs{0};
+    std::atomic<uint64_t> wakes{0};
+    std::atomic<int64_t> jitterSumNs{0};
+    std::atomic<int64_t> maxJitterNs{0};
+    std::atomic<int64_t> maxLateNs{0};
+    Buckets jitter{};
+    Buckets missCounts{};
+
+    // Exact for integer rates, so the schedule has no rounding drift
+    int64_t framesToNs(uint64_t frames) const {
+        const uint64_t r = static_cast<uint64_t>(rate);
+        return static_cast<int64_t>((frames / r) * kNsPerSecond + (frames % r) * kNsPerSecond / r);
+    }
+
+    int64_t deadline() const {
+        return anchorNs + framesToNs(scheduledFrames - anchorFrames);
+    }
+
+    void sleepUntil(int64_t deadlineNs) {
+        const int64_t wakeAt = deadlineNs - spinTailNs.load(std::memory_order_relaxed);
+#if defined(__linux__)
+        if (wakeAt > now()) {
+            timespec ts;
+            ts.tv_sec = static_cast<time_t>(wakeAt / kNsPerSecond);
+            ts.tv_nsec = static_cast<long>(wakeAt % kNsPerSecond);
+            while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {
+            }
+        }
+#else
+        std::this_thread::sleep_until(
+            std::chrono::steady_clock::time_point(std::chrono::nanoseconds(wakeAt)));
+#endif
+        while (now() < deadlineNs) {
+            cpuRelax();
+        }
+    }
+
+    static void add(Buckets& buckets, int64_t lateNs) {
+        buckets[PacingHistogram::bucketFor(lateNs)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void copy(const Buckets& from, PacingHistogram& to) {
+        for (size_t i = 0; i < PacingHistogram::kBuckets; ++i) {
+            to.counts[i] = from[i].load(std::memory_order_relaxed);
+        }
+    }
+};
+
+BlockPacer::BlockPacer()
+    : pImpl(std::make_unique<Impl>()) {}
+
+BlockPacer::~BlockPacer() = default;
+
+BlockPacer::BlockPacer(BlockPacer&&) noexcept = default;
+BlockPacer& BlockPacer::operator=(BlockPacer&&) noexcept = default;
+
+int64_t BlockPacer::now() {
+#if defined(__linux__)
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * kNsPerSecond + ts.tv_nsec;
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+void BlockPacer::start(double sampleRate) {
+    auto& impl = *pImpl;
+    impl.rate = std::max<int64_t>(std::llround(sampleRate), 1);
+    impl.anchorNs = now();
+    impl.anchorFrames = 0;
+    impl.scheduledFrames = 0;
+    impl.started = true;
+}
+
+bool BlockPacer::isStarted() const {
+    return pImpl->started;
+}
+
+int64_t BlockPacer::waitForBlock(size_t numFrames) {
+    auto& impl = *pImpl;
+    if (!impl.started) {
+        return 0;
+    }
+
+    int64_t late = 0;
+    if (impl.scheduledFrames != impl.anchorFrames) {
+        const int64_t deadline = impl.deadline();
+        const int64_t current = now();
+        late = current - deadline;
+
+        if (late > 0) {
+            impl.misses.fetch_add(1, std::memory_order_relaxed);
+            Impl::add(impl.missCounts, late);
+            raiseMax(impl.maxLateNs, late);
+            if (late > impl.maxLatenessNs.load(std::memory_order_relaxed)) {
+                // Too far behind to catch up; restart the schedule from here
+                impl.anchorNs = current;
+                impl.anchorFrames = impl.scheduledFrames;
+                impl.resyncs.fetch_add(1, std::memory_order_relaxed);
+            }
+        } else {
+            impl.sleepUntil(deadline);
+            late = now() - deadline;
+            impl.wakes.fetch_add(1, std::memory_order_relaxed);
+            impl.jitterSumNs.fetch_add(late, std::memory_order_relaxed);
+            Impl::add(impl.jitter, late);
+            raiseMax(impl.maxJitterNs, late);
+        }
+    }
+
+    impl.scheduledFrames += numFrames;
+    impl.blocks.fetch_add(1, std::memory_order_relaxed);
+    return late;
+}
+
+int64_t BlockPacer::getNextDeadline() const {
+    return pImpl->started ? pImpl->deadline() : 0;
+}
+
+uint64_t BlockPacer::getScheduledFrames() const {
+    return pImpl->scheduledFrames;
+}
+
+void BlockPacer::setSpinTail(int64_t ns) {
+    pImpl->spinTailNs.store(std::max<int64_t>(ns, 0), std::memory_order_relaxed);
+}
+
+int64_t BlockPacer::getSpinTail() const {
+    return pImpl->spinTailNs.load(std::memory_order_relaxed);
+}
+
+void BlockPacer::setMaxLateness(int64_t ns) {
+    pImpl->maxLatenessNs.store(std::max<int64_t>(ns, 0), std::memory_order_relaxed);
+}
+
+int64_t BlockPacer::getMaxLateness() const {
+    return pImpl->maxLatenessNs.load(std::memory_order_relaxed);
+}
+
+PacingStats BlockPacer::getStats() const {
+    const auto& impl = *pImpl;
+    PacingStats stats;
+    stats.blocks = impl.blocks.load(std::memory_order_relaxed);
+    stats.deadlineMisses = impl.misses.load(std::memory_order_relaxed);
+    stats.resyncs = impl.resyncs.load(std::memory_order_relaxed);
+    stats.maxJitterNs = impl.maxJitterNs.load(std::memory_order_relaxed);
+    stats.maxLatenessNs = impl.maxLateNs.load(std::memory_order_relaxed);
+
+    const uint64_t wakes = impl.wakes.load(std::memory_order_relaxed);
+    if (wakes > 0) {
+        stats.meanJitterNs = static_cast<double>(impl.jitterSumNs.load(std::memory_order_relaxed)) /
+                             static_cast<double>(wakes);
+    }
+    Impl::copy(impl.jitter, stats.jitter);
+    Impl::copy(impl.missCounts, stats.misses);
+    return stats;
+}
+
+void BlockPacer::resetStats() {
+    auto& impl = *pImpl;
+    impl.blocks.store(0, std::memory_order_relaxed);
+    impl.misses.store(0, std::memory_order_relaxed);
+    impl.resyncs.store(0, std::memory_order_relaxed);
+    impl.wakes.store(0, std::memory_order_relaxed);
+    impl.jitterSumNs.store(0, std::memory_order_relaxed);
+    impl.maxJitterNs.store(0, std::memory_order_relaxed);
+    impl.maxLateNs.store(0, std::memory_order_relaxed);
+    for (size_t i = 0; i < PacingHistogram::kBuckets; ++i) {
+        impl.jitter[i].store(0, std::memory_order_relaxed);
+        impl.missCounts[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+} // namespace nap
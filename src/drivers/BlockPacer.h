@@ -0,0 +1,108 @@
+#ifndef NAP_BLOCK_PACER_H
+#define NAP_BLOCK_PACER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace nap {
+
+/**
+ * @brief Counts of lateness values in power-of-two microsecond buckets
+ *
+ * Bucket 0 holds values under 1 us, bucket k values in [2^(k-1), 2^k) us.
+ * The last bucket also takes everything beyond its range (about 0.5 s).
+ */
+struct PacingHistogram {
+    static constexpr size_t kBuckets = 21;
+
+    std::array<uint64_t, kBuckets> counts{};
+
+    static size_t bucketFor(int64_t lateNs);
+    // Lower edge of a bucket in nanoseconds
+    static int64_t bucketFloorNs(size_t bucket);
+
+    uint64_t total() const;
+};
+
+/**
+ * @brief Timing statistics of a BlockPacer
+ *
+ * Wake-up jitter is how long after its deadline the thread woke, for
+ * blocks that had to wait. A deadline miss is a block whose deadline had
+ * already passed when it was requested, because the previous block ran
+ * long; it runs immediately and its lateness goes to the miss histogram.
+ */
+struct PacingStats {
+    uint64_t blocks = 0;
+    uint64_t deadlineMisses = 0;
+    uint64_t resyncs = 0;
+    int64_t maxJitterNs = 0;
+    double meanJitterNs = 0.0;
+    int64_t maxLatenessNs = 0;
+    PacingHistogram jitter;
+    PacingHistogram misses;
+};
+
+/**
+ * @brief Paces audio blocks on absolute CLOCK_MONOTONIC deadlines
+ *
+ * Block deadlines are derived from the number of frames since start(),
+ * not from the previous wake-up, so processing time and sleep overshoot
+ * never accumulate: after a slow block the following blocks run early
+ * until the schedule is caught up. Only a stall longer than the maximum
+ * lateness re-anchors the schedule at the current time, counted as a
+ * resync, so a suspended process does not burst to catch up.
+ *
+ * On Linux the wait is clock_nanosleep(TIMER_ABSTIME). With a spin tail
+ * the thread sleeps until that long before the deadline and spins the
+ * rest, trading CPU for wake-up jitter.
+ *
+ * waitForBlock() is called from one thread; getStats() may be called
+ * from any thread.
+ */
+class BlockPacer {
+public:
+    static constexpr int64_t kDefaultMaxLatenessNs = 100000000;
+
+    BlockPacer();
+    ~BlockPacer();
+
+    // Non-copyable, movable
+    BlockPacer(const BlockPacer&) = delete;
+    BlockPacer& operator=(const BlockPacer&) = delete;
+    BlockPacer(BlockPacer&&) noexcept;
+    BlockPacer& operator=(BlockPacer&&) noexcept;
+
+    // Anchors the schedule: the first block is due now
+    void start(double sampleRate);
+    bool isStarted() const;
+
+    // Waits until the next block is due, then advances the schedule by
+    // numFrames. Returns how late the block starts, in nanoseconds.
+    int64_t waitForBlock(size_t numFrames);
+
+    // Absolute time the next block is due, on the now() clock
+    int64_t getNextDeadline() const;
+    uint64_t getScheduledFrames() const;
+
+    void setSpinTail(int64_t ns);  // 0 sleeps the whole way
+    int64_t getSpinTail() const;
+    void setMaxLateness(int64_t ns);
+    int64_t getMaxLateness() const;
+
+    PacingStats getStats() const;
+    void resetStats();
+
+    // CLOCK_MONOTONIC in nanoseconds
+    static int64_t now();
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace nap
+
+#endif // NAP_BLOCK_PACER_H
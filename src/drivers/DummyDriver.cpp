@@ -1,7 +1,5 @@
 #include "drivers/DummyDriver.h"
 #include <vector>
-#include <thread>
-#include <chrono>
 
 namespace nap {
 
@@ -13,6 +11,8 @@ public:
     AudioCallback callback;
 
     bool simulateRealtime = false;
+    BlockPacer pacer;
+    bool pacerAnchored = false;
     uint64_t processedSamples = 0;
     uint64_t processedBlocks = 0;
 
@@ -55,6 +55,7 @@ bool DummyDriver::start() {
     pImpl->inputBuffer.resize(totalInputSamples, 0.0f);
     pImpl->outputBuffer.resize(totalOutputSamples, 0.0f);
 
+    pImpl->pacerAnchored = false;
     pImpl->state = DriverState::Running;
     return true;
 }
@@ -128,6 +129,15 @@ void DummyDriver::processBlock(int numFrames) {
         return;
     }
 
+    // Wait for this block's deadline; the first paced block anchors the schedule
+    if (pImpl->simulateRealtime && pImpl->config.sampleRate > 0) {
+        if (!pImpl->pacerAnchored) {
+            pImpl->pacer.start(pImpl->config.sampleRate);
+            pImpl->pacerAnchored = true;
+        }
+        pImpl->pacer.waitForBlock(static_cast<size_t>(numFrames));
+    }
+
     // Ensure buffers are sized correctly
     int inputSize = numFrames * pImpl->config.inputChannels;
     int outputSize = numFrames * pImpl->config.outputChannels;
@@ -154,13 +164,6 @@ void DummyDriver::processBlock(int numFrames) {
     // Update statistics
     pImpl->processedSamples += numFrames;
     pImpl->processedBlocks++;
-
-    // Simulate real-time if enabled
-    if (pImpl->simulateRealtime && pImpl->config.sampleRate > 0) {
-        double blockDuration = static_cast<double>(numFrames) / pImpl->config.sampleRate;
-        auto sleepDuration = std::chrono::duration<double>(blockDuration);
-        std::this_thread::sleep_for(sleepDuration);
-    }
 }
 
 void DummyDriver::processBlocks(int numBlocks) {
@@ -170,6 +173,10 @@ void DummyDriver::processBlocks(int numBlocks) {
 }
 
 void DummyDriver::setSimulateRealtime(bool enable) {
+    if (enable && !pImpl->simulateRealtime) {
+        // Re-anchor rather than catch up on the unpaced time in between
+        pImpl->pacerAnchored = false;
+    }
     pImpl->simulateRealtime = enable;
 }
 
@@ -177,6 +184,14 @@ bool DummyDriver::isSimulatingRealtime() const {
     return pImpl->simulateRealtime;
 }
 
+BlockPacer& DummyDriver::getPacer() {
+    return pImpl->pacer;
+}
+
+const BlockPacer& DummyDriver::getPacer() const {
+    return pImpl->pacer;
+}
+
 uint64_t DummyDriver::getProcessedSamples() const {
     return pImpl->processedSamples;
 }
@@ -188,6 +203,7 @@ uint64_t DummyDriver::getProcessedBlocks() const {
 void DummyDriver::resetStatistics() {
     pImpl->processedSamples = 0;
     pImpl->processedBlocks = 0;
+    pImpl->pacer.resetStats();
 }
 
 } // namespace nap
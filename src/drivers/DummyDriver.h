@@ -2,6 +2,7 @@
 #define NAP_DUMMY_DRIVER_H
 
 #include "drivers/IAudioDriver.h"
+#include "drivers/BlockPacer.h"
 #include <memory>
 
 namespace nap {
@@ -12,6 +13,11 @@ namespace nap {
  * Provides a no-op audio driver that simulates audio I/O
  * without requiring actual hardware. Useful for testing,
  * offline rendering, and headless operation.
+ *
+ * With realtime simulation on, each processBlock() first waits on the
+ * BlockPacer for the block's absolute deadline, counted in frames since
+ * the first paced block, so callback time does not accumulate as drift.
+ * The pacer's statistics record wake-up jitter and deadline misses.
  */
 class DummyDriver : public IAudioDriver {
 public:
@@ -52,6 +58,8 @@ public:
     // Timing simulation
     void setSimulateRealtime(bool enable);
     bool isSimulatingRealtime() const;
+    BlockPacer& getPacer();
+    const BlockPacer& getPacer() const;
 
     // Statistics
     uint64_t getProcessedSamples() const;
@@ -0,0 +1,256 @@
+#include "drivers/FakePcmDevice.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+namespace nap {
+
+class FakePcmDevice::Impl {
+public:
+    enum class State { Open, Setup, Prepared, Running, Xrun };
+
+    State state = State::Open;
+    PcmParams params;
+    size_t bufferFrames = 0;
+    size_t sampleBytes = 0;
+
+    std::vector<uint8_t> ring;
+    std::vector<PcmChannelArea> areas;
+    std::vector<uint8_t> played;  // Interleaved, in the device format
+
+    uint64_t applPtr = 0;  // Frames written by the application
+    uint64_t hwPtr = 0;    // Frames played by the hardware
+
+    uint64_t xruns = 0;
+    uint64_t copiedBytes = 0;
+    uint64_t commits = 0;
+    size_t transferLimit = 0;
+
+    size_t limit(size_t frames) const {
+        return transferLimit ? std::min(frames, transferLimit) : frames;
+    }
+
+    bool isMmap() const {
+        return params.access == PcmAccess::MMapInterleaved ||
+               params.access == PcmAccess::MMapNonInterleaved;
+    }
+
+    // 0 when the stream accepts frames, otherwise the error ALSA would give
+    int checkWritable() const {
+        if (state == State::Xrun) return -EPIPE;
+        if (state != State::Prepared && state != State::Running) return -EINVAL;
+        return 0;
+    }
+
+    size_t freeFrames() const {
+        return bufferFrames - static_cast<size_t>(applPtr - hwPtr);
+    }
+
+    uint8_t* sampleAt(size_t ringFrame, size_t channel) {
+        const PcmChannelArea& area = areas[channel];
+        const size_t bit = area.first + ringFrame * area.step;
+        return static_cast<uint8_t*>(area.addr) + bit / 8;
+    }
+
+    // Copies frames from application buffers into the ring at applPtr
+    long write(const uint8_t* const* planes, bool interleavedSource, size_t frames) {
+        if (int err = checkWritable()) return err;
+
+        frames = limit(frames);
+        const size_t channels = params.channels;
+        size_t written = 0;
+        while (written < frames) {
+            const size_t offset = static_cast<size_t>(applPtr % bufferFrames);
+            const size_t n = std::min({frames - written, freeFrames(), bufferFrames - offset});
+            if (n == 0) break;
+
+            for (size_t f = 0; f < n; ++f) {
+                for (size_t ch = 0; ch < channels; ++ch) {
+                    const uint8_t* src = interleavedSource
+                        ? planes[0] + ((written + f) * channels + ch) * sampleBytes
+                        : planes[ch] + (written + f) * sampleBytes;
+                    std::memcpy(sampleAt(offset + f, ch), src, sampleBytes);
+                }
+            }
+            copiedBytes += n * channels * sampleBytes;
+            applPtr += n;
+            written += n;
+        }
+        return written ? static_cast<long>(written) : -EAGAIN;
+    }
+};
+
+FakePcmDevice::FakePcmDevice()
+    : pImpl(std::make_unique<Impl>()) {}
+
+FakePcmDevice::~FakePcmDevice() = default;
+
+int FakePcmDevice::setParams(const PcmParams& params) {
+    if (params.channels == 0 || params.periodFrames == 0 || params.periods < 2) {
+        return -EINVAL;
+    }
+
+    auto& impl = *pImpl;
+    impl.params = params;
+    impl.bufferFrames = params.periodFrames * params.periods;
+    impl.sampleBytes = getPcmSampleBytes(params.format);
+    impl.ring.assign(impl.bufferFrames * params.channels * impl.sampleBytes, 0);
+    impl.areas.resize(params.channels);
+
+    const unsigned int bits = static_cast<unsigned int>(impl.sampleBytes * 8);
+    const bool interleaved = params.access == PcmAccess::RWInterleaved ||
+                             params.access == PcmAccess::MMapInterleaved;
+    for (unsigned int ch = 0; ch < params.channels; ++ch) {
+        if (interleaved) {
+            impl.areas[ch] = {impl.ring.data(), ch * bits, params.channels * bits};
+        } else {
+            impl.areas[ch] = {impl.ring.data() + ch * impl.bufferFrames * impl.sampleBytes, 0, bits};
+        }
+    }
+
+    // Like snd_pcm_hw_params(), installing parameters prepares the stream
+    impl.state = Impl::State::Setup;
+    return prepare();
+}
+
+int FakePcmDevice::prepare() {
+    if (pImpl->state == Impl::State::Open) return -EINVAL;
+    pImpl->applPtr = 0;
+    pImpl->hwPtr = 0;
+    pImpl->state = Impl::State::Prepared;
+    return 0;
+}
+
+int FakePcmDevice::start() {
+    if (pImpl->state != Impl::State::Prepared) return -EINVAL;
+    pImpl->state = Impl::State::Running;
+    return 0;
+}
+
+int FakePcmDevice::drop() {
+    if (pImpl->state == Impl::State::Open) return -EINVAL;
+    pImpl->state = Impl::State::Setup;
+    return 0;
+}
+
+int FakePcmDevice::recover(int error) {
+    if (error == -EPIPE) {
+        return prepare();
+    }
+    return error;
+}
+
+long FakePcmDevice::avail() {
+    if (int err = pImpl->checkWritable()) return err;
+    return static_cast<long>(pImpl->freeFrames());
+}
+
+int FakePcmDevice::mmapBegin(const PcmChannelArea*& areas, size_t& offset, size_t& frames) {
+    auto& impl = *pImpl;
+    if (!impl.isMmap()) return -EINVAL;
+    if (int err = impl.checkWritable()) return err;
+
+    offset = static_cast<size_t>(impl.applPtr % impl.bufferFrames);
+    frames = std::min({frames, impl.freeFrames(), impl.bufferFrames - offset});
+    areas = impl.areas.data();
+    return 0;
+}
+
+long FakePcmDevice::mmapCommit(size_t offset, size_t frames) {
+    auto& impl = *pImpl;
+    if (int err = impl.checkWritable()) return err;
+    if (offset != impl.applPtr % impl.bufferFrames || frames > impl.freeFrames() ||
+        offset + frames > impl.bufferFrames) {
+        return -EINVAL;
+    }
+
+    frames = impl.limit(frames);
+    impl.applPtr += frames;
+    ++impl.commits;
+    return static_cast<long>(frames);
+}
+
+long FakePcmDevice::writeInterleaved(const void* buffer, size_t frames) {
+    if (pImpl->params.access != PcmAccess::RWInterleaved) return -EINVAL;
+    const uint8_t* plane = static_cast<const uint8_t*>(buffer);
+    return pImpl->write(&plane, true, frames);
+}
+
+long FakePcmDevice::writeNonInterleaved(void* const* buffers, size_t frames) {
+    if (pImpl->params.access != PcmAccess::RWNonInterleaved) return -EINVAL;
+    std::vector<const uint8_t*> planes(pImpl->params.channels);
+    for (size_t ch = 0; ch < planes.size(); ++ch) {
+        planes[ch] = static_cast<const uint8_t*>(buffers[ch]);
+    }
+    return pImpl->write(planes.data(), false, frames);
+}
+
+size_t FakePcmDevice::consume(size_t frames) {
+    auto& impl = *pImpl;
+    if (impl.state != Impl::State::Running) return 0;
+
+    const size_t channels = impl.params.channels;
+    const size_t n = std::min(frames, static_cast<size_t>(impl.applPtr - impl.hwPtr));
+    for (size_t f = 0; f < n; ++f) {
+        const size_t ringFrame = static_cast<size_t>((impl.hwPtr + f) % impl.bufferFrames);
+        for (size_t ch = 0; ch < channels; ++ch) {
+            const uint8_t* sample = impl.sampleAt(ringFrame, ch);
+            impl.played.insert(impl.played.end(), sample, sample + impl.sampleBytes);
+        }
+    }
+    impl.hwPtr += n;
+
+    if (n < frames) {
+        impl.state = Impl::State::Xrun;
+        ++impl.xruns;
+    }
+    return n;
+}
+
+void FakePcmDevice::setTransferLimit(size_t frames) {
+    pImpl->transferLimit = frames;
+}
+
+const PcmParams& FakePcmDevice::getParams() const {
+    return pImpl->params;
+}
+
+bool FakePcmDevice::isStarted() const {
+    return pImpl->state == Impl::State::Running;
+}
+
+size_t FakePcmDevice::getBufferFrames() const {
+    return pImpl->bufferFrames;
+}
+
+size_t FakePcmDevice::getPlayedFrames() const {
+    const size_t frameBytes = pImpl->params.channels * pImpl->sampleBytes;
+    return frameBytes ? pImpl->played.size() / frameBytes : 0;
+}
+
+float FakePcmDevice::getPlayedSample(size_t frame, size_t channel) const {
+    const size_t index = (frame * pImpl->params.channels + channel) * pImpl->sampleBytes;
+    if (channel >= pImpl->params.channels || index + pImpl->sampleBytes > pImpl->played.size()) {
+        return 0.0f;
+    }
+    return decodePcmSample(pImpl->played.data() + index, pImpl->params.format);
+}
+
+void FakePcmDevice::clearPlayed() {
+    pImpl->played.clear();
+}
+
+uint64_t FakePcmDevice::getXrunCount() const {
+    return pImpl->xruns;
+}
+
+uint64_t FakePcmDevice::getCopiedBytes() const {
+    return pImpl->copiedBytes;
+}
+
+uint64_t FakePcmDevice::getCommitCount() const {
+    return pImpl->commits;
+}
+
+} // namespace nap
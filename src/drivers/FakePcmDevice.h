@@ -0,0 +1,68 @@
+#ifndef NAP_FAKE_PCM_DEVICE_H
+#define NAP_FAKE_PCM_DEVICE_H
+
+#include "drivers/AlsaPcm.h"
+#include <memory>
+
+namespace nap {
+
+/**
+ * @brief In-memory PCM that behaves like an ALSA playback device
+ *
+ * Owns a ring buffer laid out for the configured access mode and exposes
+ * it through mmapBegin()/mmapCommit() or copies into it through the write
+ * calls. The test drives the simulated hardware with consume(), which
+ * reads frames out of the ring into a playback history; consuming more
+ * than was written is an underrun, and every call then fails with -EPIPE
+ * until recover(). Bytes copied by the write calls are counted so a test
+ * can check that the mmap path copies nothing. setTransferLimit() makes
+ * writes and commits come up short, as a real device may.
+ */
+class FakePcmDevice : public IPcmDevice {
+public:
+    FakePcmDevice();
+    ~FakePcmDevice() override;
+
+    FakePcmDevice(const FakePcmDevice&) = delete;
+    FakePcmDevice& operator=(const FakePcmDevice&) = delete;
+
+    // IPcmDevice interface
+    int setParams(const PcmParams& params) override;
+    int prepare() override;
+    int start() override;
+    int drop() override;
+    int recover(int error) override;
+    long avail() override;
+    int mmapBegin(const PcmChannelArea*& areas, size_t& offset, size_t& frames) override;
+    long mmapCommit(size_t offset, size_t frames) override;
+    long writeInterleaved(const void* buffer, size_t frames) override;
+    long writeNonInterleaved(void* const* buffers, size_t frames) override;
+
+    // Simulated hardware: plays up to frames, returns how many it played
+    size_t consume(size_t frames);
+
+    // Caps the frames taken by one write or commit call, 0 for no cap
+    void setTransferLimit(size_t frames);
+
+    const PcmParams& getParams() const;
+    bool isStarted() const;
+    size_t getBufferFrames() const;
+
+    // Playback history
+    size_t getPlayedFrames() const;
+    float getPlayedSample(size_t frame, size_t channel) const;
+    void clearPlayed();
+
+    // Statistics
+    uint64_t getXrunCount() const;
+    uint64_t getCopiedBytes() const;
+    uint64_t getCommitCount() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace nap
+
+#endif // NAP_FAKE_PCM_DEVICE_H
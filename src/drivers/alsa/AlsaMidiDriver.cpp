@@ -1,4 +1,6 @@
 #include "AlsaMidiDriver.h"
+#include "../../events/MidiEventQueue.h"
+#include "../../events/SysexAssembler.h"
 #include <mutex>
 #include <atomic>
 #include <thread>
@@ -23,6 +25,10 @@ public:
     MidiCallback midiCallback;
     std::mutex callbackMutex;
 
+    // Read lock-free by the input thread, the queue's only producer
+    std::atomic<events::MidiEventQueue*> inputQueue{nullptr};
+    events::SysexAssembler* sysexAssembler = nullptr;
+
     std::thread inputThread;
     std::atomic<bool> threadRunning{false};
 
@@ -30,11 +36,33 @@ public:
 
     void inputThreadFunction() {
         while (threadRunning) {
-            // Simulated MIDI input processing
+            // Simulated MIDI input processing; received events go to deliver()
             std::this_thread::sleep_for(std::chrono::milliseconds(1));
         }
     }
 
+    void deliver(const MidiEvent& event) {
+        events::MidiEventQueue* queue = inputQueue.load(std::memory_order_acquire);
+        if (queue && event.type != MidiEvent::Type::SysEx) {
+            uint8_t status = static_cast<uint8_t>(event.type);
+            if (status < 0xF0) {
+                status |= event.channel & 0x0F;
+            }
+            const uint8_t bytes[3] = {status, event.data1, event.data2};
+            events::MidiMessage message(bytes, events::MidiMessage::getExpectedLength(status));
+            message.setTimestamp(event.timestamp);
+            queue->push(message);
+        }
+        if (sysexAssembler && event.type == MidiEvent::Type::SysEx) {
+            sysexAssembler->feed(event.sysexData.data(), event.sysexData.size(), event.timestamp);
+        }
+
+        std::lock_guard<std::mutex> lock(callbackMutex);
+        if (midiCallback) {
+            midiCallback(event);
+        }
+    }
+
     void populatePorts() {
         ports.clear();
 
@@ -276,6 +304,14 @@ void AlsaMidiDriver::setMidiCallback(MidiCallback callback) {
     pImpl->midiCallback = std::move(callback);
 }
 
+void AlsaMidiDriver::setInputQueue(events::MidiEventQueue* queue) {
+    pImpl->inputQueue.store(queue, std::memory_order_release);
+}
+
+void AlsaMidiDriver::setSysexAssembler(events::SysexAssembler* assembler) {
+    pImpl->sysexAssembler = assembler;
+}
+
 bool AlsaMidiDriver::sendEvent(const MidiEvent& event) {
     if (!pImpl->running) {
         return false;
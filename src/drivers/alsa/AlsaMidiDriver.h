@@ -8,6 +8,11 @@
 #include <cstdint>
 
 namespace nap {
+namespace events {
+class MidiEventQueue;
+class SysexAssembler;
+}
+
 namespace drivers {
 
 /**
@@ -15,6 +20,12 @@ namespace drivers {
  *
  * Provides MIDI input and output using the ALSA sequencer API.
  * Supports virtual ports, hardware MIDI devices, and routing.
+ *
+ * Incoming events can go to a callback, which runs on the input thread
+ * under a mutex, and/or to an events::MidiEventQueue for the audio thread.
+ * Queued messages keep the event timestamp, the getCurrentTime() clock.
+ * SysEx fragments go to the callback and, when attached, to an
+ * events::SysexAssembler that stitches them back into whole messages.
  */
 class AlsaMidiDriver {
 public:
@@ -103,6 +114,8 @@ public:
 
     // MIDI input
     void setMidiCallback(MidiCallback callback);
+    void setInputQueue(events::MidiEventQueue* queue);  // nullptr detaches
+    void setSysexAssembler(events::SysexAssembler* assembler);  // Set before start()
 
     // MIDI output
     bool sendEvent(const MidiEvent& event);
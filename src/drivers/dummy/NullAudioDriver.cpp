@@ -38,6 +38,7 @@ public:
 
     std::thread processingThread;
     std::atomic<bool> threadRunning{false};
+    BlockPacer pacer;
 
     // Statistics
     std::vector<double> processingTimes;
@@ -157,17 +158,13 @@ public:
     }
 
     void realtimeThreadFunction() {
-        double bufferDurationMs = (bufferSize / sampleRate) * 1000.0;
+        pacer.start(sampleRate);
 
         while (threadRunning) {
-            auto nextTime = std::chrono::steady_clock::now() +
-                           std::chrono::microseconds(static_cast<int64_t>(bufferDurationMs * 1000));
-
-            if (running) {
+            pacer.waitForBlock(bufferSize);
+            if (threadRunning && running) {
                 processOneBlock();
             }
-
-            std::this_thread::sleep_until(nextTime);
         }
     }
 
@@ -445,6 +442,15 @@ void NullAudioDriver::resetStatistics() {
     std::lock_guard<std::mutex> lock(pImpl->statsMutex);
     pImpl->processingTimes.clear();
     pImpl->maxProcessingTime = 0.0;
+    pImpl->pacer.resetStats();
+}
+
+BlockPacer& NullAudioDriver::getPacer() {
+    return pImpl->pacer;
+}
+
+const BlockPacer& NullAudioDriver::getPacer() const {
+    return pImpl->pacer;
 }
 
 void NullAudioDriver::simulateXrun() {
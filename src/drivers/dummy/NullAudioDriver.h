@@ -2,6 +2,7 @@
 #define NAP_NULL_AUDIO_DRIVER_H
 
 #include "../IAudioDriver.h"
+#include "../BlockPacer.h"
 #include <memory>
 #include <string>
 #include <vector>
@@ -15,6 +16,10 @@ namespace drivers {
  * Provides a fully functional audio driver interface without actual
  * hardware interaction. Useful for unit testing, benchmarking, and
  * continuous integration environments.
+ *
+ * In Realtime mode the processing thread waits on a BlockPacer for each
+ * block's absolute deadline, so callback time does not drift the stream
+ * clock; getPacer() exposes its jitter and deadline-miss statistics.
  */
 class NullAudioDriver : public IAudioDriver {
 public:
@@ -91,6 +96,8 @@ public:
     double getAverageProcessingTimeNs() const;
     double getMaxProcessingTimeNs() const;
     void resetStatistics();
+    BlockPacer& getPacer();
+    const BlockPacer& getPacer() const;
 
     // Simulate errors
     void simulateXrun();
@@ -0,0 +1,137 @@
+#include "ClockCorrelator.h"
+#include "DelayLockedLoop.h"
+#include <atomic>
+#include <cmath>
+
+namespace nap {
+namespace events {
+
+class ClockCorrelator::Impl {
+public:
+    struct Mapping {
+        double originUs;
+        double originSample;
+        double usPerSample;
+        bool locked;
+    };
+
+    Impl(double nominalSampleRate, double bandwidthHz)
+        : loop(bandwidthHz), nominalUsPerSample(1000000.0 / nominalSampleRate) {
+        publish({0.0, 0.0, nominalUsPerSample, false});
+    }
+
+    // Writer side of the seqlock; only the audio thread publishes
+    void publish(const Mapping& mapping) {
+        const uint32_t seq = sequence.load(std::memory_order_relaxed);
+        sequence.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        originUs.store(mapping.originUs, std::memory_order_relaxed);
+        originSample.store(mapping.originSample, std::memory_order_relaxed);
+        usPerSample.store(mapping.usPerSample, std::memory_order_relaxed);
+        locked.store(mapping.locked, std::memory_order_relaxed);
+        sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    Mapping read() const {
+        for (;;) {
+            const uint32_t before = sequence.load(std::memory_order_acquire);
+            if (before & 1u) continue;
+            Mapping mapping{originUs.load(std::memory_order_relaxed),
+                            originSample.load(std::memory_order_relaxed),
+                            usPerSample.load(std::memory_order_relaxed),
+                            locked.load(std::memory_order_relaxed)};
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence.load(std::memory_order_relaxed) == before) {
+                return mapping;
+            }
+        }
+    }
+
+    void anchor(uint64_t systemTimeUs, uint64_t samplePosition) {
+        loop.reset(static_cast<double>(systemTimeUs), nominalUsPerSample);
+        lastSample = samplePosition;
+        anchored = true;
+        updates = 1;
+        publish({static_cast<double>(systemTimeUs), static_cast<double>(samplePosition),
+                 nominalUsPerSample, false});
+    }
+
+    // Audio thread state
+    DelayLockedLoop loop;
+    double nominalUsPerSample;
+    uint64_t lastSample = 0;
+    uint64_t updates = 0;
+    bool anchored = false;
+
+    // Published mapping
+    std::atomic<uint32_t> sequence{0};
+    std::atomic<double> originUs{0.0};
+    std::atomic<double> originSample{0.0};
+    std::atomic<double> usPerSample{0.0};
+    std::atomic<bool> locked{false};
+    std::atomic<uint64_t> resyncs{0};
+};
+
+ClockCorrelator::ClockCorrelator(double nominalSampleRate, double bandwidthHz)
+    : pImpl(std::make_unique<Impl>(nominalSampleRate, bandwidthHz)) {}
+
+ClockCorrelator::~ClockCorrelator() = default;
+
+void ClockCorrelator::reset(double nominalSampleRate) {
+    pImpl->nominalUsPerSample = 1000000.0 / nominalSampleRate;
+    pImpl->anchored = false;
+    pImpl->updates = 0;
+    pImpl->publish({0.0, 0.0, pImpl->nominalUsPerSample, false});
+}
+
+void ClockCorrelator::update(uint64_t systemTimeUs, uint64_t samplePosition) {
+    Impl& impl = *pImpl;
+    if (!impl.anchored || samplePosition < impl.lastSample) {
+        if (impl.anchored) impl.resyncs.fetch_add(1, std::memory_order_relaxed);
+        impl.anchor(systemTimeUs, samplePosition);
+        return;
+    }
+
+    const double frames = static_cast<double>(samplePosition - impl.lastSample);
+    if (frames == 0.0) return;
+
+    const double predicted = impl.loop.predict(frames);
+    if (std::fabs(static_cast<double>(systemTimeUs) - predicted) > kResyncThresholdUs) {
+        impl.resyncs.fetch_add(1, std::memory_order_relaxed);
+        impl.anchor(systemTimeUs, samplePosition);
+        return;
+    }
+
+    impl.loop.update(static_cast<double>(systemTimeUs), frames);
+    impl.lastSample = samplePosition;
+    ++impl.updates;
+    impl.publish({impl.loop.getTime(), static_cast<double>(samplePosition),
+                  impl.loop.getPeriod(), impl.updates >= 2});
+}
+
+bool ClockCorrelator::isLocked() const {
+    return pImpl->read().locked;
+}
+
+double ClockCorrelator::samplePositionAt(uint64_t systemTimeUs) const {
+    const Impl::Mapping mapping = pImpl->read();
+    return mapping.originSample +
+           (static_cast<double>(systemTimeUs) - mapping.originUs) / mapping.usPerSample;
+}
+
+uint64_t ClockCorrelator::systemTimeAt(double samplePosition) const {
+    const Impl::Mapping mapping = pImpl->read();
+    const double time = mapping.originUs + (samplePosition - mapping.originSample) * mapping.usPerSample;
+    return time > 0.0 ? static_cast<uint64_t>(std::llround(time)) : 0;
+}
+
+double ClockCorrelator::getSampleRate() const {
+    return 1000000.0 / pImpl->read().usPerSample;
+}
+
+uint64_t ClockCorrelator::getResyncCount() const {
+    return pImpl->resyncs.load(std::memory_order_relaxed);
+}
+
+} // namespace events
+} // namespace nap
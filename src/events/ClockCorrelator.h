@@ -0,0 +1,57 @@
+#ifndef NAP_CLOCK_CORRELATOR_H
+#define NAP_CLOCK_CORRELATOR_H
+
+#include <cstdint>
+#include <memory>
+
+namespace nap {
+namespace events {
+
+/**
+ * @brief Maps between the system clock of MIDI timestamps and the audio sample clock
+ *
+ * The audio thread calls update() once per block. It passes the system
+ * time of the callback (steady-clock microseconds, as in
+ * MidiEventBus::now()) and the driver's stream position in samples, for
+ * example IAudioDriver::getStreamTime(). A DelayLockedLoop filters the
+ * callback jitter out of that pairing and learns the device's true sample
+ * rate as measured by the system clock. The resulting linear mapping is
+ * published through a seqlock. Any thread, such as a MIDI input thread
+ * stamping events, can then convert between the two clocks without locks.
+ *
+ * A sample position that jumps backwards, or callback times that jump by
+ * more than kResyncThresholdUs (an xrun or a device restart), re-anchor
+ * the mapping instead of being filtered.
+ */
+class ClockCorrelator {
+public:
+    static constexpr double kDefaultBandwidthHz = 0.5;
+    static constexpr double kResyncThresholdUs = 50000.0;
+
+    explicit ClockCorrelator(double nominalSampleRate = 48000.0,
+                             double bandwidthHz = kDefaultBandwidthHz);
+    ~ClockCorrelator();
+
+    ClockCorrelator(const ClockCorrelator&) = delete;
+    ClockCorrelator& operator=(const ClockCorrelator&) = delete;
+
+    // Audio thread
+    void reset(double nominalSampleRate);
+    void update(uint64_t systemTimeUs, uint64_t samplePosition);
+
+    // Any thread
+    bool isLocked() const;  // At least two updates since the last re-anchor
+    double samplePositionAt(uint64_t systemTimeUs) const;
+    uint64_t systemTimeAt(double samplePosition) const;
+    double getSampleRate() const;  // In system-clock terms
+    uint64_t getResyncCount() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace events
+} // namespace nap
+
+#endif // NAP_CLOCK_CORRELATOR_H
@@ -0,0 +1,61 @@
+#include "DelayLockedLoop.h"
+#include <algorithm>
+#include <cmath>
+
+namespace nap {
+namespace events {
+
+namespace {
+constexpr double kTwoPi = 6.283185307179586;
+constexpr double kSqrt2 = 1.4142135623730951;
+} // namespace
+
+DelayLockedLoop::DelayLockedLoop(double bandwidthHz)
+    : m_bandwidth(bandwidthHz), m_time(0.0), m_period(1.0), m_error(0.0) {}
+
+void DelayLockedLoop::setBandwidth(double bandwidthHz) {
+    m_bandwidth = bandwidthHz;
+}
+
+double DelayLockedLoop::getBandwidth() const {
+    return m_bandwidth;
+}
+
+void DelayLockedLoop::reset(double timeUs, double periodUs) {
+    m_time = timeUs;
+    m_period = periodUs;
+    m_error = 0.0;
+}
+
+double DelayLockedLoop::update(double measuredUs, double units) {
+    if (units <= 0.0) return m_time;
+
+    const double predicted = m_time + units * m_period;
+    m_error = measuredUs - predicted;
+
+    // Critically damped loop: omega = 2*pi*B*T with T the interval in seconds,
+    // capped so very long intervals cannot make the loop overshoot
+    const double omega = std::min(kTwoPi * m_bandwidth * units * m_period * 1e-6, 1.0);
+    m_time = predicted + kSqrt2 * omega * m_error;
+    m_period += omega * omega * m_error / units;
+    return m_time;
+}
+
+double DelayLockedLoop::getTime() const {
+    return m_time;
+}
+
+double DelayLockedLoop::getPeriod() const {
+    return m_period;
+}
+
+double DelayLockedLoop::predict(double units) const {
+    return m_time + units * m_period;
+}
+
+double DelayLockedLoop::getLastError() const {
+    return m_error;
+}
+
+} // namespace events
+} // namespace nap
@@ -0,0 +1,47 @@
+#ifndef NAP_DELAY_LOCKED_LOOP_H
+#define NAP_DELAY_LOCKED_LOOP_H
+
+namespace nap {
+namespace events {
+
+/**
+ * @brief Second-order delay-locked loop that filters jitter out of periodic timestamps
+ *
+ * Tracks the time of a periodic event (a block callback, a MIDI clock
+ * tick) and its period. Each update() feeds the measured time of the
+ * event that comes `units` periods after the previous one. The loop
+ * returns a filtered time that follows slow drift but not per-event
+ * jitter. Times are in microseconds and the bandwidth is in Hz; lower
+ * bandwidth means smoother output and slower lock.
+ */
+class DelayLockedLoop {
+public:
+    static constexpr double kDefaultBandwidthHz = 1.0;
+
+    explicit DelayLockedLoop(double bandwidthHz = kDefaultBandwidthHz);
+
+    void setBandwidth(double bandwidthHz);
+    double getBandwidth() const;
+
+    // Starts over at a known time with a nominal period per unit
+    void reset(double timeUs, double periodUs);
+
+    // Returns the filtered time of the event `units` periods after the last
+    double update(double measuredUs, double units = 1.0);
+
+    double getTime() const;    // Filtered time of the last event
+    double getPeriod() const;  // Estimated period per unit
+    double predict(double units) const;
+    double getLastError() const;  // Measured minus predicted, last update
+
+private:
+    double m_bandwidth;
+    double m_time;
+    double m_period;
+    double m_error;
+};
+
+} // namespace events
+} // namespace nap
+
+#endif // NAP_DELAY_LOCKED_LOOP_H
@@ -0,0 +1,140 @@
+#include "MidiClockTracker.h"
+#include <cmath>
+
+namespace nap {
+namespace events {
+
+namespace {
+// A tick later than this many periods is treated as a tempo jump
+constexpr double kMaxSkippedTicks = 8.0;
+// An interval shorter than this fraction of the period is early
+constexpr double kShortInterval = 0.7;
+constexpr uint32_t kTicksToLock = 4;
+constexpr uint32_t kSkipsToReseed = 3;
+} // namespace
+
+MidiClockTracker::MidiClockTracker(double bandwidthHz)
+    : m_loop(bandwidthHz), m_lastTimestamp(0), m_tickCount(0),
+      m_trackedTicks(0), m_skipStreak(0), m_shortStreak(0), m_running(false) {}
+
+bool MidiClockTracker::process(const MidiMessage& message) {
+    switch (message.getStatusByte()) {
+        case 0xF8:  // Timing Clock
+            processTick(message.getTimestamp());
+            return true;
+        case 0xFA:  // Start
+            m_tickCount = 0;
+            m_running = true;
+            return true;
+        case 0xFB:  // Continue
+            m_running = true;
+            return true;
+        case 0xFC:  // Stop
+            m_running = false;
+            return true;
+        default:
+            return false;
+    }
+}
+
+void MidiClockTracker::processTick(uint64_t timestampUs) {
+    const double measured = static_cast<double>(timestampUs);
+    ++m_tickCount;
+
+    if (m_trackedTicks == 0) {
+        m_lastTimestamp = timestampUs;
+        m_trackedTicks = 1;
+        return;
+    }
+
+    if (m_trackedTicks == 1) {
+        // The first interval seeds the period
+        if (timestampUs <= m_lastTimestamp) return;
+        m_loop.reset(measured, measured - static_cast<double>(m_lastTimestamp));
+        m_lastTimestamp = timestampUs;
+        m_trackedTicks = 2;
+        return;
+    }
+
+    if (timestampUs <= m_lastTimestamp) {
+        return;  // Duplicate or out of order
+    }
+
+    // Every interval well under one period means the tempo rose, not that
+    // ticks are jittering early: re-seed from the measured interval
+    const double interval = measured - static_cast<double>(m_lastTimestamp);
+    m_shortStreak = interval < kShortInterval * m_loop.getPeriod() ? m_shortStreak + 1 : 0;
+    if (m_shortStreak >= kSkipsToReseed) {
+        m_loop.reset(measured, interval);
+        m_trackedTicks = 2;
+        m_skipStreak = 0;
+        m_shortStreak = 0;
+        m_lastTimestamp = timestampUs;
+        return;
+    }
+
+    const double ticks = std::round((measured - m_loop.getTime()) / m_loop.getPeriod());
+    if (ticks < 1.0) {
+        m_lastTimestamp = timestampUs;
+        return;  // Early tick; the loop only takes whole periods
+    }
+
+    // Every interval spanning several periods means the tempo dropped, not
+    // that ticks keep getting lost: re-seed from the next interval
+    m_skipStreak = ticks > 1.0 ? m_skipStreak + 1 : 0;
+    if (ticks > kMaxSkippedTicks || m_skipStreak >= kSkipsToReseed) {
+        m_trackedTicks = 1;
+        m_skipStreak = 0;
+        m_shortStreak = 0;
+        m_lastTimestamp = timestampUs;
+        return;
+    }
+
+    m_loop.update(measured, ticks);
+    m_lastTimestamp = timestampUs;
+    if (m_trackedTicks < kTicksToLock) ++m_trackedTicks;
+}
+
+void MidiClockTracker::reset() {
+    m_loop.reset(0.0, 1.0);
+    m_lastTimestamp = 0;
+    m_tickCount = 0;
+    m_trackedTicks = 0;
+    m_skipStreak = 0;
+    m_shortStreak = 0;
+    m_running = false;
+}
+
+bool MidiClockTracker::isRunning() const {
+    return m_running;
+}
+
+bool MidiClockTracker::isLocked() const {
+    return m_trackedTicks >= kTicksToLock;
+}
+
+double MidiClockTracker::getBpm() const {
+    if (m_trackedTicks < 2) return 0.0;
+    return 60000000.0 / (m_loop.getPeriod() * kTicksPerQuarter);
+}
+
+double MidiClockTracker::getTickPeriodUs() const {
+    return m_trackedTicks < 2 ? 0.0 : m_loop.getPeriod();
+}
+
+uint64_t MidiClockTracker::getTickCount() const {
+    return m_tickCount;
+}
+
+uint64_t MidiClockTracker::getSmoothedTickTime() const {
+    if (m_trackedTicks < 2) return m_lastTimestamp;
+    return static_cast<uint64_t>(std::llround(m_loop.getTime()));
+}
+
+uint64_t MidiClockTracker::predictTickTime(uint32_t ticksAhead) const {
+    if (m_trackedTicks < 2) return m_lastTimestamp;
+    return static_cast<uint64_t>(std::llround(m_loop.predict(ticksAhead)));
+}
+
+} // namespace events
+} // namespace nap
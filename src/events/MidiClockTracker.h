@@ -0,0 +1,58 @@
+#ifndef NAP_MIDI_CLOCK_TRACKER_H
+#define NAP_MIDI_CLOCK_TRACKER_H
+
+#include "DelayLockedLoop.h"
+#include "MidiMessage.h"
+#include <cstdint>
+
+namespace nap {
+namespace events {
+
+/**
+ * @brief Recovers a steady tempo from incoming MIDI TimingClock messages
+ *
+ * Clock ticks (24 per quarter note) arrive with the jitter of the sender,
+ * the cable and the receiving thread. Their timestamps feed a
+ * DelayLockedLoop, so getBpm() and predictTickTime() follow real tempo
+ * changes without per-tick wobble. An occasional gap of several periods
+ * counts as dropped ticks; repeated long gaps mean the tempo fell, and the
+ * period is re-seeded. Start, Continue and Stop update the transport state.
+ *
+ * Not thread-safe; feed and query it from the thread that consumes the
+ * clock messages.
+ */
+class MidiClockTracker {
+public:
+    static constexpr uint32_t kTicksPerQuarter = 24;
+    static constexpr double kDefaultBandwidthHz = 0.5;
+
+    explicit MidiClockTracker(double bandwidthHz = kDefaultBandwidthHz);
+
+    // Returns true for clock and transport messages
+    bool process(const MidiMessage& message);
+    void processTick(uint64_t timestampUs);
+    void reset();
+
+    bool isRunning() const;  // Start or Continue seen, no Stop since
+    bool isLocked() const;   // Enough ticks for a tempo estimate
+
+    double getBpm() const;
+    double getTickPeriodUs() const;
+    uint64_t getTickCount() const;  // Ticks since the last Start
+    uint64_t getSmoothedTickTime() const;
+    uint64_t predictTickTime(uint32_t ticksAhead) const;
+
+private:
+    DelayLockedLoop m_loop;
+    uint64_t m_lastTimestamp;
+    uint64_t m_tickCount;
+    uint32_t m_trackedTicks;  // Ticks the loop has seen since it was seeded
+    uint32_t m_skipStreak;    // Consecutive intervals longer than one period
+    uint32_t m_shortStreak;   // Consecutive intervals well under one period
+    bool m_running;
+};
+
+} // namespace events
+} // namespace nap
+
+#endif // NAP_MIDI_CLOCK_TRACKER_H
@@ -0,0 +1,128 @@
+#include "MidiEventBus.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+namespace nap {
+namespace events {
+
+namespace {
+
+// Inserts events[first, count) among the already ordered events[0, first) by
+// offset; the new events are in order themselves and follow equal offsets
+void mergeTail(MidiBlockEvent* events, size_t first, size_t count) {
+    for (size_t k = first; k < count; ++k) {
+        const MidiBlockEvent event = events[k];
+        size_t j = k;
+        while (j > 0 && events[j - 1].sampleOffset > event.sampleOffset) {
+            events[j] = events[j - 1];
+            --j;
+        }
+        events[j] = event;
+    }
+}
+
+} // namespace
+
+class MidiEventBus::Impl {
+public:
+    explicit Impl(size_t blockCapacity) : events(blockCapacity) {}
+
+    // Slots are filled before inputCount is published, and never cleared
+    std::array<std::unique_ptr<MidiEventQueue>, kMaxInputs> inputs;
+    std::atomic<size_t> inputCount{0};
+    std::mutex addMutex;
+
+    std::array<IMidiSource*, kMaxSources> sources{};
+
+    std::vector<MidiBlockEvent> events;
+    size_t eventCount = 0;
+};
+
+MidiEventBus::MidiEventBus(size_t blockCapacity)
+    : pImpl(std::make_unique<Impl>(blockCapacity)) {}
+
+MidiEventBus::~MidiEventBus() = default;
+
+MidiEventQueue* MidiEventBus::addInput(size_t capacity) {
+    std::lock_guard<std::mutex> lock(pImpl->addMutex);
+    const size_t index = pImpl->inputCount.load(std::memory_order_relaxed);
+    if (index >= kMaxInputs) return nullptr;
+
+    pImpl->inputs[index] = std::make_unique<MidiEventQueue>(capacity);
+    pImpl->inputCount.store(index + 1, std::memory_order_release);
+    return pImpl->inputs[index].get();
+}
+
+size_t MidiEventBus::getInputCount() const {
+    return pImpl->inputCount.load(std::memory_order_acquire);
+}
+
+MidiEventQueue* MidiEventBus::getInput(size_t index) const {
+    return index < getInputCount() ? pImpl->inputs[index].get() : nullptr;
+}
+
+bool MidiEventBus::addSource(IMidiSource* source) {
+    if (!source) return false;
+    for (IMidiSource*& slot : pImpl->sources) {
+        if (!slot) {
+            slot = source;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool MidiEventBus::removeSource(IMidiSource* source) {
+    if (!source) return false;
+    for (IMidiSource*& slot : pImpl->sources) {
+        if (slot == source) {
+            slot = nullptr;
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t MidiEventBus::processBlock(uint64_t blockStartUs, uint32_t numFrames, double sampleRate) {
+    MidiBlockEvent* events = pImpl->events.data();
+    const size_t capacity = pImpl->events.size();
+    const size_t inputCount = pImpl->inputCount.load(std::memory_order_acquire);
+
+    size_t count = 0;
+    for (size_t i = 0; i < inputCount && count < capacity; ++i) {
+        const size_t first = count;
+        count += pImpl->inputs[i]->drain(blockStartUs, numFrames, sampleRate,
+                                         events + count, capacity - count);
+        mergeTail(events, first, count);
+    }
+
+    for (IMidiSource* source : pImpl->sources) {
+        // Rendered even when the buffer is full, so sources keep advancing
+        if (!source) continue;
+        const size_t first = count;
+        count += source->renderBlock(numFrames, events + count, capacity - count);
+        mergeTail(events, first, count);
+    }
+
+    pImpl->eventCount = count;
+    return count;
+}
+
+const MidiBlockEvent* MidiEventBus::getEvents() const {
+    return pImpl->events.data();
+}
+
+size_t MidiEventBus::getEventCount() const {
+    return pImpl->eventCount;
+}
+
+uint64_t MidiEventBus::now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+} // namespace events
+} // namespace nap
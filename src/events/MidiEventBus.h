@@ -0,0 +1,79 @@
+#ifndef NAP_MIDI_EVENT_BUS_H
+#define NAP_MIDI_EVENT_BUS_H
+
+#include "MidiEventQueue.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace nap {
+namespace events {
+
+/**
+ * @brief Source of MIDI events generated on the audio thread itself
+ *
+ * Sequencers and arpeggiators render their events for a block directly
+ * instead of going through a queue.
+ */
+class IMidiSource {
+public:
+    virtual ~IMidiSource() = default;
+
+    // Writes up to maxEvents events of the next numFrames, in offset order
+    virtual size_t renderBlock(uint32_t numFrames, MidiBlockEvent* out, size_t maxEvents) = 0;
+};
+
+/**
+ * @brief Collects the MIDI inputs feeding an audio graph into per-block event lists
+ *
+ * Each input gets its own MidiEventQueue, so every driver thread is the
+ * single producer of its queue. Once per block the audio thread calls
+ * processBlock(), which drains every input into a preallocated buffer and
+ * merges the events by sample offset; nodes then read getEvents() for the
+ * rest of the block. Nothing on the audio side locks or allocates.
+ *
+ * Inputs may be added while the audio thread is running and live as long
+ * as the bus. Sources (IMidiSource) are rendered after the inputs and
+ * merged the same way. They are owned by the caller and must not be
+ * added, removed or destroyed while processBlock() runs. If a block has
+ * more events than the buffer holds, the rest stay queued and arrive at
+ * the start of the next block.
+ */
+class MidiEventBus {
+public:
+    static constexpr size_t kMaxInputs = 16;
+    static constexpr size_t kMaxSources = 8;
+    static constexpr size_t kDefaultBlockCapacity = 512;
+
+    explicit MidiEventBus(size_t blockCapacity = kDefaultBlockCapacity);
+    ~MidiEventBus();
+
+    MidiEventBus(const MidiEventBus&) = delete;
+    MidiEventBus& operator=(const MidiEventBus&) = delete;
+
+    // Control thread; nullptr once kMaxInputs inputs exist
+    MidiEventQueue* addInput(size_t capacity = MidiEventQueue::kDefaultCapacity);
+    size_t getInputCount() const;
+    MidiEventQueue* getInput(size_t index) const;
+
+    // Control thread; false when full, or when the source is not attached
+    bool addSource(IMidiSource* source);
+    bool removeSource(IMidiSource* source);
+
+    // Audio thread: blockStartUs is the time of the block's first sample
+    size_t processBlock(uint64_t blockStartUs, uint32_t numFrames, double sampleRate);
+    const MidiBlockEvent* getEvents() const;
+    size_t getEventCount() const;
+
+    // Steady-clock microseconds, the timebase of event timestamps
+    static uint64_t now();
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace events
+} // namespace nap
+
+#endif // NAP_MIDI_EVENT_BUS_H
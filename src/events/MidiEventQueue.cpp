@@ -0,0 +1,79 @@
+#include "MidiEventQueue.h"
+#include "../core/threading/SpscQueue.h"
+#include <atomic>
+
+namespace nap {
+namespace events {
+
+class MidiEventQueue::Impl {
+public:
+    explicit Impl(size_t capacity) : queue(capacity) {}
+
+    SpscQueue<MidiMessage> queue;
+    std::atomic<uint64_t> dropped{0};
+
+    // Consumer side: an event popped for a block that has not started yet
+    MidiMessage pending;
+    bool hasPending = false;
+};
+
+MidiEventQueue::MidiEventQueue(size_t capacity)
+    : pImpl(std::make_unique<Impl>(capacity)) {}
+
+MidiEventQueue::~MidiEventQueue() = default;
+
+bool MidiEventQueue::push(const MidiMessage& message) {
+    if (!pImpl->queue.push(message)) {
+        pImpl->dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+uint64_t MidiEventQueue::getDroppedCount() const {
+    return pImpl->dropped.load(std::memory_order_relaxed);
+}
+
+size_t MidiEventQueue::drain(uint64_t blockStartUs, uint32_t numFrames, double sampleRate,
+                             MidiBlockEvent* out, size_t maxEvents) {
+    if (numFrames == 0 || sampleRate <= 0.0) return 0;
+
+    const double samplesPerUs = sampleRate / 1000000.0;
+    const uint64_t blockEndUs = blockStartUs +
+        static_cast<uint64_t>(static_cast<double>(numFrames) / samplesPerUs);
+
+    size_t count = 0;
+    while (count < maxEvents) {
+        if (!pImpl->hasPending) {
+            if (!pImpl->queue.pop(pImpl->pending)) break;
+            pImpl->hasPending = true;
+        }
+
+        const uint64_t timestamp = pImpl->pending.getTimestamp();
+        if (timestamp >= blockEndUs) break;
+
+        uint32_t offset = 0;
+        if (timestamp > blockStartUs) {
+            offset = static_cast<uint32_t>(static_cast<double>(timestamp - blockStartUs) *
+                                           samplesPerUs);
+            if (offset >= numFrames) offset = numFrames - 1;
+        }
+
+        out[count].message = pImpl->pending;
+        out[count].sampleOffset = offset;
+        ++count;
+        pImpl->hasPending = false;
+    }
+    return count;
+}
+
+size_t MidiEventQueue::getCapacity() const {
+    return pImpl->queue.getCapacity();
+}
+
+size_t MidiEventQueue::size() const {
+    return pImpl->queue.size() + (pImpl->hasPending ? 1 : 0);
+}
+
+} // namespace events
+} // namespace nap
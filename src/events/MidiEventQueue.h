@@ -0,0 +1,59 @@
+#ifndef NAP_MIDI_EVENT_QUEUE_H
+#define NAP_MIDI_EVENT_QUEUE_H
+
+#include "MidiMessage.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace nap {
+namespace events {
+
+/**
+ * @brief Timestamped MIDI event placed at a sample offset within a block
+ */
+struct MidiBlockEvent {
+    MidiMessage message;
+    uint32_t sampleOffset;
+};
+
+/**
+ * @brief Wait-free FIFO carrying one MIDI input's events to the audio thread
+ *
+ * A driver input thread push()es messages stamped with their arrival time
+ * in microseconds on the steady clock (the clock of MidiEventBus::now()).
+ * The audio thread drain()s the events that fall before the end of the
+ * current block, converting each timestamp to a sample offset. Events that
+ * belong to a later block stay queued. One producer and one consumer only.
+ */
+class MidiEventQueue {
+public:
+    static constexpr size_t kDefaultCapacity = 1024;
+
+    explicit MidiEventQueue(size_t capacity = kDefaultCapacity);
+    ~MidiEventQueue();
+
+    MidiEventQueue(const MidiEventQueue&) = delete;
+    MidiEventQueue& operator=(const MidiEventQueue&) = delete;
+
+    // Producer: false (and counted) when the queue is full
+    bool push(const MidiMessage& message);
+    uint64_t getDroppedCount() const;
+
+    // Consumer: appends events timestamped before blockStartUs plus the
+    // block's duration, in order, up to maxEvents. Late events go to offset 0.
+    size_t drain(uint64_t blockStartUs, uint32_t numFrames, double sampleRate,
+                 MidiBlockEvent* out, size_t maxEvents);
+
+    size_t getCapacity() const;
+    size_t size() const;  // Approximate when called off the consumer thread
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace events
+} // namespace nap
+
+#endif // NAP_MIDI_EVENT_QUEUE_H
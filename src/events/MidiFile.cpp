@@ -0,0 +1,343 @@
+#include "MidiFile.h"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+namespace nap {
+namespace events {
+
+namespace {
+
+// Bounds-checked big-endian reader over one chunk
+class ByteReader {
+public:
+    ByteReader(const uint8_t* data, size_t size) : m_pos(data), m_end(data + size) {}
+
+    bool atEnd() const { return m_pos >= m_end; }
+    size_t remaining() const { return static_cast<size_t>(m_end - m_pos); }
+    const uint8_t* position() const { return m_pos; }
+
+    bool peek(uint8_t& value) const {
+        if (m_pos >= m_end) return false;
+        value = *m_pos;
+        return true;
+    }
+
+    bool read(uint8_t& value) {
+        if (m_pos >= m_end) return false;
+        value = *m_pos++;
+        return true;
+    }
+
+    bool read16(uint16_t& value) {
+        if (remaining() < 2) return false;
+        value = static_cast<uint16_t>((m_pos[0] << 8) | m_pos[1]);
+        m_pos += 2;
+        return true;
+    }
+
+    bool read32(uint32_t& value) {
+        if (remaining() < 4) return false;
+        value = (static_cast<uint32_t>(m_pos[0]) << 24) | (static_cast<uint32_t>(m_pos[1]) << 16) |
+                (static_cast<uint32_t>(m_pos[2]) << 8) | m_pos[3];
+        m_pos += 4;
+        return true;
+    }
+
+    // Variable-length quantity, at most four bytes
+    bool readVarLen(uint32_t& value) {
+        value = 0;
+        for (int i = 0; i < 4; ++i) {
+            uint8_t byte = 0;
+            if (!read(byte)) return false;
+            value = (value << 7) | (byte & 0x7F);
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+
+    bool skip(size_t count) {
+        if (remaining() < count) return false;
+        m_pos += count;
+        return true;
+    }
+
+private:
+    const uint8_t* m_pos;
+    const uint8_t* m_end;
+};
+
+bool hasTag(const uint8_t* data, const char* tag) {
+    return std::equal(data, data + 4, reinterpret_cast<const uint8_t*>(tag));
+}
+
+} // namespace
+
+class MidiFile::Impl {
+public:
+    void clear() {
+        format = 0;
+        trackCount = 0;
+        ticksPerQuarter = 0;
+        smpteSecondsPerTick = 0.0;
+        lengthTicks = 0;
+        events.clear();
+        tempoMap.clear();
+        sysexEvents.clear();
+    }
+
+    bool fail(const std::string& message) {
+        lastError = message;
+        clear();
+        return false;
+    }
+
+    bool parseTrack(ByteReader reader, uint16_t track) {
+        uint64_t tick = 0;
+        uint8_t running = 0;
+
+        while (!reader.atEnd()) {
+            uint32_t delta = 0;
+            if (!reader.readVarLen(delta)) return fail("Truncated delta time in track " + std::to_string(track));
+            tick += delta;
+
+            uint8_t status = 0;
+            if (!reader.peek(status)) return fail("Truncated event in track " + std::to_string(track));
+            if (status < 0x80) {
+                if (!running) return fail("Data byte without running status in track " + std::to_string(track));
+                status = running;
+            } else {
+                reader.skip(1);
+            }
+
+            if (status < 0xF0) {
+                running = status;
+                uint8_t bytes[3] = {status, 0, 0};
+                const size_t length = MidiMessage::getExpectedLength(status);
+                for (size_t i = 1; i < length; ++i) {
+                    if (!reader.read(bytes[i])) return fail("Truncated channel message in track " + std::to_string(track));
+                }
+                events.push_back({tick, 0.0, track, MidiMessage(bytes, length)});
+                continue;
+            }
+
+            // SysEx and meta events cancel running status
+            running = 0;
+            if (status == 0xF0 || status == 0xF7) {
+                uint32_t length = 0;
+                if (!reader.readVarLen(length) || reader.remaining() < length) {
+                    return fail("Truncated SysEx in track " + std::to_string(track));
+                }
+                const uint8_t* bytes = reader.position();
+                reader.skip(length);
+                addSysex(status, bytes, length, tick, track);
+                continue;
+            }
+
+            if (status != 0xFF) return fail("Invalid status byte in track " + std::to_string(track));
+
+            uint8_t type = 0;
+            uint32_t length = 0;
+            if (!reader.read(type) || !reader.readVarLen(length) || reader.remaining() < length) {
+                return fail("Truncated meta event in track " + std::to_string(track));
+            }
+            const uint8_t* bytes = reader.position();
+            reader.skip(length);
+
+            if (type == 0x51 && length == 3) {
+                const uint32_t tempo = (static_cast<uint32_t>(bytes[0]) << 16) |
+                                       (static_cast<uint32_t>(bytes[1]) << 8) | bytes[2];
+                if (tempo > 0) tempoMap.push_back({tick, 0.0, tempo});
+            } else if (type == 0x2F) {
+                break;  // End of Track
+            }
+        }
+
+        lengthTicks = std::max(lengthTicks, tick);
+        return true;
+    }
+
+    void addSysex(uint8_t status, const uint8_t* bytes, uint32_t length, uint64_t tick, uint16_t track) {
+        if (status == 0xF0) {
+            SysexEvent event{tick, 0.0, track, {}};
+            event.data.reserve(length + 1);
+            event.data.push_back(0xF0);
+            event.data.insert(event.data.end(), bytes, bytes + length);
+            sysexEvents.push_back(std::move(event));
+            return;
+        }
+
+        // F7 packets continue an unterminated SysEx, or escape other messages
+        for (auto it = sysexEvents.rbegin(); it != sysexEvents.rend(); ++it) {
+            if (it->track != track) continue;
+            if (it->data.back() != 0xF7) {
+                it->data.insert(it->data.end(), bytes, bytes + length);
+                return;
+            }
+            break;
+        }
+        if (length > 0 && length <= 3 && bytes[0] >= 0xF1 && bytes[0] != 0xF7) {
+            events.push_back({tick, 0.0, track, MidiMessage(bytes, length)});
+        }
+    }
+
+    void resolveTimes() {
+        std::stable_sort(events.begin(), events.end(),
+                         [](const Event& a, const Event& b) { return a.tick < b.tick; });
+        std::stable_sort(sysexEvents.begin(), sysexEvents.end(),
+                         [](const SysexEvent& a, const SysexEvent& b) { return a.tick < b.tick; });
+        std::stable_sort(tempoMap.begin(), tempoMap.end(),
+                         [](const TempoChange& a, const TempoChange& b) { return a.tick < b.tick; });
+
+        if (tempoMap.empty() || tempoMap.front().tick > 0) {
+            tempoMap.insert(tempoMap.begin(), {0, 0.0, kDefaultMicrosecondsPerQuarter});
+        }
+        for (size_t i = 1; i < tempoMap.size(); ++i) {
+            const TempoChange& previous = tempoMap[i - 1];
+            tempoMap[i].seconds = previous.seconds + secondsFor(previous, tempoMap[i].tick);
+        }
+
+        // Events and tempo changes are both sorted: one merged pass
+        size_t segment = 0;
+        for (Event& event : events) {
+            while (segment + 1 < tempoMap.size() && tempoMap[segment + 1].tick <= event.tick) ++segment;
+            event.seconds = tempoMap[segment].seconds + secondsFor(tempoMap[segment], event.tick);
+        }
+        for (SysexEvent& event : sysexEvents) {
+            event.seconds = toSeconds(event.tick);
+        }
+    }
+
+    double secondsFor(const TempoChange& from, uint64_t tick) const {
+        const double ticks = static_cast<double>(tick - from.tick);
+        if (smpteSecondsPerTick > 0.0) return ticks * smpteSecondsPerTick;
+        return ticks * from.microsecondsPerQuarter / (1000000.0 * ticksPerQuarter);
+    }
+
+    double toSeconds(uint64_t tick) const {
+        auto it = std::upper_bound(tempoMap.begin(), tempoMap.end(), tick,
+                                   [](uint64_t t, const TempoChange& change) { return t < change.tick; });
+        if (it == tempoMap.begin()) return 0.0;
+        --it;
+        return it->seconds + secondsFor(*it, tick);
+    }
+
+    uint16_t format = 0;
+    uint16_t trackCount = 0;
+    uint16_t ticksPerQuarter = 0;
+    double smpteSecondsPerTick = 0.0;
+    uint64_t lengthTicks = 0;
+    std::vector<Event> events;
+    std::vector<TempoChange> tempoMap;
+    std::vector<SysexEvent> sysexEvents;
+    std::string lastError;
+};
+
+MidiFile::MidiFile() : pImpl(std::make_unique<Impl>()) {}
+
+MidiFile::~MidiFile() = default;
+
+MidiFile::MidiFile(MidiFile&&) noexcept = default;
+MidiFile& MidiFile::operator=(MidiFile&&) noexcept = default;
+
+bool MidiFile::loadFromFile(const std::string& filepath) {
+    std::ifstream file(filepath, std::ios::binary);
+    if (!file.is_open()) {
+        return pImpl->fail("Failed to open file for reading: " + filepath);
+    }
+    const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)),
+                                     std::istreambuf_iterator<char>());
+    return loadFromMemory(bytes.data(), bytes.size());
+}
+
+bool MidiFile::loadFromMemory(const uint8_t* data, size_t size) {
+    Impl& impl = *pImpl;
+    impl.clear();
+    impl.lastError.clear();
+
+    ByteReader reader(data, size);
+    uint32_t headerLength = 0;
+    uint16_t division = 0;
+    if (size < 14 || !hasTag(data, "MThd")) return impl.fail("Not a Standard MIDI File");
+    reader.skip(4);
+    if (!reader.read32(headerLength) || headerLength < 6 || !reader.read16(impl.format) ||
+        !reader.read16(impl.trackCount) || !reader.read16(division) || !reader.skip(headerLength - 6)) {
+        return impl.fail("Truncated MIDI file header");
+    }
+    if (impl.format > 1) return impl.fail("Unsupported MIDI file format " + std::to_string(impl.format));
+
+    if (division & 0x8000) {
+        // SMPTE: negative frames per second, ticks per frame
+        const int fps = -static_cast<int8_t>(division >> 8);
+        const double rate = fps == 29 ? 29.97 : static_cast<double>(fps);
+        const uint8_t ticksPerFrame = division & 0xFF;
+        if (rate <= 0.0 || ticksPerFrame == 0) return impl.fail("Invalid SMPTE time division");
+        impl.smpteSecondsPerTick = 1.0 / (rate * ticksPerFrame);
+    } else {
+        if (division == 0) return impl.fail("Invalid time division");
+        impl.ticksPerQuarter = division;
+    }
+
+    uint16_t track = 0;
+    while (track < impl.trackCount && reader.remaining() >= 8) {
+        const uint8_t* tag = reader.position();
+        uint32_t length = 0;
+        reader.skip(4);
+        reader.read32(length);
+        if (reader.remaining() < length) return impl.fail("Truncated track chunk");
+
+        // Unknown chunk types are skipped, as the standard requires
+        if (hasTag(tag, "MTrk")) {
+            if (!impl.parseTrack(ByteReader(reader.position(), length), track)) return false;
+            ++track;
+        }
+        reader.skip(length);
+    }
+    if (track < impl.trackCount) return impl.fail("MIDI file is missing tracks");
+
+    impl.resolveTimes();
+    return true;
+}
+
+std::string MidiFile::getLastError() const {
+    return pImpl->lastError;
+}
+
+uint16_t MidiFile::getFormat() const {
+    return pImpl->format;
+}
+
+uint16_t MidiFile::getTrackCount() const {
+    return pImpl->trackCount;
+}
+
+uint16_t MidiFile::getTicksPerQuarter() const {
+    return pImpl->ticksPerQuarter;
+}
+
+const std::vector<MidiFile::Event>& MidiFile::getEvents() const {
+    return pImpl->events;
+}
+
+const std::vector<MidiFile::TempoChange>& MidiFile::getTempoMap() const {
+    return pImpl->tempoMap;
+}
+
+const std::vector<MidiFile::SysexEvent>& MidiFile::getSysexEvents() const {
+    return pImpl->sysexEvents;
+}
+
+uint64_t MidiFile::getLengthTicks() const {
+    return pImpl->lengthTicks;
+}
+
+double MidiFile::getLengthSeconds() const {
+    return pImpl->toSeconds(pImpl->lengthTicks);
+}
+
+double MidiFile::tickToSeconds(uint64_t tick) const {
+    return pImpl->toSeconds(tick);
+}
+
+} // namespace events
+} // namespace nap
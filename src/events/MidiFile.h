@@ -0,0 +1,83 @@
+#ifndef NAP_MIDI_FILE_H
+#define NAP_MIDI_FILE_H
+
+#include "MidiMessage.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace nap {
+namespace events {
+
+/**
+ * @brief Standard MIDI File (format 0 and 1) loader
+ *
+ * Parses every track in one pass, including running status, and merges
+ * the channel and system messages into a single array sorted by tick.
+ * Events at the same tick keep their track order, then their order
+ * within the track. The file's tempo changes become a tempo map. Every
+ * event is stamped with its time in seconds, so a MidiSequencer only has
+ * to scale those times to a sample rate. SysEx events are kept in a
+ * separate list. Other meta events are read for timing only.
+ *
+ * Both PPQ and SMPTE time divisions are supported. Format 2 (independent
+ * sequences) is rejected.
+ */
+class MidiFile {
+public:
+    struct Event {
+        uint64_t tick;
+        double seconds;
+        uint16_t track;
+        MidiMessage message;
+    };
+
+    struct TempoChange {
+        uint64_t tick;
+        double seconds;
+        uint32_t microsecondsPerQuarter;
+    };
+
+    struct SysexEvent {
+        uint64_t tick;
+        double seconds;
+        uint16_t track;
+        std::vector<uint8_t> data;  // Includes the leading F0
+    };
+
+    static constexpr uint32_t kDefaultMicrosecondsPerQuarter = 500000;  // 120 BPM
+
+    MidiFile();
+    ~MidiFile();
+
+    MidiFile(MidiFile&&) noexcept;
+    MidiFile& operator=(MidiFile&&) noexcept;
+
+    bool loadFromFile(const std::string& filepath);
+    bool loadFromMemory(const uint8_t* data, size_t size);
+    std::string getLastError() const;
+
+    uint16_t getFormat() const;
+    uint16_t getTrackCount() const;
+    uint16_t getTicksPerQuarter() const;  // 0 for SMPTE division
+
+    const std::vector<Event>& getEvents() const;
+    const std::vector<TempoChange>& getTempoMap() const;
+    const std::vector<SysexEvent>& getSysexEvents() const;
+
+    // Up to the last End of Track
+    uint64_t getLengthTicks() const;
+    double getLengthSeconds() const;
+    double tickToSeconds(uint64_t tick) const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace events
+} // namespace nap
+
+#endif // NAP_MIDI_FILE_H
@@ -1,4 +1,5 @@
 #include "MidiMessage.h"
+#include <algorithm>
 #include <cmath>
 #include <sstream>
 #include <iomanip>
@@ -6,30 +7,20 @@
 namespace nap {
 namespace events {
 
-MidiMessage::MidiMessage() : data_{0, 0, 0}, size_(0), timestamp_(0) {}
+MidiMessage::MidiMessage() : timestamp_(0), data_{0, 0, 0}, size_(0) {}
 
 MidiMessage::MidiMessage(const uint8_t* data, size_t size)
-    : data_{0, 0, 0}, size_(std::min(size, size_t(3))), timestamp_(0) {
+    : timestamp_(0), data_{0, 0, 0}, size_(static_cast<uint8_t>(std::min(size, size_t(3)))) {
     for (size_t i = 0; i < size_; ++i) {
         data_[i] = data[i];
     }
 }
 
 MidiMessage::MidiMessage(std::initializer_list<uint8_t> data)
-    : data_{0, 0, 0}, size_(std::min(data.size(), size_t(3))), timestamp_(0) {
-    size_t i = 0;
-    for (uint8_t byte : data) {
-        if (i >= 3) break;
-        data_[i++] = byte;
-    }
-}
+    : MidiMessage(data.begin(), data.size()) {}
 
 MidiMessage::MidiMessage(const std::vector<uint8_t>& data)
-    : data_{0, 0, 0}, size_(std::min(data.size(), size_t(3))), timestamp_(0) {
-    for (size_t i = 0; i < size_; ++i) {
-        data_[i] = data[i];
-    }
-}
+    : MidiMessage(data.data(), data.size()) {}
 
 MidiMessage MidiMessage::noteOn(uint8_t channel, uint8_t note, uint8_t velocity) {
     return MidiMessage({
@@ -354,7 +345,7 @@ std::string MidiMessage::toString() const {
         oss << "0x" << std::hex << std::setfill('0');
         for (size_t i = 0; i < size_; ++i) {
             oss << std::setw(2) << (int)data_[i];
-            if (i < size_ - 1) oss << " ";
+            if (i + 1 < size_) oss << " ";
         }
     }
 
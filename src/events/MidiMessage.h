@@ -5,6 +5,7 @@
 #include <vector>
 #include <string>
 #include <array>
+#include <type_traits>
 
 namespace nap {
 namespace events {
@@ -14,6 +15,11 @@ namespace events {
  *
  * Encapsulates MIDI channel messages, system messages, and provides
  * convenient factory methods and accessors for common MIDI operations.
+ *
+ * The bytes are stored inline and the class is trivially copyable and
+ * 16 bytes in size, so messages can be passed through lock-free queues
+ * and copied by value on the audio thread. SysEx is carried separately
+ * by SysexMessage.
  */
 class MidiMessage {
 public:
@@ -187,11 +193,15 @@ public:
     uint64_t getTimestamp() const;
 
 private:
-    std::array<uint8_t, 3> data_;
-    size_t size_;
     uint64_t timestamp_;
+    std::array<uint8_t, 3> data_;
+    uint8_t size_;
 };
 
+static_assert(std::is_trivially_copyable<MidiMessage>::value,
+              "MidiMessage must stay trivially copyable");
+static_assert(sizeof(MidiMessage) <= 16, "MidiMessage must fit in 16 bytes");
+
 } // namespace events
 } // namespace nap
 
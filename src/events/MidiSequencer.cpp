@@ -0,0 +1,125 @@
+#include "MidiSequencer.h"
+#include "MidiFile.h"
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cmath>
+#include <vector>
+
+namespace nap {
+namespace events {
+
+class MidiSequencer::Impl {
+public:
+    // Releases sounding notes at offset 0; false if out filled up first
+    bool releaseNotes(MidiBlockEvent* out, size_t maxEvents, size_t& count) {
+        for (uint8_t channel = 0; channel < 16; ++channel) {
+            if (active[channel].none()) continue;
+            for (uint8_t note = 0; note < 128; ++note) {
+                if (!active[channel].test(note)) continue;
+                if (count >= maxEvents) return false;
+                out[count++] = {MidiMessage::noteOff(channel, note), 0};
+                active[channel].reset(note);
+            }
+        }
+        return true;
+    }
+
+    void track(const MidiMessage& message) {
+        if (message.isNoteOn()) {
+            active[message.getChannel()].set(message.getNoteNumber());
+        } else if (message.isNoteOff()) {
+            active[message.getChannel()].reset(message.getNoteNumber());
+        }
+    }
+
+    bool anyActive() const {
+        return std::any_of(active.begin(), active.end(),
+                           [](const std::bitset<128>& notes) { return notes.any(); });
+    }
+
+    // Timestamps hold sample positions
+    std::vector<MidiMessage> events;
+    uint64_t length = 0;
+    size_t cursor = 0;
+    uint64_t position = 0;
+    std::array<std::bitset<128>, 16> active;
+    bool releasePending = false;
+};
+
+MidiSequencer::MidiSequencer() : pImpl(std::make_unique<Impl>()) {}
+
+MidiSequencer::~MidiSequencer() = default;
+
+void MidiSequencer::load(const MidiFile& file, double sampleRate) {
+    Impl& impl = *pImpl;
+    const auto& source = file.getEvents();
+
+    impl.events.clear();
+    impl.events.reserve(source.size());
+    for (const MidiFile::Event& event : source) {
+        MidiMessage message = event.message;
+        message.setTimestamp(static_cast<uint64_t>(std::llround(event.seconds * sampleRate)));
+        impl.events.push_back(message);
+    }
+    impl.length = static_cast<uint64_t>(std::llround(file.getLengthSeconds() * sampleRate));
+
+    impl.cursor = 0;
+    impl.position = 0;
+    impl.releasePending = impl.anyActive();
+}
+
+size_t MidiSequencer::getEventCount() const {
+    return pImpl->events.size();
+}
+
+uint64_t MidiSequencer::getLengthSamples() const {
+    return pImpl->length;
+}
+
+size_t MidiSequencer::renderBlock(uint32_t numFrames, MidiBlockEvent* out, size_t maxEvents) {
+    Impl& impl = *pImpl;
+    size_t count = 0;
+    if (impl.releasePending) {
+        impl.releasePending = !impl.releaseNotes(out, maxEvents, count);
+    }
+
+    const uint64_t blockEnd = impl.position + numFrames;
+    const size_t total = impl.events.size();
+    while (impl.cursor < total && count < maxEvents) {
+        const MidiMessage& message = impl.events[impl.cursor];
+        const uint64_t timestamp = message.getTimestamp();
+        if (timestamp >= blockEnd) break;
+
+        // Events left over from a full block are delivered late, at offset 0
+        const uint64_t offset = timestamp > impl.position ? timestamp - impl.position : 0;
+        out[count++] = {message, static_cast<uint32_t>(offset)};
+        impl.track(message);
+        ++impl.cursor;
+    }
+
+    impl.position = blockEnd;
+    return count;
+}
+
+void MidiSequencer::seek(uint64_t samplePosition) {
+    Impl& impl = *pImpl;
+    auto it = std::lower_bound(impl.events.begin(), impl.events.end(), samplePosition,
+                               [](const MidiMessage& message, uint64_t position) {
+                                   return message.getTimestamp() < position;
+                               });
+    impl.cursor = static_cast<size_t>(it - impl.events.begin());
+    impl.position = samplePosition;
+    impl.releasePending = impl.anyActive();
+}
+
+uint64_t MidiSequencer::getPosition() const {
+    return pImpl->position;
+}
+
+bool MidiSequencer::isFinished() const {
+    return pImpl->cursor >= pImpl->events.size() && pImpl->position >= pImpl->length;
+}
+
+} // namespace events
+} // namespace nap
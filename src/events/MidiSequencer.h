@@ -0,0 +1,54 @@
+#ifndef NAP_MIDI_SEQUENCER_H
+#define NAP_MIDI_SEQUENCER_H
+
+#include "MidiEventBus.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace nap {
+namespace events {
+
+class MidiFile;
+
+/**
+ * @brief Plays a MidiFile back block by block at sample accuracy
+ *
+ * load() scales the file's event times to sample positions once. The
+ * events go into one contiguous array of 16-byte MidiMessages whose
+ * timestamps hold the sample positions. Rendering a block only moves a
+ * cursor across the events that fall inside it. seek() is a binary search.
+ * Notes still sounding when the playhead jumps, or when playback is
+ * reset, are released at the start of the next block.
+ *
+ * Attach it to a MidiEventBus as an IMidiSource to feed a graph, or call
+ * renderBlock() directly for offline rendering. load() must not run while
+ * renderBlock() does.
+ */
+class MidiSequencer : public IMidiSource {
+public:
+    MidiSequencer();
+    ~MidiSequencer() override;
+
+    MidiSequencer(const MidiSequencer&) = delete;
+    MidiSequencer& operator=(const MidiSequencer&) = delete;
+
+    void load(const MidiFile& file, double sampleRate);
+    size_t getEventCount() const;
+    uint64_t getLengthSamples() const;
+
+    // Playback thread
+    size_t renderBlock(uint32_t numFrames, MidiBlockEvent* out, size_t maxEvents) override;
+    void seek(uint64_t samplePosition);
+    uint64_t getPosition() const;
+    bool isFinished() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace events
+} // namespace nap
+
+#endif // NAP_MIDI_SEQUENCER_H
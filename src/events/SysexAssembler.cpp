@@ -0,0 +1,168 @@
+#include "SysexAssembler.h"
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace nap {
+namespace events {
+
+class SysexAssembler::Impl {
+public:
+    enum class State { Idle, Header, Body };
+
+    explicit Impl(SysexPool& pool) : pool(pool) {}
+
+    void begin(uint64_t time) {
+        state = State::Header;
+        headerSize = 0;
+        timestamp = time;
+    }
+
+    bool headerComplete() const {
+        return headerSize == 3 || (headerSize == 1 && header[0] != 0x00);
+    }
+
+    void startBody() {
+        const uint32_t id = header[0] == 0x00
+            ? (static_cast<uint32_t>(header[1]) << 8) | header[2]
+            : header[0];
+        for (const auto& [manufacturer, streamHandler] : handlers) {
+            if (manufacturer == id) handler = streamHandler;
+        }
+
+        if (handler) {
+            handler->beginSysex(id, timestamp);
+        } else {
+            startMessage();
+        }
+        state = State::Body;
+    }
+
+    void startMessage() {
+        message.emplace(pool);
+        message->append(header, headerSize);
+        message->setTimestamp(timestamp);
+    }
+
+    void body(const uint8_t* data, size_t size) {
+        if (handler) {
+            handler->sysexData(data, size);
+        } else {
+            message->append(data, size);
+        }
+    }
+
+    void finish(bool complete) {
+        if (state == State::Header && !handler) {
+            startMessage();  // Too short to name a manufacturer
+        }
+
+        if (handler) {
+            handler->endSysex(complete);
+        } else if (complete) {
+            message->append(0xF7);
+            if (message->isTruncated()) ++truncated;
+            if (callback) callback(std::move(*message));
+        }
+        ++(complete ? completed : aborted);
+
+        message.reset();
+        handler = nullptr;
+        state = State::Idle;
+    }
+
+    SysexPool& pool;
+    MessageCallback callback;
+    std::vector<std::pair<uint32_t, ISysexStreamHandler*>> handlers;
+
+    State state = State::Idle;
+    uint8_t header[3] = {};
+    size_t headerSize = 0;
+    uint64_t timestamp = 0;
+    ISysexStreamHandler* handler = nullptr;
+    std::optional<SysexMessage> message;
+
+    uint64_t completed = 0;
+    uint64_t aborted = 0;
+    uint64_t truncated = 0;
+};
+
+SysexAssembler::SysexAssembler(SysexPool& pool) : pImpl(std::make_unique<Impl>(pool)) {}
+
+SysexAssembler::~SysexAssembler() = default;
+
+void SysexAssembler::setMessageCallback(MessageCallback callback) {
+    pImpl->callback = std::move(callback);
+}
+
+void SysexAssembler::setStreamHandler(uint32_t manufacturerId, ISysexStreamHandler* handler) {
+    auto& handlers = pImpl->handlers;
+    for (auto it = handlers.begin(); it != handlers.end(); ++it) {
+        if (it->first == manufacturerId) {
+            handlers.erase(it);
+            break;
+        }
+    }
+    if (handler) {
+        handlers.emplace_back(manufacturerId, handler);
+    }
+}
+
+void SysexAssembler::feed(const uint8_t* data, size_t size, uint64_t timestamp) {
+    Impl& impl = *pImpl;
+    size_t i = 0;
+    while (i < size) {
+        const uint8_t byte = data[i];
+        if (byte < 0x80) {
+            size_t end = i;
+            if (impl.state == Impl::State::Header) {
+                impl.header[impl.headerSize++] = byte;
+                if (impl.headerComplete()) impl.startBody();
+                ++i;
+                continue;
+            }
+
+            // Whole runs of data bytes at a time
+            while (end < size && data[end] < 0x80) ++end;
+            if (impl.state == Impl::State::Body) impl.body(data + i, end - i);
+            i = end;
+            continue;
+        }
+
+        ++i;
+        if (byte >= 0xF8) continue;  // Real-time bytes may interleave
+
+        if (byte == 0xF7) {
+            if (impl.state != Impl::State::Idle) impl.finish(true);
+            continue;
+        }
+
+        if (impl.state != Impl::State::Idle) impl.finish(false);
+        if (byte == 0xF0) impl.begin(timestamp);
+    }
+}
+
+void SysexAssembler::reset() {
+    if (pImpl->state != Impl::State::Idle) {
+        pImpl->finish(false);
+    }
+}
+
+bool SysexAssembler::isReceiving() const {
+    return pImpl->state != Impl::State::Idle;
+}
+
+uint64_t SysexAssembler::getCompletedCount() const {
+    return pImpl->completed;
+}
+
+uint64_t SysexAssembler::getAbortedCount() const {
+    return pImpl->aborted;
+}
+
+uint64_t SysexAssembler::getTruncatedCount() const {
+    return pImpl->truncated;
+}
+
+} // namespace events
+} // namespace nap
@@ -0,0 +1,75 @@
+#ifndef NAP_SYSEX_ASSEMBLER_H
+#define NAP_SYSEX_ASSEMBLER_H
+
+#include "SysexMessage.h"
+#include "SysexPool.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace nap {
+namespace events {
+
+/**
+ * @brief Receives one manufacturer's SysEx as it streams in
+ *
+ * sysexData() gets the bytes after the manufacturer ID, fragment by
+ * fragment and without the closing F7, so a dump can be decoded (for
+ * example with SysexCodec::unpack) before it has finished arriving.
+ */
+class ISysexStreamHandler {
+public:
+    virtual ~ISysexStreamHandler() = default;
+
+    virtual void beginSysex(uint32_t manufacturerId, uint64_t timestamp) = 0;
+    virtual void sysexData(const uint8_t* data, size_t size) = 0;
+    virtual void endSysex(bool complete) = 0;  // False when cut off by another status byte
+};
+
+/**
+ * @brief Reassembles SysEx messages from raw MIDI bytes in arbitrary fragments
+ *
+ * Drivers hand over whatever their buffers contain, whether that is half
+ * a message or the end of one plus the start of the next. Data bytes are
+ * taken in runs. For manufacturers with a registered ISysexStreamHandler
+ * the runs are forwarded as they arrive and nothing is stored. Other
+ * messages are appended into pooled SysexMessage chunks, so a large dump
+ * is copied once and never reallocated, and are passed to the message
+ * callback when their F7 arrives.
+ *
+ * Real-time bytes (F8-FF) interleaved with a message are skipped. Any
+ * other status byte aborts the message in progress. Manufacturer IDs
+ * follow SysexMessage::getManufacturerId(). Not thread-safe; feed it
+ * from a single thread.
+ */
+class SysexAssembler {
+public:
+    using MessageCallback = std::function<void(SysexMessage&& message)>;
+
+    explicit SysexAssembler(SysexPool& pool = SysexPool::getDefault());
+    ~SysexAssembler();
+
+    SysexAssembler(const SysexAssembler&) = delete;
+    SysexAssembler& operator=(const SysexAssembler&) = delete;
+
+    void setMessageCallback(MessageCallback callback);
+    void setStreamHandler(uint32_t manufacturerId, ISysexStreamHandler* handler);  // nullptr removes
+
+    void feed(const uint8_t* data, size_t size, uint64_t timestamp = 0);
+    void reset();  // Aborts the message in progress
+    bool isReceiving() const;
+
+    uint64_t getCompletedCount() const;
+    uint64_t getAbortedCount() const;
+    uint64_t getTruncatedCount() const;  // Delivered short because the pool ran out
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace events
+} // namespace nap
+
+#endif // NAP_SYSEX_ASSEMBLER_H
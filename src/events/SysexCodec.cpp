@@ -0,0 +1,79 @@
+#include "SysexCodec.h"
+
+namespace nap {
+namespace events {
+
+namespace {
+
+constexpr uint64_t kLowBits = 0x007F7F7F7F7F7F7Full;
+constexpr uint64_t kByteMsbs = 0x0080808080808080ull;
+constexpr uint64_t kByteLsbs = 0x0001010101010101ull;
+// Moves bit 8i+7 to bit 56+i, so the top byte collects one bit per byte
+constexpr uint64_t kGatherBits = 0x0002040810204081ull;
+// Places copies of a 7-bit value 7 bits apart, so bit i lands on bit 8i
+constexpr uint64_t kSpreadBits = 0x0000040810204081ull;
+
+uint64_t load7(const uint8_t* bytes) {
+    uint64_t word = 0;
+    for (int i = 6; i >= 0; --i) word = (word << 8) | bytes[i];
+    return word;
+}
+
+void store7(uint64_t word, uint8_t* bytes) {
+    for (int i = 0; i < 7; ++i) {
+        bytes[i] = static_cast<uint8_t>(word);
+        word >>= 8;
+    }
+}
+
+} // namespace
+
+size_t SysexCodec::packedSize(size_t size) {
+    return size + (size + 6) / 7;
+}
+
+size_t SysexCodec::unpackedSize(size_t packedSize) {
+    return packedSize - (packedSize + 7) / 8;
+}
+
+size_t SysexCodec::pack(const uint8_t* data, size_t size, uint8_t* out) {
+    uint8_t* const start = out;
+    size_t i = 0;
+    for (; i + 7 <= size; i += 7) {
+        const uint64_t word = load7(data + i);
+        *out++ = static_cast<uint8_t>((((word & kByteMsbs) * kGatherBits) >> 56) & 0x7F);
+        store7(word & kLowBits, out);
+        out += 7;
+    }
+
+    if (i < size) {
+        uint8_t* header = out++;
+        *header = 0;
+        for (size_t k = 0; i < size; ++i, ++k) {
+            *header |= static_cast<uint8_t>((data[i] >> 7) << k);
+            *out++ = data[i] & 0x7F;
+        }
+    }
+    return static_cast<size_t>(out - start);
+}
+
+size_t SysexCodec::unpack(const uint8_t* packed, size_t size, uint8_t* out) {
+    uint8_t* const start = out;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        const uint64_t high = ((packed[i] & 0x7Full) * kSpreadBits) & kByteLsbs;
+        store7((load7(packed + i + 1) & kLowBits) | (high << 7), out);
+        out += 7;
+    }
+
+    if (i < size) {
+        const uint8_t header = packed[i++];
+        for (size_t k = 0; i < size; ++i, ++k) {
+            *out++ = static_cast<uint8_t>((packed[i] & 0x7F) | (((header >> k) & 1) << 7));
+        }
+    }
+    return static_cast<size_t>(out - start);
+}
+
+} // namespace events
+} // namespace nap
@@ -0,0 +1,32 @@
+#ifndef NAP_SYSEX_CODEC_H
+#define NAP_SYSEX_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace nap {
+namespace events {
+
+/**
+ * @brief Bulk conversion between 8-bit data and 7-bit SysEx-safe bytes
+ *
+ * Uses the packing most manufacturers use for sample and patch dumps.
+ * Each group of up to seven data bytes is preceded by one byte that holds
+ * their top bits, with bit i belonging to byte i of the group. Full groups
+ * are converted a 64-bit word at a time (SWAR), so long dumps cost a few
+ * instructions per seven bytes. Input and output must not overlap.
+ */
+class SysexCodec {
+public:
+    static size_t packedSize(size_t size);
+    static size_t unpackedSize(size_t packedSize);
+
+    // Return the number of bytes written
+    static size_t pack(const uint8_t* data, size_t size, uint8_t* out);
+    static size_t unpack(const uint8_t* packed, size_t size, uint8_t* out);
+};
+
+} // namespace events
+} // namespace nap
+
+#endif // NAP_SYSEX_CODEC_H
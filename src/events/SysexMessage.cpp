@@ -6,24 +6,195 @@
 namespace nap {
 namespace events {
 
-SysexMessage::SysexMessage() : timestamp_(0) {
-    data_.push_back(0xF0);
-}
+namespace {
+
+// Sequential reader over a chunk chain
+class ChunkCursor {
+public:
+    explicit ChunkCursor(const SysexChunk* chunk) : chunk_(chunk), pos_(0) {}
+
+    uint8_t next() {
+        while (pos_ >= chunk_->used) {
+            chunk_ = chunk_->next;
+            pos_ = 0;
+        }
+        return chunk_->bytes[pos_++];
+    }
+
+private:
+    const SysexChunk* chunk_;
+    uint32_t pos_;
+};
+
+} // namespace
+
+SysexMessage::SysexMessage() : SysexMessage(SysexPool::getDefault()) {}
 
 SysexMessage::SysexMessage(const std::vector<uint8_t>& data)
-    : data_(data), timestamp_(0) {
-    ensureFraming();
-}
+    : SysexMessage(SysexPool::getDefault(), data.data(), data.size()) {}
+
+SysexMessage::SysexMessage(std::initializer_list<uint8_t> data)
+    : SysexMessage(SysexPool::getDefault(), data.begin(), data.size()) {}
 
 SysexMessage::SysexMessage(const uint8_t* data, size_t size)
-    : data_(data, data + size), timestamp_(0) {
-    ensureFraming();
+    : SysexMessage(SysexPool::getDefault(), data, size) {}
+
+SysexMessage::SysexMessage(SysexPool& pool)
+    : pool_(&pool), head_(nullptr), tail_(nullptr), size_(0),
+      truncated_(false), timestamp_(0) {
+    pushBack(0xF0);
+}
+
+SysexMessage::SysexMessage(SysexPool& pool, const uint8_t* data, size_t size)
+    : pool_(&pool), head_(nullptr), tail_(nullptr), size_(0),
+      truncated_(false), timestamp_(0) {
+    assign(data, size);
+}
+
+SysexMessage::SysexMessage(const SysexMessage& other)
+    : pool_(other.pool_), head_(other.head_), tail_(other.tail_), size_(other.size_),
+      truncated_(other.truncated_), timestamp_(other.timestamp_) {
+    if (head_) {
+        head_->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+SysexMessage::SysexMessage(SysexMessage&& other) noexcept
+    : pool_(other.pool_), head_(other.head_), tail_(other.tail_), size_(other.size_),
+      truncated_(other.truncated_), timestamp_(other.timestamp_) {
+    other.head_ = nullptr;
+    other.tail_ = nullptr;
+    other.size_ = 0;
+}
+
+SysexMessage& SysexMessage::operator=(const SysexMessage& other) {
+    if (this != &other) {
+        SysexMessage copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+SysexMessage& SysexMessage::operator=(SysexMessage&& other) noexcept {
+    if (this != &other) {
+        reset();
+        pool_ = other.pool_;
+        head_ = other.head_;
+        tail_ = other.tail_;
+        size_ = other.size_;
+        truncated_ = other.truncated_;
+        timestamp_ = other.timestamp_;
+        other.head_ = nullptr;
+        other.tail_ = nullptr;
+        other.size_ = 0;
+    }
+    return *this;
+}
+
+SysexMessage::~SysexMessage() {
+    reset();
+}
+
+void SysexMessage::assign(const uint8_t* data, size_t size) {
+    if (size == 0 || data[0] != 0xF0) {
+        pushBack(0xF0);
+    }
+    pushBytes(data, size);
+}
+
+void SysexMessage::reset() {
+    // The last owner returns the chain; acq_rel orders its reads before reuse
+    if (head_ && head_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        pool_->release(head_);
+    }
+    head_ = nullptr;
+    tail_ = nullptr;
+    size_ = 0;
+}
+
+void SysexMessage::makeUnique() {
+    if (!head_ || head_->refs.load(std::memory_order_acquire) == 1) {
+        return;
+    }
+
+    SysexChunk* shared = head_;
+    const uint32_t count = size_;
+    head_ = nullptr;
+    tail_ = nullptr;
+    size_ = 0;
+
+    for (const SysexChunk* chunk = shared; chunk && size_ < count; chunk = chunk->next) {
+        if (pushBytes(chunk->bytes, chunk->used) < chunk->used) break;
+    }
+
+    if (shared->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        pool_->release(shared);
+    }
 }
 
-void SysexMessage::ensureFraming() {
-    if (data_.empty() || data_.front() != 0xF0) {
-        data_.insert(data_.begin(), 0xF0);
+bool SysexMessage::pushBack(uint8_t byte) {
+    if (!tail_ || tail_->used == pool_->getChunkSize()) {
+        SysexChunk* chunk = pool_->acquire();
+        if (!chunk) {
+            truncated_ = true;
+            return false;
+        }
+        if (tail_) {
+            tail_->next = chunk;
+        } else {
+            head_ = chunk;
+        }
+        tail_ = chunk;
+    }
+    tail_->bytes[tail_->used++] = byte;
+    ++size_;
+    return true;
+}
+
+size_t SysexMessage::pushBytes(const uint8_t* data, size_t size) {
+    // Whole runs per chunk, so long dumps are copied once
+    const size_t chunkSize = pool_->getChunkSize();
+    size_t written = 0;
+    while (written < size) {
+        if (!tail_ || tail_->used == chunkSize) {
+            if (!pushBack(data[written++])) return written - 1;
+            continue;
+        }
+        const size_t count = std::min(chunkSize - tail_->used, size - written);
+        std::copy(data + written, data + written + count, tail_->bytes + tail_->used);
+        tail_->used += static_cast<uint32_t>(count);
+        size_ += static_cast<uint32_t>(count);
+        written += count;
     }
+    return written;
+}
+
+void SysexMessage::popBack() {
+    if (size_ == 0) return;
+    --tail_->used;
+    --size_;
+    if (tail_->used == 0 && tail_ != head_) {
+        SysexChunk* previous = head_;
+        while (previous->next != tail_) {
+            previous = previous->next;
+        }
+        previous->next = nullptr;
+        pool_->release(tail_);
+        tail_ = previous;
+    }
+}
+
+uint8_t SysexMessage::at(size_t index) const {
+    const size_t chunkSize = pool_->getChunkSize();
+    const SysexChunk* chunk = head_;
+    for (size_t skip = index / chunkSize; skip > 0; --skip) {
+        chunk = chunk->next;
+    }
+    return chunk->bytes[index % chunkSize];
+}
+
+uint8_t SysexMessage::back() const {
+    return tail_->bytes[tail_->used - 1];
 }
 
 SysexMessage SysexMessage::identityRequest(uint8_t deviceId) {
@@ -147,69 +318,113 @@ SysexMessage SysexMessage::createManufacturerMessage(uint32_t manufacturerId,
     return SysexMessage(sysex);
 }
 
-const std::vector<uint8_t>& SysexMessage::data() const {
-    return data_;
+std::vector<uint8_t> SysexMessage::data() const {
+    std::vector<uint8_t> bytes(size_);
+    copyTo(bytes.data(), bytes.size());
+    return bytes;
 }
 
 size_t SysexMessage::size() const {
-    return data_.size();
+    return size_;
 }
 
 uint8_t SysexMessage::operator[](size_t index) const {
-    return index < data_.size() ? data_[index] : 0;
+    return index < size_ ? at(index) : 0;
+}
+
+size_t SysexMessage::getChunkCount() const {
+    size_t count = 0;
+    for (const SysexChunk* chunk = head_; chunk; chunk = chunk->next) {
+        ++count;
+    }
+    return count;
+}
+
+const uint8_t* SysexMessage::getChunkData(size_t chunk, size_t& length) const {
+    const SysexChunk* current = head_;
+    for (; current && chunk > 0; --chunk) {
+        current = current->next;
+    }
+    length = current ? current->used : 0;
+    return current ? current->bytes : nullptr;
+}
+
+size_t SysexMessage::copyTo(uint8_t* dest, size_t capacity) const {
+    size_t copied = 0;
+    for (const SysexChunk* chunk = head_; chunk && copied < capacity; chunk = chunk->next) {
+        const size_t count = std::min<size_t>(chunk->used, capacity - copied);
+        std::copy(chunk->bytes, chunk->bytes + count, dest + copied);
+        copied += count;
+    }
+    return copied;
+}
+
+SysexPool& SysexMessage::getPool() const {
+    return *pool_;
+}
+
+bool SysexMessage::isTruncated() const {
+    return truncated_;
 }
 
 std::vector<uint8_t> SysexMessage::getPayload() const {
-    if (data_.size() < 2) return {};
+    if (size_ < 2) return {};
 
     size_t start = 1; // Skip F0
-    size_t end = data_.size();
-    if (!data_.empty() && data_.back() == 0xF7) {
+    size_t end = size_;
+    if (back() == 0xF7) {
         end--; // Skip F7
     }
 
     if (start >= end) return {};
-    return std::vector<uint8_t>(data_.begin() + start, data_.begin() + end);
+    std::vector<uint8_t> payload;
+    payload.reserve(end - start);
+    ChunkCursor cursor(head_);
+    cursor.next();
+    for (size_t i = start; i < end; ++i) {
+        payload.push_back(cursor.next());
+    }
+    return payload;
 }
 
 bool SysexMessage::isValid() const {
-    return !data_.empty() && data_.front() == 0xF0;
+    return size_ > 0 && head_->bytes[0] == 0xF0;
 }
 
 bool SysexMessage::isComplete() const {
-    return isValid() && !data_.empty() && data_.back() == 0xF7;
+    return isValid() && back() == 0xF7;
 }
 
 bool SysexMessage::isUniversal() const {
-    return isValid() && data_.size() > 1 &&
-           (data_[1] == 0x7E || data_[1] == 0x7F);
+    return isValid() && size_ > 1 &&
+           (at(1) == 0x7E || at(1) == 0x7F);
 }
 
 bool SysexMessage::isNonRealTime() const {
-    return isValid() && data_.size() > 1 && data_[1] == 0x7E;
+    return isValid() && size_ > 1 && at(1) == 0x7E;
 }
 
 bool SysexMessage::isRealTime() const {
-    return isValid() && data_.size() > 1 && data_[1] == 0x7F;
+    return isValid() && size_ > 1 && at(1) == 0x7F;
 }
 
 uint32_t SysexMessage::getManufacturerId() const {
-    if (!isValid() || data_.size() < 2) return 0;
+    if (!isValid() || size_ < 2) return 0;
 
     if (isUniversal()) {
-        return data_[1];
+        return at(1);
     }
 
-    if (data_[1] == 0x00 && data_.size() >= 4) {
+    if (at(1) == 0x00 && size_ >= 4) {
         // Extended manufacturer ID
-        return (static_cast<uint32_t>(data_[2]) << 8) | data_[3];
+        return (static_cast<uint32_t>(at(2)) << 8) | at(3);
     }
 
-    return data_[1];
+    return at(1);
 }
 
 bool SysexMessage::isExtendedManufacturerId() const {
-    return isValid() && data_.size() >= 4 && data_[1] == 0x00;
+    return isValid() && size_ >= 4 && at(1) == 0x00;
 }
 
 std::string SysexMessage::getManufacturerName() const {
@@ -231,7 +446,7 @@ std::string SysexMessage::getManufacturerName() const {
 
     // Check extended IDs
     if (isExtendedManufacturerId()) {
-        uint32_t extId = (static_cast<uint32_t>(data_[2]) << 8) | data_[3];
+        uint32_t extId = (static_cast<uint32_t>(at(2)) << 8) | at(3);
         if (extId == 0x2109) return "Native Instruments";
     }
 
@@ -239,22 +454,22 @@ std::string SysexMessage::getManufacturerName() const {
 }
 
 std::optional<uint8_t> SysexMessage::getDeviceId() const {
-    if (!isUniversal() || data_.size() < 3) return std::nullopt;
-    return data_[2];
+    if (!isUniversal() || size_ < 3) return std::nullopt;
+    return at(2);
 }
 
 std::optional<uint8_t> SysexMessage::getSubId1() const {
-    if (!isUniversal() || data_.size() < 4) return std::nullopt;
-    return data_[3];
+    if (!isUniversal() || size_ < 4) return std::nullopt;
+    return at(3);
 }
 
 std::optional<uint8_t> SysexMessage::getSubId2() const {
-    if (!isUniversal() || data_.size() < 5) return std::nullopt;
-    return data_[4];
+    if (!isUniversal() || size_ < 5) return std::nullopt;
+    return at(4);
 }
 
 std::optional<SysexMessage::IdentityReply> SysexMessage::parseIdentityReply() const {
-    if (!isNonRealTime() || data_.size() < 15) return std::nullopt;
+    if (!isNonRealTime() || size_ < 15) return std::nullopt;
 
     auto subId1 = getSubId1();
     auto subId2 = getSubId2();
@@ -264,80 +479,93 @@ std::optional<SysexMessage::IdentityReply> SysexMessage::parseIdentityReply() co
     }
 
     IdentityReply reply;
-    reply.deviceId = data_[2];
+    reply.deviceId = at(2);
 
     size_t offset = 5;
-    if (data_[offset] == 0x00) {
+    if (at(offset) == 0x00) {
         // Extended manufacturer ID
-        reply.manufacturerId = (static_cast<uint32_t>(data_[offset + 1]) << 8) |
-                                data_[offset + 2];
+        reply.manufacturerId = (static_cast<uint32_t>(at(offset + 1)) << 8) |
+                                at(offset + 2);
         offset += 3;
     } else {
-        reply.manufacturerId = data_[offset];
+        reply.manufacturerId = at(offset);
         offset += 1;
     }
 
-    if (offset + 8 > data_.size()) return std::nullopt;
+    if (offset + 8 > size_) return std::nullopt;
 
-    reply.familyCode = (static_cast<uint16_t>(data_[offset + 1]) << 8) |
-                        data_[offset];
-    reply.modelNumber = (static_cast<uint16_t>(data_[offset + 3]) << 8) |
-                         data_[offset + 2];
-    reply.softwareRevision = (static_cast<uint32_t>(data_[offset + 7]) << 24) |
-                              (static_cast<uint32_t>(data_[offset + 6]) << 16) |
-                              (static_cast<uint32_t>(data_[offset + 5]) << 8) |
-                              data_[offset + 4];
+    reply.familyCode = (static_cast<uint16_t>(at(offset + 1)) << 8) |
+                        at(offset);
+    reply.modelNumber = (static_cast<uint16_t>(at(offset + 3)) << 8) |
+                         at(offset + 2);
+    reply.softwareRevision = (static_cast<uint32_t>(at(offset + 7)) << 24) |
+                              (static_cast<uint32_t>(at(offset + 6)) << 16) |
+                              (static_cast<uint32_t>(at(offset + 5)) << 8) |
+                              at(offset + 4);
 
     return reply;
 }
 
 void SysexMessage::append(uint8_t byte) {
+    makeUnique();
     // Remove trailing F7 if present
-    if (!data_.empty() && data_.back() == 0xF7) {
-        data_.pop_back();
+    if (size_ > 0 && back() == 0xF7) {
+        popBack();
     }
-    data_.push_back(byte);
+    pushBack(byte);
 }
 
 void SysexMessage::append(const uint8_t* data, size_t size) {
+    makeUnique();
     // Remove trailing F7 if present
-    if (!data_.empty() && data_.back() == 0xF7) {
-        data_.pop_back();
+    if (size_ > 0 && back() == 0xF7) {
+        popBack();
     }
-    data_.insert(data_.end(), data, data + size);
+    pushBytes(data, size);
 }
 
 void SysexMessage::clear() {
-    data_.clear();
-    data_.push_back(0xF0);
+    reset();
+    truncated_ = false;
+    pushBack(0xF0);
 }
 
 uint8_t SysexMessage::calculateRolandChecksum() const {
     // Roland checksum is calculated on address and data bytes
     // Checksum = 128 - (sum of bytes mod 128)
-    if (data_.size() < 8) return 0;
+    if (size_ < 8) return 0;
 
     uint32_t sum = 0;
     // Skip F0, manufacturer ID (0x41), device ID, model ID
     // Checksum is typically over address (3-4 bytes) and data
-    for (size_t i = 5; i < data_.size() - 2; ++i) {
-        sum += data_[i];
+    ChunkCursor cursor(head_);
+    for (size_t i = 0; i < size_ - 2; ++i) {
+        const uint8_t byte = cursor.next();
+        if (i >= 5) sum += byte;
     }
 
     return static_cast<uint8_t>((128 - (sum % 128)) % 128);
 }
 
 bool SysexMessage::verifyRolandChecksum() const {
-    if (data_.size() < 8) return false;
+    if (size_ < 8) return false;
 
     uint8_t expected = calculateRolandChecksum();
-    uint8_t actual = data_[data_.size() - 2]; // Checksum is second to last byte
+    uint8_t actual = at(size_ - 2); // Checksum is second to last byte
 
     return expected == actual;
 }
 
 bool SysexMessage::operator==(const SysexMessage& other) const {
-    return data_ == other.data_;
+    if (size_ != other.size_) return false;
+    if (head_ == other.head_) return true;
+
+    ChunkCursor a(head_);
+    ChunkCursor b(other.head_);
+    for (size_t i = 0; i < size_; ++i) {
+        if (a.next() != b.next()) return false;
+    }
+    return true;
 }
 
 bool SysexMessage::operator!=(const SysexMessage& other) const {
@@ -347,7 +575,7 @@ bool SysexMessage::operator!=(const SysexMessage& other) const {
 std::string SysexMessage::toString() const {
     std::ostringstream oss;
 
-    oss << "SysEx [" << data_.size() << " bytes]";
+    oss << "SysEx [" << size_ << " bytes]";
 
     if (isUniversal()) {
         if (isNonRealTime()) {
@@ -377,9 +605,10 @@ std::string SysexMessage::toHexString() const {
     std::ostringstream oss;
     oss << std::hex << std::setfill('0');
 
-    for (size_t i = 0; i < data_.size(); ++i) {
-        oss << std::setw(2) << (int)data_[i];
-        if (i < data_.size() - 1) oss << " ";
+    ChunkCursor cursor(head_);
+    for (size_t i = 0; i < size_; ++i) {
+        oss << std::setw(2) << (int)cursor.next();
+        if (i < size_ - 1) oss << " ";
     }
 
     return oss.str();
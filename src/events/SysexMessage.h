@@ -1,11 +1,13 @@
 #ifndef NAP_SYSEX_MESSAGE_H
 #define NAP_SYSEX_MESSAGE_H
 
+#include "SysexPool.h"
 #include <cstdint>
 #include <vector>
 #include <string>
 #include <memory>
 #include <optional>
+#include <initializer_list>
 
 namespace nap {
 namespace events {
@@ -15,6 +17,12 @@ namespace events {
  *
  * Handles variable-length SysEx messages with support for manufacturer IDs,
  * Universal SysEx, and common device control messages.
+ *
+ * The bytes live in a chain of chunks taken from a SysexPool rather than
+ * on the heap. Copies share the chain through a reference count and only
+ * clone it when one of them is modified, so handing a message from the
+ * MIDI thread to the UI thread never allocates. If the pool runs out, the
+ * bytes that did not fit are dropped and isTruncated() reports it.
  */
 class SysexMessage {
 public:
@@ -61,10 +69,20 @@ public:
         MobilePhoneControl = 0x0C
     };
 
-    // Constructors
+    // Constructors (default pool unless one is given)
     SysexMessage();
     explicit SysexMessage(const std::vector<uint8_t>& data);
+    SysexMessage(std::initializer_list<uint8_t> data);
     SysexMessage(const uint8_t* data, size_t size);
+    explicit SysexMessage(SysexPool& pool);
+    SysexMessage(SysexPool& pool, const uint8_t* data, size_t size);
+
+    // Copies share chunks; moves steal them
+    SysexMessage(const SysexMessage& other);
+    SysexMessage(SysexMessage&& other) noexcept;
+    SysexMessage& operator=(const SysexMessage& other);
+    SysexMessage& operator=(SysexMessage&& other) noexcept;
+    ~SysexMessage();
 
     // Factory methods for Universal SysEx
     static SysexMessage identityRequest(uint8_t deviceId = 0x7F);
@@ -97,10 +115,18 @@ public:
                                                     const std::vector<uint8_t>& data);
 
     // Data access
-    const std::vector<uint8_t>& data() const;
+    std::vector<uint8_t> data() const;  // Copies; not for the audio thread
     size_t size() const;
     uint8_t operator[](size_t index) const;
 
+    // Allocation-free access to the stored chunks
+    size_t getChunkCount() const;
+    const uint8_t* getChunkData(size_t chunk, size_t& length) const;
+    size_t copyTo(uint8_t* dest, size_t capacity) const;
+
+    SysexPool& getPool() const;
+    bool isTruncated() const;  // Bytes were dropped because the pool was empty
+
     // Raw data without F0/F7 framing
     std::vector<uint8_t> getPayload() const;
 
@@ -164,10 +190,21 @@ public:
     static constexpr uint32_t MANUFACTURER_NATIVE_INSTRUMENTS = 0x002109;
 
 private:
-    std::vector<uint8_t> data_;
+    SysexPool* pool_;
+    SysexChunk* head_;
+    SysexChunk* tail_;
+    uint32_t size_;
+    bool truncated_;
     uint64_t timestamp_;
 
-    void ensureFraming();
+    void assign(const uint8_t* data, size_t size);
+    void reset();
+    void makeUnique();
+    bool pushBack(uint8_t byte);
+    size_t pushBytes(const uint8_t* data, size_t size);
+    void popBack();
+    uint8_t at(size_t index) const;
+    uint8_t back() const;
 };
 
 } // namespace events
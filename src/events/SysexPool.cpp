@@ -0,0 +1,132 @@
+#include "SysexPool.h"
+#include <algorithm>
+#include <vector>
+
+namespace nap {
+namespace events {
+
+namespace {
+
+constexpr uint32_t kNoChunk = 0xFFFFFFFFu;
+
+// The free-list head packs a chunk index with a counter that changes on
+// every update, so a stale compare-and-swap cannot succeed (ABA)
+uint64_t pack(uint32_t index, uint32_t tag) {
+    return (static_cast<uint64_t>(tag) << 32) | index;
+}
+
+uint32_t indexOf(uint64_t head) {
+    return static_cast<uint32_t>(head);
+}
+
+uint32_t tagOf(uint64_t head) {
+    return static_cast<uint32_t>(head >> 32);
+}
+
+} // namespace
+
+class SysexPool::Impl {
+public:
+    Impl(size_t chunkSize, size_t chunkCount)
+        : chunkSize(std::max<size_t>(chunkSize, 4))
+        , chunks(chunkCount)
+        , storage(this->chunkSize * chunkCount)
+        , nextFree(new std::atomic<uint32_t>[chunkCount]) {
+        for (size_t i = 0; i < chunkCount; ++i) {
+            chunks[i].index = static_cast<uint32_t>(i);
+            chunks[i].bytes = storage.data() + i * this->chunkSize;
+            nextFree[i].store(i + 1 < chunkCount ? static_cast<uint32_t>(i + 1) : kNoChunk,
+                              std::memory_order_relaxed);
+        }
+        head.store(pack(chunkCount ? 0 : kNoChunk, 0), std::memory_order_relaxed);
+        available.store(chunkCount, std::memory_order_relaxed);
+    }
+
+    SysexChunk* pop() {
+        uint64_t current = head.load(std::memory_order_acquire);
+        for (;;) {
+            const uint32_t index = indexOf(current);
+            if (index == kNoChunk) {
+                exhausted.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            const uint64_t next = pack(nextFree[index].load(std::memory_order_relaxed),
+                                       tagOf(current) + 1);
+            if (head.compare_exchange_weak(current, next, std::memory_order_acq_rel,
+                                           std::memory_order_acquire)) {
+                available.fetch_sub(1, std::memory_order_relaxed);
+                return &chunks[index];
+            }
+        }
+    }
+
+    void push(SysexChunk* chunk) {
+        uint64_t current = head.load(std::memory_order_relaxed);
+        for (;;) {
+            nextFree[chunk->index].store(indexOf(current), std::memory_order_relaxed);
+            const uint64_t next = pack(chunk->index, tagOf(current) + 1);
+            if (head.compare_exchange_weak(current, next, std::memory_order_release,
+                                           std::memory_order_relaxed)) {
+                available.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+    }
+
+    const size_t chunkSize;
+    std::vector<SysexChunk> chunks;
+    std::vector<uint8_t> storage;
+    std::unique_ptr<std::atomic<uint32_t>[]> nextFree;
+    std::atomic<uint64_t> head{0};
+    std::atomic<size_t> available{0};
+    std::atomic<uint64_t> exhausted{0};
+};
+
+SysexPool::SysexPool(size_t chunkSize, size_t chunkCount)
+    : pImpl(std::make_unique<Impl>(chunkSize, chunkCount)) {}
+
+SysexPool::~SysexPool() = default;
+
+SysexPool& SysexPool::getDefault() {
+    // Leaked on purpose so messages in static storage can still release into it
+    static SysexPool* pool = new SysexPool();
+    return *pool;
+}
+
+SysexChunk* SysexPool::acquire() {
+    SysexChunk* chunk = pImpl->pop();
+    if (chunk) {
+        chunk->refs.store(1, std::memory_order_relaxed);
+        chunk->used = 0;
+        chunk->next = nullptr;
+    }
+    return chunk;
+}
+
+void SysexPool::release(SysexChunk* chain) {
+    while (chain) {
+        SysexChunk* next = chain->next;
+        chain->next = nullptr;
+        pImpl->push(chain);
+        chain = next;
+    }
+}
+
+size_t SysexPool::getChunkSize() const {
+    return pImpl->chunkSize;
+}
+
+size_t SysexPool::getChunkCount() const {
+    return pImpl->chunks.size();
+}
+
+size_t SysexPool::getAvailableChunks() const {
+    return pImpl->available.load(std::memory_order_relaxed);
+}
+
+uint64_t SysexPool::getExhaustedCount() const {
+    return pImpl->exhausted.load(std::memory_order_relaxed);
+}
+
+} // namespace events
+} // namespace nap
@@ -0,0 +1,73 @@
+#ifndef NAP_SYSEX_POOL_H
+#define NAP_SYSEX_POOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace nap {
+namespace events {
+
+/**
+ * @brief One fixed-size block of SysEx bytes; chained for longer messages
+ *
+ * Only the first chunk of a chain carries the reference count, which is
+ * the number of SysexMessage objects sharing the chain.
+ */
+struct SysexChunk {
+    std::atomic<uint32_t> refs{0};
+    uint32_t used = 0;
+    uint32_t index = 0;
+    SysexChunk* next = nullptr;
+    uint8_t* bytes = nullptr;
+};
+
+/**
+ * @brief Preallocated, lock-free pool of SysEx chunk buffers
+ *
+ * All chunks are allocated up front. acquire() and release() only pop and
+ * push a tagged free-list head with compare-and-swap, so any thread may
+ * take or return chunks without locking or touching the allocator; a
+ * message received on the MIDI thread can be released on the UI thread.
+ * When the pool is empty acquire() returns nullptr and the failure is
+ * counted rather than falling back to the heap.
+ *
+ * The pool must outlive every message that uses it. getDefault() returns a
+ * process-wide pool that is never destroyed.
+ */
+class SysexPool {
+public:
+    static constexpr size_t kDefaultChunkSize = 256;
+    static constexpr size_t kDefaultChunkCount = 512;
+
+    explicit SysexPool(size_t chunkSize = kDefaultChunkSize,
+                       size_t chunkCount = kDefaultChunkCount);
+    ~SysexPool();
+
+    // Non-copyable, non-movable (messages point at it)
+    SysexPool(const SysexPool&) = delete;
+    SysexPool& operator=(const SysexPool&) = delete;
+
+    static SysexPool& getDefault();
+
+    // A single chunk with refs = 1, used = 0; nullptr when exhausted
+    SysexChunk* acquire();
+
+    // Returns every chunk of a chain
+    void release(SysexChunk* chain);
+
+    size_t getChunkSize() const;
+    size_t getChunkCount() const;
+    size_t getAvailableChunks() const;
+    uint64_t getExhaustedCount() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace events
+} // namespace nap
+
+#endif // NAP_SYSEX_POOL_H
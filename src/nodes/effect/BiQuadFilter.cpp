@@ -224,8 +224,7 @@ void BiQuadFilter::process(const float* inputBuffer, float* outputBuffer,
     // --- Stage 1: Advance parameter smoothers for this block ----------
     // We maintain our own cached smoothed values (smoothedFrequency, etc.)
     // using the pre-cached paramSmoothCoeff.  This avoids calling
-    // FloatParameter::getSmoothedValue() per sample (which recomputes
-    // exp() every call).  We advance numFrames steps so the smoother
+    // FloatParameter::getSmoothedValue() once per sample.  We advance numFrames steps so the smoother
     // tracks at sample rate, then read the FloatParameter's raw target
     // via getValue() as the destination.
     //
@@ -252,8 +251,8 @@ void BiQuadFilter::process(const float* inputBuffer, float* outputBuffer,
 
         // Sync the FloatParameter internal smoothed state so that any
         // external call to getSmoothedValue() stays consistent with what
-        // we just computed.  One call per block is fine — we only pay
-        // one exp() here, not numFrames.
+        // we just computed.  One call per block is fine — it advances a
+        // single sample with the parameter's cached coefficient.
         m_impl->paramFrequency->getSmoothedValue(static_cast<float>(m_impl->sampleRate));
         m_impl->paramQ->getSmoothedValue(static_cast<float>(m_impl->sampleRate));
         m_impl->paramGain->getSmoothedValue(static_cast<float>(m_impl->sampleRate));
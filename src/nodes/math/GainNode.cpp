@@ -1,18 +1,29 @@
 #include "GainNode.h"
+#include "../../core/parameters/FloatParameter.h"
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <string>
+#include <vector>
 
 namespace nap {
 
 class GainNode::Impl {
 public:
     std::string nodeId;
-    float gain = 1.0f;
-    float targetGain = 1.0f;
-    float smoothingCoeff = 0.995f;
     double sampleRate = 44100.0;
     std::uint32_t blockSize = 512;
     bool bypassed = false;
+
+    // Gain is unbounded; the parameter is only used for its block smoother
+    FloatParameter gain{"gain", 1.0f, std::numeric_limits<float>::lowest(),
+                        std::numeric_limits<float>::max()};
+    std::vector<float> gainBuffer;
+
+    Impl() : gainBuffer(blockSize) {
+        gain.setSmoothingMode(FloatParameter::SmoothingMode::Multiplicative);
+        gain.enableSmoothing(true, 0.005f);
+    }
 };
 
 GainNode::GainNode()
@@ -35,10 +46,32 @@ void GainNode::process(const float* inputBuffer, float* outputBuffer,
         return;
     }
 
-    for (std::uint32_t i = 0; i < numFrames * numChannels; ++i) {
-        m_impl->gain = m_impl->gain * m_impl->smoothingCoeff +
-                       m_impl->targetGain * (1.0f - m_impl->smoothingCoeff);
-        outputBuffer[i] = inputBuffer[i] * m_impl->gain;
+    FloatParameter& gain = m_impl->gain;
+
+    if (!gain.isSmoothing()) {
+        const float g = gain.getValue();
+        const std::uint32_t numSamples = numFrames * numChannels;
+        for (std::uint32_t i = 0; i < numSamples; ++i) {
+            outputBuffer[i] = inputBuffer[i] * g;
+        }
+        return;
+    }
+
+    // Render the gain ramp once per frame, then apply it to every channel
+    float* gains = m_impl->gainBuffer.data();
+    const auto chunkFrames = static_cast<std::uint32_t>(m_impl->gainBuffer.size());
+
+    for (std::uint32_t start = 0; start < numFrames; start += chunkFrames) {
+        const std::uint32_t frames = std::min(chunkFrames, numFrames - start);
+        gain.fillSmoothedBlock(gains, frames);
+
+        const float* in = inputBuffer + start * numChannels;
+        float* out = outputBuffer + start * numChannels;
+        for (std::uint32_t i = 0; i < frames; ++i) {
+            for (std::uint32_t ch = 0; ch < numChannels; ++ch) {
+                out[i * numChannels + ch] = in[i * numChannels + ch] * gains[i];
+            }
+        }
     }
 }
 
@@ -46,11 +79,13 @@ void GainNode::prepare(double sampleRate, std::uint32_t blockSize)
 {
     m_impl->sampleRate = sampleRate;
     m_impl->blockSize = blockSize;
+    m_impl->gainBuffer.assign(std::max<std::uint32_t>(blockSize, 1), 0.0f);
+    m_impl->gain.setSampleRate(static_cast<float>(sampleRate));
 }
 
 void GainNode::reset()
 {
-    m_impl->gain = m_impl->targetGain;
+    m_impl->gain.resetSmoothing();
 }
 
 std::string GainNode::getNodeId() const { return m_impl->nodeId; }
@@ -60,9 +95,9 @@ std::uint32_t GainNode::getNumOutputChannels() const { return 2; }
 bool GainNode::isBypassed() const { return m_impl->bypassed; }
 void GainNode::setBypassed(bool bypassed) { m_impl->bypassed = bypassed; }
 
-void GainNode::setGain(float gainLinear) { m_impl->targetGain = gainLinear; }
-float GainNode::getGain() const { return m_impl->targetGain; }
-void GainNode::setGainDb(float gainDb) { m_impl->targetGain = std::pow(10.0f, gainDb / 20.0f); }
-float GainNode::getGainDb() const { return 20.0f * std::log10(m_impl->targetGain); }
+void GainNode::setGain(float gainLinear) { m_impl->gain.setValue(gainLinear); }
+float GainNode::getGain() const { return m_impl->gain.getValue(); }
+void GainNode::setGainDb(float gainDb) { m_impl->gain.setValue(std::pow(10.0f, gainDb / 20.0f)); }
+float GainNode::getGainDb() const { return 20.0f * std::log10(m_impl->gain.getValue()); }
 
 } // namespace nap
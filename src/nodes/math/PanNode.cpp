@@ -1,6 +1,9 @@
 #include "PanNode.h"
+#include "../../core/parameters/FloatParameter.h"
+#include <algorithm>
 #include <cmath>
 #include <string>
+#include <vector>
 
 namespace nap {
 
@@ -9,30 +12,47 @@ public:
     std::string nodeId;
     float pan = 0.0f;
     float targetPan = 0.0f;
-    float leftGain = 1.0f;
-    float rightGain = 1.0f;
     PanLaw panLaw = PanLaw::ConstantPower;
     double sampleRate = 44100.0;
     std::uint32_t blockSize = 512;
     bool bypassed = false;
 
+    // Channel gains are smoothed rather than the pan position, so the
+    // pan law's trig runs once per change instead of once per sample
+    FloatParameter leftGain{"leftGain", 1.0f, 0.0f, 2.0f};
+    FloatParameter rightGain{"rightGain", 1.0f, 0.0f, 2.0f};
+    std::vector<float> leftBuffer;
+    std::vector<float> rightBuffer;
+
+    Impl() : leftBuffer(blockSize), rightBuffer(blockSize) {
+        for (FloatParameter* gain : {&leftGain, &rightGain}) {
+            gain->setSmoothingMode(FloatParameter::SmoothingMode::Linear);
+            gain->enableSmoothing(true, 0.005f);
+        }
+    }
+
     void updateGains() {
         float normalizedPan = (pan + 1.0f) * 0.5f; // 0 to 1
+        float left = 1.0f;
+        float right = 1.0f;
 
         switch (panLaw) {
             case PanLaw::Linear:
-                leftGain = 1.0f - normalizedPan;
-                rightGain = normalizedPan;
+                left = 1.0f - normalizedPan;
+                right = normalizedPan;
                 break;
             case PanLaw::ConstantPower:
-                leftGain = std::cos(normalizedPan * 3.14159265f * 0.5f);
-                rightGain = std::sin(normalizedPan * 3.14159265f * 0.5f);
+                left = std::cos(normalizedPan * 3.14159265f * 0.5f);
+                right = std::sin(normalizedPan * 3.14159265f * 0.5f);
                 break;
             case PanLaw::MinusFourPointFive:
-                leftGain = std::sqrt((1.0f - normalizedPan) * 0.5f) * std::sqrt(2.0f);
-                rightGain = std::sqrt(normalizedPan * 0.5f) * std::sqrt(2.0f);
+                left = std::sqrt((1.0f - normalizedPan) * 0.5f) * std::sqrt(2.0f);
+                right = std::sqrt(normalizedPan * 0.5f) * std::sqrt(2.0f);
                 break;
         }
+
+        leftGain.setValue(left);
+        rightGain.setValue(right);
     }
 };
 
@@ -42,6 +62,8 @@ PanNode::PanNode()
     static int instanceCounter = 0;
     m_impl->nodeId = "PanNode_" + std::to_string(++instanceCounter);
     m_impl->updateGains();
+    m_impl->leftGain.resetSmoothing();
+    m_impl->rightGain.resetSmoothing();
 }
 
 PanNode::~PanNode() = default;
@@ -57,9 +79,34 @@ void PanNode::process(const float* inputBuffer, float* outputBuffer,
         return;
     }
 
-    for (std::uint32_t i = 0; i < numFrames; ++i) {
-        outputBuffer[i * 2] = inputBuffer[i * 2] * m_impl->leftGain;
-        outputBuffer[i * 2 + 1] = inputBuffer[i * 2 + 1] * m_impl->rightGain;
+    FloatParameter& leftGain = m_impl->leftGain;
+    FloatParameter& rightGain = m_impl->rightGain;
+
+    if (!leftGain.isSmoothing() && !rightGain.isSmoothing()) {
+        const float left = leftGain.getValue();
+        const float right = rightGain.getValue();
+        for (std::uint32_t i = 0; i < numFrames; ++i) {
+            outputBuffer[i * 2] = inputBuffer[i * 2] * left;
+            outputBuffer[i * 2 + 1] = inputBuffer[i * 2 + 1] * right;
+        }
+        return;
+    }
+
+    float* lefts = m_impl->leftBuffer.data();
+    float* rights = m_impl->rightBuffer.data();
+    const auto chunkFrames = static_cast<std::uint32_t>(m_impl->leftBuffer.size());
+
+    for (std::uint32_t start = 0; start < numFrames; start += chunkFrames) {
+        const std::uint32_t frames = std::min(chunkFrames, numFrames - start);
+        leftGain.fillSmoothedBlock(lefts, frames);
+        rightGain.fillSmoothedBlock(rights, frames);
+
+        const float* in = inputBuffer + start * 2;
+        float* out = outputBuffer + start * 2;
+        for (std::uint32_t i = 0; i < frames; ++i) {
+            out[i * 2] = in[i * 2] * lefts[i];
+            out[i * 2 + 1] = in[i * 2 + 1] * rights[i];
+        }
     }
 }
 
@@ -67,12 +114,18 @@ void PanNode::prepare(double sampleRate, std::uint32_t blockSize)
 {
     m_impl->sampleRate = sampleRate;
     m_impl->blockSize = blockSize;
+    m_impl->leftBuffer.assign(std::max<std::uint32_t>(blockSize, 1), 0.0f);
+    m_impl->rightBuffer.assign(std::max<std::uint32_t>(blockSize, 1), 0.0f);
+    m_impl->leftGain.setSampleRate(static_cast<float>(sampleRate));
+    m_impl->rightGain.setSampleRate(static_cast<float>(sampleRate));
 }
 
 void PanNode::reset()
 {
     m_impl->pan = m_impl->targetPan;
     m_impl->updateGains();
+    m_impl->leftGain.resetSmoothing();
+    m_impl->rightGain.resetSmoothing();
 }
 
 std::string PanNode::getNodeId() const { return m_impl->nodeId; }
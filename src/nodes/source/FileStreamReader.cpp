@@ -1,4 +1,5 @@
 #include "FileStreamReader.h"
+#include "../../core/memory/MultiChannelRingBuffer.h"
 #include <algorithm>
 
 namespace nap {
@@ -17,6 +18,11 @@ public:
     bool active = false;
     bool fileLoaded = false;
     bool looping = false;
+
+    // Decoded frames waiting to be played; holds several blocks of headroom
+    // so the decoder thread can run ahead of the audio thread.
+    static constexpr std::uint32_t kStreamBlocks = 8;
+    std::unique_ptr<MultiChannelRingBuffer> streamBuffer;
 };
 
 FileStreamReader::FileStreamReader()
@@ -44,19 +50,32 @@ void FileStreamReader::generate(float* outputBuffer, std::uint32_t numFrames, st
         return;
     }
 
-    // TODO: Implement actual file streaming
-    std::fill(outputBuffer, outputBuffer + numFrames * numChannels, 0.0f);
+    std::uint32_t framesRead = 0;
+    if (m_impl->streamBuffer && m_impl->streamBuffer->getNumChannels() == numChannels) {
+        framesRead = static_cast<std::uint32_t>(
+            m_impl->streamBuffer->readInterleaved(outputBuffer, numFrames));
+    }
+
+    // Underrun: the decoder has not caught up, output silence for the rest
+    std::fill(outputBuffer + framesRead * numChannels,
+              outputBuffer + numFrames * numChannels, 0.0f);
+    m_impl->currentPosition += framesRead;
 }
 
 void FileStreamReader::prepare(double sampleRate, std::uint32_t blockSize)
 {
     m_impl->sampleRate = sampleRate;
     m_impl->blockSize = blockSize;
+    m_impl->streamBuffer = std::make_unique<MultiChannelRingBuffer>(
+        getNumOutputChannels(), static_cast<std::size_t>(blockSize) * Impl::kStreamBlocks);
 }
 
 void FileStreamReader::reset()
 {
     m_impl->currentPosition = 0;
+    if (m_impl->streamBuffer) {
+        m_impl->streamBuffer->clear();
+    }
 }
 
 std::string FileStreamReader::getNodeId() const { return m_impl->nodeId; }
@@ -110,5 +129,6 @@ double FileStreamReader::getFileSampleRate() const { return m_impl->fileSampleRa
 std::uint32_t FileStreamReader::getFileChannels() const { return m_impl->fileChannels; }
 void FileStreamReader::setLooping(bool loop) { m_impl->looping = loop; }
 bool FileStreamReader::isLooping() const { return m_impl->looping; }
+MultiChannelRingBuffer* FileStreamReader::getStreamBuffer() { return m_impl->streamBuffer.get(); }
 
 } // namespace nap
@@ -8,6 +8,8 @@
 
 namespace nap {
 
+class MultiChannelRingBuffer;
+
 /**
  * @brief Audio source node that streams audio from a file.
  */
@@ -54,6 +56,16 @@ public:
     void setLooping(bool loop);
     bool isLooping() const;
 
+    /**
+     * @brief Get the ring buffer the decoder thread streams frames into.
+     *
+     * The decoder is the single producer and writes whole frames, e.g. with
+     * prepareWrite()/commitWrite(); generate() is the single consumer.
+     * Allocated in prepare().
+     * @return The stream buffer, or nullptr before prepare()
+     */
+    MultiChannelRingBuffer* getStreamBuffer();
+
 private:
     class Impl;
     std::unique_ptr<Impl> m_impl;
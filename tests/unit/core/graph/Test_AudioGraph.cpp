@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include "../../../../src/core/graph/AudioGraph.h"
 #include "../../../../src/nodes/math/GainNode.h"
+#include "../../../../src/events/ClockCorrelator.h"
+#include "../../../../src/events/MidiEventBus.h"
 
 namespace nap {
 namespace test {
@@ -47,5 +49,33 @@ TEST_F(AudioGraphTest, CanConnectNodes) {
     EXPECT_TRUE(graph->connect(gain1->getNodeId(), 0, gain2->getNodeId(), 0));
 }
 
+TEST_F(AudioGraphTest, ProcessBlockDrainsMidiInputs) {
+    graph->prepare(48000.0, 480);
+    events::MidiEventQueue* input = graph->getMidiBus().addInput(8);
+    ASSERT_NE(input, nullptr);
+
+    events::MidiMessage note = events::MidiMessage::noteOn(0, 64, 90);
+    note.setTimestamp(1000000 + 5000);
+    input->push(note);
+
+    graph->processBlock(480, 1000000);
+    ASSERT_EQ(graph->getMidiBus().getEventCount(), 1u);
+    EXPECT_EQ(graph->getMidiBus().getEvents()[0].sampleOffset, 240u);
+}
+
+TEST_F(AudioGraphTest, CorrelatorFollowsDriverStreamPosition) {
+    graph->prepare(48000.0, 480);
+
+    // The driver started long before the graph; its position is what counts
+    const std::uint64_t driverStart = 10000000;
+    for (std::uint64_t block = 0; block < 4; ++block) {
+        graph->setStreamPosition(driverStart + block * 480);
+        graph->processBlock(480);
+    }
+
+    const double position = graph->getClockCorrelator().samplePositionAt(events::MidiEventBus::now());
+    EXPECT_GE(position, static_cast<double>(driverStart));
+}
+
 } // namespace test
 } // namespace nap
@@ -45,5 +45,49 @@ TEST_F(CircularBufferTest, PeekDoesNotRemoveData) {
     EXPECT_EQ(buffer->getAvailableForRead(), 2);
 }
 
+TEST_F(CircularBufferTest, PrepareWriteThenCommitPublishesSamples) {
+    auto region = buffer->prepareWrite(3);
+    ASSERT_EQ(region.size(), 3u);
+    EXPECT_EQ(region.second.size, 0u);
+    region.first.data[0] = 1.0f;
+    region.first.data[1] = 2.0f;
+    region.first.data[2] = 3.0f;
+
+    EXPECT_TRUE(buffer->isEmpty());
+    EXPECT_EQ(buffer->commitWrite(3), 3u);
+    EXPECT_EQ(buffer->getAvailableForRead(), 3u);
+
+    float output[3];
+    buffer->read(output, 3);
+    EXPECT_FLOAT_EQ(output[0], 1.0f);
+    EXPECT_FLOAT_EQ(output[2], 3.0f);
+}
+
+TEST_F(CircularBufferTest, PrepareReadSplitsAcrossWrapAround) {
+    CircularBuffer small(8);
+    float data[] = {0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f};
+    small.write(data, 6);
+    small.skip(6);
+    small.write(data, 5);
+
+    auto region = small.prepareRead(5);
+    ASSERT_EQ(region.size(), 5u);
+    EXPECT_EQ(region.first.size, 2u);
+    EXPECT_EQ(region.second.size, 3u);
+    EXPECT_FLOAT_EQ(region.first.data[0], 0.0f);
+    EXPECT_FLOAT_EQ(region.second.data[0], 2.0f);
+
+    EXPECT_EQ(small.commitRead(5), 5u);
+    EXPECT_TRUE(small.isEmpty());
+}
+
+TEST_F(CircularBufferTest, PrepareWriteIsLimitedByFreeSpace) {
+    CircularBuffer small(4);
+    auto region = small.prepareWrite(10);
+    EXPECT_EQ(region.size(), 3u);
+    EXPECT_EQ(small.commitWrite(10), 3u);
+    EXPECT_TRUE(small.prepareWrite(1).empty());
+}
+
 } // namespace test
 } // namespace nap
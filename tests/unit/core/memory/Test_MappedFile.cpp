@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include "../../../../src/core/memory/MappedFile.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+namespace nap {
+namespace test {
+
+class MappedFileTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path = ::testing::TempDir() + "nap_mapped_file_test.bin";
+    }
+
+    void TearDown() override {
+        std::remove(path.c_str());
+    }
+
+    void writeFile(const std::string& contents) {
+        std::ofstream file(path, std::ios::binary);
+        file << contents;
+    }
+
+    std::string path;
+};
+
+TEST_F(MappedFileTest, InitialStateIsClosed) {
+    MappedFile file;
+    EXPECT_FALSE(file.isOpen());
+    EXPECT_EQ(file.data(), nullptr);
+    EXPECT_EQ(file.size(), 0u);
+}
+
+TEST_F(MappedFileTest, ExposesFileContents) {
+    writeFile("mapped contents");
+
+    MappedFile file;
+    ASSERT_TRUE(file.open(path)) << file.getLastError();
+    EXPECT_TRUE(file.isOpen());
+    ASSERT_EQ(file.size(), 15u);
+    EXPECT_EQ(std::string(reinterpret_cast<const char*>(file.data()), file.size()), "mapped contents");
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(file.data()) % 16, 0u);
+
+    file.close();
+    EXPECT_FALSE(file.isOpen());
+    EXPECT_EQ(file.data(), nullptr);
+}
+
+TEST_F(MappedFileTest, EmptyFileOpensWithNoData) {
+    writeFile("");
+
+    MappedFile file;
+    EXPECT_TRUE(file.open(path));
+    EXPECT_EQ(file.size(), 0u);
+    EXPECT_EQ(file.data(), nullptr);
+}
+
+TEST_F(MappedFileTest, MissingFileFails) {
+    MappedFile file;
+    EXPECT_FALSE(file.open(path + ".missing"));
+    EXPECT_FALSE(file.isOpen());
+    EXPECT_FALSE(file.getLastError().empty());
+}
+
+TEST_F(MappedFileTest, MoveTransfersMapping) {
+    writeFile("abc");
+
+    MappedFile first;
+    ASSERT_TRUE(first.open(path));
+    const std::uint8_t* data = first.data();
+
+    MappedFile second(std::move(first));
+    EXPECT_EQ(second.data(), data);
+    EXPECT_EQ(second.size(), 3u);
+}
+
+} // namespace test
+} // namespace nap
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include "../../../../src/core/memory/MultiChannelRingBuffer.h"
+#include <vector>
+
+namespace nap {
+namespace test {
+
+class MultiChannelRingBufferTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        buffer = std::make_unique<MultiChannelRingBuffer>(2, 8);
+    }
+
+    std::unique_ptr<MultiChannelRingBuffer> buffer;
+};
+
+TEST_F(MultiChannelRingBufferTest, InitialStateIsEmpty) {
+    EXPECT_TRUE(buffer->isEmpty());
+    EXPECT_EQ(buffer->getNumChannels(), 2u);
+    EXPECT_EQ(buffer->getCapacity(), 8u);
+    EXPECT_EQ(buffer->getAvailableForWrite(), 8u);
+}
+
+TEST_F(MultiChannelRingBufferTest, InterleavedRoundTrip) {
+    float frames[] = {1.0f, -1.0f, 2.0f, -2.0f, 3.0f, -3.0f};
+    EXPECT_EQ(buffer->writeInterleaved(frames, 3), 3u);
+    EXPECT_EQ(buffer->getAvailableForRead(), 3u);
+
+    float output[6] = {};
+    EXPECT_EQ(buffer->readInterleaved(output, 3), 3u);
+    for (int i = 0; i < 6; ++i) {
+        EXPECT_FLOAT_EQ(output[i], frames[i]);
+    }
+}
+
+TEST_F(MultiChannelRingBufferTest, StoresChannelsPlanar) {
+    float frames[] = {1.0f, 10.0f, 2.0f, 20.0f};
+    buffer->writeInterleaved(frames, 2);
+
+    EXPECT_FLOAT_EQ(buffer->getChannelData(0)[0], 1.0f);
+    EXPECT_FLOAT_EQ(buffer->getChannelData(0)[1], 2.0f);
+    EXPECT_FLOAT_EQ(buffer->getChannelData(1)[0], 10.0f);
+    EXPECT_FLOAT_EQ(buffer->getChannelData(1)[1], 20.0f);
+    EXPECT_EQ(buffer->getChannelData(2), nullptr);
+}
+
+TEST_F(MultiChannelRingBufferTest, PlanarRoundTripAcrossWrapAround) {
+    std::vector<float> left(6), right(6);
+    for (int i = 0; i < 6; ++i) {
+        left[i] = static_cast<float>(i);
+        right[i] = static_cast<float>(-i);
+    }
+    const float* in[] = {left.data(), right.data()};
+
+    buffer->writePlanar(in, 6);
+    float scratchL[6], scratchR[6];
+    float* scratch[] = {scratchL, scratchR};
+    buffer->readPlanar(scratch, 6);
+
+    EXPECT_EQ(buffer->writePlanar(in, 6), 6u);
+    auto region = buffer->prepareRead(6);
+    EXPECT_GT(region.secondFrames, 0u);
+
+    float outL[6], outR[6];
+    float* out[] = {outL, outR};
+    EXPECT_EQ(buffer->readPlanar(out, 6), 6u);
+    for (int i = 0; i < 6; ++i) {
+        EXPECT_FLOAT_EQ(outL[i], left[i]);
+        EXPECT_FLOAT_EQ(outR[i], right[i]);
+    }
+}
+
+TEST_F(MultiChannelRingBufferTest, WritesAreLimitedToWholeFramesOfFreeSpace) {
+    std::vector<float> frames(2 * 10, 1.0f);
+    EXPECT_EQ(buffer->writeInterleaved(frames.data(), 10), 8u);
+    EXPECT_EQ(buffer->getAvailableForWrite(), 0u);
+    EXPECT_TRUE(buffer->prepareWrite(1).empty());
+}
+
+TEST_F(MultiChannelRingBufferTest, PrepareWriteCommitPublishesInPlaceFrames) {
+    auto region = buffer->prepareWrite(2);
+    ASSERT_EQ(region.size(), 2u);
+    buffer->getChannelData(0)[region.firstStart] = 0.5f;
+    buffer->getChannelData(1)[region.firstStart] = -0.5f;
+    buffer->getChannelData(0)[region.firstStart + 1] = 0.25f;
+    buffer->getChannelData(1)[region.firstStart + 1] = -0.25f;
+
+    EXPECT_TRUE(buffer->isEmpty());
+    EXPECT_EQ(buffer->commitWrite(2), 2u);
+
+    float output[4];
+    buffer->readInterleaved(output, 2);
+    EXPECT_FLOAT_EQ(output[0], 0.5f);
+    EXPECT_FLOAT_EQ(output[1], -0.5f);
+    EXPECT_FLOAT_EQ(output[3], -0.25f);
+}
+
+} // namespace test
+} // namespace nap
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include "core/modulation/ModulationMatrix.h"
+#include "core/parameters/FloatParameter.h"
+#include <cmath>
+
+namespace nap {
+namespace test {
+
+class ModulationMatrixTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        matrix.prepare(1000.0, 64);
+    }
+
+    ModulationMatrix matrix;
+};
+
+TEST_F(ModulationMatrixTest, TargetWithoutRoutesHoldsBase) {
+    auto target = matrix.addTarget("Pan", -1.0f, 1.0f, 0.25f);
+    matrix.process(16);
+
+    auto values = matrix.getTargetValues(target);
+    ASSERT_EQ(values.size, 16u);
+    EXPECT_FLOAT_EQ(values[0], 0.25f);
+    EXPECT_FLOAT_EQ(values[15], 0.25f);
+}
+
+TEST_F(ModulationMatrixTest, SineLfoTracksReference) {
+    auto lfo = matrix.addLfo("LFO", 10.0f);
+    auto target = matrix.addTarget("Out", -1.0f, 1.0f, 0.0f);
+    matrix.addRoute(lfo, target, 0.5f);  // Half of a range of 2 -> unit amplitude
+
+    for (int block = 0; block < 4; ++block) {
+        matrix.process(64);
+        auto values = matrix.getTargetValues(target);
+        for (size_t i = 0; i < values.size; ++i) {
+            const double t = (block * 64 + static_cast<double>(i)) / 1000.0;
+            EXPECT_NEAR(values[i], std::sin(2.0 * 3.14159265358979 * 10.0 * t), 0.002);
+        }
+    }
+}
+
+TEST_F(ModulationMatrixTest, RoutesSumAndClampToRange) {
+    auto a = matrix.addSource("A");
+    auto b = matrix.addSource("B");
+    auto target = matrix.addTarget("Cutoff", 0.0f, 100.0f, 50.0f);
+    matrix.addRoute(a, target, 0.1f);
+    auto routeB = matrix.addRoute(b, target, 0.2f, ModulationMatrix::Curve::Unipolar);
+
+    float* bufA = matrix.getSourceBuffer(a);
+    float* bufB = matrix.getSourceBuffer(b);
+    bufA[0] = 1.0f;  bufB[0] = -1.0f;   // 50 + 10 + 0
+    bufA[1] = 1.0f;  bufB[1] = 1.0f;    // 50 + 10 + 20
+    bufA[2] = 5.0f;  bufB[2] = 1.0f;    // Clamped to 100
+    matrix.process(3);
+
+    auto values = matrix.getTargetValues(target);
+    EXPECT_FLOAT_EQ(values[0], 60.0f);
+    EXPECT_FLOAT_EQ(values[1], 80.0f);
+    EXPECT_FLOAT_EQ(values[2], 100.0f);
+
+    matrix.removeRoute(routeB);
+    EXPECT_EQ(matrix.getRouteCount(), 1u);
+    matrix.process(3);
+    EXPECT_FLOAT_EQ(matrix.getTargetValues(target)[1], 60.0f);
+}
+
+TEST_F(ModulationMatrixTest, ParameterTargetUsesParameterBaseAndRange) {
+    FloatParameter depth("Depth", 0.5f, 0.0f, 1.0f);
+    auto source = matrix.addSource("Env");
+    auto target = matrix.addTarget(&depth);
+    matrix.addRoute(source, target, 1.0f, ModulationMatrix::Curve::Squared);
+    EXPECT_EQ(matrix.findTarget("Depth"), target);
+
+    matrix.getSourceBuffer(source)[0] = -0.5f;
+    depth.setValue(0.8f);
+    matrix.process(1);
+
+    EXPECT_FLOAT_EQ(matrix.getTargetValues(target)[0], 0.55f);
+}
+
+TEST_F(ModulationMatrixTest, SharedLfoFeedsSeveralTargets) {
+    auto lfo = matrix.addLfo("LFO", 2.0f, ModulationMatrix::LfoShape::Saw);
+    auto first = matrix.addTarget("First", -1.0f, 1.0f, 0.0f);
+    auto second = matrix.addTarget("Second", -1.0f, 1.0f, 0.0f);
+    matrix.addRoute(lfo, first, 0.5f);
+    matrix.addRoute(lfo, second, -0.5f);
+
+    matrix.process(32);
+    auto a = matrix.getTargetValues(first);
+    auto b = matrix.getTargetValues(second);
+    for (size_t i = 0; i < a.size; ++i) {
+        EXPECT_FLOAT_EQ(a[i], -b[i]);
+    }
+}
+
+TEST_F(ModulationMatrixTest, InvalidIdsAreRejected) {
+    EXPECT_EQ(matrix.addRoute(0, 0, 1.0f), ModulationMatrix::kInvalidId);
+    EXPECT_EQ(matrix.getSourceBuffer(3), nullptr);
+    EXPECT_TRUE(matrix.getTargetValues(7).empty());
+}
+
+} // namespace test
+} // namespace nap
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include "core/parameters/AutomationCurve.h"
+
+namespace nap {
+namespace test {
+
+class AutomationCurveTest : public ::testing::Test {
+protected:
+    AutomationCurve curve;
+};
+
+TEST_F(AutomationCurveTest, EmptyCurveEvaluatesToZero) {
+    EXPECT_TRUE(curve.isEmpty());
+    EXPECT_FLOAT_EQ(curve.getValueAt(1.0), 0.0f);
+    EXPECT_DOUBLE_EQ(curve.getDuration(), 0.0);
+}
+
+TEST_F(AutomationCurveTest, BreakpointsAreKeptSorted) {
+    curve.addBreakpoint(2.0, 0.2f);
+    curve.addBreakpoint(0.0, 0.0f);
+    EXPECT_EQ(curve.addBreakpoint(1.0, 0.1f), 1u);
+
+    ASSERT_EQ(curve.getBreakpointCount(), 3u);
+    EXPECT_DOUBLE_EQ(curve.getBreakpoint(0).time, 0.0);
+    EXPECT_DOUBLE_EQ(curve.getBreakpoint(1).time, 1.0);
+    EXPECT_DOUBLE_EQ(curve.getBreakpoint(2).time, 2.0);
+    EXPECT_DOUBLE_EQ(curve.getDuration(), 2.0);
+}
+
+TEST_F(AutomationCurveTest, HoldsOutsideBreakpointRange) {
+    curve.addBreakpoint(1.0, 0.25f);
+    curve.addBreakpoint(2.0, 0.75f);
+
+    EXPECT_FLOAT_EQ(curve.getValueAt(0.0), 0.25f);
+    EXPECT_FLOAT_EQ(curve.getValueAt(5.0), 0.75f);
+    EXPECT_EQ(curve.findSegment(0.5), curve.getBreakpointCount());
+}
+
+TEST_F(AutomationCurveTest, EvaluatesEachShape) {
+    curve.addBreakpoint(0.0, 0.0f, AutomationCurve::Shape::Linear);
+    curve.addBreakpoint(1.0, 1.0f, AutomationCurve::Shape::Exponential);
+    curve.addBreakpoint(2.0, 100.0f, AutomationCurve::Shape::Hold);
+    curve.addBreakpoint(3.0, 5.0f);
+
+    EXPECT_FLOAT_EQ(curve.getValueAt(0.5), 0.5f);
+    EXPECT_NEAR(curve.getValueAt(1.5), 10.0f, 1e-4f);
+    EXPECT_FLOAT_EQ(curve.getValueAt(2.99), 100.0f);
+    EXPECT_FLOAT_EQ(curve.getValueAt(3.0), 5.0f);
+}
+
+TEST_F(AutomationCurveTest, ExponentialThroughZeroFallsBackToLinear) {
+    curve.addBreakpoint(0.0, -1.0f, AutomationCurve::Shape::Exponential);
+    curve.addBreakpoint(1.0, 1.0f);
+
+    EXPECT_FLOAT_EQ(curve.getValueAt(0.5), 0.0f);
+}
+
+TEST_F(AutomationCurveTest, CoincidentBreakpointsProduceJump) {
+    curve.addBreakpoint(0.0, 0.0f);
+    curve.addBreakpoint(1.0, 1.0f);
+    curve.addBreakpoint(1.0, 0.0f);
+    curve.addBreakpoint(2.0, 0.0f);
+
+    EXPECT_NEAR(curve.getValueAt(0.999), 1.0f, 0.01f);
+    EXPECT_FLOAT_EQ(curve.getValueAt(1.0), 0.0f);
+}
+
+} // namespace test
+} // namespace nap
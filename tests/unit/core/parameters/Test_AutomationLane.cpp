@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include "core/parameters/AutomationLane.h"
+#include "core/parameters/FloatParameter.h"
+#include <vector>
+
+namespace nap {
+namespace test {
+
+class AutomationLaneTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        curve = std::make_shared<AutomationCurve>();
+        lane = std::make_unique<AutomationLane>(&param);
+        lane->prepare(1000.0);
+    }
+
+    FloatParameter param{"Cutoff", 0.5f, 0.0f, 10.0f};
+    std::shared_ptr<AutomationCurve> curve;
+    std::unique_ptr<AutomationLane> lane;
+};
+
+TEST_F(AutomationLaneTest, WithoutCurveFillsParameterValue) {
+    std::vector<float> block(8);
+    lane->renderBlock(0, block.data(), block.size());
+    for (float v : block) {
+        EXPECT_FLOAT_EQ(v, 0.5f);
+    }
+}
+
+TEST_F(AutomationLaneTest, RendersLinearRampPerSample) {
+    curve->addBreakpoint(0.0, 0.0f);
+    curve->addBreakpoint(0.010, 1.0f);  // 10 samples at 1 kHz
+    lane->setCurve(curve);
+
+    std::vector<float> block(16);
+    lane->renderBlock(0, block.data(), block.size());
+
+    EXPECT_FLOAT_EQ(block[0], 0.0f);
+    EXPECT_NEAR(block[5], 0.5f, 1e-6f);
+    EXPECT_NEAR(block[9], 0.9f, 1e-6f);
+    EXPECT_FLOAT_EQ(block[10], 1.0f);
+    EXPECT_FLOAT_EQ(block[15], 1.0f);
+    EXPECT_FLOAT_EQ(lane->getLastValue(), 1.0f);
+}
+
+TEST_F(AutomationLaneTest, MatchesPointEvaluationAcrossShapes) {
+    curve->addBreakpoint(0.0, 1.0f, AutomationCurve::Shape::Exponential);
+    curve->addBreakpoint(0.1, 8.0f, AutomationCurve::Shape::Hold);
+    curve->addBreakpoint(0.15, 2.0f, AutomationCurve::Shape::Linear);
+    curve->addBreakpoint(0.3, 4.0f);
+    lane->setCurve(curve);
+
+    std::vector<float> block(64);
+    for (std::uint64_t start = 0; start < 400; start += block.size()) {
+        lane->renderBlock(start, block.data(), block.size());
+        for (size_t i = 0; i < block.size(); ++i) {
+            const double time = static_cast<double>(start + i) / 1000.0;
+            EXPECT_NEAR(block[i], curve->getValueAt(time), 1e-3f) << "sample " << start + i;
+        }
+    }
+}
+
+TEST_F(AutomationLaneTest, SequentialPlaybackAvoidsSearches) {
+    for (int i = 0; i <= 100; ++i) {
+        curve->addBreakpoint(i * 0.01, static_cast<float>(i % 2));
+    }
+    lane->setCurve(curve);
+
+    std::vector<float> block(32);
+    for (std::uint64_t start = 0; start < 1000; start += block.size()) {
+        lane->renderBlock(start, block.data(), block.size());
+    }
+    EXPECT_LE(lane->getSegmentSearchCount(), 1u);
+
+    // A seek costs one search
+    lane->renderBlock(500, block.data(), block.size());
+    EXPECT_LE(lane->getSegmentSearchCount(), 2u);
+}
+
+TEST_F(AutomationLaneTest, ClampsToTargetRange) {
+    curve->addBreakpoint(0.0, -5.0f);
+    curve->addBreakpoint(1.0, 50.0f);
+    lane->setCurve(curve);
+
+    float value;
+    lane->renderBlock(0, &value, 1);
+    EXPECT_FLOAT_EQ(value, 0.0f);
+    lane->renderBlock(999, &value, 1);
+    EXPECT_FLOAT_EQ(value, 10.0f);
+}
+
+TEST_F(AutomationLaneTest, DisabledLaneFollowsParameter) {
+    curve->addBreakpoint(0.0, 3.0f);
+    lane->setCurve(curve);
+    lane->setEnabled(false);
+    param.setValue(7.0f);
+
+    float value;
+    lane->renderBlock(0, &value, 1);
+    EXPECT_FLOAT_EQ(value, 7.0f);
+}
+
+} // namespace test
+} // namespace nap
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "core/parameters/FloatParameter.h"
+#include <vector>
 
 namespace nap {
 namespace test {
@@ -100,5 +101,85 @@ TEST_F(FloatParameterTest, CustomRange) {
     EXPECT_FLOAT_EQ(customParam.getMaxValue(), 20000.0f);
 }
 
+TEST_F(FloatParameterTest, SettledBlockIsConstant) {
+    param->enableSmoothing(true, 0.01f);
+    std::vector<float> block(64, -1.0f);
+    param->fillSmoothedBlock(block.data(), block.size());
+
+    EXPECT_FALSE(param->isSmoothing());
+    for (float v : block) {
+        EXPECT_FLOAT_EQ(v, 0.5f);
+    }
+}
+
+TEST_F(FloatParameterTest, LinearRampReachesTargetInSmoothingTime) {
+    param->setSampleRate(1000.0f);
+    param->setSmoothingMode(FloatParameter::SmoothingMode::Linear);
+    param->enableSmoothing(true, 0.01f);  // 10 samples
+    param->setValue(1.0f);
+
+    std::vector<float> block(16);
+    param->fillSmoothedBlock(block.data(), block.size());
+
+    EXPECT_FLOAT_EQ(block[0], 0.55f);
+    EXPECT_FLOAT_EQ(block[4], 0.75f);
+    EXPECT_FLOAT_EQ(block[9], 1.0f);
+    EXPECT_FLOAT_EQ(block[15], 1.0f);
+    EXPECT_FALSE(param->isSmoothing());
+}
+
+TEST_F(FloatParameterTest, MultiplicativeRampHasConstantRatio) {
+    FloatParameter freq("Frequency", 100.0f, 20.0f, 20000.0f);
+    freq.setSampleRate(1000.0f);
+    freq.setSmoothingMode(FloatParameter::SmoothingMode::Multiplicative);
+    freq.enableSmoothing(true, 0.004f);  // 4 samples
+    freq.setValue(1600.0f);
+
+    float block[4];
+    freq.fillSmoothedBlock(block, 4);
+
+    EXPECT_NEAR(block[0], 200.0f, 0.01f);
+    EXPECT_NEAR(block[1], 400.0f, 0.02f);
+    EXPECT_NEAR(block[2], 800.0f, 0.05f);
+    EXPECT_FLOAT_EQ(block[3], 1600.0f);
+}
+
+TEST_F(FloatParameterTest, OnePoleBlockConvergesAndSettles) {
+    param->setSampleRate(48000.0f);
+    param->enableSmoothing(true, 0.001f);
+    param->setValue(1.0f);
+
+    std::vector<float> block(256);
+    param->fillSmoothedBlock(block.data(), block.size());
+    for (size_t i = 1; i < block.size(); ++i) {
+        EXPECT_GE(block[i], block[i - 1]);
+    }
+    EXPECT_GT(block[0], 0.5f);
+
+    for (int i = 0; i < 20 && param->isSmoothing(); ++i) {
+        param->fillSmoothedBlock(block.data(), block.size());
+    }
+    EXPECT_FALSE(param->isSmoothing());
+
+    param->fillSmoothedBlock(block.data(), block.size());
+    EXPECT_EQ(block.front(), 1.0f);
+}
+
+TEST_F(FloatParameterTest, BlockContinuesAcrossCalls) {
+    param->setSampleRate(1000.0f);
+    param->setSmoothingMode(FloatParameter::SmoothingMode::Linear);
+    param->enableSmoothing(true, 0.01f);
+    param->setValue(1.0f);
+
+    float first[5];
+    float second[5];
+    param->fillSmoothedBlock(first, 5);
+    param->fillSmoothedBlock(second, 5);
+
+    EXPECT_FLOAT_EQ(first[4], 0.75f);
+    EXPECT_FLOAT_EQ(second[0], 0.8f);
+    EXPECT_FLOAT_EQ(second[4], 1.0f);
+}
+
 } // namespace test
 } // namespace nap
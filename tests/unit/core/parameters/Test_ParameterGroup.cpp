@@ -2,6 +2,14 @@
 #include "core/parameters/ParameterGroup.h"
 #include "core/parameters/FloatParameter.h"
 #include "core/parameters/BoolParameter.h"
+#include "core/parameters/EnumParameter.h"
+#include "core/parameters/IntParameter.h"
+#include "core/parameters/TriggerParameter.h"
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace nap {
 namespace test {
@@ -129,5 +137,268 @@ TEST_F(ParameterGroupTest, DuplicateParameterIgnored) {
     EXPECT_EQ(group->getParameterCount(), 1u);
 }
 
+TEST_F(ParameterGroupTest, HandlesAreStableAcrossRemoval) {
+    group->addParameter(std::make_shared<FloatParameter>("A", 0.0f));
+    group->addParameter(std::make_shared<FloatParameter>("B", 0.0f));
+
+    ParameterHandle a = group->getHandle("A");
+    ParameterHandle b = group->getHandle("B");
+    EXPECT_NE(a, b);
+    EXPECT_EQ(group->getHandle("Missing"), kInvalidParameterHandle);
+
+    group->removeParameter("A");
+    EXPECT_EQ(group->getParameter(a), nullptr);
+    ASSERT_NE(group->getParameter(b), nullptr);
+    EXPECT_EQ(group->getParameter(b)->getName(), "B");
+
+    group->addParameter(std::make_shared<FloatParameter>("C", 0.0f));
+    EXPECT_NE(group->getHandle("C"), a);
+}
+
+TEST_F(ParameterGroupTest, ChangesQueuedForRemovedParameterAreDropped) {
+    group->addParameter(std::make_shared<FloatParameter>("A", 0.0f));
+    const ParameterHandle a = group->getHandle("A");
+
+    int notified = 0;
+    group->setNotificationCallback([&](const ParameterNotification*, size_t count) {
+        notified += static_cast<int>(count);
+    });
+
+    ASSERT_TRUE(group->pushChange(a, 0.75f));
+    group->removeParameter("A");
+    auto replacement = std::make_shared<FloatParameter>("B", 0.0f);
+    group->addParameter(replacement);
+
+    EXPECT_EQ(group->processChanges(), 1u);
+    EXPECT_FLOAT_EQ(replacement->getValue(), 0.0f);
+    EXPECT_EQ(group->dispatchNotifications(), 0u);
+    EXPECT_EQ(notified, 0);
+}
+
+TEST_F(ParameterGroupTest, AddingParametersNeverMovesAttachedValues) {
+    auto first = std::make_shared<FloatParameter>("First", 0.25f);
+    group->addParameter(first);
+
+    // An audio-thread reader keeps reading while enough parameters are added
+    // to need several value blocks
+    std::atomic<bool> done{false};
+    std::atomic<int> badReads{0};
+    std::thread reader([&] {
+        while (!done.load()) {
+            if (first->getValue() != 0.25f) ++badReads;
+        }
+    });
+    for (int i = 0; i < 300; ++i) {
+        group->addParameter(std::make_shared<FloatParameter>("P" + std::to_string(i), 0.0f));
+    }
+    done = true;
+    reader.join();
+    EXPECT_EQ(badReads.load(), 0);
+
+    first->setValue(0.5f);
+    EXPECT_FLOAT_EQ(group->getValue(group->getHandle("First")), 0.5f);
+}
+
+TEST_F(ParameterGroupTest, QueuedChangesApplyOnProcessWithoutCallbacks) {
+    auto gain = std::make_shared<FloatParameter>("Gain", 0.5f);
+    int callbackCount = 0;
+    gain->setChangeCallback([&](float, float) { ++callbackCount; });
+    group->addParameter(gain);
+
+    ParameterHandle handle = group->getHandle("Gain");
+    EXPECT_TRUE(group->pushChange(handle, 0.25f, 32));
+    EXPECT_FLOAT_EQ(gain->getValue(), 0.5f);
+    EXPECT_EQ(group->getPendingChangeCount(), 1u);
+
+    ParameterChange applied[4];
+    EXPECT_EQ(group->processChanges(applied, 4), 1u);
+    EXPECT_FLOAT_EQ(gain->getValue(), 0.25f);
+    EXPECT_EQ(applied[0].handle, handle);
+    EXPECT_EQ(applied[0].sampleOffset, 32u);
+    EXPECT_EQ(callbackCount, 0);
+}
+
+TEST_F(ParameterGroupTest, NotificationsAreBatchedAndCoalesced) {
+    group->addParameter(std::make_shared<FloatParameter>("Gain", 0.5f));
+    group->addParameter(std::make_shared<BoolParameter>("Bypass", false));
+    group->addParameter(std::make_shared<TriggerParameter>("Reset"));
+
+    ParameterHandle gain = group->getHandle("Gain");
+    group->pushChange(gain, 0.1f);
+    group->pushChange(gain, 0.2f);
+    group->pushChange(gain, 0.3f);
+    group->pushChange(group->getHandle("Bypass"), 1.0f);
+    group->pushChange(group->getHandle("Reset"), 1.0f);
+    EXPECT_EQ(group->processChanges(), 5u);
+
+    std::vector<ParameterNotification> received;
+    int batches = 0;
+    group->setNotificationCallback([&](const ParameterNotification* notifications, size_t count) {
+        ++batches;
+        received.assign(notifications, notifications + count);
+    });
+
+    EXPECT_EQ(group->dispatchNotifications(), 3u);
+    EXPECT_EQ(batches, 1);
+    ASSERT_EQ(received.size(), 3u);
+    EXPECT_EQ(received[0].handle, gain);
+    EXPECT_FLOAT_EQ(received[0].oldValue, 0.5f);
+    EXPECT_FLOAT_EQ(received[0].newValue, 0.3f);
+    EXPECT_TRUE(static_cast<TriggerParameter*>(group->getParameter("Reset"))->isPending());
+
+    EXPECT_EQ(group->dispatchNotifications(), 0u);
+    EXPECT_EQ(batches, 1);
+}
+
+TEST_F(ParameterGroupTest, RepeatedTriggersAreAllReported) {
+    group->addParameter(std::make_shared<TriggerParameter>("Hit"));
+    group->addParameter(std::make_shared<FloatParameter>("Gain", 0.0f));
+    const ParameterHandle hit = group->getHandle("Hit");
+    const ParameterHandle gain = group->getHandle("Gain");
+
+    group->pushChange(hit, 1.0f);
+    group->pushChange(gain, 0.5f);
+    group->pushChange(hit, 1.0f);
+    group->pushChange(hit, 1.0f);
+    group->pushChange(gain, 0.25f);
+    EXPECT_EQ(group->processChanges(), 5u);
+
+    std::vector<ParameterNotification> received;
+    group->setNotificationCallback([&](const ParameterNotification* notifications, size_t count) {
+        received.assign(notifications, notifications + count);
+    });
+
+    EXPECT_EQ(group->dispatchNotifications(), 4u);
+    ASSERT_EQ(received.size(), 4u);
+    EXPECT_EQ(std::count_if(received.begin(), received.end(),
+                            [&](const ParameterNotification& n) { return n.handle == hit; }),
+              3);
+    EXPECT_EQ(received[1].handle, gain);
+    EXPECT_FLOAT_EQ(received[1].oldValue, 0.0f);
+    EXPECT_FLOAT_EQ(received[1].newValue, 0.25f);
+
+    // A second round coalesces again from scratch
+    group->pushChange(gain, 0.75f);
+    EXPECT_EQ(group->processChanges(), 1u);
+    EXPECT_EQ(group->dispatchNotifications(), 1u);
+    EXPECT_FLOAT_EQ(received[0].oldValue, 0.25f);
+}
+
+TEST_F(ParameterGroupTest, NotificationsForRemovedParametersAreDropped) {
+    group->addParameter(std::make_shared<FloatParameter>("Gain", 0.0f));
+    group->pushChange(group->getHandle("Gain"), 0.5f);
+    EXPECT_EQ(group->processChanges(), 1u);
+
+    group->removeParameter("Gain");
+    group->addParameter(std::make_shared<FloatParameter>("Other", 0.0f));
+    EXPECT_EQ(group->dispatchNotifications(), 0u);
+}
+
+TEST_F(ParameterGroupTest, FullChangeQueueDropsAndCounts) {
+    ParameterGroup small("Small", 2);
+    small.addParameter(std::make_shared<FloatParameter>("Gain", 0.5f));
+    ParameterHandle handle = small.getHandle("Gain");
+
+    EXPECT_TRUE(small.pushChange(handle, 0.1f));
+    EXPECT_TRUE(small.pushChange(handle, 0.2f));
+    EXPECT_FALSE(small.pushChange(handle, 0.3f));
+    EXPECT_EQ(small.getDroppedChangeCount(), 1u);
+}
+
+TEST_F(ParameterGroupTest, ChangesFromControlThreadReachAudioThread) {
+    auto gain = std::make_shared<FloatParameter>("Gain", 0.0f, 0.0f, 10000.0f);
+    group->addParameter(gain);
+    ParameterHandle handle = group->getHandle("Gain");
+    constexpr int kChanges = 5000;
+
+    std::thread control([&]() {
+        for (int i = 1; i <= kChanges; ++i) {
+            while (!group->pushChange(handle, static_cast<float>(i))) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    size_t applied = 0;
+    while (applied < static_cast<size_t>(kChanges)) {
+        applied += group->processChanges();
+        std::this_thread::yield();
+    }
+    control.join();
+
+    EXPECT_FLOAT_EQ(gain->getValue(), static_cast<float>(kChanges));
+}
+
+TEST_F(ParameterGroupTest, FloatValuesLiveInGroupArray) {
+    auto gain = std::make_shared<FloatParameter>("Gain", 0.5f);
+    group->addParameter(gain);
+    ParameterHandle handle = group->getHandle("Gain");
+
+    EXPECT_TRUE(gain->hasExternalValueStorage());
+    gain->setValue(0.75f);
+    EXPECT_FLOAT_EQ(group->getValue(handle), 0.75f);
+
+    EXPECT_TRUE(group->setValue(handle, 2.0f));  // Clamped by the parameter
+    EXPECT_FLOAT_EQ(gain->getValue(), 1.0f);
+}
+
+TEST_F(ParameterGroupTest, ValuesSurviveArrayGrowth) {
+    std::vector<std::shared_ptr<FloatParameter>> params;
+    for (int i = 0; i < 100; ++i) {
+        auto param = std::make_shared<FloatParameter>("P" + std::to_string(i),
+                                                      static_cast<float>(i), 0.0f, 1000.0f);
+        params.push_back(param);
+        group->addParameter(param);
+    }
+
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_FLOAT_EQ(params[i]->getValue(), static_cast<float>(i));
+        EXPECT_FLOAT_EQ(group->getValue(group->getHandle("P" + std::to_string(i))),
+                        static_cast<float>(i));
+    }
+}
+
+TEST_F(ParameterGroupTest, ParametersKeepValuesAfterLeavingGroup) {
+    auto removed = std::make_shared<FloatParameter>("Removed", 0.25f);
+    auto outlives = std::make_shared<FloatParameter>("Outlives", 0.25f);
+    group->addParameter(removed);
+    group->addParameter(outlives);
+    removed->setValue(0.3f);
+    outlives->setValue(0.4f);
+
+    group->removeParameter("Removed");
+    EXPECT_FALSE(removed->hasExternalValueStorage());
+    EXPECT_FLOAT_EQ(removed->getValue(), 0.3f);
+
+    group.reset();
+    EXPECT_FALSE(outlives->hasExternalValueStorage());
+    EXPECT_FLOAT_EQ(outlives->getValue(), 0.4f);
+    outlives->setValue(0.9f);
+    EXPECT_FLOAT_EQ(outlives->getValue(), 0.9f);
+}
+
+TEST_F(ParameterGroupTest, BulkAccessOverHandleRange) {
+    group->addParameter(std::make_shared<FloatParameter>("Freq", 440.0f, 20.0f, 20000.0f));
+    group->addParameter(std::make_shared<IntParameter>("Taps", 4, 1, 16));
+    group->addParameter(std::make_shared<BoolParameter>("Bypass", false));
+    group->addParameter(std::make_shared<EnumParameter>(
+        "Mode", std::vector<std::string>{"A", "B", "C"}, 0));
+    ParameterHandle first = group->getHandle("Freq");
+
+    const float incoming[] = {1000.0f, 8.0f, 1.0f, 2.0f};
+    EXPECT_EQ(group->setValues(first, incoming, 4), 4u);
+
+    float values[4] = {};
+    EXPECT_EQ(group->getValues(first, values, 4), 4u);
+    EXPECT_FLOAT_EQ(values[0], 1000.0f);
+    EXPECT_FLOAT_EQ(values[1], 8.0f);
+    EXPECT_FLOAT_EQ(values[2], 1.0f);
+    EXPECT_FLOAT_EQ(values[3], 2.0f);
+
+    // Ranges are clipped to the issued handles
+    EXPECT_EQ(group->getValues(first + 2, values, 10), 2u);
+    EXPECT_EQ(group->getValues(group->getHandleCount(), values, 1), 0u);
+}
+
 } // namespace test
 } // namespace nap
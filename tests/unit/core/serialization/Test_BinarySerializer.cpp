@@ -1,5 +1,17 @@
 #include <gtest/gtest.h>
 #include "core/serialization/BinarySerializer.h"
+#include "core/serialization/ParameterStateLayout.h"
+#include "core/serialization/StateVector.h"
+#include "core/graph/AudioGraph.h"
+#include "core/graph/ConnectionManager.h"
+#include "core/parameters/EnumParameter.h"
+#include "core/parameters/FloatParameter.h"
+#include "core/parameters/IntParameter.h"
+#include "core/parameters/ParameterGroup.h"
+#include "nodes/math/GainNode.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
 
 namespace nap {
 namespace test {
@@ -78,5 +90,240 @@ TEST_F(BinarySerializerTest, RoundTrip) {
     EXPECT_TRUE(serializer->isValid());
 }
 
+namespace {
+
+std::unique_ptr<ParameterGroup> makeParameters() {
+    auto root = std::make_unique<ParameterGroup>("Root");
+    root->addParameter(std::make_shared<FloatParameter>("Gain", 0.5f, 0.0f, 1.0f));
+    root->addParameter(std::make_shared<IntParameter>("Voices", 4, 1, 16));
+
+    auto filter = std::make_unique<ParameterGroup>("Filter");
+    filter->addParameter(std::make_shared<FloatParameter>("Cutoff", 1000.0f, 20.0f, 20000.0f));
+    filter->addParameter(std::make_shared<EnumParameter>(
+        "Mode", std::vector<std::string>{"LP", "HP", "BP"}, 0));
+    root->addGroup(std::move(filter));
+    return root;
+}
+
+} // namespace
+
+TEST_F(BinarySerializerTest, RoundTripsGraphAndParameters) {
+    auto params = makeParameters();
+    AudioGraph graph;
+    auto a = std::make_shared<GainNode>();
+    auto b = std::make_shared<GainNode>();
+    graph.addNode(a);
+    graph.addNode(b);
+    graph.connect(a->getNodeId(), 1, b->getNodeId(), 0);
+    a->setBypassed(true);
+
+    static_cast<FloatParameter*>(params->getParameter("Gain"))->setValue(0.3f);
+    static_cast<IntParameter*>(params->getParameter("Voices"))->setValue(11);
+    auto* filter = params->getGroup("Filter");
+    static_cast<FloatParameter*>(filter->getParameter("Cutoff"))->setValue(333.0f);
+    static_cast<EnumParameter*>(filter->getParameter("Mode"))->setSelectedIndex(2);
+
+    serializer->setGraph(&graph);
+    serializer->setParameterGroup(params.get());
+    auto binary = serializer->serializeBinary();
+
+    a->setBypassed(false);
+    graph.disconnect(a->getNodeId(), 1, b->getNodeId(), 0);
+    auto restored = makeParameters();
+
+    BinarySerializer loader;
+    loader.setGraph(&graph);
+    loader.setParameterGroup(restored.get());
+    ASSERT_TRUE(loader.deserializeBinary(binary)) << loader.getLastError();
+
+    EXPECT_TRUE(a->isBypassed());
+    ASSERT_EQ(graph.getConnections().size(), 1u);
+    EXPECT_EQ(graph.getConnections()[0].sourceChannel, 1u);
+    EXPECT_FLOAT_EQ(static_cast<FloatParameter*>(restored->getParameter("Gain"))->getValue(), 0.3f);
+    EXPECT_EQ(static_cast<IntParameter*>(restored->getParameter("Voices"))->getValue(), 11);
+    auto* restoredFilter = restored->getGroup("Filter");
+    EXPECT_FLOAT_EQ(static_cast<FloatParameter*>(restoredFilter->getParameter("Cutoff"))->getValue(), 333.0f);
+    EXPECT_EQ(static_cast<EnumParameter*>(restoredFilter->getParameter("Mode"))->getSelectedIndex(), 2u);
+}
+
+TEST_F(BinarySerializerTest, SampleDataIsReadInPlace) {
+    std::vector<float> wavetable(1000);
+    for (size_t i = 0; i < wavetable.size(); ++i) {
+        wavetable[i] = static_cast<float>(i) * 0.5f;
+    }
+    const float ir[] = {1.0f, 0.5f, 0.25f, 0.125f, -1.0f, -0.5f};
+    serializer->addSampleData("Wavetable", wavetable.data(), 1000, 1);
+    serializer->addSampleData("Room IR", ir, 3, 2);
+
+    auto binary = serializer->serializeBinary();
+
+    BinarySerializer loader;
+    ASSERT_TRUE(loader.deserializeInPlace(binary.data(), binary.size())) << loader.getLastError();
+    EXPECT_EQ(loader.getSampleDataCount(), 2u);
+
+    auto table = loader.getSampleData("Wavetable");
+    ASSERT_FALSE(table.empty());
+    EXPECT_EQ(table.frames, 1000u);
+    EXPECT_GE(reinterpret_cast<const uint8_t*>(table.data), binary.data());
+    EXPECT_LT(reinterpret_cast<const uint8_t*>(table.data), binary.data() + binary.size());
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(table.data) % BinarySerializer::SECTION_ALIGNMENT, 0u);
+    EXPECT_EQ(std::memcmp(table.data, wavetable.data(), wavetable.size() * sizeof(float)), 0);
+
+    auto room = loader.getSampleData("Room IR");
+    EXPECT_EQ(room.channels, 2u);
+    EXPECT_FLOAT_EQ(room.data[5], -0.5f);
+    EXPECT_TRUE(loader.getSampleData("Missing").empty());
+}
+
+TEST_F(BinarySerializerTest, LoadFromFileMapsSession) {
+    const float samples[] = {0.1f, 0.2f, 0.3f, 0.4f};
+    serializer->addSampleData("IR", samples, 4, 1);
+
+    const std::string path = ::testing::TempDir() + "nap_binary_mmap_test.napb";
+    ASSERT_TRUE(serializer->saveToFile(path));
+
+    BinarySerializer loader;
+    ASSERT_TRUE(loader.loadFromFile(path)) << loader.getLastError();
+    EXPECT_TRUE(loader.isMemoryMapped());
+    auto ir = loader.getSampleData("IR");
+    ASSERT_EQ(ir.frames, 4u);
+    EXPECT_FLOAT_EQ(ir.data[3], 0.4f);
+    std::remove(path.c_str());
+}
+
+TEST_F(BinarySerializerTest, RejectsCorruptOffsets) {
+    const float samples[] = {1.0f, 2.0f};
+    serializer->addSampleData("S", samples, 2, 1);
+    const auto good = serializer->serializeBinary();
+
+    // Truncation breaks the recorded file size
+    auto truncated = good;
+    truncated.resize(truncated.size() - 4);
+    EXPECT_FALSE(serializer->deserializeBinary(truncated));
+
+    // Point the first section past the end of the file
+    auto outOfRange = good;
+    const uint32_t badOffset = 0x7FFFFFF0u;
+    std::memcpy(outOfRange.data() + 32 + 4, &badOffset, sizeof(badOffset));
+    EXPECT_FALSE(serializer->deserializeBinary(outOfRange));
+    EXPECT_FALSE(serializer->isValid());
+
+    EXPECT_TRUE(serializer->deserializeBinary(good));
+}
+
+TEST_F(BinarySerializerTest, RefusesSessionsPastTheOffsetRange) {
+    // 4 GiB of sample data; the size check fails before anything is read
+    serializer->addSampleData("Huge", nullptr, 0x40000000u, 1);
+
+    EXPECT_TRUE(serializer->serializeBinary().empty());
+    EXPECT_FALSE(serializer->getLastError().empty());
+
+    const std::string path = ::testing::TempDir() + "nap_binary_overflow_test.napb";
+    EXPECT_FALSE(serializer->saveToFile(path));
+    std::remove(path.c_str());
+
+    serializer->clearSampleData();
+    EXPECT_FALSE(serializer->serializeBinary().empty());
+    EXPECT_TRUE(serializer->getLastError().empty());
+}
+
+TEST_F(BinarySerializerTest, AcceptsLegacyVersionOne) {
+    std::vector<uint8_t> legacy = {0x42, 0x50, 0x41, 0x4E, 0x01, 0x00, 0x00, 0x00,
+                                   0, 0, 0, 0, 0, 0, 0, 0};
+    EXPECT_TRUE(serializer->deserializeBinary(legacy));
+}
+
+TEST_F(BinarySerializerTest, CompressedRoundTripIsSmaller) {
+    auto params = makeParameters();
+    static_cast<FloatParameter*>(params->getParameter("Gain"))->setValue(0.7f);
+
+    std::vector<float> wavetable(4 * BinarySerializer::COMPRESSION_CHUNK_SIZE / sizeof(float));
+    for (size_t i = 0; i < wavetable.size(); ++i) {
+        wavetable[i] = std::sin(0.001f * static_cast<float>(i));
+    }
+
+    serializer->setParameterGroup(params.get());
+    serializer->addSampleData("Table", wavetable.data(), static_cast<uint32_t>(wavetable.size()), 1);
+    const auto raw = serializer->serializeBinary();
+    serializer->setCompression(true);
+    const auto compressed = serializer->serializeBinary();
+    EXPECT_LT(compressed.size(), raw.size() * 3 / 4);
+
+    for (unsigned threads : {1u, 4u}) {
+        auto restored = makeParameters();
+        BinarySerializer loader;
+        loader.setDecodeThreads(threads);
+        loader.setParameterGroup(restored.get());
+        ASSERT_TRUE(loader.deserializeBinary(compressed)) << loader.getLastError();
+
+        EXPECT_FLOAT_EQ(static_cast<FloatParameter*>(restored->getParameter("Gain"))->getValue(), 0.7f);
+        auto table = loader.getSampleData("Table");
+        ASSERT_EQ(table.frames, wavetable.size());
+        EXPECT_EQ(std::memcmp(table.data, wavetable.data(), wavetable.size() * sizeof(float)), 0);
+    }
+}
+
+TEST_F(BinarySerializerTest, CompressedFileLoadsFromDisk) {
+    const float samples[] = {0.25f, 0.5f};
+    serializer->addSampleData("S", samples, 2, 1);
+    serializer->setCompression(true);
+
+    const std::string path = ::testing::TempDir() + "nap_binary_compressed_test.napb";
+    ASSERT_TRUE(serializer->saveToFile(path));
+
+    BinarySerializer loader;
+    ASSERT_TRUE(loader.loadFromFile(path)) << loader.getLastError();
+    EXPECT_FALSE(loader.isMemoryMapped());
+    EXPECT_FLOAT_EQ(loader.getSampleData("S").data[1], 0.5f);
+    std::remove(path.c_str());
+}
+
+TEST_F(BinarySerializerTest, RejectsCorruptCompressedChunk) {
+    std::vector<float> ramp(2000);
+    for (size_t i = 0; i < ramp.size(); ++i) ramp[i] = static_cast<float>(i);
+    serializer->addSampleData("Ramp", ramp.data(), 2000, 1);
+    serializer->setCompression(true);
+    auto compressed = serializer->serializeBinary();
+
+    compressed[compressed.size() - 3] ^= 0x5A;
+    BinarySerializer loader;
+    EXPECT_FALSE(loader.deserializeBinary(compressed));
+    EXPECT_FALSE(loader.getLastError().empty());
+}
+
+TEST_F(BinarySerializerTest, ReadParameterStateLeavesParametersAlone) {
+    ParameterGroup params("Root");
+    auto gain = std::make_shared<FloatParameter>("Gain", 0.5f);
+    auto steps = std::make_shared<IntParameter>("Steps", 4, 0, 16);
+    params.addParameter(gain);
+    params.addParameter(steps);
+    auto sub = std::make_unique<ParameterGroup>("Sub");
+    auto mode = std::make_shared<EnumParameter>("Mode", std::vector<std::string>{"A", "B", "C"});
+    sub->addParameter(mode);
+    params.addGroup(std::move(sub));
+
+    gain->setValue(0.9f);
+    steps->setValue(12);
+    mode->setSelectedIndex(2);
+    serializer->setParameterGroup(&params);
+    serializer->setCompression(true);
+    const std::string path = ::testing::TempDir() + "nap_binary_state_test.napb";
+    ASSERT_TRUE(serializer->saveToFile(path));
+
+    gain->setValue(0.1f);
+    ParameterStateLayout layout(params);
+    StateVector state;
+    layout.capture(state);
+    ASSERT_TRUE(serializer->readParameterState(path, layout, state)) << serializer->getLastError();
+    EXPECT_FLOAT_EQ(state[layout.indexOf("Gain")], 0.9f);
+    EXPECT_FLOAT_EQ(state[layout.indexOf("Steps")], 12.0f);
+    EXPECT_FLOAT_EQ(state[layout.indexOf("Sub/Mode")], 2.0f);
+    EXPECT_FLOAT_EQ(gain->getValue(), 0.1f);
+
+    StateVector wrongSize;
+    EXPECT_FALSE(serializer->readParameterState(path, layout, wrongSize));
+    std::remove(path.c_str());
+}
+
 } // namespace test
 } // namespace nap
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include "core/serialization/ChunkCodec.h"
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <string>
+
+namespace nap {
+namespace test {
+
+namespace {
+
+using Filter = ChunkCodec::Filter;
+
+std::vector<uint8_t> roundTrip(const std::vector<uint8_t>& input, Filter filter, uint32_t stride,
+                               size_t* compressedSize = nullptr) {
+    auto compressed = ChunkCodec::compress(input.data(), input.size(), filter, stride);
+    if (compressedSize) *compressedSize = compressed.size();
+    std::vector<uint8_t> output(input.size(), 0xCD);
+    EXPECT_TRUE(ChunkCodec::decompress(compressed.data(), compressed.size(),
+                                       output.data(), output.size(), filter, stride));
+    return output;
+}
+
+std::vector<uint8_t> sineBytes(size_t frames) {
+    std::vector<float> samples(frames);
+    for (size_t i = 0; i < frames; ++i) {
+        samples[i] = 0.5f * std::sin(0.01f * static_cast<float>(i));
+    }
+    std::vector<uint8_t> bytes(frames * sizeof(float));
+    std::memcpy(bytes.data(), samples.data(), bytes.size());
+    return bytes;
+}
+
+} // namespace
+
+TEST(ChunkCodecTest, RoundTripsEdgeSizes) {
+    for (size_t size : {0u, 1u, 3u, 4u, 5u, 17u, 255u, 1000u}) {
+        std::vector<uint8_t> input(size);
+        for (size_t i = 0; i < size; ++i) input[i] = static_cast<uint8_t>(i * 7);
+        for (Filter filter : {Filter::None, Filter::Delta32, Filter::Xor32}) {
+            EXPECT_EQ(roundTrip(input, filter, 1), input) << size;
+        }
+    }
+}
+
+TEST(ChunkCodecTest, RoundTripsRandomData) {
+    std::mt19937 rng(42);
+    std::vector<uint8_t> input(40000);
+    for (auto& byte : input) byte = static_cast<uint8_t>(rng());
+    EXPECT_EQ(roundTrip(input, Filter::None, 1), input);
+    EXPECT_EQ(roundTrip(input, Filter::Delta32, 3), input);
+}
+
+TEST(ChunkCodecTest, CompressesRepetitiveData) {
+    std::vector<uint8_t> input;
+    static const char kPhrase[] = "GainNode_1\0GainNode_2\0";
+    const std::string phrase(kPhrase, sizeof(kPhrase) - 1);  // Keeps the embedded NULs
+    ASSERT_EQ(phrase.size(), 22u);
+    while (input.size() < 30000) input.insert(input.end(), phrase.begin(), phrase.end());
+
+    size_t compressed = 0;
+    EXPECT_EQ(roundTrip(input, Filter::None, 1, &compressed), input);
+    EXPECT_LT(compressed, input.size() / 20);
+}
+
+TEST(ChunkCodecTest, LongRunsUseOverlappingMatches) {
+    std::vector<uint8_t> input(50000, 0);
+    size_t compressed = 0;
+    EXPECT_EQ(roundTrip(input, Filter::None, 1, &compressed), input);
+    EXPECT_LT(compressed, 300u);
+}
+
+TEST(ChunkCodecTest, XorFilterHelpsSmoothFloats) {
+    const auto input = sineBytes(8192);
+    size_t plain = 0;
+    size_t filtered = 0;
+    EXPECT_EQ(roundTrip(input, Filter::None, 1, &plain), input);
+    EXPECT_EQ(roundTrip(input, Filter::Xor32, 1, &filtered), input);
+    EXPECT_LT(filtered, plain);
+    EXPECT_LT(filtered, input.size() * 3 / 4);
+}
+
+TEST(ChunkCodecTest, DeltaFilterHelpsIncreasingRecords) {
+    // Records of {offset, type, value} like the parameter table
+    std::vector<uint32_t> words;
+    for (uint32_t i = 0; i < 3000; ++i) {
+        words.push_back(i * 13);
+        words.push_back(0);
+        words.push_back(1000 + i);
+    }
+    std::vector<uint8_t> input(words.size() * 4);
+    std::memcpy(input.data(), words.data(), input.size());
+
+    size_t plain = 0;
+    size_t delta = 0;
+    EXPECT_EQ(roundTrip(input, Filter::None, 1, &plain), input);
+    EXPECT_EQ(roundTrip(input, Filter::Delta32, 3, &delta), input);
+    EXPECT_LT(delta, plain / 4);
+}
+
+TEST(ChunkCodecTest, RejectsCorruptInput) {
+    const auto input = sineBytes(1024);
+    auto compressed = ChunkCodec::compress(input.data(), input.size(), Filter::Xor32, 1);
+    std::vector<uint8_t> output(input.size());
+
+    // Wrong expected size
+    EXPECT_FALSE(ChunkCodec::decompress(compressed.data(), compressed.size(),
+                                        output.data(), output.size() - 4, Filter::Xor32, 1));
+    // Truncated stream
+    EXPECT_FALSE(ChunkCodec::decompress(compressed.data(), compressed.size() / 2,
+                                        output.data(), output.size(), Filter::Xor32, 1));
+    // Back-reference before the start of the output
+    const uint8_t badOffset[] = {0x10, 'a', 0x05, 0x00};
+    EXPECT_FALSE(ChunkCodec::decompress(badOffset, sizeof(badOffset), output.data(), 5));
+}
+
+TEST(ChunkCodecTest, ChecksumDetectsChanges) {
+    std::vector<uint8_t> data(64, 1);
+    const uint32_t original = ChunkCodec::checksum(data.data(), data.size());
+    data[10] = 2;
+    EXPECT_NE(ChunkCodec::checksum(data.data(), data.size()), original);
+}
+
+} // namespace test
+} // namespace nap
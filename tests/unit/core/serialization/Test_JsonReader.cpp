@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include "core/serialization/JsonReader.h"
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace nap {
+namespace test {
+
+// Records events as a compact token string
+class RecordingHandler : public JsonReader::Handler {
+public:
+    bool onStartObject() override { events += "{"; return true; }
+    bool onEndObject() override { events += "}"; return true; }
+    bool onStartArray() override { events += "["; return true; }
+    bool onEndArray() override { events += "]"; return true; }
+    bool onKey(std::string_view key) override {
+        events += "k:" + std::string(key) + " ";
+        return true;
+    }
+    bool onString(std::string_view value) override {
+        events += "s:" + std::string(value) + " ";
+        return true;
+    }
+    bool onNumber(double value) override {
+        numbers.push_back(value);
+        events += "n ";
+        return true;
+    }
+    bool onBool(bool value) override { events += value ? "true " : "false "; return true; }
+    bool onNull() override { events += "null "; return true; }
+
+    std::string events;
+    std::vector<double> numbers;
+};
+
+class JsonReaderTest : public ::testing::Test {
+protected:
+    JsonReader reader;
+    RecordingHandler handler;
+};
+
+TEST_F(JsonReaderTest, ReportsEventsInDocumentOrder) {
+    EXPECT_TRUE(reader.parse(R"({"a": [1, true, null], "b": {"c": "x"}, "d": []})", handler));
+    EXPECT_EQ(handler.events, "{k:a [n true null ]k:b {k:c s:x }k:d []}");
+}
+
+TEST_F(JsonReaderTest, ParsesNumbers) {
+    EXPECT_TRUE(reader.parse("[0, -1.5, 2e3, 1.25E-2]", handler));
+    ASSERT_EQ(handler.numbers.size(), 4u);
+    EXPECT_DOUBLE_EQ(handler.numbers[0], 0.0);
+    EXPECT_DOUBLE_EQ(handler.numbers[1], -1.5);
+    EXPECT_DOUBLE_EQ(handler.numbers[2], 2000.0);
+    EXPECT_DOUBLE_EQ(handler.numbers[3], 0.0125);
+}
+
+TEST_F(JsonReaderTest, DecodesEscapes) {
+    EXPECT_TRUE(reader.parse(R"(["a\"b\\c\n", "\u00e9\ud83c\udfb5"])", handler));
+    EXPECT_EQ(handler.events, "[s:a\"b\\c\n s:\xC3\xA9\xF0\x9F\x8E\xB5 ]");
+}
+
+TEST_F(JsonReaderTest, RejectsMalformedInput) {
+    const char* bad[] = {
+        "", "{", "[1,]", "{\"a\" 1}", "{\"a\":1,}", "01", "1.", "-", "tru",
+        "\"unterminated", "[1] 2", "{1: 2}", "[\"\\x\"]", "[1 2]"
+    };
+    for (const char* json : bad) {
+        RecordingHandler h;
+        EXPECT_FALSE(reader.parse(json, h)) << json;
+        EXPECT_FALSE(reader.getLastError().empty()) << json;
+    }
+}
+
+TEST_F(JsonReaderTest, EnforcesMaxDepth) {
+    reader.setMaxDepth(4);
+    EXPECT_TRUE(reader.parse("[[[[]]]]", handler));
+
+    RecordingHandler deep;
+    EXPECT_FALSE(reader.parse("[[[[[]]]]]", deep));
+}
+
+TEST_F(JsonReaderTest, HandlerCanAbort) {
+    struct StopAtKey : JsonReader::Handler {
+        bool onKey(std::string_view key) override { return key != "stop"; }
+    } stopper;
+
+    EXPECT_FALSE(reader.parse(R"({"go": 1, "stop": 2})", stopper));
+    EXPECT_TRUE(reader.wasAbortedByHandler());
+}
+
+TEST_F(JsonReaderTest, StreamInputSpanningManyChunks) {
+    // Long strings and many values cross chunk boundaries at arbitrary points
+    std::string big = "[";
+    const std::string text(JsonReader::kChunkSize / 3, 'x');
+    for (int i = 0; i < 10; ++i) {
+        big += "\"" + text + "\\n\", " + std::to_string(i) + ".5, ";
+    }
+    big += "true]";
+
+    std::istringstream stream(big);
+    EXPECT_TRUE(reader.parse(stream, handler));
+    ASSERT_EQ(handler.numbers.size(), 10u);
+    EXPECT_DOUBLE_EQ(handler.numbers[9], 9.5);
+    EXPECT_EQ(reader.getBytesConsumed(), big.size());
+}
+
+} // namespace test
+} // namespace nap
@@ -1,5 +1,14 @@
 #include <gtest/gtest.h>
 #include "core/serialization/JsonSerializer.h"
+#include "core/graph/AudioGraph.h"
+#include "core/graph/ConnectionManager.h"
+#include "core/parameters/BoolParameter.h"
+#include "core/parameters/EnumParameter.h"
+#include "core/parameters/FloatParameter.h"
+#include "core/parameters/IntParameter.h"
+#include "core/parameters/ParameterGroup.h"
+#include "nodes/math/GainNode.h"
+#include <cstdio>
 
 namespace nap {
 namespace test {
@@ -76,5 +85,139 @@ TEST_F(JsonSerializerTest, ParameterGroupBinding) {
     EXPECT_EQ(serializer->getParameterGroup(), nullptr);
 }
 
+namespace {
+
+std::unique_ptr<ParameterGroup> makeParameters() {
+    auto root = std::make_unique<ParameterGroup>("Root");
+    root->addParameter(std::make_shared<FloatParameter>("Gain", 0.5f, 0.0f, 1.0f));
+    root->addParameter(std::make_shared<IntParameter>("Voices", 4, 1, 16));
+    root->addParameter(std::make_shared<BoolParameter>("Enabled", true));
+    root->addParameter(std::make_shared<EnumParameter>(
+        "Wave", std::vector<std::string>{"Sine", "Saw", "Square"}, 0));
+
+    auto filter = std::make_unique<ParameterGroup>("Filter");
+    filter->addParameter(std::make_shared<FloatParameter>("Cutoff", 1000.0f, 20.0f, 20000.0f));
+    root->addGroup(std::move(filter));
+    return root;
+}
+
+} // namespace
+
+TEST_F(JsonSerializerTest, AppliesParametersWhileParsing) {
+    auto params = makeParameters();
+    serializer->setParameterGroup(params.get());
+
+    std::string json = R"({
+        "format": "nap-audio-graph",
+        "future": {"ignored": [1, {"Gain": 0.0}]},
+        "parameters": {
+            "Gain": 0.25, "Voices": 7.0, "Enabled": false, "Wave": "Square",
+            "Unknown": 3,
+            "Filter": {"Cutoff": 440.5, "Nested": {"Cutoff": 1}},
+            "Missing": {"Cutoff": 2}
+        }
+    })";
+    ASSERT_TRUE(serializer->deserialize(json)) << serializer->getLastError();
+
+    auto* gain = static_cast<FloatParameter*>(params->getParameter("Gain"));
+    auto* voices = static_cast<IntParameter*>(params->getParameter("Voices"));
+    auto* enabled = static_cast<BoolParameter*>(params->getParameter("Enabled"));
+    auto* wave = static_cast<EnumParameter*>(params->getParameter("Wave"));
+    auto* cutoff = static_cast<FloatParameter*>(params->getGroup("Filter")->getParameter("Cutoff"));
+    EXPECT_FLOAT_EQ(gain->getValue(), 0.25f);
+    EXPECT_EQ(voices->getValue(), 7);
+    EXPECT_FALSE(enabled->getValue());
+    EXPECT_EQ(wave->getSelectedValue(), "Square");
+    EXPECT_FLOAT_EQ(cutoff->getValue(), 440.5f);
+}
+
+TEST_F(JsonSerializerTest, RoundTripsParametersAndGraph) {
+    auto params = makeParameters();
+    AudioGraph graph;
+    auto a = std::make_shared<GainNode>();
+    auto b = std::make_shared<GainNode>();
+    graph.addNode(a);
+    graph.addNode(b);
+    graph.connect(a->getNodeId(), 0, b->getNodeId(), 1);
+    b->setBypassed(true);
+
+    serializer->setGraph(&graph);
+    serializer->setParameterGroup(params.get());
+    static_cast<FloatParameter*>(params->getParameter("Gain"))->setValue(0.125f);
+    static_cast<EnumParameter*>(params->getParameter("Wave"))->setSelectedIndex(1);
+
+    for (bool pretty : {true, false}) {
+        serializer->setPrettyPrint(pretty);
+        const std::string json = serializer->serialize();
+
+        // Disturb the state, then restore it from the document
+        b->setBypassed(false);
+        graph.disconnect(a->getNodeId(), 0, b->getNodeId(), 1);
+        auto restored = makeParameters();
+
+        JsonSerializer loader;
+        loader.setGraph(&graph);
+        loader.setParameterGroup(restored.get());
+        ASSERT_TRUE(loader.deserialize(json)) << loader.getLastError() << "\n" << json;
+
+        EXPECT_FLOAT_EQ(static_cast<FloatParameter*>(restored->getParameter("Gain"))->getValue(), 0.125f);
+        EXPECT_EQ(static_cast<EnumParameter*>(restored->getParameter("Wave"))->getSelectedIndex(), 1u);
+        EXPECT_TRUE(b->isBypassed());
+        EXPECT_FALSE(a->isBypassed());
+        ASSERT_EQ(graph.getConnections().size(), 1u);
+        EXPECT_EQ(graph.getConnections()[0].destChannel, 1u);
+    }
+}
+
+TEST_F(JsonSerializerTest, LoadFromFileStreamsDocument) {
+    auto params = makeParameters();
+    serializer->setParameterGroup(params.get());
+    static_cast<IntParameter*>(params->getParameter("Voices"))->setValue(9);
+
+    const std::string path = ::testing::TempDir() + "nap_json_stream_test.json";
+    ASSERT_TRUE(serializer->saveToFile(path));
+
+    auto restored = makeParameters();
+    JsonSerializer loader;
+    loader.setParameterGroup(restored.get());
+    EXPECT_TRUE(loader.loadFromFile(path)) << loader.getLastError();
+    EXPECT_EQ(static_cast<IntParameter*>(restored->getParameter("Voices"))->getValue(), 9);
+    std::remove(path.c_str());
+}
+
+TEST_F(JsonSerializerTest, ReportsParseErrorPosition) {
+    EXPECT_FALSE(serializer->deserialize(R"({"parameters": {"Gain": 0.5,}})"));
+    EXPECT_NE(serializer->getLastError().find("offset"), std::string::npos);
+}
+
+TEST_F(JsonSerializerTest, RejectsNumbersThatCannotBeIndices) {
+    AudioGraph graph;
+    auto a = std::make_shared<GainNode>();
+    auto b = std::make_shared<GainNode>();
+    graph.addNode(a);
+    graph.addNode(b);
+    auto params = makeParameters();
+    serializer->setGraph(&graph);
+    serializer->setParameterGroup(params.get());
+
+    const std::string connection = R"({"connections": [{"source": ")" + a->getNodeId() +
+                                   R"(", "sourceChannel": 0, "dest": ")" + b->getNodeId() +
+                                   R"(", "destChannel": )";
+    for (const char* channel : {"-1", "1.5", "4294967296", "1e300"}) {
+        EXPECT_FALSE(serializer->deserialize(connection + channel + "}]}")) << channel;
+        EXPECT_TRUE(graph.getConnections().empty()) << channel;
+    }
+
+    for (const char* index : {"-1", "0.5", "3", "1e300"}) {
+        EXPECT_FALSE(serializer->deserialize(std::string(R"({"parameters": {"Wave": )") + index + "}}"))
+            << index;
+    }
+    EXPECT_FALSE(serializer->deserialize(R"({"parameters": {"Voices": 1e300}})"));
+
+    EXPECT_TRUE(serializer->deserialize(R"({"parameters": {"Wave": 1, "Voices": 3}})"))
+        << serializer->getLastError();
+    EXPECT_EQ(static_cast<EnumParameter*>(params->getParameter("Wave"))->getSelectedIndex(), 1u);
+}
+
 } // namespace test
 } // namespace nap
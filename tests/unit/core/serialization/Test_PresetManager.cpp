@@ -1,6 +1,13 @@
 #include <gtest/gtest.h>
 #include "core/serialization/PresetManager.h"
 #include "core/serialization/JsonSerializer.h"
+#include "core/serialization/PresetMorpher.h"
+#include "core/parameters/FloatParameter.h"
+#include "core/parameters/IntParameter.h"
+#include "core/parameters/ParameterGroup.h"
+#include <atomic>
+#include <filesystem>
+#include <fstream>
 
 namespace nap {
 namespace test {
@@ -95,5 +102,279 @@ TEST_F(PresetManagerTest, GetPresetInfo) {
     EXPECT_TRUE(info.name.empty());
 }
 
+class PresetLibraryTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // One directory per test; ctest runs tests in parallel processes
+        directory = ::testing::TempDir() + "nap_preset_library_" +
+                    ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory);
+    }
+
+    void writePreset(const std::string& filename, const std::string& contents) {
+        std::ofstream file(directory + "/" + filename);
+        file << contents;
+    }
+
+    std::string directory;
+};
+
+TEST_F(PresetLibraryTest, ScanReadsMetadata) {
+    writePreset("Bass.json", "{\"a\": 1}");
+    writePreset("Lead.json", "{\"b\": 2}");
+
+    PresetManager manager;
+    manager.setPresetDirectory(directory);
+    manager.scanPresets();
+
+    ASSERT_EQ(manager.getPresetCount(), 2u);
+    auto info = manager.getPresetInfo("Bass");
+    EXPECT_EQ(info.fileSize, 8u);
+    EXPECT_GT(info.modifiedTime, 0u);
+    EXPECT_NE(info.contentHash, 0u);
+    EXPECT_NE(info.contentHash, manager.getPresetInfo("Lead").contentHash);
+    EXPECT_TRUE(std::filesystem::exists(manager.getIndexPath()));
+}
+
+TEST_F(PresetLibraryTest, RescanOnlyReadsChangedFiles) {
+    for (int i = 0; i < 20; ++i) {
+        writePreset("Preset" + std::to_string(i) + ".json", "{}");
+    }
+
+    {
+        PresetManager manager;
+        manager.setPresetDirectory(directory);
+        manager.scanPresets();
+        EXPECT_EQ(manager.getLastScanStatistics().filesRead, 20u);
+    }
+
+    // A new manager starts from the persisted index
+    writePreset("Preset3.json", "{\"changed\": true}");
+    writePreset("Extra.json", "{}");
+    std::filesystem::remove(directory + "/Preset7.json");
+
+    PresetManager manager;
+    manager.setPresetDirectory(directory);
+    manager.scanPresets();
+    auto stats = manager.getLastScanStatistics();
+    EXPECT_EQ(stats.filesSeen, 20u);
+    EXPECT_EQ(stats.filesRead, 2u);
+    EXPECT_EQ(stats.filesRemoved, 1u);
+    EXPECT_EQ(manager.getPresetCount(), 20u);
+    EXPECT_FALSE(manager.presetExists("Preset7"));
+
+    manager.scanPresets();
+    EXPECT_EQ(manager.getLastScanStatistics().filesRead, 0u);
+}
+
+TEST_F(PresetLibraryTest, CategoriesPersistAcrossSessions) {
+    {
+        PresetManager manager;
+        manager.setSerializer(std::make_shared<JsonSerializer>());
+        manager.setPresetDirectory(directory);
+        EXPECT_TRUE(manager.savePreset("Warm Pad", "Pads"));
+        EXPECT_TRUE(manager.savePreset("Glass Pad", "Pads"));
+        EXPECT_TRUE(manager.savePreset("Sub", "Bass"));
+    }
+
+    PresetManager manager;
+    manager.setPresetDirectory(directory);
+    manager.scanPresets();
+    EXPECT_EQ(manager.getCategories(), (std::vector<std::string>{"Bass", "Pads"}));
+    EXPECT_EQ(manager.getPresetsInCategory("Pads"),
+              (std::vector<std::string>{"Glass Pad", "Warm Pad"}));
+    EXPECT_EQ(manager.getLastScanStatistics().filesRead, 0u);
+}
+
+TEST_F(PresetLibraryTest, RenameAndDeleteUpdateIndexes) {
+    PresetManager manager;
+    manager.setSerializer(std::make_shared<JsonSerializer>());
+    manager.setPresetDirectory(directory);
+    ASSERT_TRUE(manager.savePreset("Keys A", "Keys"));
+    ASSERT_TRUE(manager.savePreset("Keys B", "Keys"));
+
+    ASSERT_TRUE(manager.renamePreset("Keys A", "Piano"));
+    EXPECT_EQ(manager.getPresetsInCategory("Keys"), (std::vector<std::string>{"Keys B", "Piano"}));
+
+    ASSERT_TRUE(manager.deletePreset("Keys B"));
+    ASSERT_TRUE(manager.deletePreset("Piano"));
+    EXPECT_TRUE(manager.getCategories().empty());
+}
+
+TEST_F(PresetLibraryTest, DuplicateIndexesTheCopy) {
+    PresetManager manager;
+    manager.setSerializer(std::make_shared<JsonSerializer>());
+    manager.setPresetDirectory(directory);
+    ASSERT_TRUE(manager.savePreset("Lead", "Synth"));
+
+    ASSERT_TRUE(manager.duplicatePreset("Lead", "Lead Copy"));
+    EXPECT_FALSE(manager.duplicatePreset("Lead", "Lead Copy"));
+    EXPECT_FALSE(manager.duplicatePreset("Missing", "Other"));
+
+    const auto original = manager.getPresetInfo("Lead");
+    const auto copy = manager.getPresetInfo("Lead Copy");
+    EXPECT_EQ(copy.category, "Synth");
+    EXPECT_EQ(copy.contentHash, original.contentHash);
+    EXPECT_TRUE(std::filesystem::exists(copy.filepath));
+    EXPECT_EQ(manager.getPresetsInCategory("Synth"),
+              (std::vector<std::string>{"Lead", "Lead Copy"}));
+}
+
+TEST_F(PresetLibraryTest, PrefixQueries) {
+    for (const char* name : {"Bass 1", "Bass 2", "Bell", "Brass"}) {
+        writePreset(std::string(name) + ".json", "{}");
+    }
+    PresetManager manager;
+    manager.setPresetDirectory(directory);
+    manager.scanPresets();
+
+    EXPECT_EQ(manager.findPresetsByPrefix("Bass"), (std::vector<std::string>{"Bass 1", "Bass 2"}));
+    EXPECT_EQ(manager.findPresetsByPrefix("B").size(), 4u);
+    EXPECT_TRUE(manager.findPresetsByPrefix("X").empty());
+}
+
+TEST_F(PresetLibraryTest, AsyncScanReportsCompletion) {
+    for (int i = 0; i < 50; ++i) {
+        writePreset("P" + std::to_string(i) + ".json", "{}");
+    }
+
+    PresetManager manager;
+    manager.setPresetDirectory(directory);
+    std::atomic<size_t> seen{0};
+    manager.setScanCompletedCallback([&](const PresetScanStatistics& stats) {
+        seen = stats.filesSeen;
+    });
+
+    ASSERT_TRUE(manager.scanPresetsAsync());
+    manager.waitForScan();
+    EXPECT_FALSE(manager.isScanning());
+    EXPECT_EQ(seen.load(), 50u);
+    EXPECT_EQ(manager.getPresetCount(), 50u);
+}
+
+namespace {
+
+// Reads the manager from inside the write, which deadlocks if the manager
+// still holds its mutex around file I/O
+class ReentrantSerializer : public JsonSerializer {
+public:
+    bool saveToFile(const std::string& filepath) const override {
+        presetsDuringWrite = manager ? manager->getPresetCount() : 0;
+        return JsonSerializer::saveToFile(filepath);
+    }
+
+    PresetManager* manager = nullptr;
+    mutable size_t presetsDuringWrite = 0;
+};
+
+} // namespace
+
+TEST_F(PresetLibraryTest, SaveWritesFileWithoutHoldingTheLock) {
+    writePreset("Existing.json", "{}");
+
+    PresetManager manager;
+    manager.setPresetDirectory(directory);
+    manager.scanPresets();
+
+    auto serializer = std::make_shared<ReentrantSerializer>();
+    serializer->manager = &manager;
+    manager.setSerializer(serializer);
+
+    std::string saved;
+    manager.setPresetSavedCallback([&](const std::string& name) {
+        saved = name;
+        EXPECT_TRUE(manager.presetExists(name));
+    });
+
+    ASSERT_TRUE(manager.savePreset("New", "Pads")) << manager.getLastError();
+    EXPECT_EQ(serializer->presetsDuringWrite, 1u);  // Published only after the write
+    EXPECT_EQ(saved, "New");
+    EXPECT_EQ(manager.getPresetCount(), 2u);
+    EXPECT_NE(manager.getPresetInfo("New").contentHash, 0u);
+}
+
+TEST_F(PresetLibraryTest, SynchronousScanIsReportedAsScanning) {
+    writePreset("One.json", "{}");
+
+    PresetManager manager;
+    manager.setPresetDirectory(directory);
+    bool scanningInCallback = false;
+    manager.setScanCompletedCallback([&](const PresetScanStatistics&) {
+        scanningInCallback = manager.isScanning();
+    });
+
+    manager.scanPresets();
+    EXPECT_TRUE(scanningInCallback);
+    EXPECT_FALSE(manager.isScanning());
+}
+
+TEST_F(PresetLibraryTest, CorruptIndexFallsBackToFullScan) {
+    writePreset("One.json", "{}");
+    writePreset(PresetManager::INDEX_FILENAME, "garbage\n");
+
+    PresetManager manager;
+    manager.setPresetDirectory(directory);
+    manager.scanPresets();
+    EXPECT_EQ(manager.getPresetCount(), 1u);
+    EXPECT_EQ(manager.getLastScanStatistics().filesRead, 1u);
+}
+
+TEST_F(PresetLibraryTest, AsyncLoadMorphsToPreset) {
+    ParameterGroup params("Synth");
+    auto cutoff = std::make_shared<FloatParameter>("Cutoff", 0.0f, 0.0f, 100.0f);
+    auto voices = std::make_shared<IntParameter>("Voices", 1, 1, 16);
+    params.addParameter(cutoff);
+    params.addParameter(voices);
+
+    auto serializer = std::make_shared<JsonSerializer>();
+    serializer->setParameterGroup(&params);
+    PresetManager manager;
+    manager.setSerializer(serializer);
+    manager.setPresetDirectory(directory);
+
+    cutoff->setValue(80.0f);
+    voices->setValue(6);
+    ASSERT_TRUE(manager.savePreset("Bright"));
+    cutoff->setValue(0.0f);
+    voices->setValue(1);
+
+    std::string loaded;
+    manager.setPresetLoadedCallback([&](const std::string& name) { loaded = name; });
+
+    PresetMorpher morpher(params);
+    ASSERT_TRUE(manager.loadPresetAsync("Bright", morpher, 4));
+    manager.waitForLoad();
+    EXPECT_FALSE(manager.isLoading());
+    EXPECT_EQ(loaded, "Bright");
+    EXPECT_EQ(manager.getCurrentPresetName(), "Bright");
+
+    // Nothing changes until the audio thread runs
+    EXPECT_FLOAT_EQ(cutoff->getValue(), 0.0f);
+    EXPECT_TRUE(morpher.process());
+    EXPECT_NEAR(cutoff->getValue(), 20.0f, 1e-4f);
+    EXPECT_EQ(voices->getValue(), 1);
+    while (morpher.process()) {}
+    EXPECT_FLOAT_EQ(cutoff->getValue(), 80.0f);
+    EXPECT_EQ(voices->getValue(), 6);
+}
+
+TEST_F(PresetLibraryTest, AsyncLoadReportsMissingPreset) {
+    ParameterGroup params("Synth");
+    PresetManager manager;
+    manager.setSerializer(std::make_shared<JsonSerializer>());
+    manager.setPresetDirectory(directory);
+
+    PresetMorpher morpher(params);
+    ASSERT_TRUE(manager.loadPresetAsync("Missing", morpher));
+    manager.waitForLoad();
+    EXPECT_FALSE(manager.getLastError().empty());
+    EXPECT_FALSE(morpher.isMorphing());
+}
+
 } // namespace test
 } // namespace nap
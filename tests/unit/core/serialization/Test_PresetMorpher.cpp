@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+#include "core/serialization/PresetMorpher.h"
+#include "core/parameters/BoolParameter.h"
+#include "core/parameters/EnumParameter.h"
+#include "core/parameters/FloatParameter.h"
+#include "core/parameters/IntParameter.h"
+#include "core/parameters/TriggerParameter.h"
+
+namespace nap {
+namespace test {
+
+class PresetMorpherTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        root = std::make_unique<ParameterGroup>("Root");
+        cutoff = std::make_shared<FloatParameter>("Cutoff", 0.0f, 0.0f, 100.0f);
+        resonance = std::make_shared<FloatParameter>("Resonance", 0.0f, 0.0f, 1.0f);
+        voices = std::make_shared<IntParameter>("Voices", 1, 1, 16);
+        root->addParameter(cutoff);
+        root->addParameter(std::make_shared<TriggerParameter>("Reset"));
+        root->addParameter(resonance);
+        root->addParameter(voices);
+
+        auto osc = std::make_unique<ParameterGroup>("Osc");
+        wave = std::make_shared<EnumParameter>("Wave", std::vector<std::string>{"Sine", "Saw", "Square"});
+        sync = std::make_shared<BoolParameter>("Sync", false);
+        osc->addParameter(wave);
+        osc->addParameter(sync);
+        root->addGroup(std::move(osc));
+    }
+
+    // Cutoff, Resonance, Voices, Osc/Wave, Osc/Sync
+    static std::unique_ptr<StateVector> makeTarget(PresetMorpher& morpher, float cutoffValue,
+                                                   float resonanceValue, float voicesValue) {
+        auto target = morpher.createState();
+        const auto& layout = morpher.getLayout();
+        (*target)[layout.indexOf("Cutoff")] = cutoffValue;
+        (*target)[layout.indexOf("Resonance")] = resonanceValue;
+        (*target)[layout.indexOf("Voices")] = voicesValue;
+        (*target)[layout.indexOf("Osc/Wave")] = 2.0f;
+        (*target)[layout.indexOf("Osc/Sync")] = 1.0f;
+        return target;
+    }
+
+    std::unique_ptr<ParameterGroup> root;
+    std::shared_ptr<FloatParameter> cutoff;
+    std::shared_ptr<FloatParameter> resonance;
+    std::shared_ptr<IntParameter> voices;
+    std::shared_ptr<EnumParameter> wave;
+    std::shared_ptr<BoolParameter> sync;
+};
+
+TEST_F(PresetMorpherTest, LayoutSkipsTriggersAndFlattensGroups) {
+    ParameterStateLayout layout(*root);
+    ASSERT_EQ(layout.size(), 5u);
+    EXPECT_EQ(layout.indexOf("Cutoff"), 0u);
+    EXPECT_EQ(layout.indexOf("Resonance"), 1u);
+    EXPECT_EQ(layout.indexOf("Osc/Sync"), 4u);
+    EXPECT_EQ(layout.indexOf("Reset"), ParameterStateLayout::npos);
+    EXPECT_EQ(layout.indexOf(*root, root->getHandle("Voices")), 2u);
+    EXPECT_EQ(layout.indexOf(*root->getGroup("Osc"), root->getGroup("Osc")->getHandle("Wave")), 3u);
+
+    EXPECT_FALSE(layout.isStepped(0));
+    EXPECT_TRUE(layout.isStepped(2));
+    EXPECT_EQ(layout.getSteppedIndices(), (std::vector<size_t>{2, 3, 4}));
+}
+
+TEST_F(PresetMorpherTest, LayoutCaptureAndApplyRoundTrip) {
+    ParameterStateLayout layout(*root);
+    cutoff->setValue(42.0f);
+    wave->setSelectedIndex(1);
+
+    StateVector state;
+    layout.capture(state);
+    EXPECT_FLOAT_EQ(state[0], 42.0f);
+    EXPECT_FLOAT_EQ(state[3], 1.0f);
+
+    int callbacks = 0;
+    cutoff->setChangeCallback([&](float, float) { ++callbacks; });
+    state[0] = 10.0f;
+    state[4] = 1.0f;
+    EXPECT_EQ(layout.apply(state), 5u);
+    EXPECT_FLOAT_EQ(cutoff->getValue(), 10.0f);
+    EXPECT_TRUE(sync->getValue());
+    EXPECT_EQ(callbacks, 0);
+}
+
+TEST_F(PresetMorpherTest, MorphIsLinearAndEndsOnTarget) {
+    PresetMorpher morpher(*root);
+    ASSERT_TRUE(morpher.morphTo(makeTarget(morpher, 100.0f, 1.0f, 8.0f), 4));
+    EXPECT_TRUE(morpher.isMorphing());
+
+    const float expected[] = {25.0f, 50.0f, 75.0f};
+    for (float value : expected) {
+        EXPECT_TRUE(morpher.process());
+        EXPECT_NEAR(cutoff->getValue(), value, 1e-4f);
+        // Stepped parameters hold until the last block
+        EXPECT_EQ(voices->getValue(), 1);
+        EXPECT_EQ(wave->getSelectedIndex(), 0u);
+        EXPECT_FALSE(sync->getValue());
+    }
+
+    EXPECT_FALSE(morpher.process());
+    EXPECT_FLOAT_EQ(cutoff->getValue(), 100.0f);
+    EXPECT_FLOAT_EQ(resonance->getValue(), 1.0f);
+    EXPECT_EQ(voices->getValue(), 8);
+    EXPECT_EQ(wave->getSelectedIndex(), 2u);
+    EXPECT_TRUE(sync->getValue());
+    EXPECT_FALSE(morpher.isMorphing());
+    EXPECT_EQ(morpher.getCompletedMorphCount(), 1u);
+
+    EXPECT_FALSE(morpher.process());
+}
+
+TEST_F(PresetMorpherTest, ZeroBlocksSwitchesImmediately) {
+    PresetMorpher morpher(*root);
+    ASSERT_TRUE(morpher.morphTo(makeTarget(morpher, 60.0f, 0.5f, 4.0f), 0));
+    EXPECT_FALSE(morpher.process());
+    EXPECT_FLOAT_EQ(cutoff->getValue(), 60.0f);
+    EXPECT_EQ(voices->getValue(), 4);
+}
+
+TEST_F(PresetMorpherTest, NewTargetRestartsFromCurrentValues) {
+    PresetMorpher morpher(*root);
+    ASSERT_TRUE(morpher.morphTo(makeTarget(morpher, 100.0f, 0.0f, 1.0f), 4));
+    morpher.process();
+    morpher.process();
+    ASSERT_NEAR(cutoff->getValue(), 50.0f, 1e-4f);
+
+    ASSERT_TRUE(morpher.morphTo(makeTarget(morpher, 0.0f, 0.0f, 1.0f), 2));
+    EXPECT_TRUE(morpher.process());
+    EXPECT_NEAR(cutoff->getValue(), 25.0f, 1e-4f);
+    EXPECT_FALSE(morpher.process());
+    EXPECT_FLOAT_EQ(cutoff->getValue(), 0.0f);
+    EXPECT_EQ(morpher.getCompletedMorphCount(), 1u);
+}
+
+TEST_F(PresetMorpherTest, OnlyNewestQueuedTargetIsApplied) {
+    PresetMorpher morpher(*root);
+    ASSERT_TRUE(morpher.morphTo(makeTarget(morpher, 10.0f, 0.0f, 1.0f), 0));
+    ASSERT_TRUE(morpher.morphTo(makeTarget(morpher, 20.0f, 0.0f, 1.0f), 0));
+    morpher.process();
+    EXPECT_FLOAT_EQ(cutoff->getValue(), 20.0f);
+}
+
+TEST_F(PresetMorpherTest, RejectsMismatchedAndExcessStates) {
+    PresetMorpher morpher(*root, 2);
+    EXPECT_FALSE(morpher.morphTo(nullptr, 1));
+    EXPECT_FALSE(morpher.morphTo(std::make_unique<StateVector>(), 1));
+
+    size_t accepted = 0;
+    while (morpher.morphTo(morpher.createState(), 1) && accepted < 100) ++accepted;
+    EXPECT_GE(accepted, 2u);
+    EXPECT_LT(accepted, 100u);
+
+    // Once the audio thread has consumed them there is room again
+    morpher.process();
+    EXPECT_TRUE(morpher.morphTo(morpher.createState(), 1));
+}
+
+} // namespace test
+} // namespace nap
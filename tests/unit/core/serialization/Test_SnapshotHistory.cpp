@@ -0,0 +1,216 @@
+#include <gtest/gtest.h>
+#include "core/serialization/SnapshotHistory.h"
+#include "core/serialization/StateVector.h"
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+namespace nap {
+namespace test {
+
+namespace {
+
+StateVector makeState(size_t size, float base) {
+    StateVector state;
+    for (size_t i = 0; i < size; ++i) {
+        state.pushFloat(base + static_cast<float>(i));
+    }
+    return state;
+}
+
+} // namespace
+
+TEST(SnapshotHistoryTest, RestoresEverySnapshot) {
+    SnapshotHistory history(64, 128, 8);
+    StateVector state = makeState(64, 0.0f);
+
+    std::vector<StateVector> expected;
+    for (int i = 0; i < 40; ++i) {
+        state[static_cast<size_t>(i) % 64] += 1.5f;
+        const uint64_t sequence = history.capture(state);
+        EXPECT_EQ(sequence, static_cast<uint64_t>(i + 1));
+        expected.push_back(state);
+    }
+
+    StateVector restored;
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_TRUE(history.restore(i + 1, restored)) << i;
+        EXPECT_EQ(restored, expected[i]) << i;
+    }
+    EXPECT_FALSE(history.restore(0, restored));
+    EXPECT_FALSE(history.restore(41, restored));
+}
+
+TEST(SnapshotHistoryTest, UnchangedStateStoresNothing) {
+    SnapshotHistory history(16);
+    StateVector state = makeState(16, 1.0f);
+    EXPECT_EQ(history.capture(state), 1u);
+    const size_t words = history.getStoredWords();
+    EXPECT_EQ(history.capture(state), 1u);
+    EXPECT_EQ(history.getStoredWords(), words);
+
+    StateVector wrongSize = makeState(3, 0.0f);
+    EXPECT_EQ(history.capture(wrongSize), 0u);
+}
+
+TEST(SnapshotHistoryTest, SmallChangesAreStoredAsDiffs) {
+    SnapshotHistory history(1000, 256, 64);
+    StateVector state = makeState(1000, 0.0f);
+    history.capture(state);
+    EXPECT_EQ(history.getStoredWords(), 1000u);
+
+    for (int i = 0; i < 10; ++i) {
+        state[7] += 0.25f;
+        history.capture(state);
+    }
+    // One index/XOR pair per capture instead of ten full copies
+    EXPECT_EQ(history.getStoredWords(), 1000u + 10u * 2u);
+}
+
+TEST(SnapshotHistoryTest, OldSnapshotsAreOverwritten) {
+    SnapshotHistory history(32, 16, 4, 256);
+    StateVector state = makeState(32, 0.0f);
+    for (int i = 0; i < 200; ++i) {
+        state[static_cast<size_t>(i) % 32] = static_cast<float>(i) + 0.5f;
+        history.capture(state);
+    }
+    ASSERT_EQ(history.getLatestSequence(), 200u);
+
+    const uint64_t oldest = history.getOldestSequence();
+    EXPECT_GT(oldest, 1u);
+    EXPECT_LE(history.getLatestSequence() - oldest, 16u);
+
+    StateVector restored;
+    EXPECT_FALSE(history.restore(1, restored));
+    ASSERT_TRUE(history.restore(200, restored));
+    EXPECT_EQ(restored, state);
+    EXPECT_TRUE(history.restore(oldest, restored));
+}
+
+TEST(SnapshotHistoryTest, EvictedKeyframeIsReplacedByTheNextCapture) {
+    // Default arena with dense deltas, and a ring shorter than the keyframe interval
+    struct Case { size_t maxSnapshots; uint32_t interval; };
+    for (const Case c : {Case{SnapshotHistory::kDefaultMaxSnapshots, 32}, Case{4, 32}}) {
+        SnapshotHistory history(100, c.maxSnapshots, c.interval);
+        StateVector state = makeState(100, 0.0f);
+        std::vector<StateVector> expected;
+        for (int i = 0; i < 60; ++i) {
+            // About 40% of the slots change per capture
+            for (size_t j = 0; j < 40; ++j) {
+                state[(static_cast<size_t>(i) * 7 + j) % 100] += 1.0f;
+            }
+            ASSERT_EQ(history.capture(state), static_cast<uint64_t>(i + 1));
+            expected.push_back(state);
+
+            const uint64_t oldest = history.getOldestSequence();
+            ASSERT_NE(oldest, 0u) << "capture " << i + 1;
+            StateVector restored;
+            for (uint64_t s = oldest; s <= history.getLatestSequence(); ++s) {
+                ASSERT_TRUE(history.restore(s, restored)) << "sequence " << s;
+                EXPECT_EQ(restored, expected[s - 1]) << "sequence " << s;
+            }
+        }
+    }
+}
+
+TEST(SnapshotHistoryTest, ConcurrentRestoreNeverSeesTornState) {
+    constexpr size_t kSize = 48;
+    SnapshotHistory history(kSize, 32, 8, kSize * 4);
+    std::atomic<bool> done{false};
+
+    // Every value of a captured state equals the same counter
+    std::thread writer([&]() {
+        StateVector state;
+        state.resize(kSize);
+        for (int i = 1; i <= 20000; ++i) {
+            for (size_t k = 0; k < kSize; ++k) {
+                state[k] = static_cast<float>(i);
+            }
+            history.capture(state);
+        }
+        done = true;
+    });
+
+    StateVector restored;
+    size_t restores = 0;
+    while (!done) {
+        const uint64_t sequence = history.getLatestSequence();
+        if (sequence && history.restore(sequence, restored)) {
+            for (size_t k = 1; k < kSize; ++k) {
+                ASSERT_EQ(restored[k], restored[0]);
+            }
+            ++restores;
+        }
+    }
+    writer.join();
+    EXPECT_GT(restores, 0u);
+}
+
+TEST(SnapshotHistoryTest, PersistsAndRecovers) {
+    const std::string path = ::testing::TempDir() + "nap_snapshot_history_test.naph";
+    SnapshotHistory history(20, 64, 4);
+    ASSERT_TRUE(history.startPersisting(path, 1));
+    EXPECT_TRUE(history.isPersisting());
+
+    StateVector state = makeState(20, 0.0f);
+    for (int i = 0; i < 50; ++i) {
+        state[static_cast<size_t>(i) % 20] = static_cast<float>(i) * 0.5f;
+        history.capture(state);
+    }
+    history.stopPersisting();
+    EXPECT_FALSE(history.isPersisting());
+    EXPECT_EQ(history.getPersistedSequence(), 50u);
+
+    StateVector recovered;
+    uint64_t sequence = 0;
+    ASSERT_TRUE(SnapshotHistory::recover(path, recovered, &sequence));
+    EXPECT_EQ(sequence, 50u);
+    EXPECT_EQ(recovered, state);
+    std::remove(path.c_str());
+}
+
+TEST(SnapshotHistoryTest, PersistingCatchesUpAfterFallingBehind) {
+    const std::string path = ::testing::TempDir() + "nap_snapshot_behind_test.naph";
+    SnapshotHistory history(16, 8, 4, 64);
+    StateVector state = makeState(16, 0.0f);
+
+    // Captures made before persisting starts have long left the ring
+    for (int i = 0; i < 100; ++i) {
+        state[static_cast<size_t>(i) % 16] = static_cast<float>(i);
+        history.capture(state);
+    }
+    ASSERT_TRUE(history.startPersisting(path, 1000));
+    history.stopPersisting();
+
+    StateVector recovered;
+    ASSERT_TRUE(SnapshotHistory::recover(path, recovered));
+    EXPECT_EQ(recovered, state);
+    std::remove(path.c_str());
+}
+
+TEST(SnapshotHistoryTest, RecoverIgnoresTruncatedTail) {
+    const std::string path = ::testing::TempDir() + "nap_snapshot_truncated_test.naph";
+    StateVector state = makeState(8, 0.0f);
+    {
+        SnapshotHistory history(8, 64, 4);
+        ASSERT_TRUE(history.startPersisting(path, 1000));
+        history.capture(state);
+        history.stopPersisting();
+    }
+    {
+        // Half of a record, as left by a crash mid-write
+        std::ofstream file(path, std::ios::binary | std::ios::app);
+        const char partial[10] = {};
+        file.write(partial, sizeof(partial));
+    }
+
+    StateVector recovered;
+    ASSERT_TRUE(SnapshotHistory::recover(path, recovered));
+    EXPECT_EQ(recovered, state);
+    EXPECT_FALSE(SnapshotHistory::recover(path + ".missing", recovered));
+    std::remove(path.c_str());
+}
+
+} // namespace test
+} // namespace nap
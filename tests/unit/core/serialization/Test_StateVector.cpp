@@ -144,6 +144,34 @@ TEST_F(StateVectorTest, Lerp) {
     EXPECT_FLOAT_EQ(result.getFloat(1), 10.0f);
 }
 
+TEST_F(StateVectorTest, LerpTowardsInPlace) {
+    StateVector target;
+    for (int i = 0; i < 11; ++i) {
+        vec->pushFloat(static_cast<float>(i));
+        target.pushFloat(static_cast<float>(i) + 10.0f);
+    }
+    const float* storage = vec->data();
+
+    EXPECT_TRUE(vec->lerpTowards(target, 0.25f));
+    EXPECT_EQ(vec->data(), storage);
+    for (size_t i = 0; i < vec->size(); ++i) {
+        EXPECT_FLOAT_EQ(vec->getFloat(i), static_cast<float>(i) + 2.5f);
+    }
+
+    StateVector shorter;
+    shorter.pushFloat(1.0f);
+    EXPECT_FALSE(vec->lerpTowards(shorter, 0.5f));
+}
+
+TEST_F(StateVectorTest, LerpKernelHandlesTail) {
+    float a[7] = {0, 1, 2, 3, 4, 5, 6};
+    const float b[7] = {2, 3, 4, 5, 6, 7, 8};
+    StateVector::lerp(a, b, a, 7, 0.5f);
+    for (int i = 0; i < 7; ++i) {
+        EXPECT_FLOAT_EQ(a[i], static_cast<float>(i) + 1.0f);
+    }
+}
+
 TEST_F(StateVectorTest, ToAndFromBytes) {
     vec->pushFloat(1.5f);
     vec->pushFloat(2.5f);
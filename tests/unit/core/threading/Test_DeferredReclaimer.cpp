@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include "../../../../src/core/threading/DeferredReclaimer.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace nap {
+namespace test {
+
+namespace {
+
+struct Tracked {
+    explicit Tracked(std::atomic<int>& counter) : destroyed(counter) {}
+    ~Tracked() { destroyed.fetch_add(1); }
+    std::atomic<int>& destroyed;
+};
+
+} // namespace
+
+class DeferredReclaimerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        reclaimer = std::make_unique<DeferredReclaimer>(8);
+    }
+
+    std::unique_ptr<DeferredReclaimer> reclaimer;
+    std::atomic<int> destroyed{0};
+};
+
+TEST_F(DeferredReclaimerTest, RetireDefersDestruction) {
+    auto object = std::make_shared<Tracked>(destroyed);
+    EXPECT_TRUE(reclaimer->retire(std::move(object)));
+
+    EXPECT_EQ(destroyed.load(), 0);
+    EXPECT_EQ(reclaimer->getPendingCount(), 1u);
+
+    EXPECT_EQ(reclaimer->collect(), 1u);
+    EXPECT_EQ(destroyed.load(), 1);
+    EXPECT_EQ(reclaimer->getPendingCount(), 0u);
+    EXPECT_EQ(reclaimer->getReclaimedCount(), 1u);
+}
+
+TEST_F(DeferredReclaimerTest, RetireUniquePtr) {
+    EXPECT_TRUE(reclaimer->retire(std::make_unique<Tracked>(destroyed)));
+    reclaimer->collect();
+    EXPECT_EQ(destroyed.load(), 1);
+}
+
+TEST_F(DeferredReclaimerTest, InFlightBlockKeepsObjectAlive) {
+    const int reader = reclaimer->registerReader();
+    ASSERT_GE(reader, 0);
+
+    reclaimer->enterBlock(reader);
+    reclaimer->retire(std::make_unique<Tracked>(destroyed));
+
+    EXPECT_EQ(reclaimer->collect(), 0u);
+    EXPECT_EQ(destroyed.load(), 0);
+
+    reclaimer->exitBlock(reader);
+    EXPECT_EQ(reclaimer->collect(), 1u);
+    EXPECT_EQ(destroyed.load(), 1);
+
+    reclaimer->unregisterReader(reader);
+}
+
+TEST_F(DeferredReclaimerTest, LaterBlockDoesNotPinOlderObjects) {
+    const int reader = reclaimer->registerReader();
+
+    {
+        ReclaimerBlockGuard guard(*reclaimer, reader);
+        reclaimer->retire(std::make_unique<Tracked>(destroyed));
+    }
+    reclaimer->collect();
+
+    // A block entered after the retire epoch has passed cannot hold it
+    ReclaimerBlockGuard guard(*reclaimer, reader);
+    reclaimer->collect();
+    EXPECT_EQ(destroyed.load(), 1);
+}
+
+TEST_F(DeferredReclaimerTest, OverflowLeavesObjectWithCaller) {
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_TRUE(reclaimer->retire(std::make_unique<Tracked>(destroyed)));
+    }
+
+    // Nothing is destroyed on the retiring thread; the caller keeps ownership
+    auto unique = std::make_unique<Tracked>(destroyed);
+    EXPECT_FALSE(reclaimer->retire(std::move(unique)));
+    EXPECT_NE(unique, nullptr);
+    auto shared = std::make_shared<Tracked>(destroyed);
+    EXPECT_FALSE(reclaimer->retire(std::move(shared)));
+    EXPECT_NE(shared, nullptr);
+    EXPECT_EQ(destroyed.load(), 0);
+    EXPECT_EQ(reclaimer->getOverflowCount(), 2u);
+
+    // Once the worker drains the ring the retry succeeds
+    EXPECT_EQ(reclaimer->collect(), 8u);
+    EXPECT_TRUE(reclaimer->retire(std::move(unique)));
+    EXPECT_TRUE(reclaimer->retire(std::move(shared)));
+    EXPECT_EQ(unique, nullptr);
+    EXPECT_EQ(shared, nullptr);
+    EXPECT_EQ(reclaimer->collect(), 2u);
+    EXPECT_EQ(destroyed.load(), 10);
+}
+
+TEST_F(DeferredReclaimerTest, CollectKeepsOnlyPinnedObjects) {
+    DeferredReclaimer large(256);
+    const int reader = large.registerReader();
+
+    // The first batch is pinned by the block it was retired in
+    large.enterBlock(reader);
+    for (int i = 0; i < 100; ++i) {
+        large.retire(std::make_unique<Tracked>(destroyed));
+    }
+    EXPECT_EQ(large.collect(), 0u);
+    large.exitBlock(reader);
+
+    // The second batch is pinned by a newer block; only the first is freed
+    large.enterBlock(reader);
+    for (int i = 0; i < 100; ++i) {
+        large.retire(std::make_unique<Tracked>(destroyed));
+    }
+    EXPECT_EQ(large.collect(), 100u);
+    EXPECT_EQ(large.getPendingCount(), 100u);
+    EXPECT_EQ(destroyed.load(), 100);
+
+    large.exitBlock(reader);
+    EXPECT_EQ(large.collect(), 100u);
+    EXPECT_EQ(destroyed.load(), 200);
+    large.unregisterReader(reader);
+}
+
+TEST_F(DeferredReclaimerTest, BackgroundWorkerReclaims) {
+    EXPECT_TRUE(reclaimer->start(1));
+    EXPECT_TRUE(reclaimer->isRunning());
+
+    reclaimer->retire(std::make_unique<Tracked>(destroyed));
+
+    for (int i = 0; i < 500 && destroyed.load() == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(destroyed.load(), 1);
+
+    reclaimer->stop();
+    EXPECT_FALSE(reclaimer->isRunning());
+}
+
+TEST_F(DeferredReclaimerTest, DestructorFreesPendingObjects) {
+    reclaimer->retire(std::make_unique<Tracked>(destroyed));
+    reclaimer.reset();
+    EXPECT_EQ(destroyed.load(), 1);
+}
+
+} // namespace test
+} // namespace nap
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include "../../../../src/core/threading/SpinLock.h"
+#include <chrono>
 #include <thread>
+#include <vector>
 
 namespace nap {
 namespace test {
@@ -40,5 +42,66 @@ TEST_F(SpinLockTest, TryGuardWorks) {
     EXPECT_TRUE(guard.ownsLock());
 }
 
+TEST_F(SpinLockTest, CountsAcquiresAndTryLockFailures) {
+    lock.lock();
+    EXPECT_FALSE(lock.tryLock());
+    lock.unlock();
+    EXPECT_TRUE(lock.tryLock());
+    lock.unlock();
+
+    auto stats = lock.getStatistics();
+    EXPECT_EQ(stats.acquireCount, 2u);
+    EXPECT_EQ(stats.tryLockFailures, 1u);
+
+    lock.resetStatistics();
+    EXPECT_EQ(lock.getStatistics().acquireCount, 0u);
+}
+
+TEST_F(SpinLockTest, TracksMaxHoldTimeWhenEnabled) {
+    lock.setHoldTimeTracking(true);
+    lock.lock();
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    lock.unlock();
+
+    EXPECT_GE(lock.getStatistics().maxHoldTimeNs, 1000000u);
+}
+
+TEST_F(SpinLockTest, TicketModeLocksAndUnlocks) {
+    SpinLock ticket(SpinLock::Mode::Ticket);
+    EXPECT_EQ(ticket.getMode(), SpinLock::Mode::Ticket);
+
+    ticket.lock();
+    EXPECT_TRUE(ticket.isLocked());
+    EXPECT_FALSE(ticket.tryLock());
+    ticket.unlock();
+    EXPECT_FALSE(ticket.isLocked());
+    EXPECT_TRUE(ticket.tryLock());
+    ticket.unlock();
+}
+
+TEST_F(SpinLockTest, ProvidesMutualExclusionInBothModes) {
+    for (auto mode : {SpinLock::Mode::TestAndTestAndSet, SpinLock::Mode::Ticket}) {
+        SpinLock contended(mode);
+        int counter = 0;
+        constexpr int kIterations = 5000;
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&]() {
+                for (int i = 0; i < kIterations; ++i) {
+                    SpinLockGuard guard(contended);
+                    ++counter;
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        EXPECT_EQ(counter, 4 * kIterations);
+        EXPECT_EQ(contended.getStatistics().acquireCount, 4u * kIterations);
+    }
+}
+
 } // namespace test
 } // namespace nap
@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include "../../../../src/core/threading/SpinParkEvent.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace nap {
+namespace test {
+
+TEST(SpinParkEventTest, WaitReturnsImmediatelyIfAlreadyNotified) {
+    SpinParkEvent event;
+    const auto epoch = event.prepareWait();
+    event.notifyOne();
+    EXPECT_TRUE(event.wait(epoch, 10));
+}
+
+TEST(SpinParkEventTest, WaitTimesOutWithoutNotify) {
+    SpinParkEvent event(100);
+    EXPECT_FALSE(event.wait(event.prepareWait(), 5));
+    EXPECT_EQ(event.getStatistics().timeoutCount, 1u);
+}
+
+TEST(SpinParkEventTest, ParkedWaiterIsWoken) {
+    SpinParkEvent event(0);
+    std::atomic<bool> woke{false};
+
+    std::thread waiter([&]() {
+        const auto epoch = event.prepareWait();
+        woke = event.wait(epoch, 2000);
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    event.notifyAll();
+    waiter.join();
+
+    EXPECT_TRUE(woke.load());
+    auto stats = event.getStatistics();
+    EXPECT_EQ(stats.parkedWakeCount, 1u);
+    EXPECT_GT(stats.maxLatencyNs, 0.0);
+}
+
+TEST(SpinParkEventTest, SpinIterationsAreConfigurable) {
+    SpinParkEvent event;
+    EXPECT_EQ(event.getSpinIterations(), SpinParkEvent::kDefaultSpinIterations);
+    event.setSpinIterations(16);
+    EXPECT_EQ(event.getSpinIterations(), 16u);
+}
+
+} // namespace test
+} // namespace nap
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include "../../../../src/core/threading/SpscQueue.h"
+#include <thread>
+
+namespace nap {
+namespace test {
+
+TEST(SpscQueueTest, RoundsCapacityUpToPowerOfTwo) {
+    SpscQueue<int> queue(5);
+    EXPECT_EQ(queue.getCapacity(), 8u);
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST(SpscQueueTest, PreservesOrderAndRejectsWhenFull) {
+    SpscQueue<int> queue(4);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.push(i));
+    }
+    EXPECT_FALSE(queue.push(4));
+    EXPECT_EQ(queue.size(), 4u);
+
+    int value = -1;
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(queue.pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.pop(value));
+}
+
+TEST(SpscQueueTest, TransfersAcrossThreadsInOrder) {
+    SpscQueue<int> queue(64);
+    constexpr int kCount = 100000;
+
+    std::thread producer([&]() {
+        for (int i = 0; i < kCount; ++i) {
+            while (!queue.push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int expected = 0;
+    int value = 0;
+    while (expected < kCount) {
+        if (queue.pop(value)) {
+            ASSERT_EQ(value, expected);
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+} // namespace test
+} // namespace nap
@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 #include "../../../../src/core/threading/TaskQueue.h"
+#include <atomic>
+#include <thread>
+#include <vector>
 
 namespace nap {
 namespace test {
@@ -51,5 +54,75 @@ TEST_F(TaskQueueTest, ClearRemovesAllTasks) {
     EXPECT_TRUE(queue->isEmpty());
 }
 
+TEST_F(TaskQueueTest, PushFailsWhenFull) {
+    TaskQueue small(4);
+    EXPECT_EQ(small.getCapacity(), 4u);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(small.push([]() {}));
+    }
+    EXPECT_TRUE(small.isFull());
+    EXPECT_FALSE(small.push([]() {}));
+}
+
+TEST_F(TaskQueueTest, CapacityRoundsUpToPowerOfTwo) {
+    TaskQueue odd(100);
+    EXPECT_EQ(odd.getCapacity(), 128u);
+}
+
+TEST_F(TaskQueueTest, AcceptsMoveOnlyCaptures) {
+    auto value = std::make_unique<int>(7);
+    int result = 0;
+    queue->push([v = std::move(value), &result]() { result = *v; });
+
+    EXPECT_EQ(queue->executeAll(), 1u);
+    EXPECT_EQ(result, 7);
+}
+
+TEST_F(TaskQueueTest, PopTimesOutWhenEmpty) {
+    TaskQueue::Task task;
+    EXPECT_FALSE(queue->pop(task, 5));
+}
+
+TEST_F(TaskQueueTest, MultipleProducersAndConsumersRunEveryTask) {
+    constexpr int kProducers = 4;
+    constexpr int kTasksPerProducer = 2000;
+    std::atomic<int> executed{0};
+    std::atomic<bool> producing{true};
+
+    std::vector<std::thread> consumers;
+    for (int c = 0; c < 2; ++c) {
+        consumers.emplace_back([&]() {
+            TaskQueue::Task task;
+            while (producing.load() || !queue->isEmpty()) {
+                if (queue->tryPop(task)) {
+                    task();
+                    task.reset();
+                }
+            }
+        });
+    }
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&]() {
+            for (int i = 0; i < kTasksPerProducer; ++i) {
+                while (!queue->push([&executed]() { executed.fetch_add(1); })) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for (auto& t : producers) {
+        t.join();
+    }
+    producing.store(false);
+    for (auto& t : consumers) {
+        t.join();
+    }
+
+    EXPECT_EQ(executed.load(), kProducers * kTasksPerProducer);
+}
+
 } // namespace test
 } // namespace nap
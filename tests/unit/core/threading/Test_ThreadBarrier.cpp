@@ -61,5 +61,66 @@ TEST_F(ThreadBarrierTest, CompletionFunctionIsCalled) {
     EXPECT_TRUE(called);
 }
 
+TEST_F(ThreadBarrierTest, WaitForTimesOutAndWithdraws) {
+    EXPECT_FALSE(barrier->waitFor(5));
+    EXPECT_EQ(barrier->getWaitingCount(), 0);
+}
+
+TEST_F(ThreadBarrierTest, ReusableAcrossGenerations) {
+    constexpr int kRounds = 200;
+    std::atomic<int> completions{0};
+    barrier->setCompletionFunction([&completions]() { completions++; });
+
+    auto worker = [this]() {
+        for (int i = 0; i < kRounds; ++i) {
+            barrier->wait();
+        }
+    };
+    std::thread t1(worker);
+    std::thread t2(worker);
+    t1.join();
+    t2.join();
+
+    EXPECT_EQ(completions.load(), kRounds);
+    EXPECT_EQ(barrier->getGeneration(), static_cast<std::uint64_t>(kRounds));
+    EXPECT_GT(barrier->getWakeStatistics().wakeCount, 0u);
+}
+
+TEST_F(ThreadBarrierTest, EveryRoundStartsFromZeroArrivals) {
+    constexpr int kRounds = 200;
+    ThreadBarrier three(3);
+    std::atomic<int> arrivals{0};
+    std::atomic<int> completions{0};
+    std::atomic<bool> mismatch{false};
+    three.setCompletionFunction([&]() {
+        // No thread may leave, or be counted in the next round, before this
+        if (arrivals.load() != 3 * (completions.load() + 1)) {
+            mismatch = true;
+        }
+        completions++;
+    });
+
+    auto worker = [&]() {
+        for (int i = 0; i < kRounds; ++i) {
+            arrivals++;
+            three.wait();
+            if (completions.load() <= i) {
+                mismatch = true;
+            }
+        }
+    };
+    std::thread t1(worker);
+    std::thread t2(worker);
+    std::thread t3(worker);
+    t1.join();
+    t2.join();
+    t3.join();
+
+    EXPECT_FALSE(mismatch.load());
+    EXPECT_EQ(completions.load(), kRounds);
+    EXPECT_EQ(three.getWaitingCount(), 0u);
+    EXPECT_EQ(three.getGeneration(), static_cast<std::uint64_t>(kRounds));
+}
+
 } // namespace test
 } // namespace nap
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include "../../../../src/core/threading/WorkerThread.h"
 #include <atomic>
+#include <chrono>
+#include <thread>
 
 namespace nap {
 namespace test {
@@ -44,9 +46,79 @@ TEST_F(WorkerThreadTest, ExecutesTask) {
     EXPECT_GE(counter.load(), 1);
 }
 
+TEST_F(WorkerThreadTest, WakeDuringTaskRunsItAgain) {
+    std::atomic<int> runs{0};
+    std::atomic<bool> entered{false};
+    std::atomic<bool> proceed{false};
+    worker->setTask([&]() {
+        if (runs++ == 0) {
+            entered = true;
+            while (!proceed) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    worker->start();
+    worker->wake();
+    while (!entered) {
+        std::this_thread::yield();
+    }
+
+    // Arrives while the first run is still in progress
+    worker->wake();
+    proceed = true;
+    ASSERT_TRUE(worker->waitForCompletion(5000));
+    EXPECT_EQ(runs.load(), 2);
+}
+
 TEST_F(WorkerThreadTest, HasCorrectName) {
     EXPECT_EQ(worker->getName(), "TestWorker");
 }
 
+TEST_F(WorkerThreadTest, ReportsPrefaultedStack) {
+    worker->setStackPrefaultSize(64 * 1024);
+    worker->setTask([]() {});
+    worker->start();
+    worker->wake();
+    worker->waitForCompletion(1000);
+
+    EXPECT_GE(worker->getSchedulingReport().prefaultedStackBytes, 64u * 1024u);
+}
+
+TEST_F(WorkerThreadTest, RealtimeRequestIsReportedOrFallsBack) {
+    WorkerThread rt("RtWorker", WorkerThread::Priority::Realtime);
+    rt.setRealtimePolicy(WorkerThread::RealtimePolicy::RoundRobin);
+    rt.setTask([]() {});
+    rt.start();
+    rt.wake();
+    rt.waitForCompletion(1000);
+
+    auto report = rt.getSchedulingReport();
+    EXPECT_EQ(report.requestedPriority, WorkerThread::Priority::Realtime);
+    if (report.realtimeGranted) {
+        EXPECT_GT(report.osPriority, 0);
+    } else {
+        EXPECT_EQ(report.osPriority, 0);
+    }
+    rt.stop(true);
+}
+
+TEST_F(WorkerThreadTest, AffinityAppliedWhileRunning) {
+    worker->setTask([]() {});
+    worker->start();
+    worker->wake();
+    worker->waitForCompletion(1000);
+
+    const std::uint64_t allowed = worker->getSchedulingReport().affinityMask;
+    if (allowed == 0) {
+        GTEST_SKIP() << "CPU affinity not supported on this platform";
+    }
+
+    // Pin to the lowest CPU the process is allowed to use
+    const std::uint64_t lowest = allowed & (~allowed + 1);
+    EXPECT_TRUE(worker->setAffinity(lowest));
+    EXPECT_EQ(worker->getSchedulingReport().affinityMask, lowest);
+}
+
 } // namespace test
 } // namespace nap
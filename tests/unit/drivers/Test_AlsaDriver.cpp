@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "drivers/AlsaDriver.h"
+#include "drivers/FakePcmDevice.h"
 
 namespace nap {
 namespace test {
@@ -104,5 +105,171 @@ TEST_F(AlsaDriverTest, ConfigureWhileRunningFails) {
 #endif
 }
 
+#ifdef __linux__
+class AlsaDriverPcmTest : public AlsaDriverTest {
+protected:
+    // Stereo, 64-frame periods, 3 periods; the callback writes a per-block ramp
+    FakePcmDevice* attach(AlsaDriver::AccessMode mode, AlsaDriver::SampleFormat format) {
+        auto device = std::make_unique<FakePcmDevice>();
+        FakePcmDevice* raw = device.get();
+        driver->setPcmDevice(std::move(device));
+        driver->setHardwareParams(3, 64);
+        EXPECT_TRUE(driver->setAccessMode(mode));
+        EXPECT_TRUE(driver->setSampleFormat(format));
+
+        AudioStreamConfig config;
+        config.sampleRate = 48000.0;
+        config.bufferSize = 64;
+        config.outputChannels = 2;
+        driver->configure(config);
+        driver->setAudioCallback([this](const float*, float* output, int numFrames,
+                                        int, int numOutputChannels) {
+            for (int f = 0; f < numFrames; ++f) {
+                const float value = static_cast<float>(block % 8) * 0.1f + f * 0.001f;
+                output[f * numOutputChannels] = value;
+                output[f * numOutputChannels + 1] = -value;
+            }
+            ++block;
+        });
+
+        driver->initialize();
+        EXPECT_TRUE(driver->start());
+        return raw;
+    }
+
+    void expectPlayedBlocks(const FakePcmDevice& device, size_t blocks) {
+        ASSERT_GE(device.getPlayedFrames(), blocks * 64);
+        for (size_t b = 0; b < blocks; ++b) {
+            for (size_t f = 0; f < 64; f += 7) {
+                const float value = static_cast<float>(b % 8) * 0.1f + f * 0.001f;
+                EXPECT_NEAR(device.getPlayedSample(b * 64 + f, 0), value, 1e-4f);
+                EXPECT_NEAR(device.getPlayedSample(b * 64 + f, 1), -value, 1e-4f);
+            }
+        }
+    }
+
+    int block = 0;
+};
+
+TEST_F(AlsaDriverPcmTest, DefaultsToMmapAccess) {
+    EXPECT_EQ(driver->getAccessMode(), AlsaDriver::AccessMode::MMapInterleaved);
+    EXPECT_EQ(driver->getSampleFormat(), AlsaDriver::SampleFormat::S32_LE);
+}
+
+TEST_F(AlsaDriverPcmTest, MmapPathWritesRingWithoutCopying) {
+    FakePcmDevice* device = attach(AlsaDriver::AccessMode::MMapInterleaved,
+                                   AlsaDriver::SampleFormat::S16_LE);
+
+    // Prefill: the stream starts once all three periods are queued
+    EXPECT_TRUE(driver->processPeriod());
+    EXPECT_TRUE(driver->processPeriod());
+    EXPECT_FALSE(device->isStarted());
+    EXPECT_TRUE(driver->processPeriod());
+    EXPECT_TRUE(device->isStarted());
+    EXPECT_FALSE(driver->processPeriod());  // Ring full
+
+    // Hardware advances a period at a time; crosses the ring end twice
+    for (int i = 0; i < 7; ++i) {
+        EXPECT_EQ(device->consume(64), 64u);
+        EXPECT_TRUE(driver->processPeriod());
+    }
+
+    expectPlayedBlocks(*device, 7);
+    EXPECT_EQ(device->getCopiedBytes(), 0u);
+    EXPECT_EQ(device->getCommitCount(), 10u);
+    EXPECT_EQ(driver->getXrunCount(), 0u);
+}
+
+TEST_F(AlsaDriverPcmTest, MmapNonInterleavedAllFormats) {
+    for (auto format : {AlsaDriver::SampleFormat::S16_LE, AlsaDriver::SampleFormat::S24_LE,
+                        AlsaDriver::SampleFormat::S24_3LE, AlsaDriver::SampleFormat::S32_LE,
+                        AlsaDriver::SampleFormat::Float32_LE}) {
+        block = 0;
+        driver->stop();
+        FakePcmDevice* device = attach(AlsaDriver::AccessMode::MMapNonInterleaved, format);
+        for (int i = 0; i < 3; ++i) {
+            EXPECT_TRUE(driver->processPeriod());
+        }
+        device->consume(128);
+        expectPlayedBlocks(*device, 2);
+        EXPECT_EQ(device->getCopiedBytes(), 0u);
+    }
+}
+
+TEST_F(AlsaDriverPcmTest, RwPathCopiesThroughWrite) {
+    FakePcmDevice* device = attach(AlsaDriver::AccessMode::RWInterleaved,
+                                   AlsaDriver::SampleFormat::S32_LE);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_TRUE(driver->processPeriod());
+    }
+    device->consume(64);
+    EXPECT_TRUE(driver->processPeriod());
+    device->consume(128);
+
+    expectPlayedBlocks(*device, 3);
+    EXPECT_EQ(device->getCopiedBytes(), 4u * 64 * 2 * 4);
+    EXPECT_EQ(device->getCommitCount(), 0u);
+}
+
+TEST_F(AlsaDriverPcmTest, RwNonInterleaved) {
+    FakePcmDevice* device = attach(AlsaDriver::AccessMode::RWNonInterleaved,
+                                   AlsaDriver::SampleFormat::S24_3LE);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_TRUE(driver->processPeriod());
+    }
+    device->consume(192);
+    expectPlayedBlocks(*device, 3);
+}
+
+TEST_F(AlsaDriverPcmTest, ShortTransfersAreResumed) {
+    for (auto mode : {AlsaDriver::AccessMode::MMapInterleaved, AlsaDriver::AccessMode::RWInterleaved,
+                      AlsaDriver::AccessMode::RWNonInterleaved}) {
+        block = 0;
+        driver->stop();
+        FakePcmDevice* device = attach(mode, AlsaDriver::SampleFormat::S16_LE);
+        device->setTransferLimit(24);  // Each period takes three calls
+
+        for (int i = 0; i < 3; ++i) {
+            EXPECT_TRUE(driver->processPeriod());
+        }
+        EXPECT_TRUE(device->isStarted());
+        device->consume(192);
+        expectPlayedBlocks(*device, 3);
+    }
+}
+
+TEST_F(AlsaDriverPcmTest, UnderrunIsCountedAndRecovered) {
+    FakePcmDevice* device = attach(AlsaDriver::AccessMode::MMapInterleaved,
+                                   AlsaDriver::SampleFormat::S16_LE);
+    for (int i = 0; i < 3; ++i) {
+        driver->processPeriod();
+    }
+    device->consume(256);  // Hardware runs dry
+
+    EXPECT_FALSE(driver->processPeriod());
+    EXPECT_EQ(driver->getXrunCount(), 1u);
+
+    // Recovered: prefills and restarts
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_TRUE(driver->processPeriod());
+    }
+    EXPECT_TRUE(device->isStarted());
+}
+
+TEST_F(AlsaDriverPcmTest, FormatLockedWhileRunning) {
+    attach(AlsaDriver::AccessMode::MMapInterleaved, AlsaDriver::SampleFormat::S16_LE);
+    EXPECT_FALSE(driver->setSampleFormat(AlsaDriver::SampleFormat::S32_LE));
+    EXPECT_FALSE(driver->setAccessMode(AlsaDriver::AccessMode::RWInterleaved));
+}
+
+TEST_F(AlsaDriverPcmTest, StartFailsOnRejectedParams) {
+    driver->setPcmDevice(std::make_unique<FakePcmDevice>());
+    driver->setHardwareParams(1, 64);  // A single period is not a ring
+    driver->initialize();
+    EXPECT_FALSE(driver->start());
+    EXPECT_FALSE(driver->getLastError().empty());
+}
+#endif
+
 } // namespace test
 } // namespace nap
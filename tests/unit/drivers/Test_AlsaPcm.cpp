@@ -0,0 +1,270 @@
+#include <gtest/gtest.h>
+#include "drivers/AlsaPcm.h"
+#include "drivers/FakePcmDevice.h"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace nap {
+namespace test {
+
+namespace {
+
+std::vector<float> makeRamp(size_t count) {
+    std::vector<float> samples(count);
+    for (size_t i = 0; i < count; ++i) {
+        // Runs past [-1, 1] so clamping is exercised too
+        samples[i] = -1.25f + 2.5f * static_cast<float>(i) / static_cast<float>(count);
+    }
+    return samples;
+}
+
+float tolerance(PcmFormat format) {
+    switch (format) {
+        case PcmFormat::S16_LE: return 1.0f / 32767.0f;
+        case PcmFormat::S24_LE:
+        case PcmFormat::S24_3LE: return 1.0f / 8388607.0f;
+        default: return 1e-6f;
+    }
+}
+
+float expected(float x, PcmFormat format) {
+    if (format == PcmFormat::Float32_LE) return x;
+    return std::fmin(std::fmax(x, -1.0f), 1.0f);
+}
+
+} // namespace
+
+class PcmConversionTest : public ::testing::TestWithParam<PcmFormat> {};
+
+TEST_P(PcmConversionTest, InterleavedRoundTrip) {
+    const PcmFormat format = GetParam();
+    const size_t bytes = getPcmSampleBytes(format);
+    const size_t channels = 2;
+    const size_t frames = 37;  // Leaves a scalar tail after the vector loop
+
+    const auto src = makeRamp(frames * channels);
+    std::vector<uint8_t> ring((frames + 3) * channels * bytes, 0xAA);
+    const unsigned int bits = static_cast<unsigned int>(bytes * 8);
+    PcmChannelArea areas[2] = {{ring.data(), 0, 2 * bits}, {ring.data(), bits, 2 * bits}};
+
+    convertToPcm(src.data(), channels, frames, areas, 3, format);
+
+    for (size_t i = 0; i < frames * channels; ++i) {
+        const float decoded = decodePcmSample(ring.data() + (3 * channels + i) * bytes, format);
+        EXPECT_NEAR(decoded, expected(src[i], format), tolerance(format)) << "sample " << i;
+    }
+    // Frames before the offset are untouched
+    EXPECT_EQ(ring[0], 0xAA);
+    EXPECT_EQ(ring[3 * channels * bytes - 1], 0xAA);
+}
+
+TEST_P(PcmConversionTest, NonInterleavedRoundTrip) {
+    const PcmFormat format = GetParam();
+    const size_t bytes = getPcmSampleBytes(format);
+    const size_t channels = 3;
+    const size_t frames = 150;  // More than one gather block
+    const size_t planeFrames = 160;
+
+    const auto src = makeRamp(frames * channels);
+    std::vector<uint8_t> ring(planeFrames * channels * bytes, 0);
+    const unsigned int bits = static_cast<unsigned int>(bytes * 8);
+    std::vector<PcmChannelArea> areas;
+    for (size_t ch = 0; ch < channels; ++ch) {
+        areas.push_back({ring.data() + ch * planeFrames * bytes, 0, bits});
+    }
+
+    convertToPcm(src.data(), channels, frames, areas.data(), 5, format);
+
+    for (size_t ch = 0; ch < channels; ++ch) {
+        for (size_t f = 0; f < frames; ++f) {
+            const uint8_t* sample = ring.data() + (ch * planeFrames + 5 + f) * bytes;
+            EXPECT_NEAR(decodePcmSample(sample, format), expected(src[f * channels + ch], format),
+                        tolerance(format));
+        }
+    }
+}
+
+TEST_P(PcmConversionTest, StridedSubsetOfWiderRing) {
+    // Two channels written into slots 1 and 3 of a four-channel interleaved ring
+    const PcmFormat format = GetParam();
+    const size_t bytes = getPcmSampleBytes(format);
+    const unsigned int bits = static_cast<unsigned int>(bytes * 8);
+    const size_t frames = 9;
+
+    const auto src = makeRamp(frames * 2);
+    std::vector<uint8_t> ring(frames * 4 * bytes, 0);
+    PcmChannelArea areas[2] = {{ring.data(), bits, 4 * bits}, {ring.data(), 3 * bits, 4 * bits}};
+
+    convertToPcm(src.data(), 2, frames, areas, 0, format);
+
+    for (size_t f = 0; f < frames; ++f) {
+        EXPECT_EQ(decodePcmSample(ring.data() + (f * 4) * bytes, format), 0.0f);
+        EXPECT_NEAR(decodePcmSample(ring.data() + (f * 4 + 1) * bytes, format),
+                    expected(src[f * 2], format), tolerance(format));
+        EXPECT_NEAR(decodePcmSample(ring.data() + (f * 4 + 3) * bytes, format),
+                    expected(src[f * 2 + 1], format), tolerance(format));
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(AllFormats, PcmConversionTest,
+                         ::testing::Values(PcmFormat::S16_LE, PcmFormat::S24_LE,
+                                           PcmFormat::S24_3LE, PcmFormat::S32_LE,
+                                           PcmFormat::Float32_LE));
+
+TEST(PcmConversion, FullScaleValues) {
+    const float src[8] = {1.0f, -1.0f, 0.5f, 0.0f, 2.0f, -2.0f,
+                          std::numeric_limits<float>::quiet_NaN(), 1.0f};
+    PcmChannelArea area{nullptr, 0, 16};
+
+    int16_t s16[8];
+    area.addr = s16;
+    convertToPcm(src, 1, 8, &area, 0, PcmFormat::S16_LE);
+    EXPECT_EQ(s16[0], 32767);
+    EXPECT_EQ(s16[1], -32767);
+    EXPECT_EQ(s16[2], 16384);
+    EXPECT_EQ(s16[3], 0);
+    EXPECT_EQ(s16[4], 32767);
+    EXPECT_EQ(s16[5], -32767);
+    EXPECT_EQ(s16[6], 0);  // NaN is written as silence
+
+    int32_t s32[8];
+    area = {s32, 0, 32};
+    convertToPcm(src, 1, 8, &area, 0, PcmFormat::S32_LE);
+    EXPECT_GT(s32[0], 2147483000);  // No wrap to INT_MIN at full scale
+    EXPECT_LT(s32[1], -2147483000);
+    EXPECT_GT(s32[4], 2147483000);
+    EXPECT_EQ(s32[6], 0);
+
+    int32_t s24[8];
+    area = {s24, 0, 32};
+    convertToPcm(src, 1, 8, &area, 0, PcmFormat::S24_LE);
+    EXPECT_EQ(s24[0], 8388607);
+    EXPECT_EQ(s24[1], -8388607);
+}
+
+TEST(PcmConversion, VectorAndTailAgree) {
+    // The same value must encode identically in the vector body and the tail
+    std::vector<float> src(13, 0.123456f);
+    std::vector<int16_t> out(13);
+    PcmChannelArea area{out.data(), 0, 16};
+    convertToPcm(src.data(), 1, src.size(), &area, 0, PcmFormat::S16_LE);
+    for (size_t i = 1; i < out.size(); ++i) {
+        EXPECT_EQ(out[i], out[0]);
+    }
+
+    std::fill(src.begin(), src.end(), std::numeric_limits<float>::quiet_NaN());
+    convertToPcm(src.data(), 1, src.size(), &area, 0, PcmFormat::S16_LE);
+    for (size_t i = 0; i < out.size(); ++i) {
+        EXPECT_EQ(out[i], 0) << "sample " << i;
+    }
+}
+
+class FakePcmDeviceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        params.format = PcmFormat::S16_LE;
+        params.access = PcmAccess::MMapInterleaved;
+        params.channels = 2;
+        params.periodFrames = 4;
+        params.periods = 3;
+        ASSERT_EQ(device.setParams(params), 0);
+    }
+
+    // Writes frames whose left sample is value and right is -value
+    void commitFrames(size_t frames, float value) {
+        std::vector<float> src(frames * 2);
+        for (size_t f = 0; f < frames; ++f) {
+            src[f * 2] = value;
+            src[f * 2 + 1] = -value;
+        }
+        size_t done = 0;
+        while (done < frames) {
+            const PcmChannelArea* areas = nullptr;
+            size_t offset = 0;
+            size_t granted = frames - done;
+            ASSERT_EQ(device.mmapBegin(areas, offset, granted), 0);
+            ASSERT_GT(granted, 0u);
+            convertToPcm(src.data() + done * 2, 2, granted, areas, offset, params.format);
+            ASSERT_EQ(device.mmapCommit(offset, granted), static_cast<long>(granted));
+            done += granted;
+        }
+    }
+
+    PcmParams params;
+    FakePcmDevice device;
+};
+
+TEST_F(FakePcmDeviceTest, RejectsInvalidParams) {
+    FakePcmDevice other;
+    PcmParams bad;
+    bad.periods = 1;
+    EXPECT_EQ(other.setParams(bad), -EINVAL);
+    EXPECT_EQ(other.avail(), -EINVAL);
+}
+
+TEST_F(FakePcmDeviceTest, MmapGrantsContiguousRegionAndWraps) {
+    EXPECT_EQ(device.getBufferFrames(), 12u);
+    EXPECT_EQ(device.avail(), 12);
+
+    commitFrames(8, 0.25f);
+    ASSERT_EQ(device.start(), 0);
+    EXPECT_EQ(device.consume(6), 6u);
+
+    // 10 free frames, but only 4 before the end of the ring
+    const PcmChannelArea* areas = nullptr;
+    size_t offset = 0;
+    size_t frames = 10;
+    ASSERT_EQ(device.mmapBegin(areas, offset, frames), 0);
+    EXPECT_EQ(offset, 8u);
+    EXPECT_EQ(frames, 4u);
+
+    commitFrames(8, 0.5f);
+    EXPECT_EQ(device.consume(10), 10u);
+    EXPECT_EQ(device.getPlayedFrames(), 16u);
+    EXPECT_NEAR(device.getPlayedSample(7, 0), 0.25f, 1e-4f);
+    EXPECT_NEAR(device.getPlayedSample(15, 1), -0.5f, 1e-4f);
+    EXPECT_EQ(device.getCopiedBytes(), 0u);
+}
+
+TEST_F(FakePcmDeviceTest, CommitMustMatchBegin) {
+    EXPECT_EQ(device.mmapCommit(3, 1), -EINVAL);
+    EXPECT_EQ(device.mmapCommit(0, 13), -EINVAL);
+}
+
+TEST_F(FakePcmDeviceTest, RwCallsRejectedInMmapMode) {
+    std::vector<int16_t> buffer(8);
+    EXPECT_EQ(device.writeInterleaved(buffer.data(), 4), -EINVAL);
+}
+
+TEST_F(FakePcmDeviceTest, WriteInterleavedCopies) {
+    params.access = PcmAccess::RWInterleaved;
+    ASSERT_EQ(device.setParams(params), 0);
+
+    std::vector<int16_t> buffer(16 * 2, 1000);
+    EXPECT_EQ(device.writeInterleaved(buffer.data(), 16), 12);  // Ring holds 12
+    EXPECT_EQ(device.writeInterleaved(buffer.data(), 1), -EAGAIN);
+    EXPECT_EQ(device.getCopiedBytes(), 12u * 2 * sizeof(int16_t));
+}
+
+TEST_F(FakePcmDeviceTest, UnderrunReportsEpipeUntilRecovered) {
+    commitFrames(4, 0.1f);
+    ASSERT_EQ(device.start(), 0);
+    EXPECT_EQ(device.consume(6), 4u);
+    EXPECT_EQ(device.getXrunCount(), 1u);
+    EXPECT_FALSE(device.isStarted());
+    EXPECT_EQ(device.avail(), -EPIPE);
+
+    const PcmChannelArea* areas = nullptr;
+    size_t offset = 0;
+    size_t frames = 4;
+    EXPECT_EQ(device.mmapBegin(areas, offset, frames), -EPIPE);
+
+    EXPECT_EQ(device.recover(-EPIPE), 0);
+    EXPECT_EQ(device.avail(), 12);
+}
+
+} // namespace test
+} // namespace nap
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include "drivers/BlockPacer.h"
+#include <thread>
+#include <chrono>
+#include <limits>
+
+namespace nap {
+namespace test {
+
+namespace {
+
+void busyWait(std::chrono::microseconds duration) {
+    auto until = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < until) {
+    }
+}
+
+} // namespace
+
+TEST(PacingHistogramTest, Log2MicrosecondBuckets) {
+    EXPECT_EQ(PacingHistogram::bucketFor(-5000), 0u);
+    EXPECT_EQ(PacingHistogram::bucketFor(0), 0u);
+    EXPECT_EQ(PacingHistogram::bucketFor(999), 0u);
+    EXPECT_EQ(PacingHistogram::bucketFor(1000), 1u);
+    EXPECT_EQ(PacingHistogram::bucketFor(1999), 1u);
+    EXPECT_EQ(PacingHistogram::bucketFor(2000), 2u);
+    EXPECT_EQ(PacingHistogram::bucketFor(3999), 2u);
+    EXPECT_EQ(PacingHistogram::bucketFor(4000), 3u);
+    EXPECT_EQ(PacingHistogram::bucketFor(int64_t{60} * 1000000000), PacingHistogram::kBuckets - 1);
+
+    EXPECT_EQ(PacingHistogram::bucketFloorNs(0), 0);
+    EXPECT_EQ(PacingHistogram::bucketFloorNs(1), 1000);
+    EXPECT_EQ(PacingHistogram::bucketFloorNs(3), 4000);
+    for (size_t b = 1; b < PacingHistogram::kBuckets; ++b) {
+        EXPECT_EQ(PacingHistogram::bucketFor(PacingHistogram::bucketFloorNs(b)), b);
+    }
+}
+
+TEST(BlockPacerTest, NotStartedDoesNotWait) {
+    BlockPacer pacer;
+    EXPECT_FALSE(pacer.isStarted());
+    EXPECT_EQ(pacer.waitForBlock(48000), 0);
+    EXPECT_EQ(pacer.getStats().blocks, 0u);
+}
+
+TEST(BlockPacerTest, DeadlinesCountFramesExactly) {
+    BlockPacer pacer;
+    pacer.start(44100.0);
+    const int64_t anchor = pacer.getNextDeadline();
+    EXPECT_LE(anchor, BlockPacer::now());
+
+    // The first block is due at once
+    pacer.waitForBlock(100);
+    EXPECT_EQ(pacer.getNextDeadline() - anchor, 2267573);  // 100 / 44100 s, truncated
+
+    pacer.waitForBlock(44000);
+    EXPECT_EQ(pacer.getNextDeadline() - anchor, 1000000000);
+    EXPECT_EQ(pacer.getScheduledFrames(), 44100u);
+}
+
+TEST(BlockPacerTest, ProcessingTimeDoesNotAccumulate) {
+    BlockPacer pacer;
+    // Never re-anchor, so a scheduler stall under load cannot move the grid
+    pacer.setMaxLateness(std::numeric_limits<int64_t>::max());
+    pacer.start(48000.0);
+    const int64_t anchor = pacer.getNextDeadline();
+
+    for (int i = 0; i < 40; ++i) {
+        pacer.waitForBlock(48);  // 1 ms
+        busyWait(std::chrono::microseconds(600));
+    }
+    const int64_t elapsed = BlockPacer::now() - anchor;
+
+    // Block 39 was due at 39 ms, and the next deadline stays exactly on the
+    // frame grid however long the blocks took
+    EXPECT_GE(elapsed, 39000000);
+    EXPECT_EQ(pacer.getNextDeadline() - anchor, 40000000);
+
+    const PacingStats stats = pacer.getStats();
+    EXPECT_EQ(stats.blocks, 40u);
+    EXPECT_EQ(stats.jitter.total() + stats.misses.total(), 39u);
+    EXPECT_EQ(stats.deadlineMisses, stats.misses.total());
+    EXPECT_GE(stats.meanJitterNs, 0.0);
+    EXPECT_GE(stats.maxJitterNs, static_cast<int64_t>(stats.meanJitterNs));
+    EXPECT_EQ(stats.resyncs, 0u);
+}
+
+TEST(BlockPacerTest, SlowBlockIsCaughtUp) {
+    BlockPacer pacer;
+    pacer.setMaxLateness(std::numeric_limits<int64_t>::max());
+    pacer.start(48000.0);
+    const int64_t anchor = pacer.getNextDeadline();
+
+    pacer.waitForBlock(48);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    // Blocks due at 1..4 ms are already late and run back to back
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_GT(pacer.waitForBlock(48), 0);
+    }
+    const PacingStats stats = pacer.getStats();
+    EXPECT_GE(stats.deadlineMisses, 4u);
+    EXPECT_GE(stats.maxLatenessNs, 1000000);
+    EXPECT_EQ(stats.resyncs, 0u);
+
+    // The schedule is unchanged by the stall
+    EXPECT_EQ(pacer.getNextDeadline() - anchor, 5000000);
+}
+
+TEST(BlockPacerTest, LongStallResyncs) {
+    BlockPacer pacer;
+    pacer.setMaxLateness(2000000);
+    EXPECT_EQ(pacer.getMaxLateness(), 2000000);
+    pacer.start(48000.0);
+
+    pacer.waitForBlock(48);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    pacer.waitForBlock(48);
+
+    const PacingStats stats = pacer.getStats();
+    EXPECT_EQ(stats.resyncs, 1u);
+    EXPECT_EQ(stats.deadlineMisses, 1u);
+
+    // Re-anchored: the next block is a block away rather than overdue
+    EXPECT_GT(pacer.getNextDeadline(), BlockPacer::now() - 1000000);
+}
+
+TEST(BlockPacerTest, SpinTailWakesAtDeadline) {
+    BlockPacer pacer;
+    pacer.setSpinTail(200000);
+    EXPECT_EQ(pacer.getSpinTail(), 200000);
+    pacer.start(48000.0);
+
+    for (int i = 0; i < 10; ++i) {
+        int64_t deadline = pacer.getNextDeadline();
+        pacer.waitForBlock(48);
+        EXPECT_GE(BlockPacer::now(), deadline);
+    }
+    EXPECT_EQ(pacer.getStats().blocks, 10u);
+
+    pacer.resetStats();
+    const PacingStats stats = pacer.getStats();
+    EXPECT_EQ(stats.blocks, 0u);
+    EXPECT_EQ(stats.jitter.total(), 0u);
+    EXPECT_EQ(stats.maxJitterNs, 0);
+}
+
+} // namespace test
+} // namespace nap
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include "drivers/DummyDriver.h"
+#include <chrono>
+#include <limits>
 
 namespace nap {
 namespace test {
@@ -132,6 +134,41 @@ TEST_F(DummyDriverTest, SimulateRealtime) {
     EXPECT_FALSE(driver->isSimulatingRealtime());
 }
 
+TEST_F(DummyDriverTest, RealtimeCallbackTimeDoesNotDrift) {
+    AudioStreamConfig config;
+    config.sampleRate = 48000.0;
+    config.bufferSize = 48;  // 1 ms blocks
+    driver->configure(config);
+    driver->initialize();
+    driver->start();
+    driver->setSimulateRealtime(true);
+    // A stall under load must not re-anchor the schedule this test measures
+    driver->getPacer().setMaxLateness(std::numeric_limits<int64_t>::max());
+
+    // Each callback burns half a block, which must not push later deadlines back
+    driver->setAudioCallback([](const float*, float*, int, int, int) {
+        auto until = std::chrono::steady_clock::now() + std::chrono::microseconds(500);
+        while (std::chrono::steady_clock::now() < until) {
+        }
+    });
+
+    const int64_t begin = BlockPacer::now();
+    driver->processBlocks(30);
+    const int64_t anchor = driver->getPacer().getNextDeadline() - 30000000;
+
+    // The first block anchored the schedule; the last was due 29 ms later
+    EXPECT_GE(anchor, begin);
+    EXPECT_GE(BlockPacer::now() - anchor, 29000000);
+    EXPECT_EQ(driver->getPacer().getScheduledFrames(), 30u * 48);
+
+    const PacingStats stats = driver->getPacer().getStats();
+    EXPECT_EQ(stats.blocks, 30u);
+    EXPECT_EQ(stats.jitter.total() + stats.misses.total(), 29u);
+
+    driver->resetStatistics();
+    EXPECT_EQ(driver->getPacer().getStats().blocks, 0u);
+}
+
 TEST_F(DummyDriverTest, GetAvailableDevices) {
     auto devices = driver->getAvailableDevices();
     EXPECT_EQ(devices.size(), 1u);
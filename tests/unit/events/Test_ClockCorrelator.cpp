@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include "events/ClockCorrelator.h"
+#include "events/DelayLockedLoop.h"
+#include <atomic>
+#include <cmath>
+#include <random>
+#include <thread>
+
+namespace nap {
+namespace test {
+
+using events::ClockCorrelator;
+using events::DelayLockedLoop;
+
+TEST(DelayLockedLoopTest, ConvergesOnPeriodAndRejectsJitter) {
+    DelayLockedLoop loop(0.5);
+    loop.reset(0.0, 10000.0);  // Nominal 10 ms, true period 10.1 ms
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> jitter(-500.0, 500.0);
+    double worst = 0.0;
+    for (int i = 1; i <= 2000; ++i) {
+        const double truth = i * 10100.0;
+        const double filtered = loop.update(truth + jitter(rng));
+        if (i > 1000) {
+            worst = std::max(worst, std::fabs(filtered - truth));
+        }
+    }
+    EXPECT_NEAR(loop.getPeriod(), 10100.0, 5.0);
+    EXPECT_LT(worst, 150.0);  // Well under the +/-500 us input jitter
+}
+
+TEST(DelayLockedLoopTest, UnitsBridgeMissingEvents) {
+    DelayLockedLoop loop(1.0);
+    loop.reset(0.0, 1000.0);
+    loop.update(3000.0, 3.0);
+    EXPECT_DOUBLE_EQ(loop.getLastError(), 0.0);
+    EXPECT_DOUBLE_EQ(loop.getTime(), 3000.0);
+    EXPECT_DOUBLE_EQ(loop.predict(2.0), 5000.0);
+}
+
+TEST(ClockCorrelatorTest, LearnsDeviceRateAndMapsBothWays) {
+    // The device runs 0.1% fast against the system clock
+    const double trueRate = 48048.0;
+    ClockCorrelator clock(48000.0, 0.2);
+    EXPECT_FALSE(clock.isLocked());
+
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> jitter(0.0, 800.0);
+    const uint64_t origin = 5000000;
+    uint64_t position = 0;
+    for (int block = 0; block < 3000; ++block) {
+        const double truth = origin + static_cast<double>(position) * 1e6 / trueRate;
+        clock.update(static_cast<uint64_t>(truth + jitter(rng)), position);
+        position += 256;
+    }
+    EXPECT_TRUE(clock.isLocked());
+    EXPECT_NEAR(clock.getSampleRate(), trueRate, 2.0);
+    EXPECT_EQ(clock.getResyncCount(), 0u);
+
+    // Callback lateness averages 400 us, which the mapping absorbs as a constant offset
+    const double probe = static_cast<double>(position - 256);
+    const double expected = origin + probe * 1e6 / trueRate + 400.0;
+    EXPECT_NEAR(static_cast<double>(clock.systemTimeAt(probe)), expected, 150.0);
+    EXPECT_NEAR(clock.samplePositionAt(clock.systemTimeAt(probe)), probe, 1.0);
+}
+
+TEST(ClockCorrelatorTest, ReanchorsOnDiscontinuity) {
+    ClockCorrelator clock(48000.0);
+    clock.update(1000000, 0);
+    clock.update(1010000, 480);
+    EXPECT_TRUE(clock.isLocked());
+
+    // Stream restarted from zero
+    clock.update(1020000, 0);
+    EXPECT_EQ(clock.getResyncCount(), 1u);
+    EXPECT_FALSE(clock.isLocked());
+    EXPECT_NEAR(clock.samplePositionAt(1020000), 0.0, 1e-6);
+
+    // Callback stalled for half a second
+    clock.update(1030000, 480);
+    clock.update(1530000, 960);
+    EXPECT_EQ(clock.getResyncCount(), 2u);
+    EXPECT_EQ(clock.systemTimeAt(960.0), 1530000u);
+}
+
+TEST(ClockCorrelatorTest, ReadersNeverSeeTornMappings) {
+    ClockCorrelator clock(48000.0);
+    std::atomic<bool> done{false};
+
+    std::thread writer([&]() {
+        uint64_t position = 0;
+        for (int i = 0; i < 50000; ++i) {
+            clock.update(1000000 + position * 1000000 / 48000, position);
+            position += 64;
+        }
+        done = true;
+    });
+
+    // Once anchored, every published mapping agrees with the exact timing
+    while (!clock.isLocked()) {
+        std::this_thread::yield();
+    }
+    size_t torn = 0;
+    while (!done) {
+        const double time = static_cast<double>(clock.systemTimeAt(48000.0));
+        if (std::fabs(time - 2000000.0) > 2.0) ++torn;
+    }
+    writer.join();
+    EXPECT_EQ(torn, 0u);
+}
+
+} // namespace test
+} // namespace nap
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include "events/MidiClockTracker.h"
+#include <random>
+
+namespace nap {
+namespace test {
+
+using events::MidiClockTracker;
+using events::MidiMessage;
+
+namespace {
+
+MidiMessage tickAt(uint64_t timestamp) {
+    MidiMessage tick = MidiMessage::timingClock();
+    tick.setTimestamp(timestamp);
+    return tick;
+}
+
+} // namespace
+
+TEST(MidiClockTrackerTest, SteadyTempoFromJitteryTicks) {
+    MidiClockTracker tracker;
+    EXPECT_TRUE(tracker.process(MidiMessage::start()));
+    EXPECT_TRUE(tracker.isRunning());
+
+    // 120 BPM = 20833.3 us per tick, +/- 1 ms of arrival jitter
+    const double period = 60000000.0 / (120.0 * 24.0);
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> jitter(-1000.0, 1000.0);
+    double worstBpm = 0.0;
+    for (int i = 0; i < 24 * 64; ++i) {
+        tracker.process(tickAt(static_cast<uint64_t>(1000000 + i * period + jitter(rng))));
+        if (i > 24 * 32) {
+            worstBpm = std::max(worstBpm, std::fabs(tracker.getBpm() - 120.0));
+        }
+    }
+    EXPECT_TRUE(tracker.isLocked());
+    EXPECT_EQ(tracker.getTickCount(), 24u * 64u);
+    // Raw tick intervals swing by up to 10% of the tempo; the estimate does not
+    EXPECT_LT(worstBpm, 0.5);
+
+    const double next = 1000000 + (24 * 64) * period;
+    EXPECT_NEAR(static_cast<double>(tracker.predictTickTime(1)), next, 600.0);
+
+    EXPECT_TRUE(tracker.process(MidiMessage::stop()));
+    EXPECT_FALSE(tracker.isRunning());
+    EXPECT_FALSE(tracker.process(MidiMessage::noteOn(0, 60, 1)));
+}
+
+TEST(MidiClockTrackerTest, DroppedTickKeepsTempo) {
+    MidiClockTracker tracker;
+    const uint64_t period = 20000;
+    uint64_t time = 0;
+    for (int i = 0; i < 100; ++i) {
+        if (i != 50) tracker.processTick(time);
+        time += period;
+    }
+    EXPECT_NEAR(tracker.getTickPeriodUs(), 20000.0, 1.0);
+    EXPECT_EQ(tracker.getTickCount(), 99u);
+}
+
+TEST(MidiClockTrackerTest, FollowsTempoChanges) {
+    MidiClockTracker tracker;
+    uint64_t time = 0;
+    for (int i = 0; i < 200; ++i) {
+        tracker.processTick(time);
+        time += 20000;
+    }
+    // Tempo halves: every interval now spans two old periods
+    for (int i = 0; i < 400; ++i) {
+        tracker.processTick(time);
+        time += 40000;
+    }
+    EXPECT_NEAR(tracker.getTickPeriodUs(), 40000.0, 10.0);
+
+    // And speeds up by a third
+    for (int i = 0; i < 800; ++i) {
+        tracker.processTick(time);
+        time += 30000;
+    }
+    EXPECT_NEAR(tracker.getTickPeriodUs(), 30000.0, 10.0);
+    EXPECT_NEAR(tracker.getBpm(), 60000000.0 / (30000.0 * 24.0), 0.1);
+
+    tracker.reset();
+    EXPECT_FALSE(tracker.isLocked());
+    EXPECT_EQ(tracker.getBpm(), 0.0);
+}
+
+TEST(MidiClockTrackerTest, FollowsTempoRises) {
+    MidiClockTracker tracker;
+    uint64_t time = 0;
+    // 62.5 BPM = 40000 us per tick
+    for (int i = 0; i < 200; ++i) {
+        tracker.processTick(time);
+        time += 40000;
+    }
+    EXPECT_NEAR(tracker.getBpm(), 62.5, 0.1);
+
+    // Tempo doubles: intervals now round to half a period
+    for (int i = 0; i < 200; ++i) {
+        tracker.processTick(time);
+        time += 20000;
+    }
+    EXPECT_TRUE(tracker.isLocked());
+    EXPECT_NEAR(tracker.getBpm(), 125.0, 0.1);
+
+    // Back to 62.5, then tripled to 187.5
+    for (int i = 0; i < 200; ++i) {
+        tracker.processTick(time);
+        time += 40000;
+    }
+    for (int i = 0; i < 200; ++i) {
+        tracker.processTick(time);
+        time += 13333;
+    }
+    EXPECT_NEAR(tracker.getTickPeriodUs(), 13333.0, 5.0);
+    EXPECT_NEAR(tracker.getBpm(), 187.5, 0.1);
+}
+
+} // namespace test
+} // namespace nap
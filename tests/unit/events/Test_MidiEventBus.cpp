@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include "events/MidiEventBus.h"
+#include <thread>
+
+namespace nap {
+namespace test {
+
+using events::MidiBlockEvent;
+using events::MidiEventBus;
+using events::MidiEventQueue;
+using events::MidiMessage;
+
+namespace {
+
+MidiMessage stamped(MidiMessage message, uint64_t timestamp) {
+    message.setTimestamp(timestamp);
+    return message;
+}
+
+} // namespace
+
+TEST(MidiEventQueueTest, ConvertsTimestampsToSampleOffsets) {
+    MidiEventQueue queue(16);
+    // 48 kHz: 1000 us = 48 samples; a 480-frame block spans 10000 us
+    queue.push(stamped(MidiMessage::noteOn(0, 60, 100), 500));      // late
+    queue.push(stamped(MidiMessage::noteOn(0, 62, 100), 1000));     // first sample
+    queue.push(stamped(MidiMessage::noteOff(0, 60), 3000));
+    queue.push(stamped(MidiMessage::noteOff(0, 62), 11000));        // next block
+    queue.push(stamped(MidiMessage::timingClock(), 11000 + 9999));
+
+    MidiBlockEvent events[8];
+    ASSERT_EQ(queue.drain(1000, 480, 48000.0, events, 8), 3u);
+    EXPECT_EQ(events[0].sampleOffset, 0u);
+    EXPECT_EQ(events[1].sampleOffset, 0u);
+    EXPECT_EQ(events[2].sampleOffset, 96u);
+    EXPECT_EQ(events[1].message.getNoteNumber(), 62);
+    EXPECT_EQ(queue.size(), 2u);
+
+    ASSERT_EQ(queue.drain(11000, 480, 48000.0, events, 8), 2u);
+    EXPECT_TRUE(events[0].message.isNoteOff());
+    EXPECT_EQ(events[0].sampleOffset, 0u);
+    EXPECT_EQ(events[1].sampleOffset, 479u);
+    EXPECT_EQ(queue.size(), 0u);
+}
+
+TEST(MidiEventQueueTest, FullQueueDropsAndCounts) {
+    MidiEventQueue queue(4);
+    for (int i = 0; i < 6; ++i) {
+        queue.push(stamped(MidiMessage::timingClock(), 0));
+    }
+    EXPECT_EQ(queue.getDroppedCount(), 2u);
+
+    MidiBlockEvent events[8];
+    EXPECT_EQ(queue.drain(0, 64, 48000.0, events, 8), 4u);
+}
+
+TEST(MidiEventBusTest, MergesInputsBySampleOffset) {
+    MidiEventBus bus(8);
+    MidiEventQueue* keys = bus.addInput(16);
+    MidiEventQueue* pads = bus.addInput(16);
+    ASSERT_NE(keys, nullptr);
+    ASSERT_NE(pads, nullptr);
+    EXPECT_EQ(bus.getInputCount(), 2u);
+    EXPECT_EQ(bus.getInput(1), pads);
+    EXPECT_EQ(bus.getInput(2), nullptr);
+
+    keys->push(stamped(MidiMessage::noteOn(0, 60, 1), 0));
+    keys->push(stamped(MidiMessage::noteOn(0, 61, 1), 2000));
+    pads->push(stamped(MidiMessage::noteOn(9, 36, 1), 1000));
+    pads->push(stamped(MidiMessage::noteOn(9, 38, 1), 2000));
+
+    ASSERT_EQ(bus.processBlock(0, 256, 48000.0), 4u);
+    const MidiBlockEvent* events = bus.getEvents();
+    EXPECT_EQ(events[0].message.getNoteNumber(), 60);
+    EXPECT_EQ(events[1].message.getNoteNumber(), 36);
+    EXPECT_EQ(events[2].message.getNoteNumber(), 61);  // Same offset: input order
+    EXPECT_EQ(events[3].message.getNoteNumber(), 38);
+    EXPECT_EQ(events[1].sampleOffset, 48u);
+
+    EXPECT_EQ(bus.processBlock(5333, 256, 48000.0), 0u);
+    EXPECT_EQ(bus.getEventCount(), 0u);
+}
+
+TEST(MidiEventBusTest, OverflowCarriesToNextBlock) {
+    MidiEventBus bus(2);
+    MidiEventQueue* input = bus.addInput(16);
+    for (uint8_t note = 0; note < 3; ++note) {
+        input->push(stamped(MidiMessage::noteOn(0, note, 1), 10));
+    }
+    EXPECT_EQ(bus.processBlock(0, 64, 48000.0), 2u);
+    ASSERT_EQ(bus.processBlock(2000, 64, 48000.0), 1u);
+    EXPECT_EQ(bus.getEvents()[0].message.getNoteNumber(), 2);
+    EXPECT_EQ(bus.getEvents()[0].sampleOffset, 0u);
+}
+
+TEST(MidiEventBusTest, InputLimit) {
+    MidiEventBus bus;
+    for (size_t i = 0; i < MidiEventBus::kMaxInputs; ++i) {
+        EXPECT_NE(bus.addInput(4), nullptr);
+    }
+    EXPECT_EQ(bus.addInput(4), nullptr);
+}
+
+TEST(MidiEventBusTest, ConcurrentProducerDeliversInOrder) {
+    MidiEventBus bus(64);
+    MidiEventQueue* input = bus.addInput(256);
+    constexpr int kEvents = 5000;
+
+    std::thread producer([&]() {
+        for (int i = 0; i < kEvents; ++i) {
+            MidiMessage message = MidiMessage::controlChange(0, 1, static_cast<uint8_t>(i & 0x7F));
+            message.setTimestamp(static_cast<uint64_t>(i));
+            while (!input->push(message)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int received = 0;
+    uint64_t blockStart = 0;
+    while (received < kEvents) {
+        const size_t count = bus.processBlock(blockStart, 48, 48000.0);
+        for (size_t k = 0; k < count; ++k) {
+            ASSERT_EQ(bus.getEvents()[k].message.getTimestamp(), static_cast<uint64_t>(received));
+            ++received;
+        }
+        if (count == 0) {
+            blockStart += 1000;
+        }
+    }
+    producer.join();
+}
+
+} // namespace test
+} // namespace nap
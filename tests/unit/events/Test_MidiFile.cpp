@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+#include "events/MidiFile.h"
+#include <cstdio>
+#include <fstream>
+
+namespace nap {
+namespace test {
+
+using events::MidiFile;
+
+namespace {
+
+void put32(std::vector<uint8_t>& out, uint32_t value) {
+    for (int shift = 24; shift >= 0; shift -= 8) out.push_back(static_cast<uint8_t>(value >> shift));
+}
+
+void putVarLen(std::vector<uint8_t>& out, uint32_t value) {
+    uint8_t bytes[4];
+    int count = 0;
+    do {
+        bytes[count++] = value & 0x7F;
+        value >>= 7;
+    } while (value);
+    while (count-- > 0) out.push_back(static_cast<uint8_t>(bytes[count] | (count ? 0x80 : 0)));
+}
+
+std::vector<uint8_t> header(uint16_t format, uint16_t tracks, uint16_t division) {
+    std::vector<uint8_t> out = {'M', 'T', 'h', 'd'};
+    put32(out, 6);
+    for (uint16_t value : {format, tracks, division}) {
+        out.push_back(static_cast<uint8_t>(value >> 8));
+        out.push_back(static_cast<uint8_t>(value));
+    }
+    return out;
+}
+
+// Events are (delta, raw bytes) pairs
+void appendTrack(std::vector<uint8_t>& file,
+                 const std::vector<std::pair<uint32_t, std::vector<uint8_t>>>& events) {
+    std::vector<uint8_t> body;
+    for (const auto& [delta, bytes] : events) {
+        putVarLen(body, delta);
+        body.insert(body.end(), bytes.begin(), bytes.end());
+    }
+    file.insert(file.end(), {'M', 'T', 'r', 'k'});
+    put32(file, static_cast<uint32_t>(body.size()));
+    file.insert(file.end(), body.begin(), body.end());
+}
+
+std::vector<uint8_t> makeTwoTrackFile() {
+    std::vector<uint8_t> file = header(1, 2, 480);
+    appendTrack(file, {
+        {0, {0xFF, 0x51, 0x03, 0x07, 0xA1, 0x20}},    // 500000 us per quarter
+        {960, {0xFF, 0x51, 0x03, 0x03, 0xD0, 0x90}},  // 250000 us per quarter
+        {960, {0xFF, 0x2F, 0x00}},
+    });
+    appendTrack(file, {
+        {0, {0x90, 60, 100}},
+        {480, {64, 90}},                         // Running status
+        {480, {0xF0, 0x04, 0x43, 0x10, 0x4C, 0xF7}},
+        {0, {0x90, 60, 0}},                      // Note off as velocity 0
+        {480, {0xC1, 5}},
+        {0, {0xFF, 0x2F, 0x00}},
+    });
+    return file;
+}
+
+} // namespace
+
+TEST(MidiFileTest, ParsesTracksAndTempoMap) {
+    const std::vector<uint8_t> bytes = makeTwoTrackFile();
+    MidiFile file;
+    ASSERT_TRUE(file.loadFromMemory(bytes.data(), bytes.size())) << file.getLastError();
+    EXPECT_EQ(file.getFormat(), 1);
+    EXPECT_EQ(file.getTrackCount(), 2);
+    EXPECT_EQ(file.getTicksPerQuarter(), 480);
+
+    const auto& events = file.getEvents();
+    ASSERT_EQ(events.size(), 4u);
+    EXPECT_TRUE(events[0].message.isNoteOn());
+    EXPECT_DOUBLE_EQ(events[0].seconds, 0.0);
+    EXPECT_EQ(events[1].message.getNoteNumber(), 64);
+    EXPECT_DOUBLE_EQ(events[1].seconds, 0.5);
+    EXPECT_TRUE(events[2].message.isNoteOff());
+    EXPECT_DOUBLE_EQ(events[2].seconds, 1.0);
+    EXPECT_TRUE(events[3].message.isProgramChange());
+    EXPECT_EQ(events[3].tick, 1440u);
+    EXPECT_DOUBLE_EQ(events[3].seconds, 1.25);
+    EXPECT_EQ(events[3].track, 1);
+
+    ASSERT_EQ(file.getTempoMap().size(), 2u);
+    EXPECT_DOUBLE_EQ(file.getTempoMap()[1].seconds, 1.0);
+    EXPECT_EQ(file.getLengthTicks(), 1920u);
+    EXPECT_DOUBLE_EQ(file.getLengthSeconds(), 1.5);
+    EXPECT_DOUBLE_EQ(file.tickToSeconds(1200), 1.125);
+
+    ASSERT_EQ(file.getSysexEvents().size(), 1u);
+    EXPECT_EQ(file.getSysexEvents()[0].data, (std::vector<uint8_t>{0xF0, 0x43, 0x10, 0x4C, 0xF7}));
+    EXPECT_DOUBLE_EQ(file.getSysexEvents()[0].seconds, 1.0);
+}
+
+TEST(MidiFileTest, SameTickKeepsTrackOrder) {
+    std::vector<uint8_t> bytes = header(1, 2, 96);
+    appendTrack(bytes, {{10, {0xB0, 7, 1}}, {0, {0xFF, 0x2F, 0x00}}});
+    appendTrack(bytes, {{10, {0xB0, 7, 2}}, {0, {0xB0, 7, 3}}, {0, {0xFF, 0x2F, 0x00}}});
+    MidiFile file;
+    ASSERT_TRUE(file.loadFromMemory(bytes.data(), bytes.size()));
+    ASSERT_EQ(file.getEvents().size(), 3u);
+    for (uint8_t i = 0; i < 3; ++i) {
+        EXPECT_EQ(file.getEvents()[i].message[2], i + 1);
+    }
+    // Default tempo of 120 BPM
+    EXPECT_DOUBLE_EQ(file.getEvents()[0].seconds, 10.0 * 0.5 / 96.0);
+}
+
+TEST(MidiFileTest, SmpteDivision) {
+    // 25 fps, 40 ticks per frame: one millisecond per tick
+    std::vector<uint8_t> bytes = header(0, 1, 0xE728);
+    appendTrack(bytes, {{250, {0x90, 1, 1}}, {0, {0xFF, 0x2F, 0x00}}});
+    MidiFile file;
+    ASSERT_TRUE(file.loadFromMemory(bytes.data(), bytes.size()));
+    EXPECT_EQ(file.getTicksPerQuarter(), 0);
+    EXPECT_NEAR(file.getEvents()[0].seconds, 0.25, 1e-12);
+}
+
+TEST(MidiFileTest, RejectsMalformedFiles) {
+    MidiFile file;
+    const uint8_t junk[] = {'R', 'I', 'F', 'F', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+    EXPECT_FALSE(file.loadFromMemory(junk, sizeof(junk)));
+    EXPECT_FALSE(file.getLastError().empty());
+
+    std::vector<uint8_t> format2 = header(2, 1, 96);
+    appendTrack(format2, {{0, {0xFF, 0x2F, 0x00}}});
+    EXPECT_FALSE(file.loadFromMemory(format2.data(), format2.size()));
+
+    std::vector<uint8_t> noStatus = header(0, 1, 96);
+    appendTrack(noStatus, {{0, {60, 100}}});
+    EXPECT_FALSE(file.loadFromMemory(noStatus.data(), noStatus.size()));
+
+    std::vector<uint8_t> truncated = makeTwoTrackFile();
+    truncated.resize(truncated.size() - 5);
+    EXPECT_FALSE(file.loadFromMemory(truncated.data(), truncated.size()));
+    EXPECT_TRUE(file.getEvents().empty());
+
+    EXPECT_FALSE(file.loadFromFile("/nonexistent/nap_missing.mid"));
+}
+
+TEST(MidiFileTest, LoadsFromDisk) {
+    const std::string path = ::testing::TempDir() + "nap_midi_file_test.mid";
+    const std::vector<uint8_t> bytes = makeTwoTrackFile();
+    {
+        std::ofstream out(path, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    }
+    MidiFile file;
+    ASSERT_TRUE(file.loadFromFile(path)) << file.getLastError();
+    EXPECT_EQ(file.getEvents().size(), 4u);
+    std::remove(path.c_str());
+}
+
+} // namespace test
+} // namespace nap
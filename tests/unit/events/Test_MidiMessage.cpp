@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+#include "events/MidiMessage.h"
+#include <cstring>
+#include <type_traits>
+
+namespace nap {
+namespace test {
+
+using events::MidiMessage;
+
+TEST(MidiMessageTest, IsCompactPod) {
+    EXPECT_TRUE(std::is_trivially_copyable<MidiMessage>::value);
+    EXPECT_LE(sizeof(MidiMessage), 16u);
+}
+
+TEST(MidiMessageTest, FactoriesSurviveByteCopy) {
+    MidiMessage note = MidiMessage::noteOn(3, 60, 100);
+    note.setTimestamp(12345);
+
+    // Trivially copyable messages may be moved around with memcpy
+    MidiMessage copy;
+    std::memcpy(&copy, &note, sizeof(MidiMessage));
+    EXPECT_EQ(copy, note);
+    EXPECT_TRUE(copy.isNoteOn());
+    EXPECT_EQ(copy.getChannel(), 3);
+    EXPECT_EQ(copy.getNoteNumber(), 60);
+    EXPECT_EQ(copy.getVelocity(), 100);
+    EXPECT_EQ(copy.getTimestamp(), 12345u);
+    EXPECT_EQ(copy.size(), 3u);
+}
+
+TEST(MidiMessageTest, RawConstructorsClampToThreeBytes) {
+    const uint8_t bytes[] = {0xB0, 7, 64, 99, 98};
+    MidiMessage message(bytes, sizeof(bytes));
+    EXPECT_EQ(message.size(), 3u);
+    EXPECT_TRUE(message.isControlChange());
+    EXPECT_EQ(message[2], 64);
+    EXPECT_EQ(message[3], 0);
+
+    MidiMessage fromList({0xF8});
+    EXPECT_EQ(fromList.size(), 1u);
+    EXPECT_EQ(MidiMessage(std::vector<uint8_t>{0xB0, 7, 64}), message);
+}
+
+} // namespace test
+} // namespace nap
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include "events/MidiFile.h"
+#include "events/MidiSequencer.h"
+
+namespace nap {
+namespace test {
+
+using events::MidiBlockEvent;
+using events::MidiEventBus;
+using events::MidiFile;
+using events::MidiSequencer;
+
+namespace {
+
+// Format 0 at 120 BPM, 100 ticks per quarter: one tick = 5 ms = 240 samples at 48 kHz
+MidiFile makeScale() {
+    std::vector<uint8_t> bytes = {'M', 'T', 'h', 'd', 0, 0, 0, 6, 0, 0, 0, 1, 0, 100};
+    std::vector<uint8_t> track;
+    for (uint8_t i = 0; i < 8; ++i) {
+        track.insert(track.end(), {0x00, 0x90, static_cast<uint8_t>(60 + i), 100});
+        track.insert(track.end(), {0x32, 0x80, static_cast<uint8_t>(60 + i), 0});
+    }
+    track.insert(track.end(), {0x00, 0xFF, 0x2F, 0x00});
+    bytes.insert(bytes.end(), {'M', 'T', 'r', 'k', 0, 0, 0, static_cast<uint8_t>(track.size())});
+    bytes.insert(bytes.end(), track.begin(), track.end());
+
+    MidiFile file;
+    EXPECT_TRUE(file.loadFromMemory(bytes.data(), bytes.size())) << file.getLastError();
+    return file;
+}
+
+} // namespace
+
+TEST(MidiSequencerTest, RendersEventsAtSampleOffsets) {
+    MidiSequencer sequencer;
+    sequencer.load(makeScale(), 48000.0);
+    EXPECT_EQ(sequencer.getEventCount(), 16u);
+    EXPECT_EQ(sequencer.getLengthSamples(), 8u * 50u * 240u);
+
+    // Notes 50 ticks apart = 12000 samples; 512-frame blocks
+    MidiBlockEvent events[16];
+    size_t rendered = 0;
+    uint64_t blockStart = 0;
+    while (!sequencer.isFinished()) {
+        const size_t count = sequencer.renderBlock(512, events, 16);
+        for (size_t i = 0; i < count; ++i) {
+            EXPECT_EQ(blockStart + events[i].sampleOffset, events[i].message.getTimestamp());
+        }
+        rendered += count;
+        blockStart += 512;
+    }
+    EXPECT_EQ(rendered, 16u);
+    EXPECT_EQ(sequencer.renderBlock(512, events, 16), 0u);
+}
+
+TEST(MidiSequencerTest, SeekReleasesSoundingNotes) {
+    MidiSequencer sequencer;
+    sequencer.load(makeScale(), 48000.0);
+
+    MidiBlockEvent events[16];
+    ASSERT_EQ(sequencer.renderBlock(100, events, 16), 1u);
+    EXPECT_TRUE(events[0].message.isNoteOn());
+
+    // Into the middle of the fourth note
+    sequencer.seek(3 * 12000 + 10);
+    EXPECT_EQ(sequencer.getPosition(), 36010u);
+    const size_t count = sequencer.renderBlock(12000, events, 16);
+    ASSERT_EQ(count, 3u);
+    EXPECT_TRUE(events[0].message.isNoteOff());
+    EXPECT_EQ(events[0].message.getNoteNumber(), 60);
+    EXPECT_EQ(events[0].sampleOffset, 0u);
+    EXPECT_EQ(events[1].message.getNoteNumber(), 63);  // Its note off
+    EXPECT_EQ(events[1].sampleOffset, 48000u - 36010u);
+    EXPECT_TRUE(events[2].message.isNoteOn());
+}
+
+TEST(MidiSequencerTest, FullBufferDefersEvents) {
+    MidiSequencer sequencer;
+    sequencer.load(makeScale(), 48000.0);
+    MidiBlockEvent events[16];
+
+    // Three events land in the first 13000 samples; room for one
+    ASSERT_EQ(sequencer.renderBlock(13000, events, 1), 1u);
+    ASSERT_EQ(sequencer.renderBlock(100, events, 16), 2u);
+    EXPECT_EQ(events[0].sampleOffset, 0u);
+    EXPECT_EQ(events[1].sampleOffset, 0u);
+    EXPECT_TRUE(events[0].message.isNoteOff());
+    EXPECT_TRUE(events[1].message.isNoteOn());
+}
+
+TEST(MidiSequencerTest, FeedsEventBusAsSource) {
+    MidiSequencer sequencer;
+    sequencer.load(makeScale(), 48000.0);
+    MidiEventBus bus(8);
+    ASSERT_TRUE(bus.addSource(&sequencer));
+
+    size_t delivered = 0;
+    for (int block = 0; block < 200; ++block) {
+        delivered += bus.processBlock(0, 512, 48000.0);
+    }
+    EXPECT_EQ(delivered, 16u);
+    EXPECT_TRUE(bus.removeSource(&sequencer));
+    EXPECT_FALSE(bus.removeSource(&sequencer));
+}
+
+} // namespace test
+} // namespace nap
@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+#include "events/SysexAssembler.h"
+#include "events/SysexCodec.h"
+#include <random>
+#include <vector>
+
+namespace nap {
+namespace test {
+
+using events::ISysexStreamHandler;
+using events::SysexAssembler;
+using events::SysexCodec;
+using events::SysexMessage;
+using events::SysexPool;
+
+namespace {
+
+// Unpacks a streamed 7-bit dump as it arrives
+class DumpDecoder : public ISysexStreamHandler {
+public:
+    void beginSysex(uint32_t manufacturerId, uint64_t) override {
+        manufacturer = manufacturerId;
+        pending.clear();
+        decoded.clear();
+        ++begins;
+    }
+
+    void sysexData(const uint8_t* data, size_t size) override {
+        pending.insert(pending.end(), data, data + size);
+        const size_t whole = pending.size() / 8 * 8;
+        decode(whole);
+    }
+
+    void endSysex(bool complete) override {
+        decode(pending.size());
+        completed = complete;
+    }
+
+    void decode(size_t count) {
+        if (count == 0) return;
+        const size_t offset = decoded.size();
+        decoded.resize(offset + SysexCodec::unpackedSize(count));
+        SysexCodec::unpack(pending.data(), count, decoded.data() + offset);
+        pending.erase(pending.begin(), pending.begin() + static_cast<std::ptrdiff_t>(count));
+    }
+
+    uint32_t manufacturer = 0;
+    int begins = 0;
+    bool completed = false;
+    std::vector<uint8_t> pending;
+    std::vector<uint8_t> decoded;
+};
+
+} // namespace
+
+TEST(SysexCodecTest, RoundTripsEveryLength) {
+    std::mt19937 rng(5);
+    for (size_t size = 0; size < 64; ++size) {
+        std::vector<uint8_t> data(size);
+        for (auto& byte : data) byte = static_cast<uint8_t>(rng());
+
+        std::vector<uint8_t> packed(SysexCodec::packedSize(size));
+        ASSERT_EQ(SysexCodec::pack(data.data(), size, packed.data()), packed.size());
+        for (uint8_t byte : packed) ASSERT_LT(byte, 0x80);
+
+        std::vector<uint8_t> unpacked(SysexCodec::unpackedSize(packed.size()));
+        ASSERT_EQ(unpacked.size(), size);
+        SysexCodec::unpack(packed.data(), packed.size(), unpacked.data());
+        EXPECT_EQ(unpacked, data) << size;
+    }
+}
+
+TEST(SysexCodecTest, MatchesReferenceLayout) {
+    const uint8_t data[] = {0x80, 0x01, 0xFF, 0x7F, 0x00, 0x81, 0x02, 0xC0};
+    uint8_t packed[10] = {};
+    ASSERT_EQ(SysexCodec::pack(data, sizeof(data), packed), 10u);
+    const uint8_t expected[] = {0x25, 0x00, 0x01, 0x7F, 0x7F, 0x00, 0x01, 0x02, 0x01, 0x40};
+    EXPECT_EQ(std::vector<uint8_t>(packed, packed + 10), std::vector<uint8_t>(expected, expected + 10));
+}
+
+TEST(SysexAssemblerTest, ReassemblesAcrossFragments) {
+    SysexPool pool(16, 64);
+    SysexAssembler assembler(pool);
+    std::vector<SysexMessage> received;
+    assembler.setMessageCallback([&](SysexMessage&& message) { received.push_back(std::move(message)); });
+
+    // Two messages, a clock byte inside the first and a note between them
+    const std::vector<uint8_t> stream = {
+        0xF0, 0x43, 0x10, 0x4C, 0xF8, 0x00, 0x00, 0x7E, 0x00, 0xF7,
+        0x90, 0x3C, 0x40,
+        0xF0, 0x7E, 0x7F, 0x06, 0x01, 0xF7};
+
+    for (size_t fragment = 1; fragment <= stream.size(); ++fragment) {
+        received.clear();
+        for (size_t i = 0; i < stream.size(); i += fragment) {
+            const size_t count = std::min(fragment, stream.size() - i);
+            assembler.feed(stream.data() + i, count, 1000 + i);
+        }
+        ASSERT_EQ(received.size(), 2u) << fragment;
+        EXPECT_EQ(received[0].data(), (std::vector<uint8_t>{0xF0, 0x43, 0x10, 0x4C, 0x00, 0x00, 0x7E, 0x00, 0xF7}));
+        EXPECT_EQ(received[0].getManufacturerName(), "Yamaha");
+        EXPECT_EQ(received[0].getTimestamp(), 1000u);
+        EXPECT_EQ(received[1], SysexMessage::identityRequest());
+        EXPECT_FALSE(assembler.isReceiving());
+    }
+    EXPECT_EQ(assembler.getAbortedCount(), 0u);
+}
+
+TEST(SysexAssemblerTest, LargeDumpUsesChunks) {
+    SysexPool pool(256, 64);
+    SysexAssembler assembler(pool);
+    SysexMessage dump(pool);
+    assembler.setMessageCallback([&](SysexMessage&& message) { dump = std::move(message); });
+
+    std::vector<uint8_t> bytes(10000);
+    for (size_t i = 0; i < bytes.size(); ++i) bytes[i] = static_cast<uint8_t>(i % 128);
+    const uint8_t start[] = {0xF0, 0x47};
+    const uint8_t end[] = {0xF7};
+    assembler.feed(start, sizeof(start));
+    for (size_t i = 0; i < bytes.size(); i += 333) {
+        assembler.feed(bytes.data() + i, std::min<size_t>(333, bytes.size() - i));
+    }
+    assembler.feed(end, sizeof(end));
+
+    ASSERT_EQ(dump.size(), bytes.size() + 3);
+    EXPECT_EQ(dump.getChunkCount(), (bytes.size() + 3 + 255) / 256);
+    EXPECT_TRUE(dump.isComplete());
+    const std::vector<uint8_t> payload = dump.getPayload();
+    EXPECT_TRUE(std::equal(bytes.begin(), bytes.end(), payload.begin() + 1));
+    EXPECT_EQ(assembler.getTruncatedCount(), 0u);
+}
+
+TEST(SysexAssemblerTest, StreamsRegisteredManufacturer) {
+    SysexPool pool(16, 4);
+    SysexAssembler assembler(pool);
+    DumpDecoder decoder;
+    assembler.setStreamHandler(0x002109, &decoder);
+    int messages = 0;
+    assembler.setMessageCallback([&](SysexMessage&&) { ++messages; });
+
+    std::vector<uint8_t> original(5000);
+    std::mt19937 rng(9);
+    for (auto& byte : original) byte = static_cast<uint8_t>(rng());
+    std::vector<uint8_t> stream = {0xF0, 0x00, 0x21, 0x09};
+    std::vector<uint8_t> packed(SysexCodec::packedSize(original.size()));
+    SysexCodec::pack(original.data(), original.size(), packed.data());
+    stream.insert(stream.end(), packed.begin(), packed.end());
+    stream.push_back(0xF7);
+
+    // Far more data than the tiny pool could hold: nothing is stored
+    for (size_t i = 0; i < stream.size(); i += 61) {
+        assembler.feed(stream.data() + i, std::min<size_t>(61, stream.size() - i));
+    }
+    EXPECT_EQ(decoder.begins, 1);
+    EXPECT_EQ(decoder.manufacturer, 0x002109u);
+    EXPECT_TRUE(decoder.completed);
+    EXPECT_EQ(decoder.decoded, original);
+    EXPECT_EQ(messages, 0);
+    EXPECT_EQ(pool.getAvailableChunks(), 4u);
+}
+
+TEST(SysexAssemblerTest, StatusByteAbortsMessage) {
+    SysexPool pool(16, 8);
+    SysexAssembler assembler(pool);
+    DumpDecoder decoder;
+    assembler.setStreamHandler(0x41, &decoder);
+    int messages = 0;
+    assembler.setMessageCallback([&](SysexMessage&&) { ++messages; });
+
+    const uint8_t stream[] = {0xF0, 0x43, 0x01, 0x02, 0x80, 0x3C, 0x00,
+                              0xF0, 0x41, 0x05, 0xF0, 0x01, 0xF7};
+    assembler.feed(stream, sizeof(stream));
+    EXPECT_EQ(assembler.getAbortedCount(), 2u);
+    EXPECT_EQ(assembler.getCompletedCount(), 1u);
+    EXPECT_FALSE(decoder.completed);
+    EXPECT_EQ(messages, 1);
+    EXPECT_EQ(pool.getAvailableChunks(), 8u);
+
+    const uint8_t partial[] = {0xF0, 0x43, 0x01};
+    assembler.feed(partial, sizeof(partial));
+    EXPECT_TRUE(assembler.isReceiving());
+    assembler.reset();
+    EXPECT_FALSE(assembler.isReceiving());
+    EXPECT_EQ(pool.getAvailableChunks(), 8u);
+}
+
+} // namespace test
+} // namespace nap
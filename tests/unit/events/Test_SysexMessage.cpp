@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+#include "events/SysexMessage.h"
+#include "events/SysexPool.h"
+#include "core/threading/SpscQueue.h"
+#include <thread>
+
+namespace nap {
+namespace test {
+
+using events::SysexMessage;
+using events::SysexPool;
+
+TEST(SysexMessageTest, FactoriesAndAccessors) {
+    SysexMessage request = SysexMessage::identityRequest(0x10);
+    EXPECT_TRUE(request.isComplete());
+    EXPECT_TRUE(request.isNonRealTime());
+    EXPECT_EQ(request.getDeviceId(), 0x10);
+    EXPECT_EQ(request.getSubId1(), 0x06);
+    EXPECT_EQ(request.toHexString(), "f0 7e 10 06 01 f7");
+
+    SysexMessage reply = SysexMessage::identityReply(0x01, 0x41, 0, 0, 0x01, 0x02,
+                                                     0x03, 0x04, 0, 1, 2, 3);
+    auto parsed = reply.parseIdentityReply();
+    ASSERT_TRUE(parsed.has_value());
+    EXPECT_EQ(parsed->manufacturerId, SysexMessage::MANUFACTURER_ROLAND);
+    EXPECT_EQ(parsed->familyCode, 0x0102);
+    EXPECT_EQ(parsed->modelNumber, 0x0304);
+
+    SysexMessage unframed({0x43, 0x10, 0xF7});
+    EXPECT_EQ(unframed.size(), 4u);
+    EXPECT_EQ(unframed.getManufacturerName(), "Yamaha");
+    EXPECT_EQ(unframed.getPayload(), (std::vector<uint8_t>{0x43, 0x10}));
+}
+
+TEST(SysexMessageTest, RolandChecksumAcrossChunks) {
+    SysexPool pool(4, 16);
+    // DT1 to address 40 00 7F, data 00: checksum 0x41
+    SysexMessage message(pool);
+    const uint8_t bytes[] = {0x41, 0x10, 0x42, 0x12, 0x40, 0x00, 0x7F, 0x00, 0x41, 0xF7};
+    message.append(bytes, sizeof(bytes));
+    EXPECT_EQ(message.getChunkCount(), 3u);
+    EXPECT_EQ(message.calculateRolandChecksum(), 0x41);
+    EXPECT_TRUE(message.verifyRolandChecksum());
+}
+
+TEST(SysexMessageTest, MessagesDrawFromAndReturnToPool) {
+    SysexPool pool(8, 4);
+    {
+        const std::vector<uint8_t> bytes(20, 0x11);
+        SysexMessage message(pool, bytes.data(), bytes.size());
+        EXPECT_EQ(message.size(), 21u);
+        EXPECT_EQ(message.getChunkCount(), 3u);
+        EXPECT_EQ(pool.getAvailableChunks(), 1u);
+
+        size_t length = 0;
+        const uint8_t* first = message.getChunkData(0, length);
+        ASSERT_NE(first, nullptr);
+        EXPECT_EQ(length, 8u);
+        EXPECT_EQ(first[0], 0xF0);
+        message.getChunkData(2, length);
+        EXPECT_EQ(length, 5u);
+        EXPECT_EQ(message.getChunkData(3, length), nullptr);
+
+        uint8_t out[32] = {};
+        EXPECT_EQ(message.copyTo(out, sizeof(out)), 21u);
+        EXPECT_EQ(out[20], 0x11);
+        EXPECT_EQ(message.copyTo(out, 10), 10u);
+    }
+    EXPECT_EQ(pool.getAvailableChunks(), 4u);
+}
+
+TEST(SysexMessageTest, ExhaustedPoolTruncates) {
+    SysexPool pool(4, 2);
+    const std::vector<uint8_t> bytes(12, 0x22);
+    SysexMessage message(pool, bytes.data(), bytes.size());
+    EXPECT_TRUE(message.isTruncated());
+    EXPECT_EQ(message.size(), 8u);
+    EXPECT_GT(pool.getExhaustedCount(), 0u);
+
+    message.clear();
+    EXPECT_FALSE(message.isTruncated());
+    EXPECT_EQ(message.size(), 1u);
+    EXPECT_EQ(pool.getAvailableChunks(), 1u);
+}
+
+TEST(SysexMessageTest, CopiesShareUntilModified) {
+    SysexPool pool(4, 8);
+    SysexMessage original(pool);
+    const uint8_t bytes[] = {0x41, 1, 2, 3, 4, 0xF7};
+    original.append(bytes, sizeof(bytes));
+    const size_t used = pool.getChunkCount() - pool.getAvailableChunks();
+
+    SysexMessage copy = original;
+    EXPECT_EQ(pool.getChunkCount() - pool.getAvailableChunks(), used);
+    EXPECT_EQ(copy, original);
+
+    // Appending replaces the trailing F7 on a private clone only
+    copy.append(0x55);
+    EXPECT_EQ(pool.getChunkCount() - pool.getAvailableChunks(), used * 2);
+    EXPECT_NE(copy, original);
+    EXPECT_TRUE(original.isComplete());
+    EXPECT_FALSE(copy.isComplete());
+    EXPECT_EQ(copy[6], 0x55);
+    EXPECT_EQ(original.size(), 7u);
+
+    SysexMessage moved = std::move(copy);
+    EXPECT_EQ(moved[6], 0x55);
+    copy = original;
+    EXPECT_EQ(copy, original);
+}
+
+TEST(SysexMessageTest, ReleasedFromAnotherThread) {
+    SysexPool pool(16, 64);
+    SpscQueue<SysexMessage*> queue(64);
+    constexpr int kMessages = 2000;
+
+    std::thread consumer([&]() {
+        int received = 0;
+        SysexMessage* message = nullptr;
+        while (received < kMessages) {
+            if (queue.pop(message)) {
+                EXPECT_TRUE(message->isComplete());
+                delete message;
+                ++received;
+            }
+        }
+    });
+
+    const std::vector<uint8_t> bytes = {0xF0, 0x7E, 0x7F, 0x06, 0x01, 0xF7};
+    for (int i = 0; i < kMessages; ++i) {
+        auto* message = new SysexMessage(pool, bytes.data(), bytes.size());
+        while (message->isTruncated()) {
+            delete message;
+            std::this_thread::yield();
+            message = new SysexMessage(pool, bytes.data(), bytes.size());
+        }
+        while (!queue.push(message)) {
+            std::this_thread::yield();
+        }
+    }
+    consumer.join();
+    EXPECT_EQ(pool.getAvailableChunks(), 64u);
+}
+
+} // namespace test
+} // namespace nap
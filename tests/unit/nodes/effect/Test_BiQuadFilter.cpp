@@ -37,7 +37,7 @@ static float magnitudeAtFrequency(const std::vector<float>& ir, double freqHz, d
 
 static float magnitudeToDb(float linear)
 {
-    return 20.0f * std::log10f(linear + 1e-12f);
+    return 20.0f * std::log10(linear + 1e-12f);
 }
 
 constexpr uint32_t IR_LENGTH   = 4096;
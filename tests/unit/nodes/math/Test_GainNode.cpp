@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <algorithm>
 #include "../../../../src/nodes/math/GainNode.h"
 
 namespace nap { namespace test {
@@ -36,4 +37,25 @@ TEST(GainNodeTest, ProcessAppliesGain) {
     EXPECT_LT(output[0], 1.0f);
 }
 
+TEST(GainNodeTest, GainRampSettlesOnTarget) {
+    GainNode node;
+    node.prepare(48000.0, 256);
+    node.setGain(0.25f);
+
+    float input[512];
+    float output[512];
+    std::fill(input, input + 512, 1.0f);
+
+    // Ramp is 5 ms (240 frames); both channels share the per-frame gain
+    node.process(input, output, 256, 2);
+    EXPECT_FLOAT_EQ(output[0], output[1]);
+    EXPECT_LT(output[0], 1.0f);
+    EXPECT_GT(output[0], output[2]);
+    EXPECT_FLOAT_EQ(output[510], 0.25f);
+
+    node.process(input, output, 256, 2);
+    EXPECT_FLOAT_EQ(output[0], 0.25f);
+    EXPECT_FLOAT_EQ(output[511], 0.25f);
+}
+
 }} // namespace nap::test
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <algorithm>
 #include "../../../../src/nodes/math/PanNode.h"
 
 namespace nap { namespace test {
@@ -33,4 +34,22 @@ TEST(PanNodeTest, CanSetPanLaw) {
     EXPECT_EQ(node.getPanLaw(), PanNode::PanLaw::Linear);
 }
 
+TEST(PanNodeTest, PanChangeIsSmoothedThenSettles) {
+    PanNode node;
+    node.setPanLaw(PanNode::PanLaw::Linear);
+    node.prepare(48000.0, 512);
+    node.reset();
+    node.setPan(-1.0f);
+
+    float input[1024];
+    float output[1024];
+    std::fill(input, input + 1024, 1.0f);
+
+    node.process(input, output, 512, 2);
+    EXPECT_GT(output[1], 0.0f);        // Right channel ramps down
+    EXPECT_LT(output[1], 0.5f);
+    EXPECT_FLOAT_EQ(output[1022], 1.0f);
+    EXPECT_FLOAT_EQ(output[1023], 0.0f);
+}
+
 }} // namespace nap::test
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "../../../../src/nodes/source/FileStreamReader.h"
+#include "../../../../src/core/memory/MultiChannelRingBuffer.h"
 
 namespace nap { namespace test {
 
@@ -36,4 +37,22 @@ TEST(FileStreamReaderTest, IsSeekableWhenLoaded) {
     EXPECT_TRUE(reader.isSeekable());
 }
 
+TEST(FileStreamReaderTest, GeneratePlaysFramesFromStreamBuffer) {
+    FileStreamReader reader;
+    reader.prepare(44100.0, 4);
+    reader.loadFile("/fake/path.wav");
+    reader.start();
+
+    ASSERT_NE(reader.getStreamBuffer(), nullptr);
+    float frames[] = {0.1f, 0.2f, 0.3f, 0.4f};
+    reader.getStreamBuffer()->writeInterleaved(frames, 2);
+
+    float output[8] = {};
+    reader.generate(output, 4, 2);
+    EXPECT_FLOAT_EQ(output[0], 0.1f);
+    EXPECT_FLOAT_EQ(output[3], 0.4f);
+    EXPECT_FLOAT_EQ(output[4], 0.0f);
+    EXPECT_EQ(reader.getCurrentPosition(), 2u);
+}
+
 }} // namespace nap::test